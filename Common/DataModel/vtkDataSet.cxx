@@ -236,6 +236,18 @@ unsigned long int vtkDataSet::GetMTime()
   return ( mtime > result ? mtime : result );
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkDataSet::GetGeometryMTime()
+{
+  return this->vtkDataObject::GetMTime();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkDataSet::GetTopologyMTime()
+{
+  return this->vtkDataObject::GetMTime();
+}
+
 //----------------------------------------------------------------------------
 vtkCell *vtkDataSet::FindAndGetCell (double x[3], vtkCell *cell,
                                      vtkIdType cellId, double tol2, int& subId,
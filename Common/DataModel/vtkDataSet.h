@@ -206,6 +206,19 @@ public:
   // THIS METHOD IS THREAD SAFE
   unsigned long int GetMTime();
 
+  // Description:
+  // Return the modification time of the geometry (the point coordinates)
+  // and of the topology (the cells) of the dataset. Unlike GetMTime(),
+  // these ignore the point and cell data and, for datasets that store
+  // points and cells separately, each other. Filters can compare them with
+  // the values seen at their last execution to find out whether only the
+  // points or the attributes of their input changed. As for GetMTime(),
+  // arrays modified in place must be marked modified. This implementation
+  // returns the modification time of the dataset itself for both.
+  // THIS METHOD IS THREAD SAFE
+  virtual unsigned long GetGeometryMTime();
+  virtual unsigned long GetTopologyMTime();
+
   // Description:
   // Return a pointer to this dataset's cell data.
   // THIS METHOD IS THREAD SAFE
@@ -122,6 +122,12 @@ unsigned long int vtkPointSet::GetMTime()
   return dsTime;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkPointSet::GetGeometryMTime()
+{
+  return this->Points ? this->Points->GetMTime() : 0;
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkPointSet::FindPoint(double x[3])
 {
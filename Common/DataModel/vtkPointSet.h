@@ -67,6 +67,10 @@ public:
   // Get MTime which also considers its vtkPoints MTime.
   unsigned long GetMTime();
 
+  // Description:
+  // The geometry modification time is the one of the points.
+  virtual unsigned long GetGeometryMTime();
+
   // Description:
   // Compute the (X, Y, Z)  bounds of the data.
   void ComputeBounds();
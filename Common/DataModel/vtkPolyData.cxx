@@ -904,6 +904,32 @@ int vtkPolyData::GetMaxCellSize()
   return maxCellSize;
 }
 
+//----------------------------------------------------------------------------
+// The modification time of a cell array does not include the one of its id
+// array.
+static unsigned long vtkPolyDataGetCellArrayMTime(vtkCellArray *cells)
+{
+  if ( !cells )
+    {
+    return 0;
+    }
+  unsigned long mtime = cells->GetMTime();
+  unsigned long dataTime = cells->GetData()->GetMTime();
+  return ( dataTime > mtime ? dataTime : mtime );
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPolyData::GetTopologyMTime()
+{
+  unsigned long result = vtkPolyDataGetCellArrayMTime(this->Verts);
+  unsigned long mtime = vtkPolyDataGetCellArrayMTime(this->Lines);
+  result = ( mtime > result ? mtime : result );
+  mtime = vtkPolyDataGetCellArrayMTime(this->Polys);
+  result = ( mtime > result ? mtime : result );
+  mtime = vtkPolyDataGetCellArrayMTime(this->Strips);
+  return ( mtime > result ? mtime : result );
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkPolyData::GetNumberOfCells()
 {
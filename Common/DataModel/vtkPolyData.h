@@ -128,6 +128,11 @@ public:
   // Return the maximum cell size in this poly data.
   int GetMaxCellSize();
 
+  // Description:
+  // The topology modification time is the latest one of the vertex,
+  // line, polygon and strip cell arrays.
+  virtual unsigned long GetTopologyMTime();
+
   // Description:
   // Set the cell array defining vertices.
   void SetVerts (vtkCellArray* v);
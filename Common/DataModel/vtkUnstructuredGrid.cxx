@@ -873,6 +873,29 @@ int vtkUnstructuredGrid::GetMaxCellSize()
     }
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkUnstructuredGrid::GetTopologyMTime()
+{
+  unsigned long result = 0;
+  unsigned long mtime;
+  vtkObject *parts[6] = {this->Connectivity, NULL, this->Types,
+                         this->Locations, this->Faces, this->FaceLocations};
+  if ( this->Connectivity )
+    {
+    // The cell array does not include the modification time of its ids.
+    parts[1] = this->Connectivity->GetData();
+    }
+  for (int i = 0; i < 6; i++)
+    {
+    if ( parts[i] )
+      {
+      mtime = parts[i]->GetMTime();
+      result = ( mtime > result ? mtime : result );
+      }
+    }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkUnstructuredGrid::GetNumberOfCells()
 {
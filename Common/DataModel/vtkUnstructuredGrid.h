@@ -127,6 +127,12 @@ public:
   void Initialize();
   int GetMaxCellSize();
   void BuildLinks();
+
+  // Description:
+  // The topology modification time is the latest one of the connectivity,
+  // cell type, cell location and polyhedron face arrays.
+  virtual unsigned long GetTopologyMTime();
+
   vtkCellLinks *GetCellLinks() {return this->Links;};
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                              vtkIdType* &pts);
@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineDataCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that an executive with a vtkPipelineDataCache restores the
+// time steps already produced by its algorithm instead of executing it,
+// that the least recently used time steps are released when the memory
+// limit is reached and that modifying the algorithm invalidates the cache.
+
+#include "vtkDataArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineDataCache.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Produces a 64^3 float image filled with Offset + the time step.
+class TestTimeSource : public vtkImageAlgorithm
+{
+public:
+  static TestTimeSource* New();
+  vtkTypeMacro(TestTimeSource, vtkImageAlgorithm);
+
+  vtkSetMacro(Offset, double);
+  vtkGetMacro(NumberOfExecutions, int);
+
+protected:
+  TestTimeSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->Offset = 0.0;
+    this->NumberOfExecutions = 0;
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = {0, 63, 0, 63, 0, 63};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    double timeSteps[10];
+    for (int i = 0; i < 10; i++)
+      {
+      timeSteps[i] = i;
+      }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(),
+                 timeSteps, 10);
+    double timeRange[2] = {0, 9};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(),
+                 timeRange, 2);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+    return 1;
+    }
+
+  virtual void ExecuteDataWithInformation(vtkDataObject* output,
+                                          vtkInformation* outInfo)
+    {
+    this->NumberOfExecutions++;
+    vtkImageData* image = this->AllocateOutputData(output, outInfo);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    image->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    float* values =
+      static_cast<float*>(image->GetPointData()->GetScalars()->GetVoidPointer(0));
+    vtkIdType numberOfPoints = image->GetNumberOfPoints();
+    for (vtkIdType i = 0; i < numberOfPoints; i++)
+      {
+      values[i] = static_cast<float>(this->Offset + time);
+      }
+    }
+
+  double Offset;
+  int NumberOfExecutions;
+};
+vtkStandardNewMacro(TestTimeSource);
+
+// Update the source at the given time and return the value of its output.
+double UpdateAt(TestTimeSource* source, double time)
+{
+  source->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+    source->GetOutputInformation(0), time);
+  source->Update();
+  vtkImageData* image = source->GetOutput();
+  if (image->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+    {
+    return -1;
+    }
+  return image->GetPointData()->GetScalars()->GetComponent(1000, 0);
+}
+}
+
+int TestPipelineDataCache(int, char*[])
+{
+  vtkNew<vtkPipelineDataCache> cache;
+  vtkNew<TestTimeSource> source;
+  vtkStreamingDemandDrivenPipeline::SafeDownCast(source->GetExecutive())
+    ->SetDataCache(cache.GetPointer());
+
+  // Scrubbing back and forth only executes the source once per time step.
+  double times[] = {0, 1, 2, 3, 2, 1, 0, 1, 2, 3};
+  for (int i = 0; i < 10; i++)
+    {
+    TEST_ASSERT(UpdateAt(source.GetPointer(), times[i]) == times[i],
+                "Wrong output at time " << times[i]);
+    }
+  TEST_ASSERT(source->GetNumberOfExecutions() == 4,
+              "Expected 4 executions, got " << source->GetNumberOfExecutions());
+  TEST_ASSERT(cache->GetNumberOfEntries() == 4,
+              "Expected 4 cached time steps");
+  TEST_ASSERT(cache->GetNumberOfHits() == 6,
+              "Expected 6 cache hits, got " << cache->GetNumberOfHits());
+
+  // Keep room for 2 time steps only: the least recently used ones go.
+  unsigned long stepSize = cache->GetMemorySize() / 4;
+  cache->SetMemoryLimit(2 * stepSize + stepSize / 2);
+  TEST_ASSERT(cache->GetNumberOfEntries() == 2,
+              "Expected 2 time steps to fit in the memory limit");
+  UpdateAt(source.GetPointer(), 2);
+  TEST_ASSERT(source->GetNumberOfExecutions() == 4,
+              "Expected the most recent time steps to be kept");
+  UpdateAt(source.GetPointer(), 0);
+  UpdateAt(source.GetPointer(), 3);
+  TEST_ASSERT(source->GetNumberOfExecutions() == 6,
+              "Expected the released time steps to be executed again");
+  TEST_ASSERT(cache->GetMemorySize() <= cache->GetMemoryLimit(),
+              "The cache exceeds its memory limit");
+  UpdateAt(source.GetPointer(), 0);
+  TEST_ASSERT(source->GetNumberOfExecutions() == 6,
+              "Expected time step 0 to be cached");
+
+  // Modifying the source makes all cached time steps invalid.
+  source->SetOffset(100);
+  TEST_ASSERT(UpdateAt(source.GetPointer(), 3) == 103,
+              "Expected the modified source to execute");
+  TEST_ASSERT(source->GetNumberOfExecutions() == 7,
+              "Expected the modified source to execute once");
+  TEST_ASSERT(UpdateAt(source.GetPointer(), 0) == 100,
+              "Expected time step 0 of the modified source");
+  TEST_ASSERT(source->GetNumberOfExecutions() == 8,
+              "Expected the old time step 0 to be invalid");
+
+  // The shared cache works the same way.
+  vtkNew<TestTimeSource> shared;
+  vtkStreamingDemandDrivenPipeline::SafeDownCast(shared->GetExecutive())
+    ->SetDataCache(vtkPipelineDataCache::GetGlobalCache());
+  UpdateAt(shared.GetPointer(), 5);
+  UpdateAt(shared.GetPointer(), 6);
+  UpdateAt(shared.GetPointer(), 5);
+  TEST_ASSERT(shared->GetNumberOfExecutions() == 2,
+              "Expected the shared cache to keep time step 5");
+  vtkPipelineDataCache::GetGlobalCache()->RemoveEntries(shared.GetPointer());
+  TEST_ASSERT(vtkPipelineDataCache::GetGlobalCache()->GetNumberOfEntries() == 0,
+              "Expected the entries of the source to be removed");
+
+  return EXIT_SUCCESS;
+}
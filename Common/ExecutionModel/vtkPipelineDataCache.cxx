@@ -0,0 +1,377 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineDataCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineDataCache.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimeStamp.h"
+#include "vtkWeakPointer.h"
+
+#include <list>
+#include <vector>
+
+vtkStandardNewMacro(vtkPipelineDataCache);
+
+//----------------------------------------------------------------------------
+class vtkPipelineDataCacheEntry
+{
+public:
+  vtkWeakPointer<vtkAlgorithm> Algorithm;
+  int Port;
+  // Values of the request keys the data was produced for.
+  std::vector<double> Request;
+  vtkSmartPointer<vtkDataObject> Data;
+  // Data information keys restored with the data.
+  vtkSmartPointer<vtkInformation> DataInformation;
+  unsigned long Size;
+  vtkTimeStamp StoreTime;
+};
+
+class vtkPipelineDataCacheInternals
+{
+public:
+  // The most recently used entries come first.
+  typedef std::list<vtkPipelineDataCacheEntry> EntryList;
+  EntryList Entries;
+  unsigned long MemorySize;
+
+  static vtkPipelineDataCache* GlobalCache;
+};
+
+vtkPipelineDataCache* vtkPipelineDataCacheInternals::GlobalCache = 0;
+
+//----------------------------------------------------------------------------
+// Releases the shared cache at exit.
+class vtkPipelineDataCacheCleanup
+{
+public:
+  ~vtkPipelineDataCacheCleanup()
+    {
+    vtkPipelineDataCache::SetGlobalCache(0);
+    }
+};
+static vtkPipelineDataCacheCleanup vtkPipelineDataCacheCleanupInstance;
+
+//----------------------------------------------------------------------------
+namespace
+{
+// Append the value of a request key to the request values, preceded by
+// its number of values so that a missing key cannot match another one.
+void AppendRequestValue(vtkInformation* info, vtkInformationIntegerKey* key,
+                        std::vector<double>& values)
+{
+  values.push_back(info->Has(key) ? 1 : 0);
+  if (info->Has(key))
+    {
+    values.push_back(info->Get(key));
+    }
+}
+
+void AppendRequestValue(vtkInformation* info, vtkInformationDoubleKey* key,
+                        std::vector<double>& values)
+{
+  values.push_back(info->Has(key) ? 1 : 0);
+  if (info->Has(key))
+    {
+    values.push_back(info->Get(key));
+    }
+}
+
+void AppendRequestValue(vtkInformation* info,
+                        vtkInformationIntegerVectorKey* key,
+                        std::vector<double>& values)
+{
+  int length = info->Has(key) ? info->Length(key) : 0;
+  values.push_back(length);
+  int* v = length > 0 ? info->Get(key) : 0;
+  for (int i = 0; i < length; i++)
+    {
+    values.push_back(v[i]);
+    }
+}
+
+// Return the values of the keys that select what an algorithm produces.
+std::vector<double> GetRequestValues(vtkInformation* outInfo)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  std::vector<double> values;
+  AppendRequestValue(outInfo, vtkSDDP::UPDATE_TIME_STEP(), values);
+  AppendRequestValue(outInfo, vtkSDDP::UPDATE_PIECE_NUMBER(), values);
+  AppendRequestValue(outInfo, vtkSDDP::UPDATE_NUMBER_OF_PIECES(), values);
+  AppendRequestValue(outInfo, vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS(), values);
+  AppendRequestValue(outInfo, vtkSDDP::UPDATE_EXTENT(), values);
+  AppendRequestValue(outInfo, vtkSDDP::UPDATE_RESOLUTION(), values);
+  AppendRequestValue(outInfo, vtkSDDP::EXACT_EXTENT(), values);
+  AppendRequestValue(
+    outInfo, vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(), values);
+  return values;
+}
+
+// Copy the pipeline information of a data object that is not copied by
+// vtkDataObject::ShallowCopy().
+void CopyDataInformation(vtkInformation* from, vtkInformation* to)
+{
+  vtkInformationDoubleKey* doubleKeys[] =
+    {
+    vtkDataObject::DATA_TIME_STEP(),
+    vtkDataObject::DATA_RESOLUTION()
+    };
+  for (int i = 0; i < 2; i++)
+    {
+    if (from->Has(doubleKeys[i]))
+      {
+      to->CopyEntry(from, doubleKeys[i]);
+      }
+    else
+      {
+      to->Remove(doubleKeys[i]);
+      }
+    }
+  vtkInformationIntegerKey* integerKeys[] =
+    {
+    vtkDataObject::DATA_PIECE_NUMBER(),
+    vtkDataObject::DATA_NUMBER_OF_PIECES(),
+    vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS()
+    };
+  for (int i = 0; i < 3; i++)
+    {
+    if (from->Has(integerKeys[i]))
+      {
+      to->CopyEntry(from, integerKeys[i]);
+      }
+    else
+      {
+      to->Remove(integerKeys[i]);
+      }
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineDataCache::vtkPipelineDataCache()
+{
+  this->MemoryLimit = 1048576;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->Internals = new vtkPipelineDataCacheInternals;
+  this->Internals->MemorySize = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineDataCache::~vtkPipelineDataCache()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineDataCache* vtkPipelineDataCache::GetGlobalCache()
+{
+  if (!vtkPipelineDataCacheInternals::GlobalCache)
+    {
+    vtkPipelineDataCacheInternals::GlobalCache = vtkPipelineDataCache::New();
+    }
+  return vtkPipelineDataCacheInternals::GlobalCache;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::SetGlobalCache(vtkPipelineDataCache* cache)
+{
+  if (vtkPipelineDataCacheInternals::GlobalCache == cache)
+    {
+    return;
+    }
+  if (cache)
+    {
+    cache->Register(0);
+    }
+  if (vtkPipelineDataCacheInternals::GlobalCache)
+    {
+    vtkPipelineDataCacheInternals::GlobalCache->UnRegister(0);
+    }
+  vtkPipelineDataCacheInternals::GlobalCache = cache;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::SetMemoryLimit(unsigned long limit)
+{
+  if (this->MemoryLimit == limit)
+    {
+    return;
+    }
+  this->MemoryLimit = limit;
+  this->Prune();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineDataCache::GetMemorySize()
+{
+  return this->Internals->MemorySize;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineDataCache::GetNumberOfEntries()
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::Store(vtkAlgorithm* algorithm, int port,
+                                 vtkInformation* outInfo, vtkDataObject* data)
+{
+  if (!algorithm || !outInfo || !data)
+    {
+    return;
+    }
+  unsigned long size = data->GetActualMemorySize();
+  if (size > this->MemoryLimit)
+    {
+    return;
+    }
+
+  // Replace the entry of the same request, if any.
+  std::vector<double> request = GetRequestValues(outInfo);
+  vtkPipelineDataCacheInternals::EntryList& entries = this->Internals->Entries;
+  vtkPipelineDataCacheInternals::EntryList::iterator it;
+  for (it = entries.begin(); it != entries.end(); ++it)
+    {
+    if (it->Algorithm.GetPointer() == algorithm && it->Port == port &&
+        it->Request == request)
+      {
+      this->Internals->MemorySize -= it->Size;
+      entries.erase(it);
+      break;
+      }
+    }
+
+  vtkPipelineDataCacheEntry entry;
+  entry.Algorithm = algorithm;
+  entry.Port = port;
+  entry.Request = request;
+  entry.Data.TakeReference(data->NewInstance());
+  entry.Data->ShallowCopy(data);
+  entry.DataInformation = vtkSmartPointer<vtkInformation>::New();
+  CopyDataInformation(data->GetInformation(), entry.DataInformation);
+  entry.Size = size;
+  entry.StoreTime.Modified();
+  entries.push_front(entry);
+  this->Internals->MemorySize += size;
+
+  this->Prune();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineDataCache::Retrieve(vtkAlgorithm* algorithm, int port,
+                                   vtkInformation* outInfo,
+                                   vtkDataObject* output,
+                                   unsigned long pipelineMTime)
+{
+  if (!algorithm || !outInfo || !output)
+    {
+    return 0;
+    }
+
+  std::vector<double> request = GetRequestValues(outInfo);
+  vtkPipelineDataCacheInternals::EntryList& entries = this->Internals->Entries;
+  vtkPipelineDataCacheInternals::EntryList::iterator it = entries.begin();
+  while (it != entries.end())
+    {
+    if (it->Algorithm.GetPointer() != algorithm || it->Port != port)
+      {
+      ++it;
+      }
+    else if (it->StoreTime.GetMTime() < pipelineMTime)
+      {
+      // The pipeline changed since the data was produced. The entry
+      // cannot become valid again.
+      this->Internals->MemorySize -= it->Size;
+      it = entries.erase(it);
+      }
+    else if (it->Request == request && output->IsA(it->Data->GetClassName()))
+      {
+      output->ShallowCopy(it->Data);
+      CopyDataInformation(it->DataInformation, output->GetInformation());
+      // Move the entry to the front of the list.
+      entries.splice(entries.begin(), entries, it);
+      this->NumberOfHits++;
+      return 1;
+      }
+    else
+      {
+      ++it;
+      }
+    }
+  this->NumberOfMisses++;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::RemoveEntries(vtkAlgorithm* algorithm)
+{
+  vtkPipelineDataCacheInternals::EntryList& entries = this->Internals->Entries;
+  vtkPipelineDataCacheInternals::EntryList::iterator it = entries.begin();
+  while (it != entries.end())
+    {
+    if (it->Algorithm.GetPointer() == algorithm)
+      {
+      this->Internals->MemorySize -= it->Size;
+      it = entries.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::RemoveAllEntries()
+{
+  this->Internals->Entries.clear();
+  this->Internals->MemorySize = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::Prune()
+{
+  // Release the entries of deleted algorithms first.
+  this->RemoveEntries(0);
+
+  vtkPipelineDataCacheInternals::EntryList& entries = this->Internals->Entries;
+  while (!entries.empty() && this->Internals->MemorySize > this->MemoryLimit)
+    {
+    this->Internals->MemorySize -= entries.back().Size;
+    entries.pop_back();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineDataCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+  os << indent << "MemorySize: " << this->Internals->MemorySize << endl;
+  os << indent << "NumberOfEntries: " << this->GetNumberOfEntries() << endl;
+  os << indent << "NumberOfHits: " << this->NumberOfHits << endl;
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << endl;
+}
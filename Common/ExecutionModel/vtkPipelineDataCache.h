@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineDataCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPipelineDataCache - Memory bounded cache of algorithm outputs.
+// .SECTION Description
+// vtkPipelineDataCache keeps shallow copies of the outputs of algorithms
+// so that an executive can restore them instead of executing its
+// algorithm again. An entry is identified by the algorithm, the output
+// port and the request that produced it: the update time step, piece,
+// number of pieces, ghost levels, update extent, resolution and
+// composite indices. An entry is valid as long as the pipeline
+// modification time of the algorithm is older than the entry.
+//
+// The cache is bounded by MemoryLimit, the sum of the actual memory
+// sizes of the cached data objects. When an entry is added, the least
+// recently used entries are released until the cache fits in the limit.
+// Note that the memory of a cached data object may be shared with the
+// current output of its algorithm.
+//
+// vtkStreamingDemandDrivenPipeline (and its subclasses) use a cache set
+// with SetDataCache(). Executives can share the cache returned by
+// GetGlobalCache() so that a single memory limit applies to the whole
+// process, for example to keep the time steps of a reader when scrubbing
+// back and forth in time:
+// \code
+// vtkStreamingDemandDrivenPipeline::SafeDownCast(reader->GetExecutive())
+//   ->SetDataCache(vtkPipelineDataCache::GetGlobalCache());
+// \endcode
+// .SECTION See Also
+// vtkStreamingDemandDrivenPipeline vtkCachedStreamingDemandDrivenPipeline
+
+#ifndef __vtkPipelineDataCache_h
+#define __vtkPipelineDataCache_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkDataObject;
+class vtkInformation;
+class vtkPipelineDataCacheInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineDataCache : public vtkObject
+{
+public:
+  static vtkPipelineDataCache* New();
+  vtkTypeMacro(vtkPipelineDataCache,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Return the cache shared by the executives of the process. It is
+  // created on first use and deleted at exit.
+  static vtkPipelineDataCache* GetGlobalCache();
+
+  // Description:
+  // Replace the shared cache. Passing NULL releases it.
+  static void SetGlobalCache(vtkPipelineDataCache* cache);
+
+  // Description:
+  // Set / Get the maximum memory used by the cached data objects in
+  // kibibytes. Lowering the limit releases the least recently used
+  // entries. Default is 1048576 (1 GiB).
+  void SetMemoryLimit(unsigned long limit);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // Return the memory used by the cached data objects in kibibytes.
+  unsigned long GetMemorySize();
+
+  // Description:
+  // Return the number of cached data objects.
+  int GetNumberOfEntries();
+
+  // Description:
+  // Return the number of requests satisfied from the cache and the
+  // number of requests that were not.
+  vtkGetMacro(NumberOfHits, int);
+  vtkGetMacro(NumberOfMisses, int);
+
+  // Description:
+  // Add a shallow copy of the output of the algorithm on the given port
+  // as produced for the request in outInfo. The data information
+  // (time step, piece) is kept with it. Data objects larger than the
+  // memory limit are not cached.
+  void Store(vtkAlgorithm* algorithm, int port, vtkInformation* outInfo,
+             vtkDataObject* data);
+
+  // Description:
+  // Shallow copy into output the data cached for the request in outInfo
+  // on the given port of the algorithm. Entries older than pipelineMTime
+  // are released. Returns 1 if the data was found, 0 otherwise.
+  int Retrieve(vtkAlgorithm* algorithm, int port, vtkInformation* outInfo,
+               vtkDataObject* output, unsigned long pipelineMTime);
+
+  // Description:
+  // Release the entries of the given algorithm.
+  void RemoveEntries(vtkAlgorithm* algorithm);
+
+  // Description:
+  // Release all entries.
+  void RemoveAllEntries();
+
+protected:
+  vtkPipelineDataCache();
+  ~vtkPipelineDataCache();
+
+  // Description:
+  // Release the least recently used entries until the cache fits in
+  // the memory limit, and the entries of deleted algorithms.
+  void Prune();
+
+  unsigned long MemoryLimit;
+  int NumberOfHits;
+  int NumberOfMisses;
+
+private:
+  vtkPipelineDataCache(const vtkPipelineDataCache&);  // Not implemented.
+  void operator=(const vtkPipelineDataCache&);  // Not implemented.
+
+  vtkPipelineDataCacheInternals* Internals;
+};
+
+#endif
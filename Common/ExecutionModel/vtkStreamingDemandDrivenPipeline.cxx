@@ -34,8 +34,11 @@
 #include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineDataCache.h"
 #include "vtkSmartPointer.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkStreamingDemandDrivenPipeline);
 
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, CONTINUE_EXECUTING, Integer);
@@ -86,6 +89,9 @@ vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, BOUNDS, DoubleVector);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, TIME_DEPENDENT_INFORMATION, Integer);
 vtkInformationKeyMacro(vtkStreamingDemandDrivenPipeline, TIME_LABEL_ANNOTATION, String);
 
+vtkCxxSetObjectMacro(vtkStreamingDemandDrivenPipeline, DataCache,
+                     vtkPipelineDataCache);
+
 //----------------------------------------------------------------------------
 class vtkStreamingDemandDrivenPipelineToDataObjectFriendship
 {
@@ -102,6 +108,7 @@ vtkStreamingDemandDrivenPipeline::vtkStreamingDemandDrivenPipeline()
   this->ContinueExecuting = 0;
   this->UpdateExtentRequest = 0;
   this->LastPropogateUpdateExtentShortCircuited = 0;
+  this->DataCache = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -111,12 +118,14 @@ vtkStreamingDemandDrivenPipeline::~vtkStreamingDemandDrivenPipeline()
     {
     this->UpdateExtentRequest->Delete();
     }
+  this->SetDataCache(0);
 }
 
 //----------------------------------------------------------------------------
 void vtkStreamingDemandDrivenPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DataCache: " << this->DataCache << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -267,6 +276,14 @@ int vtkStreamingDemandDrivenPipeline
         }
       }
 
+    // If the output is in the data cache, restore it instead of
+    // executing.
+    if (this->DataCache && outInfo &&
+        this->NeedToExecuteData(outputPort,inInfoVec,outInfoVec))
+      {
+      this->RetrieveFromDataCache(outputPort, outInfoVec);
+      }
+
     // If we need to execute, propagate the update extent.
     int result = 1;
     int N2E = this->NeedToExecuteData(outputPort,inInfoVec,outInfoVec);
@@ -1239,10 +1256,68 @@ vtkStreamingDemandDrivenPipeline
   else
     {
     this->ContinueExecuting = 0;
+
+    // Remember the outputs that were generated before the superclass
+    // removes the marks.
+    std::vector<int> generated(outInfoVec->GetNumberOfInformationObjects());
+    for (size_t i = 0; i < generated.size(); ++i)
+      {
+      generated[i] = !outInfoVec->GetInformationObject(
+        static_cast<int>(i))->Get(DATA_NOT_GENERATED());
+      }
+
     this->Superclass::ExecuteDataEnd(request,inInfoVec,outInfoVec);
+
+    // Keep the new outputs in the data cache.
+    if (this->DataCache && !this->Algorithm->GetAbortExecute())
+      {
+      for (size_t i = 0; i < generated.size(); ++i)
+        {
+        vtkInformation* outInfo =
+          outInfoVec->GetInformationObject(static_cast<int>(i));
+        vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+        if (data && generated[i] &&
+            !outInfo->Has(FAST_PATH_FOR_TEMPORAL_DATA()))
+          {
+          this->DataCache->Store(this->Algorithm, static_cast<int>(i),
+                                 outInfo, data);
+          }
+        }
+      }
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkStreamingDemandDrivenPipeline
+::RetrieveFromDataCache(int outputPort, vtkInformationVector* outInfoVec)
+{
+  if (this->ContinueExecuting)
+    {
+    return 0;
+    }
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+  vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!data || outInfo->Has(FAST_PATH_FOR_TEMPORAL_DATA()) ||
+      !this->DataCache->Retrieve(this->Algorithm, outputPort, outInfo, data,
+                                 this->PipelineMTime))
+    {
+    return 0;
+    }
+
+  // The output is now up to date as if the algorithm executed.
+  data->DataHasBeenGenerated();
+  this->DataTime.Modified();
+  if (outInfo->Has(UPDATE_TIME_STEP()))
+    {
+    outInfo->Set(PREVIOUS_UPDATE_TIME_STEP(), outInfo->Get(UPDATE_TIME_STEP()));
+    }
+  else
+    {
+    outInfo->Remove(PREVIOUS_UPDATE_TIME_STEP());
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void
 vtkStreamingDemandDrivenPipeline
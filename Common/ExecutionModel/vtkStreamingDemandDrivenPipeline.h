@@ -39,6 +39,7 @@ class vtkInformationObjectBaseKey;
 class vtkInformationStringKey;
 class vtkInformationStringKey;
 class vtkInformationUnsignedLongKey;
+class vtkPipelineDataCache;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkStreamingDemandDrivenPipeline : public vtkDemandDrivenPipeline
 {
@@ -330,6 +331,16 @@ public:
     }
   virtual double ComputePriority(int port);
 
+  // Description:
+  // Set / Get the cache keeping the outputs of the algorithm. When set,
+  // an output that needs to be updated is first looked up in the cache
+  // and the algorithm only executes if it is not found. The outputs are
+  // added to the cache after every execution. Set it to
+  // vtkPipelineDataCache::GetGlobalCache() to share one memory limit
+  // with the other executives. Default is NULL.
+  void SetDataCache(vtkPipelineDataCache* cache);
+  vtkGetObjectMacro(DataCache, vtkPipelineDataCache);
+
 protected:
   vtkStreamingDemandDrivenPipeline();
   ~vtkStreamingDemandDrivenPipeline();
@@ -414,6 +425,12 @@ protected:
   // did the most recent PUE do anything ?
   int LastPropogateUpdateExtentShortCircuited;
 
+  // Restore the output on the given port from the data cache if it
+  // holds the data for the current request. Returns 1 on success.
+  int RetrieveFromDataCache(int outputPort, vtkInformationVector* outInfoVec);
+
+  vtkPipelineDataCache* DataCache;
+
 private:
   vtkStreamingDemandDrivenPipeline(const vtkStreamingDemandDrivenPipeline&);  // Not implemented.
   void operator=(const vtkStreamingDemandDrivenPipeline&);  // Not implemented.
@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdCacheTopology.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkThreshold reuses its cached cells when only the points
+// of a deforming mesh change, and evaluates the cells again when the
+// thresholded array or the criterion change.
+
+#include "vtkCellArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Return a grid sharing the cells and point data of the given one with
+// displaced points and a new displacement array.
+void Deform(vtkUnstructuredGrid* grid, double scale,
+            vtkUnstructuredGrid* deformed)
+{
+  deformed->ShallowCopy(grid);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> displacement;
+  displacement->SetName("Displacement");
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); i++)
+    {
+    double x[3];
+    grid->GetPoint(i, x);
+    points->InsertNextPoint(x[0], x[1], scale * x[2]);
+    displacement->InsertNextValue((scale - 1.0) * x[2]);
+    }
+  deformed->SetPoints(points.GetPointer());
+  deformed->GetPointData()->AddArray(displacement.GetPointer());
+}
+
+bool CompareGrids(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells() ||
+      a->GetPointData()->GetNumberOfArrays() !=
+        b->GetPointData()->GetNumberOfArrays())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); i++)
+    {
+    double xA[3], xB[3];
+    a->GetPoint(i, xA);
+    b->GetPoint(i, xB);
+    if (xA[0] != xB[0] || xA[1] != xB[1] || xA[2] != xB[2])
+      {
+      return false;
+      }
+    }
+  for (int i = 0; i < a->GetPointData()->GetNumberOfArrays(); i++)
+    {
+    vtkDataArray* arrayA = a->GetPointData()->GetArray(i);
+    vtkDataArray* arrayB = b->GetPointData()->GetArray(arrayA->GetName());
+    if (!arrayB)
+      {
+      return false;
+      }
+    for (vtkIdType t = 0; t < arrayA->GetNumberOfTuples(); t++)
+      {
+      if (arrayA->GetComponent(t, 0) != arrayB->GetComponent(t, 0))
+        {
+        return false;
+        }
+      }
+    }
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType i = 0; i < a->GetNumberOfCells(); i++)
+    {
+    a->GetCellPoints(i, idsA.GetPointer());
+    b->GetCellPoints(i, idsB.GetPointer());
+    if (a->GetCellType(i) != b->GetCellType(i) ||
+        idsA->GetNumberOfIds() != idsB->GetNumberOfIds())
+      {
+      return false;
+      }
+    for (vtkIdType j = 0; j < idsA->GetNumberOfIds(); j++)
+      {
+      if (idsA->GetId(j) != idsB->GetId(j))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestThresholdCacheTopology(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 10, 0, 10, 0, 10);
+  vtkNew<vtkDataSetTriangleFilter> tetra;
+  tetra->SetInputConnection(wavelet->GetOutputPort());
+  tetra->Update();
+  vtkUnstructuredGrid* grid = tetra->GetOutput();
+
+  vtkNew<vtkThreshold> cached;
+  cached->CacheTopologyOn();
+  cached->ThresholdBetween(100, 200);
+  cached->SetInputData(grid);
+  cached->Update();
+  vtkNew<vtkThreshold> reference;
+  reference->ThresholdBetween(100, 200);
+  reference->SetInputData(grid);
+  reference->Update();
+  TEST_ASSERT(cached->GetOutput()->GetNumberOfCells() > 0 &&
+              cached->GetOutput()->GetNumberOfCells() < grid->GetNumberOfCells(),
+              "Expected a part of the cells to be extracted");
+  TEST_ASSERT(CompareGrids(cached->GetOutput(), reference->GetOutput()),
+              "Threshold differs from the reference");
+  // Keep a reference so that a new array cannot have the same address.
+  vtkSmartPointer<vtkCellArray> cells = cached->GetOutput()->GetCells();
+
+  // Only the points and an array that is not thresholded change.
+  for (int step = 1; step <= 3; step++)
+    {
+    vtkNew<vtkUnstructuredGrid> deformed;
+    Deform(grid, 1.0 + 0.1 * step, deformed.GetPointer());
+    cached->SetInputData(deformed.GetPointer());
+    cached->Update();
+    reference->SetInputData(deformed.GetPointer());
+    reference->Update();
+    TEST_ASSERT(cached->GetOutput()->GetCells() == cells,
+                "Expected the cached cells to be reused at step " << step);
+    TEST_ASSERT(CompareGrids(cached->GetOutput(), reference->GetOutput()),
+                "Threshold of the deformed grid differs from the reference at "
+                "step " << step);
+    }
+
+  // New values of the thresholded array: the cells are evaluated again.
+  vtkNew<vtkUnstructuredGrid> changed;
+  changed->ShallowCopy(grid);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->DeepCopy(grid->GetPointData()->GetScalars());
+  scalars->SetName("RTData");
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+    {
+    scalars->SetValue(i, scalars->GetValue(i) + 20.0);
+    }
+  changed->GetPointData()->SetScalars(scalars.GetPointer());
+  cached->SetInputData(changed.GetPointer());
+  cached->Update();
+  reference->SetInputData(changed.GetPointer());
+  reference->Update();
+  TEST_ASSERT(cached->GetOutput()->GetCells() != cells,
+              "Expected the cells to be evaluated for new scalars");
+  TEST_ASSERT(CompareGrids(cached->GetOutput(), reference->GetOutput()),
+              "Threshold of the new scalars differs from the reference");
+  cells = cached->GetOutput()->GetCells();
+
+  // A new criterion: the cells are evaluated again.
+  cached->ThresholdByUpper(150);
+  cached->Update();
+  reference->ThresholdByUpper(150);
+  reference->Update();
+  TEST_ASSERT(cached->GetOutput()->GetCells() != cells,
+              "Expected the cells to be evaluated for a new criterion");
+  TEST_ASSERT(CompareGrids(cached->GetOutput(), reference->GetOutput()),
+              "Threshold with a new criterion differs from the reference");
+
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,28 @@
 
 vtkStandardNewMacro(vtkThreshold);
 
+// Set the data type of the output points from the desired precision.
+static void vtkThresholdSetPointsDataType(int precision, vtkDataSet *input,
+                                          vtkPoints *points)
+{
+  if(precision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
+    if(inputPointSet)
+      {
+      points->SetDataType(inputPointSet->GetPoints()->GetDataType());
+      }
+    }
+  else if(precision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+    points->SetDataType(VTK_FLOAT);
+    }
+  else if(precision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+    points->SetDataType(VTK_DOUBLE);
+    }
+}
+
 // Construct with lower threshold=0, upper threshold=1, and threshold
 // function=upper AllScalars=1.
 vtkThreshold::vtkThreshold()
@@ -39,6 +61,21 @@ vtkThreshold::vtkThreshold()
   this->SelectedComponent      = 0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
 
+  this->CacheTopology = 0;
+  this->TopologyCache = NULL;
+  this->CachedPointIds = NULL;
+  this->CachedCellIds = NULL;
+  this->CachedTopologyMTime = 0;
+  this->CachedScalarsMTime = 0;
+  this->CachedNumberOfPoints = 0;
+  this->CachedNumberOfCells = 0;
+  this->CachedLowerThreshold = 0.0;
+  this->CachedUpperThreshold = 0.0;
+  this->CachedThresholdFunction = NULL;
+  this->CachedAllScalars = 0;
+  this->CachedComponentMode = 0;
+  this->CachedSelectedComponent = 0;
+
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS,
                                vtkDataSetAttributes::SCALARS);
@@ -49,6 +86,7 @@ vtkThreshold::vtkThreshold()
 
 vtkThreshold::~vtkThreshold()
 {
+  this->ReleaseTopologyCache();
 }
 
 // Criterion is cells whose scalars are less or equal to lower threshold.
@@ -131,6 +169,18 @@ int vtkThreshold::RequestData(
     return 1;
     }
 
+  if (this->CacheTopology && this->IsTopologyCacheValid(input, inScalars))
+    {
+    this->ExecuteFromTopologyCache(input, output);
+    return 1;
+    }
+  this->ReleaseTopologyCache();
+  if (this->CacheTopology)
+    {
+    this->CachedPointIds = vtkIdList::New();
+    this->CachedCellIds = vtkIdList::New();
+    }
+
   outPD->CopyGlobalIdsOn();
   outPD->CopyAllocate(pd);
   outCD->CopyGlobalIdsOn();
@@ -142,22 +192,7 @@ int vtkThreshold::RequestData(
   newPoints = vtkPoints::New();
 
   // set precision for the points in the output
-  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-    {
-    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
-    if(inputPointSet)
-      {
-      newPoints->SetDataType(inputPointSet->GetPoints()->GetDataType());
-      }
-    }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-    {
-    newPoints->SetDataType(VTK_FLOAT);
-    }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-    {
-    newPoints->SetDataType(VTK_DOUBLE);
-    }
+  vtkThresholdSetPointsDataType(this->OutputPointsPrecision, input, newPoints);
 
   newPoints->Allocate(numPts);
 
@@ -218,6 +253,10 @@ int vtkThreshold::RequestData(
           newId = newPoints->InsertNextPoint(x);
           pointMap->SetId(ptId,newId);
           outPD->CopyData(pd,ptId,newId);
+          if (this->CachedPointIds)
+            {
+            this->CachedPointIds->InsertNextId(ptId);
+            }
           }
         newCellPts->InsertId(i,newId);
         }
@@ -233,6 +272,10 @@ int vtkThreshold::RequestData(
         }
       newCellId = output->InsertNextCell(cell->GetCellType(),newCellPts);
       outCD->CopyData(cd,cellId,newCellId);
+      if (this->CachedCellIds)
+        {
+        this->CachedCellIds->InsertNextId(cellId);
+        }
       newCellPts->Reset();
       } // satisfied thresholding
     } // for all cells
@@ -249,9 +292,104 @@ int vtkThreshold::RequestData(
 
   output->Squeeze();
 
+  if (this->CacheTopology)
+    {
+    this->TopologyCache = vtkUnstructuredGrid::New();
+    this->TopologyCache->CopyStructure(output);
+    this->TopologyCache->SetPoints(NULL);
+    this->CachedTopologyMTime = input->GetTopologyMTime();
+    this->CachedScalarsMTime = inScalars->GetMTime();
+    this->CachedNumberOfPoints = input->GetNumberOfPoints();
+    this->CachedNumberOfCells = input->GetNumberOfCells();
+    this->CachedLowerThreshold = this->LowerThreshold;
+    this->CachedUpperThreshold = this->UpperThreshold;
+    this->CachedThresholdFunction = this->ThresholdFunction;
+    this->CachedAllScalars = this->AllScalars;
+    this->CachedComponentMode = this->ComponentMode;
+    this->CachedSelectedComponent = this->SelectedComponent;
+    }
+
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkThreshold::ReleaseTopologyCache()
+{
+  if (this->TopologyCache)
+    {
+    this->TopologyCache->Delete();
+    this->TopologyCache = NULL;
+    }
+  if (this->CachedPointIds)
+    {
+    this->CachedPointIds->Delete();
+    this->CachedPointIds = NULL;
+    }
+  if (this->CachedCellIds)
+    {
+    this->CachedCellIds->Delete();
+    this->CachedCellIds = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkThreshold::IsTopologyCacheValid(vtkDataSet *input,
+                                       vtkDataArray *scalars)
+{
+  // The modification time of the filter is not used since it changes with
+  // the input connection. A different array has a different modification
+  // time.
+  return this->TopologyCache != NULL &&
+    this->LowerThreshold == this->CachedLowerThreshold &&
+    this->UpperThreshold == this->CachedUpperThreshold &&
+    this->ThresholdFunction == this->CachedThresholdFunction &&
+    this->AllScalars == this->CachedAllScalars &&
+    this->ComponentMode == this->CachedComponentMode &&
+    this->SelectedComponent == this->CachedSelectedComponent &&
+    input->GetTopologyMTime() == this->CachedTopologyMTime &&
+    scalars->GetMTime() == this->CachedScalarsMTime &&
+    input->GetNumberOfPoints() == this->CachedNumberOfPoints &&
+    input->GetNumberOfCells() == this->CachedNumberOfCells;
+}
+
+//----------------------------------------------------------------------------
+void vtkThreshold::ExecuteFromTopologyCache(vtkDataSet *input,
+                                            vtkUnstructuredGrid *output)
+{
+  vtkDebugMacro(<< "Reusing the cached cells");
+
+  vtkPointData *pd=input->GetPointData(), *outPD=output->GetPointData();
+  vtkCellData *cd=input->GetCellData(), *outCD=output->GetCellData();
+  vtkIdType numPts = this->CachedPointIds->GetNumberOfIds();
+  vtkIdType numCells = this->CachedCellIds->GetNumberOfIds();
+  vtkIdType *pointIds = this->CachedPointIds->GetPointer(0);
+  vtkIdType *cellIds = this->CachedCellIds->GetPointer(0);
+  vtkIdType i;
+  double x[3];
+
+  vtkPoints *newPoints = vtkPoints::New();
+  vtkThresholdSetPointsDataType(this->OutputPointsPrecision, input, newPoints);
+  newPoints->SetNumberOfPoints(numPts);
+  outPD->CopyGlobalIdsOn();
+  outPD->CopyAllocate(pd, numPts);
+  for (i=0; i < numPts; i++)
+    {
+    input->GetPoint(pointIds[i], x);
+    newPoints->SetPoint(i, x);
+    outPD->CopyData(pd, pointIds[i], i);
+    }
+  outCD->CopyGlobalIdsOn();
+  outCD->CopyAllocate(cd, numCells);
+  for (i=0; i < numCells; i++)
+    {
+    outCD->CopyData(cd, cellIds[i], i);
+    }
+
+  output->CopyStructure(this->TopologyCache);
+  output->SetPoints(newPoints);
+  newPoints->Delete();
+}
+
 int vtkThreshold::EvaluateComponents( vtkDataArray *scalars, vtkIdType id )
 {
   int keepCell = 0;
@@ -390,6 +528,8 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Upper Threshold: " << this->UpperThreshold << "\n";
   os << indent << "Precision of the output points: "
      << this->OutputPointsPrecision << "\n";
+  os << indent << "Cache Topology: "
+     << (this->CacheTopology ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
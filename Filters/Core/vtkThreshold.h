@@ -47,6 +47,7 @@
 #define VTK_COMPONENT_MODE_USE_ANY         2
 
 class vtkDataArray;
+class vtkIdList;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
 {
@@ -141,6 +142,20 @@ public:
   void SetOutputPointsPrecision(int precision);
   int GetOutputPointsPrecision() const;
 
+  // Description:
+  // If on, the extracted cells and the input point and cell each output
+  // point and cell comes from are cached. When the filter executes again
+  // and only the points or the attributes other than the thresholded array
+  // of the input changed (the topology modification time of the input, see
+  // vtkDataSet::GetTopologyMTime(), the thresholded array and the
+  // threshold criterion are the same), the cells are not evaluated
+  // again: points and attributes are copied through the cached ids. This
+  // speeds up thresholding deforming meshes by a constant array, at the
+  // cost of keeping the ids in memory. The default is off.
+  vtkSetMacro(CacheTopology, int);
+  vtkGetMacro(CacheTopology, int);
+  vtkBooleanMacro(CacheTopology, int);
+
   virtual int ProcessRequest(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
 
 protected:
@@ -172,6 +187,30 @@ protected:
 
   int EvaluateComponents( vtkDataArray *scalars, vtkIdType id );
 
+  // Description:
+  // Return 1 if the cached topology can be used for the input thresholded
+  // by the given scalars. ExecuteFromTopologyCache() then copies the
+  // points and attributes of the input through the cached ids.
+  int IsTopologyCacheValid(vtkDataSet *input, vtkDataArray *scalars);
+  void ExecuteFromTopologyCache(vtkDataSet *input,
+                                vtkUnstructuredGrid *output);
+  void ReleaseTopologyCache();
+
+  int CacheTopology;
+  vtkUnstructuredGrid *TopologyCache;
+  vtkIdList *CachedPointIds;
+  vtkIdList *CachedCellIds;
+  unsigned long CachedTopologyMTime;
+  unsigned long CachedScalarsMTime;
+  vtkIdType CachedNumberOfPoints;
+  vtkIdType CachedNumberOfCells;
+  double CachedLowerThreshold;
+  double CachedUpperThreshold;
+  int (vtkThreshold::*CachedThresholdFunction)(double s);
+  int CachedAllScalars;
+  int CachedComponentMode;
+  int CachedSelectedComponent;
+
 private:
   vtkThreshold(const vtkThreshold&);  // Not implemented.
   void operator=(const vtkThreshold&);  // Not implemented.
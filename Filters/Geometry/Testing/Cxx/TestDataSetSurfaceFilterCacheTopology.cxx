@@ -0,0 +1,240 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterCacheTopology.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkDataSetSurfaceFilter reuses its cached topology when
+// only the points and the point data of a deforming mesh change, and that
+// the result matches the one extracted without the cache.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+const int Resolution = 8;
+
+// Fill the grid with Resolution^3 hexahedra and a point and cell array.
+void BuildGrid(vtkUnstructuredGrid* grid)
+{
+  const int n = Resolution + 1;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  for (int k = 0; k < n; k++)
+    {
+    for (int j = 0; j < n; j++)
+      {
+      for (int i = 0; i < n; i++)
+        {
+        points->InsertNextPoint(i, j, k);
+        pointValues->InsertNextValue(i + 10 * j + 100 * k);
+        }
+      }
+    }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(pointValues.GetPointer());
+
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  grid->Allocate(Resolution * Resolution * Resolution);
+  for (int k = 0; k < Resolution; k++)
+    {
+    for (int j = 0; j < Resolution; j++)
+      {
+      for (int i = 0; i < Resolution; i++)
+        {
+        vtkIdType p = i + n * (j + n * k);
+        vtkIdType ids[8] = {p, p + 1, p + n + 1, p + n,
+                            p + n * n, p + n * n + 1, p + n * n + n + 1,
+                            p + n * n + n};
+        cellValues->InsertNextValue(
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids));
+        }
+      }
+    }
+  grid->GetCellData()->SetScalars(cellValues.GetPointer());
+}
+
+// Return a grid sharing the cells of the given one with displaced points
+// and new point data.
+void Deform(vtkUnstructuredGrid* grid, double scale,
+            vtkUnstructuredGrid* deformed)
+{
+  deformed->ShallowCopy(grid);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); i++)
+    {
+    double x[3];
+    grid->GetPoint(i, x);
+    points->InsertNextPoint(scale * x[0], x[1] + scale * x[2], x[2]);
+    pointValues->InsertNextValue(scale * i);
+    }
+  deformed->SetPoints(points.GetPointer());
+  deformed->GetPointData()->SetScalars(pointValues.GetPointer());
+}
+
+bool CompareArrays(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    return false;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); i++)
+    {
+    vtkDataArray* arrayA = a->GetArray(i);
+    vtkDataArray* arrayB = b->GetArray(arrayA->GetName());
+    if (!arrayB || arrayA->GetNumberOfTuples() != arrayB->GetNumberOfTuples())
+      {
+      return false;
+      }
+    for (vtkIdType t = 0; t < arrayA->GetNumberOfTuples(); t++)
+      {
+      if (arrayA->GetComponent(t, 0) != arrayB->GetComponent(t, 0))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool ComparePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); i++)
+    {
+    double xA[3], xB[3];
+    a->GetPoint(i, xA);
+    b->GetPoint(i, xB);
+    if (xA[0] != xB[0] || xA[1] != xB[1] || xA[2] != xB[2])
+      {
+      return false;
+      }
+    }
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType i = 0; i < a->GetNumberOfCells(); i++)
+    {
+    a->GetCellPoints(i, idsA.GetPointer());
+    b->GetCellPoints(i, idsB.GetPointer());
+    if (idsA->GetNumberOfIds() != idsB->GetNumberOfIds())
+      {
+      return false;
+      }
+    for (vtkIdType j = 0; j < idsA->GetNumberOfIds(); j++)
+      {
+      if (idsA->GetId(j) != idsB->GetId(j))
+        {
+        return false;
+        }
+      }
+    }
+  return CompareArrays(a->GetPointData(), b->GetPointData()) &&
+    CompareArrays(a->GetCellData(), b->GetCellData());
+}
+}
+
+int TestDataSetSurfaceFilterCacheTopology(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(grid.GetPointer());
+
+  vtkNew<vtkDataSetSurfaceFilter> cached;
+  cached->CacheTopologyOn();
+  cached->PassThroughPointIdsOn();
+  cached->SetInputData(grid.GetPointer());
+  cached->Update();
+  vtkNew<vtkDataSetSurfaceFilter> reference;
+  reference->PassThroughPointIdsOn();
+  reference->SetInputData(grid.GetPointer());
+  reference->Update();
+  TEST_ASSERT(ComparePolyData(cached->GetOutput(), reference->GetOutput()),
+              "Surface differs from the reference");
+  TEST_ASSERT(!cached->GetOutput()->GetCellData()->GetArray("vtkOriginalCellIds"),
+              "Cell ids are passed although they were not requested");
+  // Keep a reference so that a new array cannot have the same address.
+  vtkSmartPointer<vtkCellArray> polys = cached->GetOutput()->GetPolys();
+
+  // Only the points and the point data change: the cache is used.
+  for (int step = 1; step <= 3; step++)
+    {
+    vtkNew<vtkUnstructuredGrid> deformed;
+    Deform(grid.GetPointer(), 1.0 + 0.1 * step, deformed.GetPointer());
+    TEST_ASSERT(deformed->GetTopologyMTime() == grid->GetTopologyMTime(),
+                "Expected the deformed grid to share the topology");
+    TEST_ASSERT(deformed->GetGeometryMTime() != grid->GetGeometryMTime(),
+                "Expected the deformed grid to have a new geometry");
+    cached->SetInputData(deformed.GetPointer());
+    cached->Update();
+    reference->SetInputData(deformed.GetPointer());
+    reference->Update();
+    TEST_ASSERT(cached->GetOutput()->GetPolys() == polys,
+                "Expected the cached cells to be reused at step " << step);
+    TEST_ASSERT(ComparePolyData(cached->GetOutput(), reference->GetOutput()),
+                "Surface of the deformed grid differs from the reference at "
+                "step " << step);
+    }
+
+  // New cells: the surface is extracted again.
+  vtkNew<vtkUnstructuredGrid> remeshed;
+  BuildGrid(remeshed.GetPointer());
+  cached->SetInputData(remeshed.GetPointer());
+  cached->Update();
+  reference->SetInputData(remeshed.GetPointer());
+  reference->Update();
+  TEST_ASSERT(cached->GetOutput()->GetPolys() != polys,
+              "Expected the surface to be extracted for new cells");
+  TEST_ASSERT(ComparePolyData(cached->GetOutput(), reference->GetOutput()),
+              "Surface of the new grid differs from the reference");
+  polys = cached->GetOutput()->GetPolys();
+
+  // Passing the cell ids does not need a new extraction.
+  cached->PassThroughCellIdsOn();
+  cached->Update();
+  reference->PassThroughCellIdsOn();
+  reference->Update();
+  TEST_ASSERT(cached->GetOutput()->GetPolys() == polys,
+              "Expected the cached cells to be reused with the cell ids");
+  TEST_ASSERT(ComparePolyData(cached->GetOutput(), reference->GetOutput()),
+              "Surface with the cell ids differs from the reference");
+
+  // Changing a parameter that affects the topology invalidates the cache.
+  cached->SetNonlinearSubdivisionLevel(2);
+  cached->Update();
+  TEST_ASSERT(cached->GetOutput()->GetPolys() != polys,
+              "Expected the surface to be extracted for new parameters");
+
+  return EXIT_SUCCESS;
+}
@@ -118,6 +118,18 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
 
   this->NonlinearSubdivisionLevel = 1;
 
+  this->CacheTopology = 0;
+  this->TopologyCache = NULL;
+  this->CachedPointIds = NULL;
+  this->CachedCellIds = NULL;
+  this->CachedTopologyMTime = 0;
+  this->CachedGhostLevelsMTime = 0;
+  this->CachedNumberOfPoints = 0;
+  this->CachedNumberOfCells = 0;
+  this->CachedUpdateGhostLevel = 0;
+  this->CachedPieceInvariant = 0;
+  this->CachedNonlinearSubdivisionLevel = 0;
+
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_BOUNDS(), 1);
   this->GetInformation()->Set(vtkAlgorithm::PRESERVES_RANGES(), 1);
 
@@ -137,6 +149,7 @@ vtkDataSetSurfaceFilter::~vtkDataSetSurfaceFilter()
     }
   this->SetOriginalCellIdsName(NULL);
   this->SetOriginalPointIdsName(NULL);
+  this->ReleaseTopologyCache();
 }
 
 //----------------------------------------------------------------------------
@@ -184,6 +197,12 @@ int vtkDataSetSurfaceFilter::RequestData(
     {
     case  VTK_UNSTRUCTURED_GRID:
       {
+      if (this->CacheTopology)
+        {
+        return this->CachedUnstructuredGridExecute(
+          input, output, outInfo->Get(
+            vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()));
+        }
       if (!this->UnstructuredGridExecute(
             input, output, outInfo->Get(
               vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())))
@@ -1236,6 +1255,178 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NonlinearSubdivisionLevel: "
      << this->NonlinearSubdivisionLevel << endl;
+  os << indent << "CacheTopology: " << (this->CacheTopology ? "On\n" : "Off\n");
+}
+
+//----------------------------------------------------------------------------
+// The ghost levels decide which cells are removed when PieceInvariant is on.
+static unsigned long vtkDataSetSurfaceFilterGetGhostLevelsMTime(
+  vtkDataSet *input)
+{
+  vtkDataArray *ghostLevels = input->GetCellData()->GetArray("vtkGhostLevels");
+  return ghostLevels ? ghostLevels->GetMTime() : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSetSurfaceFilter::ReleaseTopologyCache()
+{
+  if (this->TopologyCache)
+    {
+    this->TopologyCache->Delete();
+    this->TopologyCache = NULL;
+    }
+  if (this->CachedPointIds)
+    {
+    this->CachedPointIds->Delete();
+    this->CachedPointIds = NULL;
+    }
+  if (this->CachedCellIds)
+    {
+    this->CachedCellIds->Delete();
+    this->CachedCellIds = NULL;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::IsTopologyCacheValid(vtkUnstructuredGrid *input,
+                                                  int updateGhostLevel)
+{
+  // The modification time of the filter is not used since it changes with
+  // the input connection.
+  return this->TopologyCache != NULL &&
+    this->PieceInvariant == this->CachedPieceInvariant &&
+    this->NonlinearSubdivisionLevel == this->CachedNonlinearSubdivisionLevel &&
+    !strcmp(this->CachedPointIds->GetName(), this->GetOriginalPointIdsName()) &&
+    !strcmp(this->CachedCellIds->GetName(), this->GetOriginalCellIdsName()) &&
+    input->GetTopologyMTime() == this->CachedTopologyMTime &&
+    input->GetNumberOfPoints() == this->CachedNumberOfPoints &&
+    input->GetNumberOfCells() == this->CachedNumberOfCells &&
+    updateGhostLevel == this->CachedUpdateGhostLevel &&
+    vtkDataSetSurfaceFilterGetGhostLevelsMTime(input) ==
+      this->CachedGhostLevelsMTime;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::CachedUnstructuredGridExecute(
+  vtkDataSet *dataSetInput, vtkPolyData *output, int updateGhostLevel)
+{
+  vtkUnstructuredGrid *input = vtkUnstructuredGrid::SafeDownCast(dataSetInput);
+  vtkPointData *inputPD = input->GetPointData();
+  vtkCellData *inputCD = input->GetCellData();
+  vtkPointData *outputPD = output->GetPointData();
+  vtkCellData *outputCD = output->GetCellData();
+
+  if (!this->IsTopologyCacheValid(input, updateGhostLevel))
+    {
+    this->ReleaseTopologyCache();
+
+    // Extract the surface with the original ids, they are the cache.
+    int passThroughCellIds = this->PassThroughCellIds;
+    int passThroughPointIds = this->PassThroughPointIds;
+    this->PassThroughCellIds = 1;
+    this->PassThroughPointIds = 1;
+    int result = this->UnstructuredGridExecute(input, output, updateGhostLevel);
+    this->PassThroughCellIds = passThroughCellIds;
+    this->PassThroughPointIds = passThroughPointIds;
+    if (!result)
+      {
+      return 1;
+      }
+
+    vtkIdTypeArray *pointIds = vtkIdTypeArray::SafeDownCast(
+      outputPD->GetArray(this->GetOriginalPointIdsName()));
+    vtkIdTypeArray *cellIds = vtkIdTypeArray::SafeDownCast(
+      outputCD->GetArray(this->GetOriginalCellIdsName()));
+
+    // Points interpolated when subdividing nonlinear cells depend on the
+    // geometry and have no original id: such surfaces are not cached.
+    bool cacheable = pointIds && cellIds &&
+      pointIds->GetNumberOfTuples() == output->GetNumberOfPoints() &&
+      cellIds->GetNumberOfTuples() == output->GetNumberOfCells();
+    if (cacheable && this->NonlinearSubdivisionLevel >= 1)
+      {
+      vtkIdType numCells = input->GetNumberOfCells();
+      unsigned char* cellTypes = input->GetCellTypesArray()->GetPointer(0);
+      for (vtkIdType i = 0; cacheable && i < numCells; i++)
+        {
+        cacheable = vtkCellTypes::IsLinear(cellTypes[i]) != 0;
+        }
+      }
+
+    if (cacheable)
+      {
+      this->TopologyCache = vtkPolyData::New();
+      this->TopologyCache->CopyStructure(output);
+      this->TopologyCache->SetPoints(NULL);
+      this->CachedPointIds = pointIds;
+      this->CachedPointIds->Register(this);
+      this->CachedCellIds = cellIds;
+      this->CachedCellIds->Register(this);
+      this->CachedTopologyMTime = input->GetTopologyMTime();
+      this->CachedGhostLevelsMTime =
+        vtkDataSetSurfaceFilterGetGhostLevelsMTime(input);
+      this->CachedNumberOfPoints = input->GetNumberOfPoints();
+      this->CachedNumberOfCells = input->GetNumberOfCells();
+      this->CachedUpdateGhostLevel = updateGhostLevel;
+      this->CachedPieceInvariant = this->PieceInvariant;
+      this->CachedNonlinearSubdivisionLevel = this->NonlinearSubdivisionLevel;
+      }
+
+    if (!this->PassThroughPointIds && pointIds)
+      {
+      outputPD->RemoveArray(this->GetOriginalPointIdsName());
+      }
+    if (!this->PassThroughCellIds && cellIds)
+      {
+      outputCD->RemoveArray(this->GetOriginalCellIdsName());
+      }
+    output->CheckAttributes();
+    return 1;
+    }
+
+  vtkDebugMacro(<< "Reusing the cached surface topology");
+
+  vtkIdType numPts = this->CachedPointIds->GetNumberOfTuples();
+  vtkIdType numCells = this->CachedCellIds->GetNumberOfTuples();
+  vtkIdType *pointIds = this->CachedPointIds->GetPointer(0);
+  vtkIdType *cellIds = this->CachedCellIds->GetPointer(0);
+
+  vtkPoints *inPts = input->GetPoints();
+  vtkPoints *newPts = vtkPoints::New();
+  newPts->SetDataType(inPts->GetData()->GetDataType());
+  newPts->SetNumberOfPoints(numPts);
+  outputPD->CopyGlobalIdsOn();
+  outputPD->CopyAllocate(inputPD, numPts);
+  double x[3];
+  vtkIdType i;
+  for (i = 0; i < numPts; i++)
+    {
+    inPts->GetPoint(pointIds[i], x);
+    newPts->SetPoint(i, x);
+    outputPD->CopyData(inputPD, pointIds[i], i);
+    }
+  outputCD->CopyGlobalIdsOn();
+  outputCD->CopyAllocate(inputCD, numCells);
+  for (i = 0; i < numCells; i++)
+    {
+    outputCD->CopyData(inputCD, cellIds[i], i);
+    }
+
+  if (this->PassThroughPointIds)
+    {
+    outputPD->AddArray(this->CachedPointIds);
+    }
+  if (this->PassThroughCellIds)
+    {
+    outputCD->AddArray(this->CachedCellIds);
+    }
+
+  output->CopyStructure(this->TopologyCache);
+  output->SetPoints(newPts);
+  newPts->Delete();
+  output->CheckAttributes();
+
+  return 1;
 }
 
 //========================================================================
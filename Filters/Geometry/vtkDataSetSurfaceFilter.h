@@ -32,6 +32,7 @@
 class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
+class vtkUnstructuredGrid;
 
 //BTX
 // Helper structure for hashing faces.
@@ -110,6 +111,22 @@ public:
   vtkSetMacro(NonlinearSubdivisionLevel, int);
   vtkGetMacro(NonlinearSubdivisionLevel, int);
 
+  // Description:
+  // If on, the surface extracted from an unstructured grid is cached as
+  // its cells and the input point and cell each output point and cell
+  // comes from. When the filter executes again and only the points or the
+  // point and cell data of the input changed (the topology modification
+  // time of the input, see vtkDataSet::GetTopologyMTime(), PieceInvariant,
+  // NonlinearSubdivisionLevel and the original id names are the same), the
+  // surface is not extracted
+  // again: points and attributes are copied through the cached ids. This
+  // makes extracting the surface of deforming meshes much faster, at the
+  // cost of keeping the ids in memory. Inputs with nonlinear cells that
+  // are subdivided are not cached. The default is off.
+  vtkSetMacro(CacheTopology, int);
+  vtkGetMacro(CacheTopology, int);
+  vtkBooleanMacro(CacheTopology, int);
+
   // Description:
   // Direct access methods that can be used to use the this class as an
   // algorithm without using it as a filter.
@@ -244,6 +261,27 @@ protected:
 
   int NonlinearSubdivisionLevel;
 
+  // Description:
+  // Extract the surface of an unstructured grid with the topology cache:
+  // reuse the cache when it is valid for the input, otherwise execute and
+  // cache the result.
+  int CachedUnstructuredGridExecute(vtkDataSet *input, vtkPolyData *output,
+                                    int updateGhostLevel);
+  int IsTopologyCacheValid(vtkUnstructuredGrid *input, int updateGhostLevel);
+  void ReleaseTopologyCache();
+
+  int CacheTopology;
+  vtkPolyData *TopologyCache;
+  vtkIdTypeArray *CachedPointIds;
+  vtkIdTypeArray *CachedCellIds;
+  unsigned long CachedTopologyMTime;
+  unsigned long CachedGhostLevelsMTime;
+  vtkIdType CachedNumberOfPoints;
+  vtkIdType CachedNumberOfCells;
+  int CachedUpdateGhostLevel;
+  int CachedPieceInvariant;
+  int CachedNonlinearSubdivisionLevel;
+
 private:
   vtkDataSetSurfaceFilter(const vtkDataSetSurfaceFilter&);  // Not implemented.
   void operator=(const vtkDataSetSurfaceFilter&);  // Not implemented.
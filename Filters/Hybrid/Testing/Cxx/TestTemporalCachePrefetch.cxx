@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTemporalCachePrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkTemporalDataSetCache loads the time step following
+// the requested one in the background when Prefetch is on, following the
+// direction and the stride of the playback.
+
+#include "vtkDataArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalDataSetCache.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Produces a 16^3 float image filled with the time step.
+class TestTimeSource : public vtkImageAlgorithm
+{
+public:
+  static TestTimeSource* New();
+  vtkTypeMacro(TestTimeSource, vtkImageAlgorithm);
+
+  vtkGetMacro(NumberOfExecutions, int);
+
+protected:
+  TestTimeSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->NumberOfExecutions = 0;
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+                                 vtkInformationVector* outputVector)
+    {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = {0, 15, 0, 15, 0, 15};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    double timeSteps[10];
+    for (int i = 0; i < 10; i++)
+      {
+      timeSteps[i] = i;
+      }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(),
+                 timeSteps, 10);
+    double timeRange[2] = {0, 9};
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(),
+                 timeRange, 2);
+    vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+    return 1;
+    }
+
+  virtual void ExecuteDataWithInformation(vtkDataObject* output,
+                                          vtkInformation* outInfo)
+    {
+    this->NumberOfExecutions++;
+    vtkImageData* image = this->AllocateOutputData(output, outInfo);
+    double time =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    image->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    image->GetPointData()->GetScalars()->FillComponent(0, time);
+    }
+
+  int NumberOfExecutions;
+};
+vtkStandardNewMacro(TestTimeSource);
+
+// Update the cache at the given time and return the value of its output.
+double UpdateAt(vtkTemporalDataSetCache* cache, double time)
+{
+  cache->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+    cache->GetOutputInformation(0), time);
+  cache->Update();
+  vtkImageData* image = vtkImageData::SafeDownCast(cache->GetOutputDataObject(0));
+  if (!image || !image->GetPointData()->GetScalars())
+    {
+    return -1;
+    }
+  return image->GetPointData()->GetScalars()->GetComponent(100, 0);
+}
+}
+
+int TestTemporalCachePrefetch(int, char*[])
+{
+  vtkNew<TestTimeSource> source;
+  vtkNew<vtkTemporalDataSetCache> cache;
+  cache->SetInputConnection(source->GetOutputPort());
+  cache->PrefetchOn();
+
+  // The step after the first one is loaded in the background.
+  TEST_ASSERT(UpdateAt(cache.GetPointer(), 0) == 0, "Wrong output at time 0");
+  cache->WaitForPrefetch();
+  TEST_ASSERT(source->GetNumberOfExecutions() == 2,
+              "Expected time step 1 to be prefetched");
+
+  // Playing forward finds every step already loaded.
+  for (int t = 1; t <= 3; t++)
+    {
+    TEST_ASSERT(UpdateAt(cache.GetPointer(), t) == t,
+                "Wrong output at time " << t);
+    cache->WaitForPrefetch();
+    TEST_ASSERT(source->GetNumberOfExecutions() == t + 2,
+                "Expected time step " << t << " to come from the prefetch");
+    }
+
+  // Playing backward: the previous steps are cached and nothing is loaded.
+  TEST_ASSERT(UpdateAt(cache.GetPointer(), 2) == 2, "Wrong output at time 2");
+  TEST_ASSERT(UpdateAt(cache.GetPointer(), 1) == 1, "Wrong output at time 1");
+  cache->WaitForPrefetch();
+  TEST_ASSERT(source->GetNumberOfExecutions() == 5,
+              "Expected no prefetch of cached time steps, got "
+              << source->GetNumberOfExecutions() << " executions");
+
+  // Jumping by a stride of 4 prefetches the step 4 further.
+  TEST_ASSERT(UpdateAt(cache.GetPointer(), 5) == 5, "Wrong output at time 5");
+  cache->WaitForPrefetch();
+  TEST_ASSERT(source->GetNumberOfExecutions() == 7,
+              "Expected time steps 5 and 9 to be loaded");
+  TEST_ASSERT(UpdateAt(cache.GetPointer(), 9) == 9, "Wrong output at time 9");
+
+  // Past the last time step there is nothing to prefetch.
+  cache->WaitForPrefetch();
+  TEST_ASSERT(source->GetNumberOfExecutions() == 7,
+              "Expected no prefetch after the last time step");
+
+  return EXIT_SUCCESS;
+}
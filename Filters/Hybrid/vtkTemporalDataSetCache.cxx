@@ -14,8 +14,10 @@
 =========================================================================*/
 #include "vtkTemporalDataSetCache.h"
 
+#include "vtkAlgorithmOutput.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkCompositeDataPipeline.h"
@@ -23,17 +25,35 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <vector>
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTemporalDataSetCache);
 
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkTemporalDataSetCachePrefetchThread(void* arg)
+{
+  vtkTemporalDataSetCache* self = static_cast<vtkTemporalDataSetCache*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg)->UserData);
+  self->ExecutePrefetch();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 {
   this->CacheSize = 10;
+  this->Prefetch = 0;
+  this->Threader = vtkMultiThreader::New();
+  this->PrefetchThreadId = -1;
+  this->PrefetchExecutive = 0;
+  this->PrefetchPort = 0;
+  this->PrefetchTime = 0.0;
+  this->LastRequestedTime = 0.0;
+  this->HasLastRequestedTime = 0;
   this->SetNumberOfInputPorts(1);
   this->SetNumberOfOutputPorts(1);
 }
@@ -41,6 +61,8 @@ vtkTemporalDataSetCache::vtkTemporalDataSetCache()
 //----------------------------------------------------------------------------
 vtkTemporalDataSetCache::~vtkTemporalDataSetCache()
 {
+  this->WaitForPrefetch();
+  this->Threader->Delete();
   CacheType::iterator pos = this->Cache.begin();
   for (; pos != this->Cache.end();)
     {
@@ -103,6 +125,7 @@ void vtkTemporalDataSetCache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "Prefetch: " << this->Prefetch << endl;
 }
 //----------------------------------------------------------------------------
 void vtkTemporalDataSetCache::SetCacheSize(int size)
@@ -324,43 +347,161 @@ int vtkTemporalDataSetCache::RequestData(
   // size add the requested data to the cache first
   if(input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
     {
+    this->AddToCache(inTime, input, input->GetUpdateTime());
+    }
 
-// is the input time not already in the cache?
-    CacheType::iterator pos1 = this->Cache.find(inTime);
-    if (pos1 == this->Cache.end())
-      {
-      // if we have room in the Cache then just add the new data
-      if (this->Cache.size() < static_cast<unsigned long>(this->CacheSize))
-        {
-        vtkDataObject* cachedData  = input->NewInstance();
-        cachedData->ShallowCopy(input);
+  if (this->Prefetch)
+    {
+    this->StartPrefetch(inInfo, upTime);
+    }
+  return 1;
+}
 
-        this->Cache[inTime] =
-          std::pair<unsigned long, vtkDataObject *>
-          (outputUpdateTime, cachedData);
-        }
-      // no room in the cache, we need to get rid of something
-      else
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::AddToCache(double time, vtkDataObject* data,
+                                         unsigned long updateTime)
+{
+  // is the time not already in the cache?
+  if (this->Cache.find(time) != this->Cache.end())
+    {
+    return;
+    }
+
+  // no room in the cache, we need to get rid of something
+  if (this->Cache.size() >= static_cast<unsigned long>(this->CacheSize))
+    {
+    // get rid of the oldest data in the cache
+    CacheType::iterator pos = this->Cache.begin();
+    CacheType::iterator oldestpos = this->Cache.begin();
+    for (; pos != this->Cache.end(); ++pos)
+      {
+      if (pos->second.first < oldestpos->second.first)
         {
-        // get rid of the oldest data in the cache
-        CacheType::iterator pos2 = this->Cache.begin();
-        CacheType::iterator oldestpos = this->Cache.begin();
-        for (; pos2 != this->Cache.end(); ++pos2)
-          {
-          if (pos2->second.first < oldestpos->second.first)
-            {
-            oldestpos = pos2;
-            }
-          }
-        //was there old data?
-        if (oldestpos->second.first < outputUpdateTime)
-          {
-          oldestpos->second.second->UnRegister(this);
-          this->Cache.erase(oldestpos);
-          }
-        // if no old data and no room then we are done
+        oldestpos = pos;
         }
       }
+    // if no old data and no room then we are done
+    if (oldestpos->second.first >= updateTime)
+      {
+      return;
+      }
+    oldestpos->second.second->UnRegister(this);
+    this->Cache.erase(oldestpos);
     }
-  return 1;
+
+  vtkDataObject* cachedData = data->NewInstance();
+  cachedData->ShallowCopy(data);
+  this->Cache[time] =
+    std::pair<unsigned long, vtkDataObject *>(updateTime, cachedData);
+}
+
+//----------------------------------------------------------------------------
+int vtkTemporalDataSetCache::ComputePipelineMTime(
+  vtkInformation* request,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec,
+  int requestFromOutputPort,
+  unsigned long* mtime)
+{
+  // Every pipeline pass starts here, before going upstream. The input
+  // must not be in use by the prefetch thread from now on.
+  this->WaitForPrefetch();
+  return this->Superclass::ComputePipelineMTime(request, inInfoVec, outInfoVec,
+                                                requestFromOutputPort, mtime);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::StartPrefetch(vtkInformation* inInfo,
+                                            double time)
+{
+  int numSteps =
+    inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  if (numSteps < 2 || this->PrefetchThreadId >= 0)
+    {
+    return;
+    }
+  double* steps = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+
+  // Predict the next time step from the direction and the stride of the
+  // last two requests.
+  int index = static_cast<int>(
+    std::lower_bound(steps, steps + numSteps, time) - steps);
+  int stride = 1;
+  if (this->HasLastRequestedTime)
+    {
+    int lastIndex = static_cast<int>(
+      std::lower_bound(steps, steps + numSteps, this->LastRequestedTime) -
+      steps);
+    if (lastIndex != index)
+      {
+      stride = index - lastIndex;
+      }
+    }
+  this->LastRequestedTime = time;
+  this->HasLastRequestedTime = 1;
+  int next = index + stride;
+  if (next < 0 || next >= numSteps ||
+      this->Cache.find(steps[next]) != this->Cache.end())
+    {
+    return;
+    }
+  double nextTime = steps[next];
+
+  vtkAlgorithmOutput* connection = this->GetInputConnection(0, 0);
+  vtkStreamingDemandDrivenPipeline* executive = connection ?
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(
+      connection->GetProducer()->GetExecutive()) : 0;
+  if (!executive)
+    {
+    return;
+    }
+
+  // Load the time step into a new data object. The current one shares
+  // its data with the output and the cache. The information is set
+  // directly since vtkExecutive::SetOutputData() would reset the
+  // pipeline information of the input.
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (input)
+    {
+    vtkDataObject* newInput = input->NewInstance();
+    inInfo->Set(vtkDataObject::DATA_OBJECT(), newInput);
+    newInput->Delete();
+    }
+
+  this->PrefetchExecutive = executive;
+  this->PrefetchPort = connection->GetIndex();
+  this->PrefetchTime = nextTime;
+  this->PrefetchThreadId =
+    this->Threader->SpawnThread(vtkTemporalDataSetCachePrefetchThread, this);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::ExecutePrefetch()
+{
+  vtkStreamingDemandDrivenPipeline* executive = this->PrefetchExecutive;
+  executive->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateTimeStep(
+    executive->GetOutputInformation(this->PrefetchPort), this->PrefetchTime);
+  executive->Update(this->PrefetchPort);
+}
+
+//----------------------------------------------------------------------------
+void vtkTemporalDataSetCache::WaitForPrefetch()
+{
+  if (this->PrefetchThreadId < 0)
+    {
+    return;
+    }
+  this->Threader->TerminateThread(this->PrefetchThreadId);
+  this->PrefetchThreadId = -1;
+
+  vtkDataObject* data =
+    this->PrefetchExecutive->GetOutputData(this->PrefetchPort);
+  if (data && data->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+    {
+    this->AddToCache(
+      data->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()),
+      data, data->GetUpdateTime());
+    }
+  this->PrefetchExecutive = 0;
 }
@@ -16,6 +16,18 @@
 // .SECTION Description
 // vtkTemporalDataSetCache cache time step requests of a temporal dataset,
 // when cached data is requested it is returned using a shallow copy.
+//
+// When Prefetch is on, the time step following the one just produced is
+// loaded on a background thread while the current one is rendered. The
+// next time step is predicted from the last two requests, so it follows
+// playback in both directions and with a constant stride over the input
+// TIME_STEPS. The input is updated into a new data object so that the
+// data shared with the output is not touched by the background thread.
+// The next update of the cache waits for the prefetch to complete before
+// the pipeline is used, and finds the time step in the cache if it was
+// predicted correctly. The algorithms upstream must not be modified or
+// updated by other consumers while a prefetch runs; call
+// WaitForPrefetch() first.
 // .SECTION Thanks
 // Ken Martin (Kitware) and John Bidiscombe of
 // CSCS - Swiss National Supercomputing Centre
@@ -33,6 +45,9 @@
 #include "vtkAlgorithm.h"
 #include <map> // used for the cache
 
+class vtkMultiThreader;
+class vtkStreamingDemandDrivenPipeline;
+
 class VTKFILTERSHYBRID_EXPORT vtkTemporalDataSetCache : public vtkAlgorithm
 {
 public:
@@ -46,11 +61,28 @@ public:
   void SetCacheSize(int size);
   vtkGetMacro(CacheSize,int);
 
+  // Description:
+  // Set / Get whether the predicted next time step is loaded on a
+  // background thread after every update. Default is off.
+  vtkSetMacro(Prefetch, int);
+  vtkGetMacro(Prefetch, int);
+  vtkBooleanMacro(Prefetch, int);
+
+  // Description:
+  // Wait for the running prefetch, if any, and add the loaded time step
+  // to the cache.
+  void WaitForPrefetch();
+
+  // Description:
+  // Load the predicted time step. Called on the prefetch thread.
+  void ExecutePrefetch();
+
 protected:
   vtkTemporalDataSetCache();
   ~vtkTemporalDataSetCache();
 
   int CacheSize;
+  int Prefetch;
 
 //BTX
   typedef std::map<double,std::pair<unsigned long,vtkDataObject *> >
@@ -79,6 +111,32 @@ protected:
                           vtkInformationVector **,
                           vtkInformationVector *);
 
+  // Description:
+  // Wait for the prefetch before the pipeline goes upstream.
+  virtual int ComputePipelineMTime(vtkInformation* request,
+                                   vtkInformationVector** inInfoVec,
+                                   vtkInformationVector* outInfoVec,
+                                   int requestFromOutputPort,
+                                   unsigned long* mtime);
+
+  // Description:
+  // Predict the time step following the given one and start loading it
+  // on the prefetch thread unless it is already cached.
+  void StartPrefetch(vtkInformation* inInfo, double time);
+
+  // Description:
+  // Add the data of a time step to the cache, releasing the least
+  // recently used time step if the cache is full.
+  void AddToCache(double time, vtkDataObject* data, unsigned long updateTime);
+
+  vtkMultiThreader* Threader;
+  int PrefetchThreadId;
+  vtkStreamingDemandDrivenPipeline* PrefetchExecutive;
+  int PrefetchPort;
+  double PrefetchTime;
+  double LastRequestedTime;
+  int HasLastRequestedTime;
+
 private:
   vtkTemporalDataSetCache(const vtkTemporalDataSetCache&);  // Not implemented.
   void operator=(const vtkTemporalDataSetCache&);  // Not implemented.
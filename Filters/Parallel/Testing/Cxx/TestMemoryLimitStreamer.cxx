@@ -0,0 +1,279 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMemoryLimitStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests vtkMemoryLimitStreamer by comparing streamed image, poly,
+// unstructured and multiblock results with the unstreamed ones.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkImageData.h"
+#include "vtkMemoryLimitStreamer.h"
+#include "vtkMultiBlockDataGroupFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Returns true if both attributes hold the same arrays with the same values.
+bool CompareAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+    {
+    return false;
+    }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+    {
+    vtkDataArray* arrA = a->GetArray(i);
+    vtkDataArray* arrB = b->GetArray(arrA->GetName());
+    if (!arrB ||
+        arrA->GetNumberOfTuples() != arrB->GetNumberOfTuples() ||
+        arrA->GetNumberOfComponents() != arrB->GetNumberOfComponents())
+      {
+      return false;
+      }
+    for (vtkIdType t = 0; t < arrA->GetNumberOfTuples(); ++t)
+      {
+      for (int c = 0; c < arrA->GetNumberOfComponents(); ++c)
+        {
+        if (arrA->GetComponent(t, c) != arrB->GetComponent(t, c))
+          {
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+bool CompareImages(vtkImageData* a, vtkImageData* b)
+{
+  int extA[6], extB[6];
+  a->GetExtent(extA);
+  b->GetExtent(extB);
+  for (int i = 0; i < 6; ++i)
+    {
+    if (extA[i] != extB[i])
+      {
+      return false;
+      }
+    }
+  return CompareAttributes(a->GetPointData(), b->GetPointData()) &&
+    CompareAttributes(a->GetCellData(), b->GetCellData());
+}
+
+// Sum of all components of a cell array. Appended pieces may duplicate
+// points but every cell appears once, so the sums must match.
+double SumCellArray(vtkDataSet* ds, const char* name)
+{
+  vtkDataArray* array = ds->GetCellData()->GetArray(name);
+  double sum = 0.0;
+  if (!array)
+    {
+    return sum;
+    }
+  for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+    {
+    for (int c = 0; c < array->GetNumberOfComponents(); ++c)
+      {
+      sum += array->GetComponent(t, c);
+      }
+    }
+  return sum;
+}
+
+void CountExecutions(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+bool CompareCells(vtkDataSet* a, vtkDataSet* b, const char* name)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+    {
+    return false;
+    }
+  double sumA = SumCellArray(a, name);
+  double sumB = SumCellArray(b, name);
+  return a->GetCellData()->GetArray(name) != NULL &&
+    std::fabs(sumA - sumB) <= 1e-6 * (std::fabs(sumA) + 1.0);
+}
+}
+
+int TestMemoryLimitStreamer(int, char*[])
+{
+  // Image data with point and cell data.
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  vtkNew<vtkPointDataToCellData> waveletCells;
+  waveletCells->SetInputConnection(wavelet->GetOutputPort());
+  waveletCells->PassPointDataOn();
+  waveletCells->Update();
+  vtkNew<vtkImageData> image;
+  image->DeepCopy(waveletCells->GetOutput());
+
+  vtkNew<vtkMemoryLimitStreamer> imageStreamer;
+  imageStreamer->SetInputConnection(waveletCells->GetOutputPort());
+  imageStreamer->SetMemoryLimit(100);
+  imageStreamer->Update();
+  TEST_ASSERT(imageStreamer->GetNumberOfStreamDivisions() >= 4,
+              "Expected at least 4 passes for the image, got "
+              << imageStreamer->GetNumberOfStreamDivisions());
+  TEST_ASSERT(CompareImages(
+                vtkImageData::SafeDownCast(imageStreamer->GetOutputDataObject(0)),
+                image.GetPointer()),
+              "Streamed image differs from the unstreamed one");
+
+  // Poly data.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkPointDataToCellData> sphereCells;
+  sphereCells->SetInputConnection(sphere->GetOutputPort());
+  sphereCells->Update();
+  vtkNew<vtkPolyData> poly;
+  poly->DeepCopy(sphereCells->GetOutput());
+
+  vtkNew<vtkMemoryLimitStreamer> polyStreamer;
+  polyStreamer->SetInputConnection(sphereCells->GetOutputPort());
+  polyStreamer->SetMemoryLimit(1);
+  polyStreamer->SetMaximumNumberOfPasses(16);
+  polyStreamer->Update();
+  TEST_ASSERT(polyStreamer->GetNumberOfStreamDivisions() == 16,
+              "Expected 16 passes for a small limit, got "
+              << polyStreamer->GetNumberOfStreamDivisions());
+  TEST_ASSERT(CompareCells(
+                vtkPolyData::SafeDownCast(polyStreamer->GetOutputDataObject(0)),
+                poly.GetPointer(), "Normals"),
+              "Streamed poly data differs from the unstreamed one");
+
+  // Probe: a source that never executed has no size information, so the
+  // first pass measures one piece out of ProbeNumberOfPasses and the
+  // streamer starts over with the number of passes planned from it.
+  int probeExecutions = 0;
+  vtkNew<vtkCallbackCommand> counter;
+  counter->SetCallback(CountExecutions);
+  counter->SetClientData(&probeExecutions);
+
+  vtkNew<vtkSphereSource> probeSphere;
+  probeSphere->SetThetaResolution(64);
+  probeSphere->SetPhiResolution(32);
+  probeSphere->AddObserver(vtkCommand::EndEvent, counter.GetPointer());
+  vtkNew<vtkPointDataToCellData> probeCells;
+  probeCells->SetInputConnection(probeSphere->GetOutputPort());
+
+  vtkNew<vtkMemoryLimitStreamer> probeStreamer;
+  probeStreamer->SetInputConnection(probeCells->GetOutputPort());
+  probeStreamer->SetMemoryLimit(1000000);
+  probeStreamer->Update();
+  TEST_ASSERT(probeStreamer->GetNumberOfStreamDivisions() == 1,
+              "Expected 1 pass after probing with a large limit, got "
+              << probeStreamer->GetNumberOfStreamDivisions());
+  TEST_ASSERT(probeExecutions == 2,
+              "Expected a probe and a full execution, got "
+              << probeExecutions << " executions");
+  TEST_ASSERT(CompareCells(
+                vtkPolyData::SafeDownCast(probeStreamer->GetOutputDataObject(0)),
+                poly.GetPointer(), "Normals"),
+              "Poly data streamed after probing differs from the unstreamed one");
+
+  // Re-plan from a probe that is too large for the limit.
+  probeExecutions = 0;
+  vtkNew<vtkSphereSource> replanSphere;
+  replanSphere->SetThetaResolution(64);
+  replanSphere->SetPhiResolution(32);
+  replanSphere->AddObserver(vtkCommand::EndEvent, counter.GetPointer());
+  vtkNew<vtkPointDataToCellData> replanCells;
+  replanCells->SetInputConnection(replanSphere->GetOutputPort());
+
+  vtkNew<vtkMemoryLimitStreamer> replanStreamer;
+  replanStreamer->SetInputConnection(replanCells->GetOutputPort());
+  replanStreamer->SetMemoryLimit(1);
+  replanStreamer->SetProbeNumberOfPasses(2);
+  replanStreamer->SetMaximumNumberOfPasses(16);
+  replanStreamer->Update();
+  TEST_ASSERT(replanStreamer->GetNumberOfStreamDivisions() == 16,
+              "Expected 16 passes after re-planning, got "
+              << replanStreamer->GetNumberOfStreamDivisions());
+  TEST_ASSERT(probeExecutions == 17,
+              "Expected a probe and 16 passes, got "
+              << probeExecutions << " executions");
+  TEST_ASSERT(CompareCells(
+                vtkPolyData::SafeDownCast(replanStreamer->GetOutputDataObject(0)),
+                poly.GetPointer(), "Normals"),
+              "Re-planned poly data differs from the unstreamed one");
+
+  // Unstructured grid.
+  vtkNew<vtkDataSetTriangleFilter> tetra;
+  tetra->SetInputConnection(waveletCells->GetOutputPort());
+  tetra->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(tetra->GetOutput());
+
+  vtkNew<vtkMemoryLimitStreamer> gridStreamer;
+  gridStreamer->SetInputConnection(tetra->GetOutputPort());
+  gridStreamer->SetMemoryLimit(1);
+  gridStreamer->SetMaximumNumberOfPasses(8);
+  gridStreamer->Update();
+  TEST_ASSERT(gridStreamer->GetNumberOfStreamDivisions() > 1,
+              "Expected the unstructured grid to be streamed");
+  TEST_ASSERT(CompareCells(
+                vtkUnstructuredGrid::SafeDownCast(gridStreamer->GetOutputDataObject(0)),
+                grid.GetPointer(), "RTData"),
+              "Streamed unstructured grid differs from the unstreamed one");
+
+  // Multiblock with a poly data and an image data leaf.
+  vtkNew<vtkMultiBlockDataGroupFilter> group;
+  group->AddInputConnection(sphereCells->GetOutputPort());
+  group->AddInputConnection(waveletCells->GetOutputPort());
+
+  vtkNew<vtkMemoryLimitStreamer> groupStreamer;
+  groupStreamer->SetInputConnection(group->GetOutputPort());
+  groupStreamer->SetMemoryLimit(1);
+  groupStreamer->SetMaximumNumberOfPasses(8);
+  groupStreamer->Update();
+  vtkMultiBlockDataSet* blocks =
+    vtkMultiBlockDataSet::SafeDownCast(groupStreamer->GetOutputDataObject(0));
+  TEST_ASSERT(blocks && blocks->GetNumberOfBlocks() == 2,
+              "Expected a multiblock output with 2 blocks");
+  TEST_ASSERT(groupStreamer->GetNumberOfStreamDivisions() > 1,
+              "Expected the multiblock to be streamed");
+  vtkPolyData* polyBlock = vtkPolyData::SafeDownCast(blocks->GetBlock(0));
+  TEST_ASSERT(polyBlock &&
+              CompareCells(polyBlock, poly.GetPointer(), "Normals"),
+              "Streamed poly data block differs from the unstreamed one");
+  vtkImageData* imageBlock = vtkImageData::SafeDownCast(blocks->GetBlock(1));
+  TEST_ASSERT(imageBlock && CompareImages(imageBlock, image.GetPointer()),
+              "Streamed image block differs from the unstreamed one");
+
+  return EXIT_SUCCESS;
+}
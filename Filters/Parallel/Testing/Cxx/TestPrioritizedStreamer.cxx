@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPrioritizedStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkPrioritizedStreamer culls pieces outside of the view
+// frustum, executes the closest pieces first and produces the same
+// result as the unstreamed pipeline once done.
+
+#include "vtkCamera.h"
+#include "vtkContourFilter.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkPrioritizedStreamer.h"
+#include "vtkRenderer.h"
+#include "vtkRTAnalyticSource.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Update until all pieces were executed. Returns the number of updates.
+int StreamAll(vtkPrioritizedStreamer* streamer)
+{
+  int numUpdates = 1;
+  while (streamer->ContinueStreaming())
+    {
+    streamer->Update();
+    ++numUpdates;
+    }
+  return numUpdates;
+}
+}
+
+int TestPrioritizedStreamer(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 63, 0, 63, 0, 63);
+  wavelet->SetCenter(31.5, 31.5, 31.5);
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputConnection(wavelet->GetOutputPort());
+  contour->SetValue(0, 150);
+  contour->Update();
+  vtkIdType numCells = contour->GetOutput()->GetNumberOfCells();
+
+  // Looking down the x axis at the pieces with large y and z. The 8
+  // pieces are the octants of the image.
+  vtkNew<vtkRenderer> renderer;
+  vtkCamera* camera = renderer->GetActiveCamera();
+  camera->SetPosition(200, 48, 48);
+  camera->SetFocalPoint(63, 48, 48);
+  camera->SetViewUp(0, 0, 1);
+  camera->SetViewAngle(6);
+  camera->SetClippingRange(1, 1000);
+
+  vtkNew<vtkPrioritizedStreamer> streamer;
+  streamer->SetInputConnection(contour->GetOutputPort());
+  streamer->SetNumberOfPieces(8);
+  streamer->SetRenderer(renderer.GetPointer());
+  streamer->Update();
+
+  TEST_ASSERT(streamer->GetNumberOfExecutedPieces() == 1,
+              "Expected 1 piece after the first update, got "
+              << streamer->GetNumberOfExecutedPieces());
+  TEST_ASSERT(streamer->GetNumberOfPendingPieces() == 1,
+              "Expected 1 visible piece left, got "
+              << streamer->GetNumberOfPendingPieces());
+  double bounds[6];
+  streamer->GetOutput()->GetBounds(bounds);
+  TEST_ASSERT(bounds[0] >= 31 && bounds[2] >= 31 && bounds[4] >= 31,
+              "Expected the closest visible piece first");
+
+  StreamAll(streamer.GetPointer());
+  TEST_ASSERT(streamer->IsDone() && streamer->GetNumberOfExecutedPieces() == 2,
+              "Expected the 6 pieces outside of the view to be culled, "
+              << streamer->GetNumberOfExecutedPieces() << " were executed");
+  streamer->GetOutput()->GetBounds(bounds);
+  TEST_ASSERT(bounds[0] < 31 && bounds[2] >= 31 && bounds[4] >= 31,
+              "Expected the far visible piece last");
+
+  // Moving the camera orders the remaining pieces again and brings the
+  // pieces with small y into view.
+  camera->SetPosition(200, 16, 48);
+  camera->SetFocalPoint(63, 16, 48);
+  streamer->Update();
+  TEST_ASSERT(streamer->GetNumberOfExecutedPieces() == 3 &&
+              streamer->GetNumberOfPendingPieces() == 1,
+              "Expected the pieces that entered the view to be streamed");
+
+  // With everything in view, the final result is the whole contour.
+  camera->SetPosition(400, 31.5, 31.5);
+  camera->SetFocalPoint(31.5, 31.5, 31.5);
+  camera->SetViewAngle(30);
+  streamer->SetPiecesPerUpdate(2);
+  streamer->Update();
+  int numUpdates = StreamAll(streamer.GetPointer());
+  TEST_ASSERT(numUpdates == 3,
+              "Expected 5 pieces in 3 updates, got " << numUpdates);
+  TEST_ASSERT(streamer->GetNumberOfExecutedPieces() == 8,
+              "Expected all pieces to be executed");
+  TEST_ASSERT(streamer->GetOutput()->GetNumberOfCells() == numCells,
+              "Expected " << numCells << " cells, got "
+              << streamer->GetOutput()->GetNumberOfCells());
+
+  // Without a renderer, all pieces are executed in priority order.
+  vtkNew<vtkPrioritizedStreamer> blindStreamer;
+  blindStreamer->SetInputConnection(contour->GetOutputPort());
+  blindStreamer->SetNumberOfPieces(8);
+  blindStreamer->SetPiecesPerUpdate(4);
+  blindStreamer->Update();
+  numUpdates = StreamAll(blindStreamer.GetPointer());
+  TEST_ASSERT(numUpdates == 2 && blindStreamer->IsDone(),
+              "Expected 8 pieces in 2 updates, got " << numUpdates);
+  TEST_ASSERT(blindStreamer->GetOutput()->GetNumberOfCells() == numCells,
+              "Expected " << numCells << " cells without a renderer");
+
+  // Changing the input starts over.
+  contour->SetValue(0, 200);
+  blindStreamer->Update();
+  TEST_ASSERT(blindStreamer->GetNumberOfExecutedPieces() == 4,
+              "Expected streaming to restart when the input changed");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,841 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryLimitStreamer.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkExtentTranslator.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineSize.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStructuredData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+class vtkMemoryLimitStreamerInternals
+{
+public:
+  // Partial results of one leaf with their merge level (see
+  // vtkMemoryLimitStreamer::AccumulatePiece()).
+  typedef std::pair<int, vtkSmartPointer<vtkDataSet> > PartialType;
+  typedef std::vector<PartialType> PartialsType;
+  typedef std::map<unsigned int, PartialsType> PartialsMapType;
+  typedef std::vector<vtkSmartPointer<vtkImageData> > ImagePiecesType;
+  typedef std::map<unsigned int, ImagePiecesType> ImageLeavesType;
+
+  vtkMemoryLimitStreamerInternals()
+  {
+    for (int i = 0; i < 6; i += 2)
+      {
+      this->OutputExtent[i] = 0;
+      this->OutputExtent[i+1] = -1;
+      }
+  }
+
+  // Appended pieces per leaf (flat index 0 for non-composite input).
+  PartialsMapType Partials;
+
+  // Pieces of image data leaves of composite inputs. The whole extent of
+  // a leaf is only known once all pieces are available.
+  ImageLeavesType ImageLeaves;
+
+  // Assembled result for image data input.
+  vtkSmartPointer<vtkImageData> Image;
+
+  // Assembled image data leaves, kept until they are set in the output.
+  std::map<unsigned int, vtkSmartPointer<vtkDataObject> > Results;
+
+  // Extent requested downstream of the streamer for image data.
+  int OutputExtent[6];
+
+  void Clear()
+  {
+    this->Partials.clear();
+    this->ImageLeaves.clear();
+    this->Results.clear();
+    this->Image = 0;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Allocate the arrays of "out" like the ones of "in" with numTuples tuples.
+static void vtkMemoryLimitStreamerAllocate(vtkDataSetAttributes* in,
+                                           vtkDataSetAttributes* out,
+                                           vtkIdType numTuples)
+{
+  out->CopyStructure(in);
+  int numArrays = in->GetNumberOfArrays();
+  for (int i = 0; i < numArrays; ++i)
+    {
+    out->GetAbstractArray(i)->SetNumberOfTuples(numTuples);
+    }
+  for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+    {
+    vtkAbstractArray* active = in->GetAbstractAttribute(attr);
+    for (int i = 0; active && i < numArrays; ++i)
+      {
+      if (in->GetAbstractArray(i) == active)
+        {
+        out->SetActiveAttribute(i, attr);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Copy the tuples of copyExt from "in" (laid out over inExt) to "out"
+// (laid out over outExt) one row at a time. Arrays are matched by index,
+// "out" must have been allocated with vtkMemoryLimitStreamerAllocate.
+static void vtkMemoryLimitStreamerCopyExtent(vtkDataSetAttributes* in,
+                                             const int* inExt,
+                                             vtkDataSetAttributes* out,
+                                             const int* outExt,
+                                             const int* copyExt)
+{
+  if (copyExt[0] > copyExt[1] || copyExt[2] > copyExt[3] ||
+      copyExt[4] > copyExt[5])
+    {
+    return;
+    }
+  vtkIdType inDims[2] = { inExt[1] - inExt[0] + 1, inExt[3] - inExt[2] + 1 };
+  vtkIdType outDims[2] = { outExt[1] - outExt[0] + 1,
+                           outExt[3] - outExt[2] + 1 };
+  vtkIdType rowLength = copyExt[1] - copyExt[0] + 1;
+
+  int numArrays = in->GetNumberOfArrays();
+  if (out->GetNumberOfArrays() < numArrays)
+    {
+    numArrays = out->GetNumberOfArrays();
+    }
+  for (int i = 0; i < numArrays; ++i)
+    {
+    vtkAbstractArray* inArray = in->GetAbstractArray(i);
+    vtkAbstractArray* outArray = out->GetAbstractArray(i);
+    vtkDataArray* inData = vtkDataArray::SafeDownCast(inArray);
+    vtkDataArray* outData = vtkDataArray::SafeDownCast(outArray);
+    // Bit arrays do not address single tuples by pointer.
+    int rawCopy = inData && outData &&
+      inData->GetDataType() == outData->GetDataType() &&
+      inData->GetDataType() != VTK_BIT;
+    int numComp = inArray->GetNumberOfComponents();
+    for (int k = copyExt[4]; k <= copyExt[5]; ++k)
+      {
+      for (int j = copyExt[2]; j <= copyExt[3]; ++j)
+        {
+        vtkIdType inId = (copyExt[0] - inExt[0]) +
+          (j - inExt[2]) * inDims[0] +
+          static_cast<vtkIdType>(k - inExt[4]) * inDims[0] * inDims[1];
+        vtkIdType outId = (copyExt[0] - outExt[0]) +
+          (j - outExt[2]) * outDims[0] +
+          static_cast<vtkIdType>(k - outExt[4]) * outDims[0] * outDims[1];
+        if (rawCopy)
+          {
+          int typeSize = inData->GetDataTypeSize();
+          memcpy(outData->GetVoidPointer(outId * numComp),
+                 inData->GetVoidPointer(inId * numComp),
+                 rowLength * numComp * typeSize);
+          }
+        else
+          {
+          for (vtkIdType t = 0; t < rowLength; ++t)
+            {
+            outArray->SetTuple(outId + t, inId + t, inArray);
+            }
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Copy the points in "extent" and the cells starting in "extent" from
+// "piece" to "result". Cells on the upper boundary of "extent" belong to
+// the next piece, except on the upper boundary of the result.
+static void vtkMemoryLimitStreamerCopyImage(vtkImageData* piece,
+                                            vtkImageData* result,
+                                            const int* extent)
+{
+  const int* inExt = piece->GetExtent();
+  const int* outExt = result->GetExtent();
+  int copyExt[6];
+  for (int i = 0; i < 6; i += 2)
+    {
+    copyExt[i] = extent[i] > outExt[i] ? extent[i] : outExt[i];
+    copyExt[i+1] = extent[i+1] < outExt[i+1] ? extent[i+1] : outExt[i+1];
+    }
+  vtkMemoryLimitStreamerCopyExtent(piece->GetPointData(), inExt,
+                                   result->GetPointData(), outExt, copyExt);
+
+  // Cell extents have one less sample than point extents along every
+  // dimension that is not flat.
+  int inCellExt[6], outCellExt[6], cellExt[6];
+  for (int i = 0; i < 6; i += 2)
+    {
+    int flat = (outExt[i] == outExt[i+1]);
+    inCellExt[i] = inExt[i];
+    inCellExt[i+1] = flat ? inExt[i+1] : inExt[i+1] - 1;
+    outCellExt[i] = outExt[i];
+    outCellExt[i+1] = flat ? outExt[i+1] : outExt[i+1] - 1;
+    cellExt[i] = copyExt[i];
+    cellExt[i+1] = flat ? copyExt[i+1] : copyExt[i+1] - 1;
+    }
+  vtkMemoryLimitStreamerCopyExtent(piece->GetCellData(), inCellExt,
+                                   result->GetCellData(), outCellExt, cellExt);
+}
+
+//----------------------------------------------------------------------------
+// Create an image over "extent" with the geometry and arrays of "piece".
+static vtkImageData* vtkMemoryLimitStreamerNewImage(vtkImageData* piece,
+                                                    const int* extent)
+{
+  vtkImageData* result = vtkImageData::New();
+  result->SetExtent(const_cast<int*>(extent));
+  result->SetOrigin(piece->GetOrigin());
+  result->SetSpacing(piece->GetSpacing());
+  vtkMemoryLimitStreamerAllocate(piece->GetPointData(),
+                                 result->GetPointData(),
+                                 result->GetNumberOfPoints());
+  vtkMemoryLimitStreamerAllocate(piece->GetCellData(),
+                                 result->GetCellData(),
+                                 result->GetNumberOfCells());
+  return result;
+}
+
+vtkStandardNewMacro(vtkMemoryLimitStreamer);
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitStreamer::vtkMemoryLimitStreamer()
+{
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+
+  // Set a default memory limit of 50 Megabytes
+  this->MemoryLimit = 50000;
+  this->MaximumNumberOfPasses = 128;
+  this->ProbeNumberOfPasses = 64;
+  this->AdaptivePlanning = 1;
+  this->MergePoints = 0;
+  this->Replanning = 0;
+  this->Replanned = 0;
+  this->Probing = 0;
+
+  this->ExtentTranslator = vtkExtentTranslator::New();
+  this->Internals = new vtkMemoryLimitStreamerInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkMemoryLimitStreamer::~vtkMemoryLimitStreamer()
+{
+  this->ExtentTranslator->Delete();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "MemoryLimit (in kb): " << this->MemoryLimit << endl;
+  os << indent << "MaximumNumberOfPasses: "
+     << this->MaximumNumberOfPasses << endl;
+  os << indent << "ProbeNumberOfPasses: " << this->ProbeNumberOfPasses << endl;
+  os << indent << "AdaptivePlanning: " << this->AdaptivePlanning << endl;
+  os << indent << "MergePoints: " << this->MergePoints << endl;
+  os << indent << "NumberOfStreamDivisions: " << this->NumberOfPasses << endl;
+}
+
+//----------------------------------------------------------------------------
+vtkExecutive* vtkMemoryLimitStreamer::CreateDefaultExecutive()
+{
+  return vtkCompositeDataPipeline::New();
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkCompositeDataSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::FillOutputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ProcessRequest(vtkInformation* request,
+                                           vtkInformationVector** inputVector,
+                                           vtkInformationVector* outputVector)
+{
+  // create the output
+  if(request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+    {
+    return this->RequestDataObject(request, inputVector, outputVector);
+    }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestDataObject(
+  vtkInformation*,
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  if (!inInfo)
+    {
+    return 0;
+    }
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!input)
+    {
+    return 0;
+    }
+
+  // Image data and poly data are assembled into the same type. Composite
+  // data keeps its structure. Everything else is appended into an
+  // unstructured grid.
+  int sameType = vtkImageData::SafeDownCast(input) ||
+    vtkPolyData::SafeDownCast(input) ||
+    vtkCompositeDataSet::SafeDownCast(input);
+  const char* outputType =
+    sameType ? input->GetClassName() : "vtkUnstructuredGrid";
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || !output->IsA(outputType))
+    {
+    vtkDataObject* newOutput = sameType ?
+      input->NewInstance() : vtkUnstructuredGrid::New();
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+    newOutput->Delete();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitStreamer::SetPassUpdateExtent(vtkInformation* inInfo,
+                                                 vtkInformation* outInfo,
+                                                 int pass, int numPasses)
+{
+  if (vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT())))
+    {
+    // split the requested extent like vtkImageDataStreamer does
+    int outExt[6];
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+
+    int inExt[6] = {0, -1, 0, -1, 0, -1};
+    vtkExtentTranslator *translator = this->ExtentTranslator;
+    translator->SetWholeExtent(outExt);
+    translator->SetNumberOfPieces(numPasses);
+    translator->SetPiece(pass);
+    translator->SetGhostLevel(0);
+    // Split by cells so that adjacent pieces share a layer of points
+    // and every cell belongs to exactly one piece.
+    if (translator->PieceToExtent())
+      {
+      translator->GetExtent(inExt);
+      }
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
+    return;
+    }
+
+  // Everything else is divided into pieces. The pipeline translates
+  // pieces into extents for structured data upstream.
+  int outPiece = vtkStreamingDemandDrivenPipeline::GetUpdatePiece(outInfo);
+  int outNumPieces =
+    vtkStreamingDemandDrivenPipeline::GetUpdateNumberOfPieces(outInfo);
+  int ghostLevel = vtkStreamingDemandDrivenPipeline::GetUpdateGhostLevel(outInfo);
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    inInfo, outPiece * numPasses + pass, outNumPieces * numPasses, ghostLevel);
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMemoryLimitStreamer::EstimatePassSize(vtkInformation* inInfo)
+{
+  vtkStreamingDemandDrivenPipeline *sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(
+      vtkExecutive::PRODUCER()->GetExecutive(inInfo));
+  if (!sddp)
+    {
+    return 0;
+    }
+  int index = vtkExecutive::PRODUCER()->GetPort(inInfo);
+
+  // set a hint not to combine with previous requests
+  inInfo->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(),
+    VTK_UPDATE_EXTENT_REPLACE);
+
+  sddp->PropagateUpdateExtent(index);
+
+  // then reset the INITIALIZED flag to the default value COMBINE
+  inInfo->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(),
+    VTK_UPDATE_EXTENT_COMBINE);
+
+  vtkPipelineSize *sizer = vtkPipelineSize::New();
+  unsigned long size = sizer->GetEstimatedSize(this,0,0);
+  sizer->Delete();
+  return size;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::HasPieceSizeInformation(vtkInformation* inInfo)
+{
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!input)
+    {
+    return 0;
+    }
+  // Structured requests are estimated from the extents and the scalar
+  // meta-data, which are available before execution.
+  if (vtkImageData::SafeDownCast(input))
+    {
+    return 1;
+    }
+  // Piece requests are estimated from the data of the previous execution.
+  // The pipeline records the piece once something was produced. Data that
+  // was never produced has no piece or piece -1 (see vtkPolyData).
+  vtkInformation *dataInfo = input->GetInformation();
+  return dataInfo->Has(vtkDataObject::DATA_PIECE_NUMBER()) &&
+    dataInfo->Get(vtkDataObject::DATA_PIECE_NUMBER()) >= 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ComputeNumberOfPasses(vtkInformation* inInfo,
+                                                  vtkInformation* outInfo)
+{
+  this->Probing = 0;
+  if (!this->HasPieceSizeInformation(inInfo))
+    {
+    // Nothing is known about the size of a piece yet. Run the first pass
+    // on a small piece and plan from its actual size (see ExecutePass).
+    this->Probing = 1;
+    int numPasses = this->ProbeNumberOfPasses;
+    if (numPasses > this->MaximumNumberOfPasses)
+      {
+      numPasses = this->MaximumNumberOfPasses;
+      }
+    return numPasses;
+    }
+
+  int numPasses = 1;
+  unsigned long oldSize, size = 0;
+  float ratio;
+
+  // watch for the limiting case where the size is the maximum size
+  // represented by an unsigned long. In that case we do not want to do
+  // the ratio test.
+  unsigned long maxSize;
+  maxSize = (((unsigned long)0x1) << (8*sizeof(unsigned long) - 1));
+
+  int count = 0;
+
+  // double the number of passes until the size fits in memory
+  // or the reduction in size falls to 20%
+  do
+    {
+    oldSize = size;
+    this->SetPassUpdateExtent(inInfo, outInfo, 0, numPasses);
+    size = this->EstimatePassSize(inInfo);
+    // watch for the first time through
+    if (!oldSize)
+      {
+      ratio = 0.5;
+      }
+    // otherwise the normal ratio calculation
+    else
+      {
+      ratio = size/(float)oldSize;
+      }
+    numPasses = numPasses*2;
+    count++;
+    }
+  while (size > this->MemoryLimit &&
+         (size < maxSize && ratio < 0.8) &&
+         numPasses <= this->MaximumNumberOfPasses && count < 29);
+
+  // undo the last *2
+  return numPasses/2;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  if (this->CurrentIndex == 0)
+    {
+    // Plan the streaming before the first pass, unless we are restarting
+    // with a number of passes computed from the first pass.
+    if (!this->Replanning)
+      {
+      this->NumberOfPasses = this->ComputeNumberOfPasses(inInfo, outInfo);
+      this->Replanned = 0;
+      }
+    this->Replanning = 0;
+    }
+
+  this->SetPassUpdateExtent(inInfo, outInfo,
+                            this->CurrentIndex, this->NumberOfPasses);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::RequestData(vtkInformation *request,
+                                        vtkInformationVector **inputVector,
+                                        vtkInformationVector *outputVector)
+{
+  if (this->CurrentIndex == 0 &&
+      this->ReplanFromFirstPass(inputVector[0]->GetInformationObject(0),
+                                outputVector->GetInformationObject(0)))
+    {
+    // The first pass was only used to measure. Start over before the
+    // superclass counts it as a pass.
+    this->Replanning = 1;
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+    return 1;
+    }
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ReplanFromFirstPass(vtkInformation* inInfo,
+                                                vtkInformation* outInfo)
+{
+  int probing = this->Probing;
+  this->Probing = 0;
+  // Every pass continues the execution from within the pipeline, so
+  // restart at most once per update.
+  if (this->Replanned || (!probing && !this->AdaptivePlanning))
+    {
+    return 0;
+    }
+  this->Replanned = 1;
+
+  int numPasses = static_cast<int>(this->NumberOfPasses);
+  if (!probing)
+    {
+    // Only re-plan when the first piece turned out larger than planned.
+    vtkPipelineSize *sizer = vtkPipelineSize::New();
+    unsigned long size = sizer->GetEstimatedSize(this,0,0);
+    sizer->Delete();
+    if (size <= this->MemoryLimit || numPasses >= this->MaximumNumberOfPasses)
+      {
+      return 0;
+      }
+    }
+
+  // The data of the first pass exists now, so the estimates are scaled
+  // from the actual size of a piece.
+  int newNumPasses = this->ComputeNumberOfPasses(inInfo, outInfo);
+  this->Probing = 0;
+  if (newNumPasses == numPasses || (!probing && newNumPasses < numPasses))
+    {
+    // Keep the first pass. Restore its request, which the estimate
+    // replaced.
+    this->SetPassUpdateExtent(inInfo, outInfo, 0, numPasses);
+    return 0;
+    }
+  vtkDebugMacro("Re-planning streaming with " << newNumPasses
+                << " passes instead of " << numPasses);
+  this->NumberOfPasses = newNumPasses;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::ExecutePass(vtkInformationVector **inputVector,
+                                        vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject *input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+
+  if (this->CurrentIndex == 0)
+    {
+    this->Internals->Clear();
+
+    if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
+      {
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+                   this->Internals->OutputExtent);
+      }
+    else if (inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()))
+      {
+      inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
+                  this->Internals->OutputExtent);
+      }
+    }
+
+  if (vtkCompositeDataSet *cd = vtkCompositeDataSet::SafeDownCast(input))
+    {
+    vtkCompositeDataIterator *iter = cd->NewIterator();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+         iter->GoToNextItem())
+      {
+      vtkDataSet *ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (ds)
+        {
+        this->AccumulatePiece(iter->GetCurrentFlatIndex(), ds, 0);
+        }
+      }
+    iter->Delete();
+    }
+  else if (vtkDataSet *ds = vtkDataSet::SafeDownCast(input))
+    {
+    if (vtkImageData::SafeDownCast(ds))
+      {
+      int inExt[6];
+      inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
+      this->AccumulatePiece(0, ds, inExt);
+      }
+    else
+      {
+      this->AccumulatePiece(0, ds, 0);
+      }
+    }
+
+  this->UpdateProgress(static_cast<double>(this->CurrentIndex + 1) /
+                       static_cast<double>(this->NumberOfPasses));
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMemoryLimitStreamer::AccumulatePiece(unsigned int flatIndex,
+                                             vtkDataSet* piece,
+                                             int* extent)
+{
+  vtkImageData *image = vtkImageData::SafeDownCast(piece);
+  if (image && extent)
+    {
+    if (extent[0] > extent[1] || extent[2] > extent[3] ||
+        extent[4] > extent[5])
+      {
+      return;
+      }
+    if (!this->Internals->Image)
+      {
+      this->Internals->Image.TakeReference(
+        vtkMemoryLimitStreamerNewImage(image, this->Internals->OutputExtent));
+      }
+    vtkMemoryLimitStreamerCopyImage(image, this->Internals->Image, extent);
+    return;
+    }
+
+  if (image)
+    {
+    // Image leaves of composite data are assembled in FinalizeOutput().
+    if (image->GetNumberOfPoints() > 0)
+      {
+      vtkImageData *copy = vtkImageData::New();
+      copy->ShallowCopy(image);
+      this->Internals->ImageLeaves[flatIndex].push_back(copy);
+      copy->Delete();
+      }
+    return;
+    }
+
+  if (piece->GetNumberOfPoints() == 0)
+    {
+    return;
+    }
+
+  vtkMemoryLimitStreamerInternals::PartialsType &partials =
+    this->Internals->Partials[flatIndex];
+  if (!partials.empty() &&
+      (vtkPolyData::SafeDownCast(partials[0].second) != 0) !=
+      (vtkPolyData::SafeDownCast(piece) != 0))
+    {
+    vtkErrorMacro("Piece of type " << piece->GetClassName()
+                  << " cannot be appended to "
+                  << partials[0].second->GetClassName() << ".");
+    return;
+    }
+
+  vtkSmartPointer<vtkDataSet> copy;
+  copy.TakeReference(piece->NewInstance());
+  copy->ShallowCopy(piece);
+  partials.push_back(
+    vtkMemoryLimitStreamerInternals::PartialType(0, copy));
+
+  // Merge partial results of the same level like a binary counter, so
+  // that pieces are appended as they arrive but every piece is copied
+  // only log2(NumberOfPasses) times.
+  while (partials.size() > 1 &&
+         partials[partials.size()-1].first == partials[partials.size()-2].first)
+    {
+    vtkMemoryLimitStreamerInternals::PartialType &last =
+      partials[partials.size()-2];
+    last.second.TakeReference(
+      this->AppendPieces(last.second, partials.back().second));
+    last.first++;
+    partials.pop_back();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkDataSet* vtkMemoryLimitStreamer::AppendPieces(vtkDataSet* first,
+                                                 vtkDataSet* second)
+{
+  vtkAlgorithm *appender;
+  if (vtkPolyData::SafeDownCast(first))
+    {
+    appender = vtkAppendPolyData::New();
+    }
+  else
+    {
+    vtkAppendFilter *append = vtkAppendFilter::New();
+    append->SetMergePoints(this->MergePoints);
+    appender = append;
+    }
+  appender->AddInputDataObject(first);
+  appender->AddInputDataObject(second);
+  appender->Update();
+  vtkDataSet *result = vtkDataSet::SafeDownCast(
+    appender->GetOutputDataObject(0));
+  result->Register(this);
+  appender->Delete();
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkMemoryLimitStreamer::FinalizeOutput(unsigned int flatIndex)
+{
+  if (flatIndex == 0 && this->Internals->Image)
+    {
+    return this->Internals->Image;
+    }
+
+  vtkMemoryLimitStreamerInternals::ImageLeavesType::iterator leaf =
+    this->Internals->ImageLeaves.find(flatIndex);
+  if (leaf != this->Internals->ImageLeaves.end())
+    {
+    vtkMemoryLimitStreamerInternals::ImagePiecesType &pieces = leaf->second;
+    int wholeExt[6];
+    pieces[0]->GetExtent(wholeExt);
+    for (size_t i = 1; i < pieces.size(); ++i)
+      {
+      const int *ext = pieces[i]->GetExtent();
+      for (int j = 0; j < 6; j += 2)
+        {
+        wholeExt[j] = ext[j] < wholeExt[j] ? ext[j] : wholeExt[j];
+        wholeExt[j+1] = ext[j+1] > wholeExt[j+1] ? ext[j+1] : wholeExt[j+1];
+        }
+      }
+    vtkImageData *result =
+      vtkMemoryLimitStreamerNewImage(pieces[0], wholeExt);
+    for (size_t i = 0; i < pieces.size(); ++i)
+      {
+      // The pipeline splits pieces by cells, so adjacent pieces share a
+      // layer of points and copying the cells that start in each piece
+      // covers every cell once.
+      vtkMemoryLimitStreamerCopyImage(pieces[i], result,
+                                      pieces[i]->GetExtent());
+      }
+    this->Internals->ImageLeaves.erase(leaf);
+    this->Internals->Results[flatIndex].TakeReference(result);
+    return result;
+    }
+
+  vtkMemoryLimitStreamerInternals::PartialsMapType::iterator it =
+    this->Internals->Partials.find(flatIndex);
+  if (it == this->Internals->Partials.end() || it->second.empty())
+    {
+    return 0;
+    }
+  vtkMemoryLimitStreamerInternals::PartialsType &partials = it->second;
+  vtkSmartPointer<vtkDataSet> result = partials.back().second;
+  for (size_t i = partials.size() - 1; i > 0; --i)
+    {
+    result.TakeReference(this->AppendPieces(partials[i-1].second, result));
+    }
+  this->Internals->Partials.erase(it);
+  this->Internals->Results[flatIndex] = result;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkMemoryLimitStreamer::PostExecute(
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject *output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+
+  if (vtkCompositeDataSet *outCD = vtkCompositeDataSet::SafeDownCast(output))
+    {
+    vtkCompositeDataSet *inCD = vtkCompositeDataSet::SafeDownCast(
+      inInfo->Get(vtkDataObject::DATA_OBJECT()));
+    outCD->CopyStructure(inCD);
+
+    vtkCompositeDataIterator *iter = outCD->NewIterator();
+    iter->SkipEmptyNodesOff();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+         iter->GoToNextItem())
+      {
+      vtkDataObject *result = this->FinalizeOutput(iter->GetCurrentFlatIndex());
+      if (result)
+        {
+        vtkDataObject *leaf = result->NewInstance();
+        leaf->ShallowCopy(result);
+        outCD->SetDataSet(iter, leaf);
+        leaf->Delete();
+        }
+      }
+    iter->Delete();
+    }
+  else
+    {
+    vtkDataObject *result = this->FinalizeOutput(0);
+    if (result)
+      {
+      output->ShallowCopy(result);
+      }
+    else
+      {
+      output->Initialize();
+      }
+    }
+
+  this->Internals->Clear();
+  return 1;
+}
@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryLimitStreamer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMemoryLimitStreamer - Streams any input within a memory budget.
+// .SECTION Description
+// vtkMemoryLimitStreamer initiates streaming on its input pipeline and
+// chooses the number of passes so that the estimated memory footprint
+// of the upstream pipeline for one pass stays below MemoryLimit. The
+// estimate is made with vtkPipelineSize by doubling the number of
+// pieces until the pipeline fits (or stops shrinking).
+//
+// The size of unstructured pieces is only known once data was produced.
+// When nothing was produced yet, the first pass requests one piece out of
+// ProbeNumberOfPasses, measures it and plans the actual number of passes
+// from it. If the first pass turns out to use more memory than the limit,
+// the streamer re-plans with more pieces and starts over. This happens at
+// most once per update.
+//
+// When the limit cannot be reached, either because MaximumNumberOfPasses
+// is hit or because more pieces stop reducing the estimated size by at
+// least 20%, the streamer uses the number of passes reached at that point
+// and the pipeline executes with more memory than MemoryLimit.
+//
+// Pieces are accumulated into the output as follows:
+// - vtkImageData: the requested extent is split into sub-extents and
+//   each sub-extent is copied into a preallocated output image.
+// - vtkPolyData: pieces are appended with vtkAppendPolyData as they
+//   arrive.
+// - other vtkDataSet types: pieces are appended with vtkAppendFilter
+//   as they arrive and the output is a vtkUnstructuredGrid.
+// - vtkCompositeDataSet: every leaf is streamed as above and the output
+//   has the same structure as the input. The pieces of image data leaves
+//   are kept until the last pass and then assembled into one image.
+//
+// Subclasses can override AccumulatePiece() and FinalizeOutput() to
+// reduce pieces (e.g. compute statistics) instead of appending them.
+// .SECTION Note
+// MemoryLimit bounds the memory used by the input pipeline for one pass,
+// not the size of the output. Appending keeps the whole result in memory:
+// image data is copied into a preallocated output after every pass, but
+// appending poly data and unstructured pieces needs up to twice the size
+// of the result while the last partial results are merged, and the pieces
+// of image data leaves of composite inputs are kept until the last pass.
+// To write results that do not fit in memory, stream the writer instead
+// (vtkXMLWriter supports NumberOfPieces) or reduce pieces in a subclass.
+//
+// Every pass continues the execution from within the pipeline, which uses
+// stack space for each pass. Keep MaximumNumberOfPasses moderate.
+// .SECTION See Also
+// vtkPipelineSize vtkMemoryLimitImageDataStreamer vtkPolyDataStreamer
+
+#ifndef __vtkMemoryLimitStreamer_h
+#define __vtkMemoryLimitStreamer_h
+
+#include "vtkFiltersParallelModule.h" // For export macro
+#include "vtkStreamerBase.h"
+
+class vtkDataObject;
+class vtkDataSet;
+class vtkExtentTranslator;
+class vtkMemoryLimitStreamerInternals;
+
+class VTKFILTERSPARALLEL_EXPORT vtkMemoryLimitStreamer : public vtkStreamerBase
+{
+public:
+  static vtkMemoryLimitStreamer *New();
+  vtkTypeMacro(vtkMemoryLimitStreamer,vtkStreamerBase);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set / Get the memory limit in kilobytes. Default is 50 megabytes.
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+
+  // Description:
+  // Set / Get the maximum number of passes the streamer may use.
+  // Default is 128.
+  vtkSetClampMacro(MaximumNumberOfPasses, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPasses, int);
+
+  // Description:
+  // Set / Get the number of pieces the input is split into for the first
+  // pass when the size of a piece cannot be estimated before execution.
+  // Default is 64.
+  vtkSetClampMacro(ProbeNumberOfPasses, int, 1, VTK_INT_MAX);
+  vtkGetMacro(ProbeNumberOfPasses, int);
+
+  // Description:
+  // When on (the default), re-plan the number of passes if the first
+  // pass used more memory than MemoryLimit.
+  vtkSetMacro(AdaptivePlanning, int);
+  vtkGetMacro(AdaptivePlanning, int);
+  vtkBooleanMacro(AdaptivePlanning, int);
+
+  // Description:
+  // Passed to vtkAppendFilter when unstructured pieces are appended.
+  // Default is off.
+  vtkSetMacro(MergePoints, int);
+  vtkGetMacro(MergePoints, int);
+  vtkBooleanMacro(MergePoints, int);
+
+  // Description:
+  // Get the number of passes chosen for the last execution.
+  int GetNumberOfStreamDivisions()
+  {
+    return static_cast<int>(this->NumberOfPasses);
+  }
+
+  // Description:
+  // Compute the number of passes needed to fit the pipeline connected
+  // to the input of this filter into MemoryLimit when the output
+  // request is (piece, numPieces, ghostLevel) or extent. This
+  // propagates update extents upstream but does not execute anything.
+  int ComputeNumberOfPasses(vtkInformation* inInfo, vtkInformation* outInfo);
+
+  // Description:
+  // see vtkAlgorithm for details
+  virtual int ProcessRequest(vtkInformation*,
+                             vtkInformationVector**,
+                             vtkInformationVector*);
+
+protected:
+  vtkMemoryLimitStreamer();
+  ~vtkMemoryLimitStreamer();
+
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+  virtual int FillOutputPortInformation(int port, vtkInformation* info);
+  virtual vtkExecutive* CreateDefaultExecutive();
+
+  virtual int RequestDataObject(vtkInformation*,
+                                vtkInformationVector**,
+                                vtkInformationVector*);
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector**,
+                                  vtkInformationVector*);
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector**,
+                          vtkInformationVector*);
+
+  virtual int ExecutePass(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+  virtual int PostExecute(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+
+  // Description:
+  // Add one piece of the input to the result. flatIndex identifies the
+  // leaf for composite inputs and is 0 otherwise. extent is the sub
+  // extent requested for image data and NULL otherwise.
+  virtual void AccumulatePiece(unsigned int flatIndex, vtkDataSet* piece,
+                               int* extent);
+
+  // Description:
+  // Return the accumulated result for a leaf (or the whole input when
+  // flatIndex is 0 and the input is not composite). The returned object
+  // is shallow copied into the output.
+  virtual vtkDataObject* FinalizeOutput(unsigned int flatIndex);
+
+  // Description:
+  // Set the update request of inInfo for pass "pass" out of "numPasses".
+  void SetPassUpdateExtent(vtkInformation* inInfo, vtkInformation* outInfo,
+                           int pass, int numPasses);
+
+  // Description:
+  // Estimate the memory, in kilobytes, required by the input pipeline to
+  // produce the request currently set on inInfo.
+  unsigned long EstimatePassSize(vtkInformation* inInfo);
+
+  // Description:
+  // Return 1 if the size of the request on inInfo can be estimated
+  // before executing the input pipeline.
+  int HasPieceSizeInformation(vtkInformation* inInfo);
+
+  // Description:
+  // Called after the first pass executed. Recompute NumberOfPasses from
+  // the actual size of the first piece and return 1 if it changed.
+  int ReplanFromFirstPass(vtkInformation* inInfo, vtkInformation* outInfo);
+
+  // Description:
+  // Append two pieces of the same leaf. The caller owns the result.
+  vtkDataSet* AppendPieces(vtkDataSet* first, vtkDataSet* second);
+
+  unsigned long MemoryLimit;
+  int MaximumNumberOfPasses;
+  int ProbeNumberOfPasses;
+  int AdaptivePlanning;
+  int MergePoints;
+
+  // Set while the streamer restarts after re-planning.
+  int Replanning;
+
+  // Set once the streamer re-planned during the current update.
+  int Replanned;
+
+  // Set while the first pass only measures the size of a piece.
+  int Probing;
+
+  vtkExtentTranslator* ExtentTranslator;
+
+private:
+  vtkMemoryLimitStreamer(const vtkMemoryLimitStreamer&);  // Not implemented.
+  void operator=(const vtkMemoryLimitStreamer&);  // Not implemented.
+
+  vtkMemoryLimitStreamerInternals* Internals;
+};
+
+#endif
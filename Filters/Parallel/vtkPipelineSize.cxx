@@ -280,8 +280,28 @@ GenericComputeOutputMemorySize( vtkAlgorithm *src, int outputPort,
       if (dataInfo->Get(vtkDataObject::DATA_EXTENT_TYPE()) ==
           VTK_PIECES_EXTENT)
         {
-        // TODO: need something here
-        tmp = 1;
+        // Without a better model, scale the size of the data produced by
+        // the last execution by the ratio of its number of pieces to the
+        // requested number of pieces.
+        vtkDataObject *data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+        tmp = data->GetActualMemorySize();
+        int dataNumPieces = 1;
+        if (dataInfo->Has(vtkDataObject::DATA_NUMBER_OF_PIECES()))
+          {
+          dataNumPieces = dataInfo->Get(vtkDataObject::DATA_NUMBER_OF_PIECES());
+          }
+        int updateNumPieces =
+          vtkStreamingDemandDrivenPipeline::GetUpdateNumberOfPieces(outInfo);
+        if (tmp == 0)
+          {
+          tmp = 1;
+          }
+        else if (dataNumPieces > 0 && updateNumPieces > 0 &&
+                 updateNumPieces != dataNumPieces)
+          {
+          tmp = tmp*dataNumPieces;
+          tmp /= updateNumPieces;
+          }
         }
       if (dataInfo->Get(vtkDataObject::DATA_EXTENT_TYPE()) == VTK_3D_EXTENT)
         {
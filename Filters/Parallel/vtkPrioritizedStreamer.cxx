@@ -0,0 +1,546 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPrioritizedStreamer.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPrioritizedStreamer.h"
+
+#include "vtkAppendPolyData.h"
+#include "vtkCamera.h"
+#include "vtkDataObject.h"
+#include "vtkExtentTranslator.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkRenderer.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkWeakPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------------
+class vtkPrioritizedStreamerInternals
+{
+public:
+  struct PieceInfo
+  {
+    double Priority;
+    double Importance;
+    double Distance;
+    double Bounds[6];
+    int HasBounds;
+    int Executed;
+  };
+
+  vtkPrioritizedStreamerInternals()
+  {
+    this->InputMTime = 0;
+    this->CameraMTime = 0;
+    this->CurrentPiece = -1;
+    this->LastPiece = -1;
+    this->NumberOfExecutedPieces = 0;
+  }
+
+  // Sorts piece indices by decreasing importance. Pieces that are equally
+  // important, for example because they both fill the view, are sorted
+  // by increasing distance to the camera.
+  struct MoreImportant
+  {
+    const std::vector<PieceInfo>* Pieces;
+    bool operator()(int a, int b) const
+    {
+      const PieceInfo &pa = (*this->Pieces)[a];
+      const PieceInfo &pb = (*this->Pieces)[b];
+      if (pa.Importance != pb.Importance)
+        {
+        return pa.Importance > pb.Importance;
+        }
+      return pa.Distance < pb.Distance;
+    }
+  };
+
+  std::vector<PieceInfo> Pieces;
+
+  // Pieces that are neither executed nor culled, most important first.
+  std::vector<int> Order;
+
+  vtkSmartPointer<vtkPolyData> Result;
+  vtkWeakPointer<vtkRenderer> Renderer;
+
+  // Pipeline modification time of the input when streaming started.
+  unsigned long InputMTime;
+
+  // Modification time of the camera the pieces were ordered for.
+  unsigned long CameraMTime;
+
+  int CurrentPiece;
+  int LastPiece;
+  int NumberOfExecutedPieces;
+};
+
+//----------------------------------------------------------------------------
+// Find the bounding box of the piece requested on info. Looks for
+// PIECE_BOUNDING_BOX or a structured update extent upstream.
+static int vtkPrioritizedStreamerGetPieceBounds(vtkInformation* info,
+                                                double bounds[6])
+{
+  while (info)
+    {
+    if (info->Has(vtkStreamingDemandDrivenPipeline::PIECE_BOUNDING_BOX()))
+      {
+      info->Get(vtkStreamingDemandDrivenPipeline::PIECE_BOUNDING_BOX(),
+                bounds);
+      if (bounds[0] <= bounds[1] && bounds[2] <= bounds[3] &&
+          bounds[4] <= bounds[5])
+        {
+        return 1;
+        }
+      }
+    // Update extents may be combined with earlier requests, so translate
+    // the requested piece instead.
+    if (info->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()) &&
+        info->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) &&
+        info->Has(vtkDataObject::ORIGIN()) &&
+        info->Has(vtkDataObject::SPACING()))
+      {
+      int ext[6];
+      double origin[3], spacing[3];
+      vtkExtentTranslator* translator =
+        vtkStreamingDemandDrivenPipeline::GetExtentTranslator(info);
+      translator->SetWholeExtent(
+        info->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
+      translator->SetPiece(
+        info->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()));
+      translator->SetNumberOfPieces(
+        info->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()));
+      translator->SetGhostLevel(0);
+      translator->PieceToExtent();
+      translator->GetExtent(ext);
+      info->Get(vtkDataObject::ORIGIN(), origin);
+      info->Get(vtkDataObject::SPACING(), spacing);
+      if (ext[0] <= ext[1] && ext[2] <= ext[3] && ext[4] <= ext[5])
+        {
+        for (int i = 0; i < 3; ++i)
+          {
+          double b0 = origin[i] + ext[2*i] * spacing[i];
+          double b1 = origin[i] + ext[2*i+1] * spacing[i];
+          bounds[2*i] = b0 < b1 ? b0 : b1;
+          bounds[2*i+1] = b0 < b1 ? b1 : b0;
+          }
+        return 1;
+        }
+      }
+
+    vtkExecutive* executive = vtkExecutive::PRODUCER()->GetExecutive(info);
+    vtkAlgorithm* algorithm = executive ? executive->GetAlgorithm() : 0;
+    if (!algorithm || algorithm->GetNumberOfInputPorts() < 1 ||
+        algorithm->GetNumberOfInputConnections(0) < 1)
+      {
+      break;
+      }
+    info = algorithm->GetInputInformation(0, 0);
+    }
+  return 0;
+}
+
+vtkStandardNewMacro(vtkPrioritizedStreamer);
+
+//----------------------------------------------------------------------------
+vtkPrioritizedStreamer::vtkPrioritizedStreamer()
+{
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+
+  this->NumberOfPieces = 64;
+  this->PiecesPerUpdate = 1;
+
+  this->Internals = new vtkPrioritizedStreamerInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkPrioritizedStreamer::~vtkPrioritizedStreamer()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPrioritizedStreamer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+  os << indent << "PiecesPerUpdate: " << this->PiecesPerUpdate << endl;
+  os << indent << "Renderer: " << this->GetRenderer() << endl;
+  os << indent << "NumberOfPendingPieces: "
+     << this->Internals->Order.size() << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkPrioritizedStreamer::SetRenderer(vtkRenderer* renderer)
+{
+  if (this->Internals->Renderer != renderer)
+    {
+    this->Internals->Renderer = renderer;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkRenderer* vtkPrioritizedStreamer::GetRenderer()
+{
+  return this->Internals->Renderer;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::GetNumberOfPendingPieces()
+{
+  return static_cast<int>(this->Internals->Order.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::GetNumberOfExecutedPieces()
+{
+  return this->Internals->NumberOfExecutedPieces;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::IsDone()
+{
+  return !this->Internals->Pieces.empty() && this->Internals->Order.empty();
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::ContinueStreaming()
+{
+  if (this->Internals->Order.empty())
+    {
+    return 0;
+    }
+  this->Modified();
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPrioritizedStreamer::GetMTime()
+{
+  unsigned long mTime = this->Superclass::GetMTime();
+  vtkRenderer* renderer = this->Internals->Renderer;
+  if (renderer && renderer->IsActiveCameraCreated())
+    {
+    unsigned long cameraMTime = renderer->GetActiveCamera()->GetMTime();
+    mTime = cameraMTime > mTime ? cameraMTime : mTime;
+    }
+  return mTime;
+}
+
+//----------------------------------------------------------------------------
+vtkPolyData* vtkPrioritizedStreamer::GetOutput()
+{
+  return vtkPolyData::SafeDownCast(this->GetOutputDataObject(0));
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::FillOutputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkPolyData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPrioritizedStreamer::ComputePieceInformation(vtkInformation* inInfo)
+{
+  vtkPrioritizedStreamerInternals::PieceInfo empty = {1.0, 1.0, 0.0,
+    {0.0, -1.0, 0.0, -1.0, 0.0, -1.0}, 0, 0};
+  this->Internals->Pieces.assign(this->NumberOfPieces, empty);
+
+  vtkStreamingDemandDrivenPipeline *sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(
+      vtkExecutive::PRODUCER()->GetExecutive(inInfo));
+  if (!sddp)
+    {
+    return;
+    }
+  int port = vtkExecutive::PRODUCER()->GetPort(inInfo);
+
+  for (int i = 0; i < this->NumberOfPieces; ++i)
+    {
+    vtkPrioritizedStreamerInternals::PieceInfo &piece =
+      this->Internals->Pieces[i];
+    vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+      inInfo, i, this->NumberOfPieces, 0);
+    piece.Priority = sddp->ComputePriority(port);
+    piece.HasBounds = vtkPrioritizedStreamerGetPieceBounds(inInfo,
+                                                           piece.Bounds);
+    }
+}
+
+//----------------------------------------------------------------------------
+double vtkPrioritizedStreamer::ComputeViewImportance(vtkCamera* camera,
+                                                     double aspect,
+                                                     const double bounds[6])
+{
+  double corners[8][4];
+  for (int i = 0; i < 8; ++i)
+    {
+    corners[i][0] = bounds[i & 1];
+    corners[i][1] = bounds[2 + ((i >> 1) & 1)];
+    corners[i][2] = bounds[4 + ((i >> 2) & 1)];
+    corners[i][3] = 1.0;
+    }
+
+  // Cull boxes that are completely outside of one of the frustum planes.
+  // The plane normals point inward.
+  double planes[24];
+  camera->GetFrustumPlanes(aspect, planes);
+  for (int p = 0; p < 6; ++p)
+    {
+    const double* plane = planes + 4*p;
+    int outside = 0;
+    for (int i = 0; i < 8; ++i)
+      {
+      if (plane[0]*corners[i][0] + plane[1]*corners[i][1] +
+          plane[2]*corners[i][2] + plane[3] < 0.0)
+        {
+        outside++;
+        }
+      }
+    if (outside == 8)
+      {
+      return 0.0;
+      }
+    }
+
+  // Area of the screen rectangle covered by the projected box.
+  vtkMatrix4x4* matrix =
+    camera->GetCompositeProjectionTransformMatrix(aspect, -1.0, 1.0);
+  double xMin = VTK_DOUBLE_MAX, xMax = -VTK_DOUBLE_MAX;
+  double yMin = VTK_DOUBLE_MAX, yMax = -VTK_DOUBLE_MAX;
+  for (int i = 0; i < 8; ++i)
+    {
+    double view[4];
+    matrix->MultiplyPoint(corners[i], view);
+    if (view[3] <= 0.0)
+      {
+      // The box reaches behind the camera, so it fills the view.
+      return 1.0;
+      }
+    double x = view[0] / view[3];
+    double y = view[1] / view[3];
+    xMin = x < xMin ? x : xMin;
+    xMax = x > xMax ? x : xMax;
+    yMin = y < yMin ? y : yMin;
+    yMax = y > yMax ? y : yMax;
+    }
+  xMin = xMin < -1.0 ? -1.0 : xMin;
+  xMax = xMax > 1.0 ? 1.0 : xMax;
+  yMin = yMin < -1.0 ? -1.0 : yMin;
+  yMax = yMax > 1.0 ? 1.0 : yMax;
+  double area = (xMax - xMin) * (yMax - yMin) / 4.0;
+
+  // Visible pieces that project to a line still need to be executed.
+  return area > 1e-12 ? area : 1e-12;
+}
+
+//----------------------------------------------------------------------------
+void vtkPrioritizedStreamer::OrderPieces()
+{
+  vtkRenderer* renderer = this->Internals->Renderer;
+  vtkCamera* camera = renderer ? renderer->GetActiveCamera() : 0;
+  double aspect = 1.0;
+  if (renderer && renderer->GetVTKWindow())
+    {
+    aspect = renderer->GetTiledAspectRatio();
+    }
+
+  std::vector<vtkPrioritizedStreamerInternals::PieceInfo> &pieces =
+    this->Internals->Pieces;
+  std::vector<int> &order = this->Internals->Order;
+  order.clear();
+  for (int i = 0; i < static_cast<int>(pieces.size()); ++i)
+    {
+    vtkPrioritizedStreamerInternals::PieceInfo &piece = pieces[i];
+    if (piece.Executed || piece.Priority <= 0.0)
+      {
+      continue;
+      }
+    piece.Importance = piece.Priority;
+    piece.Distance = 0.0;
+    if (camera && piece.HasBounds)
+      {
+      piece.Importance *=
+        this->ComputeViewImportance(camera, aspect, piece.Bounds);
+      double center[3];
+      for (int j = 0; j < 3; ++j)
+        {
+        center[j] = 0.5 * (piece.Bounds[2*j] + piece.Bounds[2*j+1]);
+        }
+      piece.Distance = vtkMath::Distance2BetweenPoints(
+        center, camera->GetPosition());
+      }
+    if (piece.Importance > 0.0)
+      {
+      order.push_back(i);
+      }
+    }
+
+  vtkPrioritizedStreamerInternals::MoreImportant compare;
+  compare.Pieces = &pieces;
+  std::stable_sort(order.begin(), order.end(), compare);
+
+  this->Internals->CameraMTime = camera ? camera->GetMTime() : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::RequestUpdateExtent(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *vtkNotUsed(outputVector))
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+
+  if (this->CurrentIndex == 0)
+    {
+    unsigned long inputMTime = 0;
+    vtkDemandDrivenPipeline *ddp = vtkDemandDrivenPipeline::SafeDownCast(
+      vtkExecutive::PRODUCER()->GetExecutive(inInfo));
+    if (ddp)
+      {
+      inputMTime = ddp->GetPipelineMTime();
+      }
+
+    vtkRenderer* renderer = this->Internals->Renderer;
+    vtkCamera* camera = renderer ? renderer->GetActiveCamera() : 0;
+    if (this->Internals->Pieces.size() !=
+        static_cast<size_t>(this->NumberOfPieces) ||
+        inputMTime != this->Internals->InputMTime)
+      {
+      // Start over.
+      this->ComputePieceInformation(inInfo);
+      this->Internals->InputMTime = inputMTime;
+      this->Internals->Result = vtkSmartPointer<vtkPolyData>::New();
+      this->Internals->LastPiece = -1;
+      this->Internals->NumberOfExecutedPieces = 0;
+      this->OrderPieces();
+      }
+    else if (camera && camera->GetMTime() != this->Internals->CameraMTime)
+      {
+      this->OrderPieces();
+      }
+
+    int numPasses = static_cast<int>(this->Internals->Order.size());
+    if (numPasses > this->PiecesPerUpdate)
+      {
+      numPasses = this->PiecesPerUpdate;
+      }
+    this->NumberOfPasses = numPasses > 0 ? numPasses : 1;
+    }
+
+  int piece = -1;
+  if (!this->Internals->Order.empty())
+    {
+    piece = this->Internals->Order[0];
+    }
+  this->Internals->CurrentPiece = piece;
+
+  // When nothing is left, request the last piece again, which the input
+  // still holds.
+  if (piece < 0)
+    {
+    piece = this->Internals->LastPiece >= 0 ? this->Internals->LastPiece : 0;
+    }
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    inInfo, piece, this->NumberOfPieces, 0);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::ExecutePass(vtkInformationVector **inputVector,
+                                        vtkInformationVector *vtkNotUsed(outputVector))
+{
+  int piece = this->Internals->CurrentPiece;
+  if (piece < 0)
+    {
+    return 1;
+    }
+
+  vtkPolyData *input = vtkPolyData::GetData(inputVector[0]);
+  this->Internals->Pieces[piece].Executed = 1;
+  this->Internals->Order.erase(this->Internals->Order.begin());
+  this->Internals->LastPiece = piece;
+  this->Internals->NumberOfExecutedPieces++;
+
+  if (input && input->GetNumberOfPoints() > 0 &&
+      this->Internals->Result->GetNumberOfPoints() == 0)
+    {
+    // Appending to an empty result would drop the arrays of the piece.
+    this->Internals->Result = vtkSmartPointer<vtkPolyData>::New();
+    this->Internals->Result->ShallowCopy(input);
+    }
+  else if (input && input->GetNumberOfPoints() > 0)
+    {
+    vtkPolyData *copy = vtkPolyData::New();
+    copy->ShallowCopy(input);
+    vtkAppendPolyData *append = vtkAppendPolyData::New();
+    append->AddInputData(this->Internals->Result);
+    append->AddInputData(copy);
+    append->Update();
+    this->Internals->Result = append->GetOutput();
+    append->Delete();
+    copy->Delete();
+    }
+
+  // Stop after this piece when asked to abort or when the camera moved.
+  // The remaining pieces are ordered again on the next update.
+  vtkRenderer* renderer = this->Internals->Renderer;
+  vtkCamera* camera = renderer ? renderer->GetActiveCamera() : 0;
+  if (this->GetAbortExecute() ||
+      (camera && camera->GetMTime() != this->Internals->CameraMTime))
+    {
+    this->NumberOfPasses = this->CurrentIndex + 1;
+    }
+
+  this->UpdateProgress(static_cast<double>(this->CurrentIndex + 1) /
+                       static_cast<double>(this->NumberOfPasses));
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPrioritizedStreamer::PostExecute(
+  vtkInformationVector **vtkNotUsed(inputVector),
+  vtkInformationVector *outputVector)
+{
+  vtkPolyData *output = vtkPolyData::GetData(outputVector);
+  if (this->Internals->Result)
+    {
+    output->ShallowCopy(this->Internals->Result);
+    }
+  else
+    {
+    output->Initialize();
+    }
+  return 1;
+}
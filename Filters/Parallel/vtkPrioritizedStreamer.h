@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPrioritizedStreamer.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPrioritizedStreamer - Streams poly data pieces by view importance.
+// .SECTION Description
+// vtkPrioritizedStreamer divides its input into NumberOfPieces pieces and
+// executes them progressively, PiecesPerUpdate pieces per update, in
+// order of importance. The output contains all pieces executed so far.
+//
+// Before streaming, the priority of every piece is computed with
+// vtkStreamingDemandDrivenPipeline::ComputePriority(). Pieces with a
+// priority of 0 (for example pieces rejected by vtkContourFilter from
+// their scalar range) are skipped. When a renderer is set, pieces whose
+// bounding box is outside of the view frustum of the active camera are
+// skipped too and the others are ordered by the area of their bounding
+// box on screen multiplied by their priority. The bounding box of a piece
+// is taken from the first PIECE_BOUNDING_BOX found upstream, or computed
+// from the update extent of structured data. This assumes that the
+// filters between this source of bounds and the streamer do not move
+// geometry outside of the piece (true for contouring, clipping, cutting
+// and thresholding).
+//
+// Call ContinueStreaming() and update (or render) again to execute the
+// next pieces until IsDone() returns 1. When the camera changes, the
+// remaining pieces are ordered again and pieces that entered the view
+// frustum are added. When the input changes, streaming restarts. Setting
+// AbortExecute during an update (for example from a progress observer
+// when the user starts interacting) stops after the current piece and
+// keeps the pieces executed so far.
+// .SECTION See Also
+// vtkStreamerBase vtkMemoryLimitStreamer vtkPolyDataStreamer
+
+#ifndef __vtkPrioritizedStreamer_h
+#define __vtkPrioritizedStreamer_h
+
+#include "vtkFiltersParallelModule.h" // For export macro
+#include "vtkStreamerBase.h"
+
+class vtkCamera;
+class vtkPolyData;
+class vtkPrioritizedStreamerInternals;
+class vtkRenderer;
+
+class VTKFILTERSPARALLEL_EXPORT vtkPrioritizedStreamer : public vtkStreamerBase
+{
+public:
+  static vtkPrioritizedStreamer *New();
+  vtkTypeMacro(vtkPrioritizedStreamer,vtkStreamerBase);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Set / Get the number of pieces the input is divided into.
+  // Default is 64.
+  vtkSetClampMacro(NumberOfPieces, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPieces, int);
+
+  // Description:
+  // Set / Get the number of pieces executed per update. Default is 1.
+  vtkSetClampMacro(PiecesPerUpdate, int, 1, VTK_INT_MAX);
+  vtkGetMacro(PiecesPerUpdate, int);
+
+  // Description:
+  // Set / Get the renderer whose active camera is used to cull and order
+  // pieces. When NULL, pieces are only culled by priority and executed in
+  // order of decreasing priority. The renderer is not reference counted
+  // since it usually renders the output of the streamer.
+  void SetRenderer(vtkRenderer* renderer);
+  vtkRenderer* GetRenderer();
+
+  // Description:
+  // Return the number of pieces that are neither executed nor culled.
+  int GetNumberOfPendingPieces();
+
+  // Description:
+  // Return the number of pieces executed since streaming started.
+  int GetNumberOfExecutedPieces();
+
+  // Description:
+  // Return 1 when all pieces that are not culled were executed.
+  int IsDone();
+
+  // Description:
+  // Mark the streamer modified if pieces are pending so that the next
+  // update executes them. Returns 1 if pieces are pending.
+  int ContinueStreaming();
+
+  // Description:
+  // The modification time includes the active camera of the renderer.
+  unsigned long GetMTime();
+
+  vtkPolyData* GetOutput();
+
+protected:
+  vtkPrioritizedStreamer();
+  ~vtkPrioritizedStreamer();
+
+  virtual int FillInputPortInformation(int port, vtkInformation* info);
+  virtual int FillOutputPortInformation(int port, vtkInformation* info);
+
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector**,
+                                  vtkInformationVector*);
+
+  virtual int ExecutePass(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+  virtual int PostExecute(vtkInformationVector **inputVector,
+                          vtkInformationVector *outputVector);
+
+  // Description:
+  // Compute the priority and the bounding box of every piece.
+  void ComputePieceInformation(vtkInformation* inInfo);
+
+  // Description:
+  // Compute the importance of every piece that was not executed yet from
+  // the camera and sort the pending pieces by decreasing importance.
+  void OrderPieces();
+
+  // Description:
+  // Return the view importance of a bounding box for the camera: 0 if it
+  // is outside of the view frustum, otherwise the fraction of the
+  // viewport it covers.
+  double ComputeViewImportance(vtkCamera* camera, double aspect,
+                               const double bounds[6]);
+
+  int NumberOfPieces;
+  int PiecesPerUpdate;
+
+private:
+  vtkPrioritizedStreamer(const vtkPrioritizedStreamer&);  // Not implemented.
+  void operator=(const vtkPrioritizedStreamer&);  // Not implemented.
+
+  vtkPrioritizedStreamerInternals* Internals;
+};
+
+#endif
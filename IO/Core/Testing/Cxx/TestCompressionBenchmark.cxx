@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressionBenchmark.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the data compressors restore the data they compress and
+// reports their speed and ratio on float fields, compressed in blocks of
+// the default size of vtkXMLWriter.
+
+#include "vtkLZ4DataCompressor.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkTimerLog.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+const size_t BlockSize = 32768;
+
+// Compress and uncompress the data block by block.  Returns false if the
+// data are not restored.
+bool Benchmark(vtkDataCompressor* compressor, const char* name,
+               const char* fieldName, std::vector<float>& field)
+{
+  unsigned char const* data =
+    reinterpret_cast<unsigned char const*>(&field[0]);
+  size_t size = field.size() * sizeof(float);
+  std::vector<unsigned char> compressed(
+    compressor->GetMaximumCompressionSpace(BlockSize));
+  std::vector<unsigned char> compressedData;
+  std::vector<size_t> compressedSizes;
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (size_t offset = 0; offset < size; offset += BlockSize)
+    {
+    size_t blockSize = size - offset < BlockSize ? size - offset : BlockSize;
+    size_t n = compressor->Compress(data + offset, blockSize,
+                                    &compressed[0], compressed.size());
+    if (n == 0)
+      {
+      cerr << name << " failed to compress " << fieldName << endl;
+      return false;
+      }
+    compressedData.insert(compressedData.end(),
+                          compressed.begin(), compressed.begin() + n);
+    compressedSizes.push_back(n);
+    }
+  timer->StopTimer();
+  double compressTime = timer->GetElapsedTime();
+
+  std::vector<unsigned char> uncompressed(size);
+  timer->StartTimer();
+  size_t compressedOffset = 0;
+  for (size_t i = 0; i < compressedSizes.size(); i++)
+    {
+    size_t offset = i * BlockSize;
+    size_t blockSize = size - offset < BlockSize ? size - offset : BlockSize;
+    if (compressor->Uncompress(&compressedData[compressedOffset],
+                               compressedSizes[i], &uncompressed[offset],
+                               blockSize) != blockSize)
+      {
+      cerr << name << " failed to uncompress " << fieldName << endl;
+      return false;
+      }
+    compressedOffset += compressedSizes[i];
+    }
+  timer->StopTimer();
+  double uncompressTime = timer->GetElapsedTime();
+
+  if (memcmp(&uncompressed[0], data, size) != 0)
+    {
+    cerr << name << " did not restore " << fieldName << endl;
+    return false;
+    }
+
+  double megabytes = size / 1048576.0;
+  cout << name << " on " << fieldName << ": ratio "
+       << static_cast<double>(size) / compressedData.size()
+       << ", compression " << megabytes / (compressTime + 1e-9)
+       << " MB/s, decompression " << megabytes / (uncompressTime + 1e-9)
+       << " MB/s" << endl;
+  return true;
+}
+}
+
+int TestCompressionBenchmark(int, char*[])
+{
+  // A smooth field, the same field with noise, and a field with constant
+  // regions, 64^3 values each.
+  const int n = 64;
+  std::vector<float> smooth(n * n * n);
+  std::vector<float> noisy(n * n * n);
+  std::vector<float> regions(n * n * n);
+  vtkMath::RandomSeed(1234);
+  for (int k = 0; k < n; k++)
+    {
+    for (int j = 0; j < n; j++)
+      {
+      for (int i = 0; i < n; i++)
+        {
+        size_t id = (static_cast<size_t>(k) * n + j) * n + i;
+        smooth[id] = static_cast<float>(sin(0.1 * i) * cos(0.2 * j) + 0.05 * k);
+        noisy[id] =
+          smooth[id] + static_cast<float>(vtkMath::Random(-0.01, 0.01));
+        regions[id] = static_cast<float>((i / 16 + j / 16 + k / 16) % 3);
+        }
+      }
+    }
+
+  vtkNew<vtkZLibDataCompressor> zlibFast;
+  zlibFast->SetCompressionLevel(1);
+  vtkNew<vtkZLibDataCompressor> zlib;
+  zlib->SetCompressionLevel(6);
+  vtkNew<vtkZLibDataCompressor> zlibBest;
+  zlibBest->SetCompressionLevel(9);
+  vtkNew<vtkLZ4DataCompressor> lz4Fast;
+  lz4Fast->SetCompressionLevel(1);
+  vtkNew<vtkLZ4DataCompressor> lz4;
+  vtkDataCompressor* compressors[] =
+    {
+    zlibFast.GetPointer(), zlib.GetPointer(), zlibBest.GetPointer(),
+    lz4Fast.GetPointer(), lz4.GetPointer()
+    };
+  const char* names[] =
+    {
+    "zlib 1", "zlib 6", "zlib 9", "lz4 1", "lz4 9"
+    };
+
+  bool result = true;
+  for (int c = 0; c < 5; c++)
+    {
+    result &= Benchmark(compressors[c], names[c], "smooth field", smooth);
+    result &= Benchmark(compressors[c], names[c], "noisy field", noisy);
+    result &= Benchmark(compressors[c], names[c], "constant regions", regions);
+    }
+
+  // Small and incompressible buffers are restored as well.
+  unsigned char bytes[1000];
+  for (int i = 0; i < 1000; i++)
+    {
+    bytes[i] = static_cast<unsigned char>(vtkMath::Random(0, 256));
+    }
+  for (size_t size = 1; size <= 1000; size += 37)
+    {
+    unsigned char compressed[1100];
+    unsigned char uncompressed[1000];
+    size_t compressedSize =
+      lz4->Compress(bytes, size, compressed, sizeof(compressed));
+    if (compressedSize == 0 ||
+        lz4->Uncompress(compressed, compressedSize, uncompressed, size) != size ||
+        memcmp(bytes, uncompressed, size) != 0)
+      {
+      cerr << "lz4 did not restore " << size << " random bytes" << endl;
+      result = false;
+      }
+    }
+
+  return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNumberParser.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkNumberParser converts numbers like the standard
+// library, rejects what is not a number, and gives the same values on
+// one and several threads.
+
+#include "vtkMath.h"
+#include "vtkNumberParser.h"
+#include "vtkNew.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/ios/sstream>
+
+#include <locale>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+bool ParseDouble(const char* text, double& value)
+{
+  const char* end = text + strlen(text);
+  return vtkNumberParser::Parse(text, end, value) == end;
+}
+
+bool ParseInt(const char* text, vtkTypeInt64& value)
+{
+  const char* end = text + strlen(text);
+  return vtkNumberParser::Parse(text, end, value) == end;
+}
+}
+
+int TestNumberParser(int, char*[])
+{
+  double d;
+  vtkTypeInt64 i;
+
+  // Valid numbers.
+  TEST_ASSERT(ParseDouble("  1.5", d) && d == 1.5, "1.5");
+  TEST_ASSERT(ParseDouble("-0.000125", d) && d == -0.000125, "-0.000125");
+  TEST_ASSERT(ParseDouble("+3e2", d) && d == 300, "+3e2");
+  TEST_ASSERT(ParseDouble("2.5E-3", d) && d == 2.5e-3, "2.5E-3");
+  TEST_ASSERT(ParseDouble(".5", d) && d == 0.5, ".5");
+  TEST_ASSERT(ParseDouble("7.", d) && d == 7, "7.");
+  TEST_ASSERT(ParseDouble("1e300", d) && d == 1e300, "1e300");
+  TEST_ASSERT(ParseDouble("4.9406564584124654e-324", d) && d > 0,
+              "denormal");
+  TEST_ASSERT(ParseDouble("12345678901234567890123", d) &&
+              d == 12345678901234567890123.0, "long integer as double");
+  TEST_ASSERT(ParseDouble("nan", d) && vtkMath::IsNan(d), "nan");
+  TEST_ASSERT(ParseDouble("-Infinity", d) && d == vtkMath::NegInf(),
+              "-Infinity");
+  TEST_ASSERT(ParseInt("-9223372036854775808", i) &&
+              static_cast<vtkTypeUInt64>(i) ==
+              static_cast<vtkTypeUInt64>(1) << 63,
+              "smallest 64-bit integer");
+  TEST_ASSERT(ParseInt(" +42", i) && i == 42, "+42");
+
+  // Not numbers.
+  const char* invalid[] = {"", "-", "e5", "1e", "1.5x", "1,5", "--1", "nanx"};
+  for (size_t k = 0; k < sizeof(invalid)/sizeof(invalid[0]); k++)
+    {
+    TEST_ASSERT(!ParseDouble(invalid[k], d),
+                "Expected \"" << invalid[k] << "\" to be rejected");
+    }
+  TEST_ASSERT(!ParseInt("1.5", i), "Expected 1.5 to be rejected as integer");
+  TEST_ASSERT(!ParseInt("9223372036854775808", i),
+              "Expected an integer overflow to be rejected");
+
+  // Random numbers round like the standard library.
+  vtkMath::RandomSeed(5678);
+  for (int k = 0; k < 100000; k++)
+    {
+    vtksys_ios::ostringstream os;
+    os.imbue(std::locale::classic());
+    os.precision(1 + k % 17);
+    double x = vtkMath::Random(-1, 1) * pow(10.0, vtkMath::Random(-30, 30));
+    os << x;
+    std::string text = os.str();
+    double expected = strtod(text.c_str(), 0);
+    TEST_ASSERT(ParseDouble(text.c_str(), d) && d == expected,
+                "Wrong value " << d << " for " << text);
+    }
+
+  // A large buffer gives the same values on one and several threads, and
+  // its values are counted as requested.
+  const size_t count = 2000000;
+  vtksys_ios::ostringstream os;
+  os.imbue(std::locale::classic());
+  os.precision(9);
+  std::vector<float> expected(count);
+  for (size_t k = 0; k < count; k++)
+    {
+    expected[k] = static_cast<float>(vtkMath::Random(-1000, 1000));
+    os << expected[k] << ((k % 3 == 2)? "\n" : " ");
+    }
+  std::string text = os.str();
+  const char* begin = text.c_str();
+  const char* end = begin + text.size();
+
+  vtkNew<vtkTimerLog> timer;
+  std::vector<float> serial(count);
+  std::vector<float> threaded(count);
+  const char* serialStop;
+  const char* threadedStop;
+  timer->StartTimer();
+  size_t n = vtkNumberParser::ParseValues(begin, end, &serial[0], count,
+                                          &serialStop, 1);
+  timer->StopTimer();
+  double serialTime = timer->GetElapsedTime();
+  TEST_ASSERT(n == count && serial == expected,
+              "Wrong values parsed on one thread");
+  timer->StartTimer();
+  n = vtkNumberParser::ParseValues(begin, end, &threaded[0], count,
+                                   &threadedStop, 4);
+  timer->StopTimer();
+  cout << "Parsed " << text.size() / 1048576.0 << " MB in " << serialTime
+       << " s on one thread and " << timer->GetElapsedTime()
+       << " s on 4 threads" << endl;
+  TEST_ASSERT(n == count && threaded == serial && threadedStop == serialStop,
+              "Wrong values parsed on 4 threads");
+
+  // Fewer values than available stop after the last of them, and a bad
+  // token stops the parsing on it.
+  n = vtkNumberParser::ParseValues(begin, end, &threaded[0], count - 7,
+                                   &threadedStop, 4);
+  vtkNumberParser::ParseValues(begin, end, &serial[0], count - 7,
+                               &serialStop, 1);
+  TEST_ASSERT(n == count - 7 && threadedStop == serialStop,
+              "Wrong stop for fewer values on 4 threads");
+  text[text.size() / 2] = 'x';
+  begin = text.c_str();
+  end = begin + text.size();
+  n = vtkNumberParser::ParseValues(begin, end, &threaded[0], count,
+                                   &threadedStop, 4);
+  size_t m = vtkNumberParser::ParseValues(begin, end, &serial[0], count,
+                                          &serialStop, 1);
+  TEST_ASSERT(n < count && n == m && threadedStop - begin == serialStop - begin,
+              "Wrong stop on a bad token on 4 threads");
+
+  return EXIT_SUCCESS;
+}
@@ -13,8 +13,90 @@
 
 =========================================================================*/
 #include "vtkDataCompressor.h"
+#include "vtkMultiThreader.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 
+//----------------------------------------------------------------------------
+// Blocks shared by the threads of CompressBlocks() and UncompressBlocks().
+// Thread i processes the blocks i, i+n, i+2n, ... where n is the number
+// of threads.
+class vtkDataCompressorBlocks
+{
+public:
+  vtkDataCompressor* Compressor;
+  int Compress;
+  size_t Count;
+  unsigned char const* const* Input;
+  size_t const* InputSizes;
+  unsigned char* const* Output;
+  size_t const* OutputSizes;
+  // The size produced for each block, 0 on error.
+  size_t* Results;
+
+  void Execute(int threadId, int numberOfThreads)
+    {
+    for(size_t i = threadId; i < this->Count; i += numberOfThreads)
+      {
+      if(this->Compress)
+        {
+        this->Results[i] =
+          this->Compressor->Compress(this->Input[i], this->InputSizes[i],
+                                     this->Output[i], this->OutputSizes[i]);
+        }
+      else
+        {
+        this->Results[i] =
+          this->Compressor->Uncompress(this->Input[i], this->InputSizes[i],
+                                       this->Output[i], this->OutputSizes[i]);
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkDataCompressorThreadedExecute(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkDataCompressorBlocks* blocks =
+    static_cast<vtkDataCompressorBlocks*>(info->UserData);
+  blocks->Execute(info->ThreadID, info->NumberOfThreads);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// Process the blocks on up to numberOfThreads threads.  Returns 1 if
+// all blocks were processed.
+static int vtkDataCompressorExecute(vtkDataCompressorBlocks* blocks,
+                                    int numberOfThreads)
+{
+  if(numberOfThreads > static_cast<int>(blocks->Count))
+    {
+    numberOfThreads = static_cast<int>(blocks->Count);
+    }
+  if(numberOfThreads > 1)
+    {
+    vtkSmartPointer<vtkMultiThreader> threader =
+      vtkSmartPointer<vtkMultiThreader>::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(vtkDataCompressorThreadedExecute, blocks);
+    threader->SingleMethodExecute();
+    }
+  else
+    {
+    blocks->Execute(0, 1);
+    }
+  for(size_t i = 0; i < blocks->Count; ++i)
+    {
+    if(!blocks->Results[i])
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 
 //----------------------------------------------------------------------------
 vtkDataCompressor::vtkDataCompressor()
@@ -116,3 +198,80 @@ vtkDataCompressor::Uncompress(unsigned char const* compressedData,
 
   return outputArray;
 }
+
+//----------------------------------------------------------------------------
+int vtkDataCompressor::CompressBlocks(size_t count,
+                                      unsigned char const* const* uncompressedData,
+                                      size_t const* uncompressedSizes,
+                                      vtkUnsignedCharArray** compressedArrays,
+                                      int numberOfThreads)
+{
+  // Allocate the output arrays here, the threads only compress.
+  unsigned char** compressedData = new unsigned char*[count];
+  size_t* compressionSpaces = new size_t[count];
+  size_t* compressedSizes = new size_t[count];
+  for(size_t i = 0; i < count; ++i)
+    {
+    compressionSpaces[i] =
+      this->GetMaximumCompressionSpace(uncompressedSizes[i]);
+    compressedArrays[i] = vtkUnsignedCharArray::New();
+    compressedArrays[i]->SetNumberOfComponents(1);
+    compressedArrays[i]->SetNumberOfTuples(compressionSpaces[i]);
+    compressedData[i] = compressedArrays[i]->GetPointer(0);
+    }
+
+  vtkDataCompressorBlocks blocks;
+  blocks.Compressor = this;
+  blocks.Compress = 1;
+  blocks.Count = count;
+  blocks.Input = uncompressedData;
+  blocks.InputSizes = uncompressedSizes;
+  blocks.Output = compressedData;
+  blocks.OutputSizes = compressionSpaces;
+  blocks.Results = compressedSizes;
+  int result = vtkDataCompressorExecute(&blocks, numberOfThreads);
+
+  // Store the actual sizes.
+  for(size_t i = 0; i < count; ++i)
+    {
+    if(result)
+      {
+      compressedArrays[i]->SetNumberOfTuples(compressedSizes[i]);
+      }
+    else
+      {
+      compressedArrays[i]->Delete();
+      compressedArrays[i] = 0;
+      }
+    }
+
+  delete [] compressedData;
+  delete [] compressionSpaces;
+  delete [] compressedSizes;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataCompressor::UncompressBlocks(size_t count,
+                                        unsigned char const* const* compressedData,
+                                        size_t const* compressedSizes,
+                                        unsigned char* const* uncompressedData,
+                                        size_t const* uncompressedSizes,
+                                        int numberOfThreads)
+{
+  size_t* decompressedSizes = new size_t[count];
+
+  vtkDataCompressorBlocks blocks;
+  blocks.Compressor = this;
+  blocks.Compress = 0;
+  blocks.Count = count;
+  blocks.Input = compressedData;
+  blocks.InputSizes = compressedSizes;
+  blocks.Output = uncompressedData;
+  blocks.OutputSizes = uncompressedSizes;
+  blocks.Results = decompressedSizes;
+  int result = vtkDataCompressorExecute(&blocks, numberOfThreads);
+
+  delete [] decompressedSizes;
+  return result;
+}
@@ -75,12 +75,39 @@ public:
   vtkUnsignedCharArray* Uncompress(unsigned char const* compressedData,
                                    size_t compressedSize,
                                    size_t uncompressedSize);
+
+  // Description:
+  // Compress count independent buffers using up to numberOfThreads
+  // threads.  The compressed data of buffer i is returned in a new
+  // vtkUnsignedCharArray stored in compressedArrays[i] that the caller
+  // must delete.  Each buffer is compressed as by Compress() so the
+  // result does not depend on the number of threads.  Returns 1 on
+  // success, 0 if a buffer could not be compressed, in which case no
+  // array is returned.
+  int CompressBlocks(size_t count,
+                     unsigned char const* const* uncompressedData,
+                     size_t const* uncompressedSizes,
+                     vtkUnsignedCharArray** compressedArrays,
+                     int numberOfThreads);
+
+  // Description:
+  // Uncompress count independent buffers into the given output buffers
+  // using up to numberOfThreads threads.  Returns 1 on success, 0 if a
+  // buffer could not be uncompressed.
+  int UncompressBlocks(size_t count,
+                       unsigned char const* const* compressedData,
+                       size_t const* compressedSizes,
+                       unsigned char* const* uncompressedData,
+                       size_t const* uncompressedSizes,
+                       int numberOfThreads);
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor();
 
   // Actual compression method.  This must be provided by a subclass.
   // Must return the size of the compressed data, or zero on error.
+  // CompressBlocks() and UncompressBlocks() call these methods
+  // concurrently so they must not modify the compressor.
   virtual size_t CompressBuffer(unsigned char const* uncompressedData,
                                 size_t uncompressedSize,
                                 unsigned char* compressedData,
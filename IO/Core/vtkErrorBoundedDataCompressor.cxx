@@ -0,0 +1,438 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkErrorBoundedDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkErrorBoundedDataCompressor.h"
+#include "vtkByteSwap.h"
+#include "vtkObjectFactory.h"
+#include "vtk_zlib.h"
+
+#include <math.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkErrorBoundedDataCompressor);
+
+class vtkErrorBoundedDataCompressorInternals
+{
+public:
+  std::map<std::string, double> ArrayTolerances;
+};
+
+// A compressed block starts with its mode.  Lossless blocks continue
+// with the zlib compressed data.  Lossy blocks continue with the byte
+// order of the values (0 little endian, 1 big endian), the number of
+// components (4 bytes) and the tolerance (8 bytes), both little endian,
+// then the zlib compressed codes of the values.  The code of a value is
+// the zigzag encoded difference between its quantized value and the one
+// of the previous tuple, plus 1, as a variable length integer of 7 bits
+// per byte.  A code of 0 is followed by the exact value.
+namespace
+{
+enum
+{
+  vtkErrorBoundedLossless = 0,
+  vtkErrorBoundedFloat = 1,
+  vtkErrorBoundedDouble = 2
+};
+const size_t vtkErrorBoundedHeaderSize = 14;
+// Quantized values must be exact integers in a double.
+const double vtkErrorBoundedMaxQuantized = 4503599627370496.0; // 2^52
+
+inline size_t vtkErrorBoundedZLibSpace(size_t size)
+{
+  return size + (size+999)/1000 + 12;
+}
+
+// Return the value a quantized value is restored to.
+template <class T>
+inline T vtkErrorBoundedRestore(vtkTypeInt64 q, double step)
+{
+  return static_cast<T>(static_cast<double>(q) * step);
+}
+
+// Write the codes of the values.  Returns the size of the codes.
+template <class T>
+size_t vtkErrorBoundedEncode(T const* values, size_t n, size_t numComponents,
+                             double tolerance, unsigned char* codes)
+{
+  double step = 2.0 * tolerance;
+  std::vector<vtkTypeInt64> quantized(n);
+  unsigned char* op = codes;
+  for(size_t i = 0; i < n; ++i)
+    {
+    T v = values[i];
+    double scaled = static_cast<double>(v) / step;
+    quantized[i] = 0;
+    if(scaled > -vtkErrorBoundedMaxQuantized &&
+       scaled < vtkErrorBoundedMaxQuantized)
+      {
+      vtkTypeInt64 q = static_cast<vtkTypeInt64>(floor(scaled + 0.5));
+      double error = static_cast<double>(vtkErrorBoundedRestore<T>(q, step)) -
+        static_cast<double>(v);
+      vtkTypeInt64 prediction = i >= numComponents ?
+        quantized[i - numComponents] : 0;
+      vtkTypeInt64 delta = q - prediction;
+      vtkTypeUInt64 code = ((static_cast<vtkTypeUInt64>(delta) << 1) ^
+                            static_cast<vtkTypeUInt64>(delta >> 63)) + 1;
+      // Codes longer than the value are not worth it.
+      if(fabs(error) <= tolerance && code < (vtkTypeUInt64(1) << (7*sizeof(T))))
+        {
+        quantized[i] = q;
+        for(; code >= 128; code >>= 7)
+          {
+          *op++ = static_cast<unsigned char>(code | 128);
+          }
+        *op++ = static_cast<unsigned char>(code);
+        continue;
+        }
+      }
+    *op++ = 0;
+    memcpy(op, &v, sizeof(T));
+    op += sizeof(T);
+    }
+  return static_cast<size_t>(op - codes);
+}
+
+// Restore the values from their codes.  Returns false if the codes are
+// invalid.
+template <class T>
+bool vtkErrorBoundedDecode(unsigned char const* ip, unsigned char const* end,
+                           size_t n, size_t numComponents, double tolerance,
+                           bool swap, unsigned char* output)
+{
+  double step = 2.0 * tolerance;
+  std::vector<vtkTypeInt64> quantized(n);
+  for(size_t i = 0; i < n; ++i, output += sizeof(T))
+    {
+    if(ip >= end)
+      {
+      return false;
+      }
+    if(*ip == 0)
+      {
+      // The exact value, in the byte order of the file.
+      ++ip;
+      if(static_cast<size_t>(end - ip) < sizeof(T))
+        {
+        return false;
+        }
+      memcpy(output, ip, sizeof(T));
+      ip += sizeof(T);
+      quantized[i] = 0;
+      continue;
+      }
+    vtkTypeUInt64 code = 0;
+    int shift = 0;
+    unsigned char b;
+    do
+      {
+      if(ip >= end || shift > 63)
+        {
+        return false;
+        }
+      b = *ip++;
+      code |= static_cast<vtkTypeUInt64>(b & 127) << shift;
+      shift += 7;
+      }
+    while(b & 128);
+    code -= 1;
+    vtkTypeInt64 delta = static_cast<vtkTypeInt64>(code >> 1) ^
+      -static_cast<vtkTypeInt64>(code & 1);
+    vtkTypeInt64 prediction = i >= numComponents ?
+      quantized[i - numComponents] : 0;
+    quantized[i] = prediction + delta;
+    T v = vtkErrorBoundedRestore<T>(quantized[i], step);
+    if(swap)
+      {
+      vtkByteSwap::SwapVoidRange(&v, 1, sizeof(T));
+      }
+    memcpy(output, &v, sizeof(T));
+    }
+  return ip == end;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkErrorBoundedDataCompressor::vtkErrorBoundedDataCompressor()
+{
+  this->CompressionLevel = 6;
+  this->Tolerance = 0.0;
+  this->CurrentDataType = VTK_VOID;
+  this->CurrentNumberOfComponents = 1;
+  this->CurrentTolerance = 0.0;
+  this->Internals = new vtkErrorBoundedDataCompressorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkErrorBoundedDataCompressor::~vtkErrorBoundedDataCompressor()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkErrorBoundedDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "Tolerance: " << this->Tolerance << endl;
+  std::map<std::string, double>::const_iterator it;
+  for(it = this->Internals->ArrayTolerances.begin();
+      it != this->Internals->ArrayTolerances.end(); ++it)
+    {
+    os << indent << "ArrayTolerance " << it->first << ": " << it->second
+       << endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkErrorBoundedDataCompressor::SetArrayTolerance(const char* name,
+                                                      double tolerance)
+{
+  if(!name)
+    {
+    return;
+    }
+  if(tolerance < 0.0)
+    {
+    tolerance = 0.0;
+    }
+  std::map<std::string, double>::iterator it =
+    this->Internals->ArrayTolerances.find(name);
+  if(it == this->Internals->ArrayTolerances.end() || it->second != tolerance)
+    {
+    this->Internals->ArrayTolerances[name] = tolerance;
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+double vtkErrorBoundedDataCompressor::GetArrayTolerance(const char* name)
+{
+  if(name)
+    {
+    std::map<std::string, double>::const_iterator it =
+      this->Internals->ArrayTolerances.find(name);
+    if(it != this->Internals->ArrayTolerances.end())
+      {
+      return it->second;
+      }
+    }
+  return this->Tolerance;
+}
+
+//----------------------------------------------------------------------------
+void vtkErrorBoundedDataCompressor::RemoveAllArrayTolerances()
+{
+  if(!this->Internals->ArrayTolerances.empty())
+    {
+    this->Internals->ArrayTolerances.clear();
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkErrorBoundedDataCompressor::SetCurrentArray(int dataType,
+                                                    int numberOfComponents,
+                                                    double tolerance)
+{
+  this->CurrentDataType = dataType;
+  this->CurrentNumberOfComponents =
+    numberOfComponents > 0 ? numberOfComponents : 1;
+  this->CurrentTolerance = tolerance > 0.0 ? tolerance : 0.0;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkErrorBoundedDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+                                              size_t uncompressedSize,
+                                              unsigned char* compressedData,
+                                              size_t compressionSpace)
+{
+  if(compressionSpace < vtkErrorBoundedHeaderSize)
+    {
+    vtkErrorMacro("Compression buffer is too small.");
+    return 0;
+    }
+
+  // Find how to compress the values.
+  int mode = vtkErrorBoundedLossless;
+  size_t wordSize = 1;
+  if(this->CurrentTolerance > 0.0 && this->CurrentDataType == VTK_FLOAT)
+    {
+    mode = vtkErrorBoundedFloat;
+    wordSize = sizeof(float);
+    }
+  else if(this->CurrentTolerance > 0.0 && this->CurrentDataType == VTK_DOUBLE)
+    {
+    mode = vtkErrorBoundedDouble;
+    wordSize = sizeof(double);
+    }
+  if(uncompressedSize == 0 || uncompressedSize % wordSize)
+    {
+    mode = vtkErrorBoundedLossless;
+    }
+
+  // Write the header and find the data to pass to zlib.
+  unsigned char* op = compressedData;
+  *op++ = static_cast<unsigned char>(mode);
+  unsigned char const* data = uncompressedData;
+  size_t dataSize = uncompressedSize;
+  std::vector<unsigned char> codes;
+  if(mode != vtkErrorBoundedLossless)
+    {
+#ifdef VTK_WORDS_BIGENDIAN
+    *op++ = 1;
+#else
+    *op++ = 0;
+#endif
+    vtkTypeUInt32 numComponents =
+      static_cast<vtkTypeUInt32>(this->CurrentNumberOfComponents);
+    vtkByteSwap::Swap4LE(&numComponents);
+    memcpy(op, &numComponents, 4);
+    op += 4;
+    double tolerance = this->CurrentTolerance;
+    vtkByteSwap::Swap8LE(&tolerance);
+    memcpy(op, &tolerance, 8);
+    op += 8;
+
+    size_t n = uncompressedSize / wordSize;
+    codes.resize(n * (wordSize + 1) + 1);
+    if(mode == vtkErrorBoundedFloat)
+      {
+      dataSize = vtkErrorBoundedEncode(
+        reinterpret_cast<float const*>(uncompressedData), n,
+        this->CurrentNumberOfComponents, this->CurrentTolerance, &codes[0]);
+      }
+    else
+      {
+      dataSize = vtkErrorBoundedEncode(
+        reinterpret_cast<double const*>(uncompressedData), n,
+        this->CurrentNumberOfComponents, this->CurrentTolerance, &codes[0]);
+      }
+    data = &codes[0];
+    }
+
+  uLongf cs = static_cast<uLongf>(compressionSpace - (op - compressedData));
+  if(compress2(reinterpret_cast<Bytef*>(op), &cs,
+               reinterpret_cast<const Bytef*>(data),
+               static_cast<uLong>(dataSize), this->CompressionLevel) != Z_OK)
+    {
+    vtkErrorMacro("Zlib error while compressing data.");
+    return 0;
+    }
+  return static_cast<size_t>(op - compressedData) + static_cast<size_t>(cs);
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkErrorBoundedDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+                                                size_t compressedSize,
+                                                unsigned char* uncompressedData,
+                                                size_t uncompressedSize)
+{
+  if(compressedSize < 1)
+    {
+    vtkErrorMacro("Compressed data are empty.");
+    return 0;
+    }
+  int mode = compressedData[0];
+  if(mode == vtkErrorBoundedLossless)
+    {
+    uLongf us = static_cast<uLongf>(uncompressedSize);
+    if(uncompress(reinterpret_cast<Bytef*>(uncompressedData), &us,
+                  reinterpret_cast<const Bytef*>(compressedData + 1),
+                  static_cast<uLong>(compressedSize - 1)) != Z_OK ||
+       us != static_cast<uLongf>(uncompressedSize))
+      {
+      vtkErrorMacro("Zlib error while uncompressing data.");
+      return 0;
+      }
+    return uncompressedSize;
+    }
+
+  size_t wordSize = mode == vtkErrorBoundedFloat ? sizeof(float) :
+    sizeof(double);
+  if((mode != vtkErrorBoundedFloat && mode != vtkErrorBoundedDouble) ||
+     compressedSize < vtkErrorBoundedHeaderSize ||
+     uncompressedSize == 0 || uncompressedSize % wordSize)
+    {
+    vtkErrorMacro("Invalid compressed data.");
+    return 0;
+    }
+
+  // Read the header.
+#ifdef VTK_WORDS_BIGENDIAN
+  bool swap = compressedData[1] != 1;
+#else
+  bool swap = compressedData[1] != 0;
+#endif
+  vtkTypeUInt32 numComponents;
+  memcpy(&numComponents, compressedData + 2, 4);
+  vtkByteSwap::Swap4LE(&numComponents);
+  double tolerance;
+  memcpy(&tolerance, compressedData + 6, 8);
+  vtkByteSwap::Swap8LE(&tolerance);
+  if(numComponents == 0 || !(tolerance > 0.0))
+    {
+    vtkErrorMacro("Invalid compressed data.");
+    return 0;
+    }
+
+  // Uncompress the codes.
+  size_t n = uncompressedSize / wordSize;
+  std::vector<unsigned char> codes(n * (wordSize + 1) + 1);
+  uLongf cs = static_cast<uLongf>(codes.size());
+  if(uncompress(reinterpret_cast<Bytef*>(&codes[0]), &cs,
+                reinterpret_cast<const Bytef*>(
+                  compressedData + vtkErrorBoundedHeaderSize),
+                static_cast<uLong>(compressedSize - vtkErrorBoundedHeaderSize))
+     != Z_OK)
+    {
+    vtkErrorMacro("Zlib error while uncompressing data.");
+    return 0;
+    }
+
+  // Restore the values.
+  bool result;
+  if(mode == vtkErrorBoundedFloat)
+    {
+    result = vtkErrorBoundedDecode<float>(&codes[0], &codes[0] + cs, n,
+                                          numComponents, tolerance, swap,
+                                          uncompressedData);
+    }
+  else
+    {
+    result = vtkErrorBoundedDecode<double>(&codes[0], &codes[0] + cs, n,
+                                           numComponents, tolerance, swap,
+                                           uncompressedData);
+    }
+  if(!result)
+    {
+    vtkErrorMacro("Invalid compressed values.");
+    return 0;
+    }
+  return uncompressedSize;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkErrorBoundedDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  // The codes of float values take at most 5 bytes per value.
+  return vtkErrorBoundedHeaderSize +
+    vtkErrorBoundedZLibSpace(size + size/4 + 1);
+}
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkErrorBoundedDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkErrorBoundedDataCompressor - Lossy compression of floating point data with a bounded error.
+// .SECTION Description
+// vtkErrorBoundedDataCompressor compresses float and double values with
+// an absolute error no larger than a tolerance.  The values are quantized
+// to multiples of twice the tolerance, each quantized value is predicted
+// from the value of the same component in the previous tuple, and the
+// prediction residuals are entropy coded with zlib.  Values that cannot
+// be quantized within the tolerance (infinite, NaN or huge values) are
+// stored exactly.  Smooth fields compress several times better than
+// with vtkZLibDataCompressor.
+//
+// The compressed blocks describe themselves, so they are uncompressed
+// without knowing the type, number of components or tolerance of the
+// values.  Data of other types, or compressed with a tolerance of 0, are
+// compressed without loss.
+//
+// The tolerance is set for all arrays with SetTolerance() and for
+// particular arrays with SetArrayTolerance().  The user of the compressor
+// calls SetCurrentArray() before compressing the values of an array.
+// vtkXMLWriter does so and records the tolerance of each array in the
+// file:
+// \code
+// vtkErrorBoundedDataCompressor* compressor =
+//   vtkErrorBoundedDataCompressor::New();
+// compressor->SetArrayTolerance("Temperature", 0.01);
+// writer->SetCompressor(compressor);
+// \endcode
+// .SECTION See Also
+// vtkZLibDataCompressor vtkXMLWriter
+
+#ifndef __vtkErrorBoundedDataCompressor_h
+#define __vtkErrorBoundedDataCompressor_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkDataCompressor.h"
+
+class vtkErrorBoundedDataCompressorInternals;
+
+class VTKIOCORE_EXPORT vtkErrorBoundedDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkErrorBoundedDataCompressor,vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent);
+  static vtkErrorBoundedDataCompressor* New();
+
+  // Description:
+  // Get the maximum space that may be needed to store data of the
+  // given uncompressed size after compression.  This is the minimum
+  // size of the output buffer that can be passed to the four-argument
+  // Compress method.
+  size_t GetMaximumCompressionSpace(size_t size);
+
+  // Description:
+  // Get/Set the zlib compression level of the prediction residuals.
+  // Default is 6.
+  vtkSetClampMacro(CompressionLevel, int, 0, 9);
+  vtkGetMacro(CompressionLevel, int);
+
+  // Description:
+  // Get/Set the absolute error allowed for the arrays without a
+  // tolerance of their own.  Default is 0: no loss.
+  vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(Tolerance, double);
+
+  // Description:
+  // Set the absolute error allowed for the array of the given name.
+  void SetArrayTolerance(const char* name, double tolerance);
+
+  // Description:
+  // Return the tolerance of the array of the given name, or the
+  // default tolerance if the array has none.
+  double GetArrayTolerance(const char* name);
+
+  // Description:
+  // Remove the tolerances of all arrays.
+  void RemoveAllArrayTolerances();
+
+  // Description:
+  // Set the type, number of components and tolerance of the values
+  // compressed by the following calls.  The values must be in the byte
+  // order of this machine.  Values of another type than VTK_FLOAT and
+  // VTK_DOUBLE, or with a tolerance of 0, are compressed without loss.
+  // This is the default.
+  void SetCurrentArray(int dataType, int numberOfComponents,
+                       double tolerance);
+
+protected:
+  vtkErrorBoundedDataCompressor();
+  ~vtkErrorBoundedDataCompressor();
+
+  int CompressionLevel;
+  double Tolerance;
+
+  int CurrentDataType;
+  int CurrentNumberOfComponents;
+  double CurrentTolerance;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData,
+                        size_t uncompressedSize,
+                        unsigned char* compressedData,
+                        size_t compressionSpace);
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData,
+                          size_t compressedSize,
+                          unsigned char* uncompressedData,
+                          size_t uncompressedSize);
+private:
+  vtkErrorBoundedDataCompressor(const vtkErrorBoundedDataCompressor&);  // Not implemented.
+  void operator=(const vtkErrorBoundedDataCompressor&);  // Not implemented.
+
+  vtkErrorBoundedDataCompressorInternals* Internals;
+};
+
+#endif
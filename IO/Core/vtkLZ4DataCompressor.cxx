@@ -0,0 +1,310 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLZ4DataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtkType.h"
+
+#include <string.h>
+
+vtkStandardNewMacro(vtkLZ4DataCompressor);
+
+// The LZ4 block format is a sequence of (literals, match) pairs.  Each
+// sequence starts with a token holding the number of literals in its
+// high 4 bits and the match length minus 4 in its low 4 bits.  A value
+// of 15 is followed by bytes adding to it until one is not 255.  The
+// literals follow, then the 2 bytes little endian offset of the match.
+// The last sequence has no match.  The last 5 bytes of the block are
+// always literals and the last match starts at least 12 bytes before the
+// end of the block.
+namespace
+{
+const size_t vtkLZ4MinMatch = 4;
+const size_t vtkLZ4LastLiterals = 5;
+const size_t vtkLZ4MatchFindLimit = 12;
+const size_t vtkLZ4MaxOffset = 65535;
+const int vtkLZ4HashLog = 12;
+// Number of failed searches after which the search step grows.
+const int vtkLZ4SkipTrigger = 6;
+
+inline vtkTypeUInt32 vtkLZ4Read32(unsigned char const* p)
+{
+  vtkTypeUInt32 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline unsigned int vtkLZ4Hash(unsigned char const* p)
+{
+  return (vtkLZ4Read32(p) * 2654435761U) >> (32 - vtkLZ4HashLog);
+}
+
+// Write the bytes following a token field of 15 or more.
+inline unsigned char* vtkLZ4WriteLength(unsigned char* op, size_t length)
+{
+  for(; length >= 255; length -= 255)
+    {
+    *op++ = 255;
+    }
+  *op++ = static_cast<unsigned char>(length);
+  return op;
+}
+
+// Write the token and literals of a sequence.  Returns the position of
+// the token.
+inline unsigned char* vtkLZ4WriteLiterals(unsigned char*& op,
+                                          unsigned char const* literals,
+                                          size_t length)
+{
+  unsigned char* token = op++;
+  if(length >= 15)
+    {
+    *token = 15 << 4;
+    op = vtkLZ4WriteLength(op, length - 15);
+    }
+  else
+    {
+    *token = static_cast<unsigned char>(length << 4);
+    }
+  memcpy(op, literals, length);
+  op += length;
+  return token;
+}
+
+// Read the bytes following a token field of 15.  Returns false past the end
+// of the input.
+inline bool vtkLZ4ReadLength(unsigned char const*& ip,
+                             unsigned char const* end, size_t& length)
+{
+  unsigned char b;
+  do
+    {
+    if(ip >= end)
+      {
+      return false;
+      }
+    b = *ip++;
+    length += b;
+    }
+  while(b == 255);
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::vtkLZ4DataCompressor()
+{
+  this->CompressionLevel = 9;
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DataCompressor::~vtkLZ4DataCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+                                     size_t uncompressedSize,
+                                     unsigned char* compressedData,
+                                     size_t compressionSpace)
+{
+  if(compressionSpace < this->GetMaximumCompressionSpace(uncompressedSize))
+    {
+    vtkErrorMacro("LZ4 compression buffer is too small.");
+    return 0;
+    }
+
+  unsigned char const* in = uncompressedData;
+  unsigned char const* anchor = in;
+  unsigned char* op = compressedData;
+
+  // Blocks too small for a match are stored as literals.
+  if(uncompressedSize > vtkLZ4MatchFindLimit)
+    {
+    unsigned char const* const matchFindLimit =
+      in + uncompressedSize - vtkLZ4MatchFindLimit;
+    unsigned char const* const matchLimit =
+      in + uncompressedSize - vtkLZ4LastLiterals;
+
+    // Last position of each hashed 4 bytes sequence.
+    size_t table[1 << vtkLZ4HashLog];
+    memset(table, 0, sizeof(table));
+
+    // Lower levels give up sooner on incompressible data.
+    int acceleration = 10 - this->CompressionLevel;
+
+    unsigned char const* ip = in + 1;
+    while(ip <= matchFindLimit)
+      {
+      // Find a match.
+      unsigned char const* ref = 0;
+      int searches = acceleration << vtkLZ4SkipTrigger;
+      for(; ip <= matchFindLimit; ip += searches++ >> vtkLZ4SkipTrigger)
+        {
+        unsigned int h = vtkLZ4Hash(ip);
+        ref = in + table[h];
+        table[h] = static_cast<size_t>(ip - in);
+        if(ref < ip && static_cast<size_t>(ip - ref) <= vtkLZ4MaxOffset &&
+           vtkLZ4Read32(ref) == vtkLZ4Read32(ip))
+          {
+          break;
+          }
+        }
+      if(ip > matchFindLimit)
+        {
+        break;
+        }
+
+      // Extend the match backward over the pending literals.
+      while(ip > anchor && ref > in && ip[-1] == ref[-1])
+        {
+        --ip;
+        --ref;
+        }
+
+      // Write the literals and the offset.
+      unsigned char* token =
+        vtkLZ4WriteLiterals(op, anchor, static_cast<size_t>(ip - anchor));
+      size_t offset = static_cast<size_t>(ip - ref);
+      *op++ = static_cast<unsigned char>(offset & 0xff);
+      *op++ = static_cast<unsigned char>(offset >> 8);
+
+      // Extend the match forward and write its length.
+      ip += vtkLZ4MinMatch;
+      ref += vtkLZ4MinMatch;
+      unsigned char const* matchStart = ip;
+      while(ip < matchLimit && *ip == *ref)
+        {
+        ++ip;
+        ++ref;
+        }
+      size_t length = static_cast<size_t>(ip - matchStart);
+      if(length >= 15)
+        {
+        *token |= 15;
+        op = vtkLZ4WriteLength(op, length - 15);
+        }
+      else
+        {
+        *token |= static_cast<unsigned char>(length);
+        }
+      anchor = ip;
+
+      if(ip <= matchFindLimit)
+        {
+        table[vtkLZ4Hash(ip - 2)] = static_cast<size_t>(ip - 2 - in);
+        }
+      }
+    }
+
+  // Write the remaining bytes as literals.
+  vtkLZ4WriteLiterals(op, anchor,
+                      static_cast<size_t>(in + uncompressedSize - anchor));
+  return static_cast<size_t>(op - compressedData);
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::UncompressBuffer(unsigned char const* compressedData,
+                                       size_t compressedSize,
+                                       unsigned char* uncompressedData,
+                                       size_t uncompressedSize)
+{
+  unsigned char const* ip = compressedData;
+  unsigned char const* const end = compressedData + compressedSize;
+  unsigned char* op = uncompressedData;
+  unsigned char* const outEnd = uncompressedData + uncompressedSize;
+
+  while(ip < end)
+    {
+    // Copy the literals.
+    unsigned char token = *ip++;
+    size_t length = token >> 4;
+    if(length == 15 && !vtkLZ4ReadLength(ip, end, length))
+      {
+      break;
+      }
+    if(length > static_cast<size_t>(end - ip) ||
+       length > static_cast<size_t>(outEnd - op))
+      {
+      break;
+      }
+    memcpy(op, ip, length);
+    ip += length;
+    op += length;
+
+    // The last sequence has no match.
+    if(ip == end)
+      {
+      if(op != outEnd)
+        {
+        break;
+        }
+      return uncompressedSize;
+      }
+
+    // Copy the match.
+    if(end - ip < 2)
+      {
+      break;
+      }
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    length = token & 15;
+    if(length == 15 && !vtkLZ4ReadLength(ip, end, length))
+      {
+      break;
+      }
+    length += vtkLZ4MinMatch;
+    if(offset == 0 || offset > static_cast<size_t>(op - uncompressedData) ||
+       length > static_cast<size_t>(outEnd - op))
+      {
+      break;
+      }
+    unsigned char const* ref = op - offset;
+    if(offset >= length)
+      {
+      memcpy(op, ref, length);
+      op += length;
+      }
+    else
+      {
+      // The match overlaps the bytes it produces.
+      for(size_t i = 0; i < length; ++i)
+        {
+        *op++ = *ref++;
+        }
+      }
+    }
+
+  vtkErrorMacro("LZ4 error while uncompressing data.");
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+size_t
+vtkLZ4DataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  // Incompressible data grow by one byte per 255 literals plus the token.
+  return size + size/255 + 16;
+}
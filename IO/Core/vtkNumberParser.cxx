@@ -0,0 +1,516 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkNumberParser.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkNumberParser.h"
+
+#include "vtkMath.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+
+#include <vtksys/ios/sstream>
+
+#include <locale>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkNumberParser);
+
+//----------------------------------------------------------------------------
+// Powers of ten that are exact in a double.
+static const double vtkNumberParserPowersOf10[23] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//----------------------------------------------------------------------------
+static const char* vtkNumberParserSkipSpace(const char* p, const char* end)
+{
+  while(p < end && vtkNumberParser::IsSpace(*p))
+    {
+    ++p;
+    }
+  return p;
+}
+
+//----------------------------------------------------------------------------
+// Compare the token [p, end) to a lower case word, ignoring case.
+static bool vtkNumberParserIsWord(const char* p, const char* end,
+                                  const char* word)
+{
+  for(; p < end && *word; ++p, ++word)
+    {
+    if((*p | 0x20) != *word)
+      {
+      return false;
+      }
+    }
+  return p == end && !*word;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkNumberParser::Parse(const char* begin, const char* end,
+                                   double& value)
+{
+  const char* p = vtkNumberParserSkipSpace(begin, end);
+  const char* start = p;
+  bool negative = false;
+  if(p < end && (*p == '-' || *p == '+'))
+    {
+    negative = *p == '-';
+    ++p;
+    }
+
+  // Accumulate up to 19 significant digits in an integer mantissa and
+  // count the decimal exponent.
+  vtkTypeUInt64 mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool anyDigit = false;
+  bool truncated = false;
+  for(; p < end && static_cast<unsigned char>(*p - '0') < 10; ++p)
+    {
+    unsigned int d = static_cast<unsigned int>(*p - '0');
+    anyDigit = true;
+    if(digits < 19)
+      {
+      mantissa = mantissa*10 + d;
+      digits += mantissa != 0;
+      }
+    else
+      {
+      ++exponent;
+      truncated |= d != 0;
+      }
+    }
+  if(p < end && *p == '.')
+    {
+    for(++p; p < end && static_cast<unsigned char>(*p - '0') < 10; ++p)
+      {
+      unsigned int d = static_cast<unsigned int>(*p - '0');
+      anyDigit = true;
+      if(digits < 19)
+        {
+        mantissa = mantissa*10 + d;
+        digits += mantissa != 0;
+        --exponent;
+        }
+      else
+        {
+        truncated |= d != 0;
+        }
+      }
+    }
+
+  if(!anyDigit)
+    {
+    // Only nan and infinity are numbers without digits.
+    const char* q = p;
+    while(q < end && !vtkNumberParser::IsSpace(*q))
+      {
+      ++q;
+      }
+    if(vtkNumberParserIsWord(p, q, "nan"))
+      {
+      value = vtkMath::Nan();
+      }
+    else if(vtkNumberParserIsWord(p, q, "inf") ||
+            vtkNumberParserIsWord(p, q, "infinity"))
+      {
+      value = negative? vtkMath::NegInf() : vtkMath::Inf();
+      }
+    else
+      {
+      return 0;
+      }
+    return q;
+    }
+
+  if(p < end && (*p == 'e' || *p == 'E'))
+    {
+    ++p;
+    bool negativeExponent = false;
+    if(p < end && (*p == '-' || *p == '+'))
+      {
+      negativeExponent = *p == '-';
+      ++p;
+      }
+    if(p == end || static_cast<unsigned char>(*p - '0') >= 10)
+      {
+      return 0;
+      }
+    int e = 0;
+    for(; p < end && static_cast<unsigned char>(*p - '0') < 10; ++p)
+      {
+      if(e < 100000)
+        {
+        e = e*10 + (*p - '0');
+        }
+      }
+    exponent += negativeExponent? -e : e;
+    }
+  if(p < end && !vtkNumberParser::IsSpace(*p))
+    {
+    return 0;
+    }
+
+  if(mantissa == 0)
+    {
+    value = 0;
+    }
+  else if(!truncated && mantissa <= (static_cast<vtkTypeUInt64>(1) << 53) &&
+          exponent >= -22 && exponent <= 22)
+    {
+    // Both the mantissa and the power of ten are exact, so one operation
+    // rounds correctly.
+    double m = static_cast<double>(mantissa);
+    value = exponent < 0? m / vtkNumberParserPowersOf10[-exponent] :
+      m * vtkNumberParserPowersOf10[exponent];
+    }
+  else
+    {
+    // Let the standard library round the rare long or huge numbers.
+    vtksys_ios::istringstream is(std::string(start, p));
+    is.imbue(std::locale::classic());
+    is >> value;
+    if(is.fail())
+      {
+      return 0;
+      }
+    return p;
+    }
+  if(negative)
+    {
+    value = -value;
+    }
+  return p;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkNumberParser::Parse(const char* begin, const char* end,
+                                   float& value)
+{
+  double d;
+  const char* p = vtkNumberParser::Parse(begin, end, d);
+  value = static_cast<float>(d);
+  return p;
+}
+
+//----------------------------------------------------------------------------
+// Parse the sign and digits of an integer into its magnitude.
+static const char* vtkNumberParserParseInteger(const char* begin,
+                                               const char* end,
+                                               bool& negative,
+                                               vtkTypeUInt64& magnitude)
+{
+  const char* p = vtkNumberParserSkipSpace(begin, end);
+  negative = false;
+  if(p < end && (*p == '-' || *p == '+'))
+    {
+    negative = *p == '-';
+    ++p;
+    }
+  if(p == end || static_cast<unsigned char>(*p - '0') >= 10)
+    {
+    return 0;
+    }
+  vtkTypeUInt64 const maximum = ~static_cast<vtkTypeUInt64>(0);
+  magnitude = 0;
+  for(; p < end && static_cast<unsigned char>(*p - '0') < 10; ++p)
+    {
+    unsigned int d = static_cast<unsigned int>(*p - '0');
+    if(magnitude > maximum/10 || magnitude*10 > maximum - d)
+      {
+      return 0;
+      }
+    magnitude = magnitude*10 + d;
+    }
+  if(p < end && !vtkNumberParser::IsSpace(*p))
+    {
+    return 0;
+    }
+  return p;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkNumberParser::Parse(const char* begin, const char* end,
+                                   vtkTypeInt64& value)
+{
+  bool negative;
+  vtkTypeUInt64 magnitude;
+  const char* p = vtkNumberParserParseInteger(begin, end, negative,
+                                              magnitude);
+  vtkTypeUInt64 const limit = static_cast<vtkTypeUInt64>(1) << 63;
+  if(!p || magnitude > (negative? limit : limit - 1))
+    {
+    return 0;
+    }
+  value = static_cast<vtkTypeInt64>(negative? 0 - magnitude : magnitude);
+  return p;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkNumberParser::Parse(const char* begin, const char* end,
+                                   vtkTypeUInt64& value)
+{
+  bool negative;
+  vtkTypeUInt64 magnitude;
+  const char* p = vtkNumberParserParseInteger(begin, end, negative,
+                                              magnitude);
+  if(p)
+    {
+    value = negative? 0 - magnitude : magnitude;
+    }
+  return p;
+}
+
+//----------------------------------------------------------------------------
+// Parse one value of the given type.  Floating point values are parsed
+// as such, 64-bit unsigned values as unsigned and other integers as
+// signed 64-bit integers.
+static inline const char* vtkNumberParserParseOne(const char* begin,
+                                                  const char* end,
+                                                  double& value)
+{
+  return vtkNumberParser::Parse(begin, end, value);
+}
+static inline const char* vtkNumberParserParseOne(const char* begin,
+                                                  const char* end,
+                                                  float& value)
+{
+  return vtkNumberParser::Parse(begin, end, value);
+}
+static inline const char* vtkNumberParserParseOne(const char* begin,
+                                                  const char* end,
+                                                  vtkTypeUInt64& value)
+{
+  return vtkNumberParser::Parse(begin, end, value);
+}
+template <class T>
+static inline const char* vtkNumberParserParseOne(const char* begin,
+                                                  const char* end,
+                                                  T& value)
+{
+  if(sizeof(T) == 8 && static_cast<T>(-1) > 0)
+    {
+    vtkTypeUInt64 u;
+    const char* p = vtkNumberParser::Parse(begin, end, u);
+    value = static_cast<T>(u);
+    return p;
+    }
+  vtkTypeInt64 i;
+  const char* p = vtkNumberParser::Parse(begin, end, i);
+  value = static_cast<T>(i);
+  return p;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+static size_t vtkNumberParserParseRange(const char* begin, const char* end,
+                                        T* values, size_t count,
+                                        const char** stop)
+{
+  size_t n = 0;
+  const char* p = begin;
+  while(n < count)
+    {
+    const char* q = vtkNumberParserParseOne(p, end, values[n]);
+    if(!q)
+      {
+      break;
+      }
+    p = q;
+    ++n;
+    }
+  *stop = p;
+  return n;
+}
+
+//----------------------------------------------------------------------------
+static size_t vtkNumberParserCountTokens(const char* begin, const char* end)
+{
+  size_t n = 0;
+  bool inToken = false;
+  for(const char* p = begin; p < end; ++p)
+    {
+    bool space = vtkNumberParser::IsSpace(*p);
+    n += !space && !inToken;
+    inToken = !space;
+    }
+  return n;
+}
+
+//----------------------------------------------------------------------------
+// The parts of a buffer parsed on several threads.  The first stage
+// counts the numbers in each part, the second parses them.
+template <class T>
+struct vtkNumberParserParts
+{
+  std::vector<const char*> Bounds;
+  std::vector<size_t> Counts;
+  std::vector<size_t> Offsets;
+  std::vector<size_t> Parsed;
+  std::vector<const char*> Stops;
+  T* Values;
+  int Stage;
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+static VTK_THREAD_RETURN_TYPE vtkNumberParserThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkNumberParserParts<T>* parts =
+    static_cast<vtkNumberParserParts<T>*>(info->UserData);
+  size_t i = static_cast<size_t>(info->ThreadID);
+  if(parts->Stage == 0)
+    {
+    parts->Counts[i] = vtkNumberParserCountTokens(parts->Bounds[i],
+                                                  parts->Bounds[i+1]);
+    }
+  else
+    {
+    parts->Parsed[i] =
+      vtkNumberParserParseRange(parts->Bounds[i], parts->Bounds[i+1],
+                                parts->Values + parts->Offsets[i],
+                                parts->Counts[i], &parts->Stops[i]);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+static size_t vtkNumberParserParseValues(const char* begin, const char* end,
+                                         T* values, size_t count,
+                                         const char** stop,
+                                         int numberOfThreads)
+{
+  if(numberOfThreads <= 0)
+    {
+    numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  if(numberOfThreads > VTK_MAX_THREADS)
+    {
+    numberOfThreads = VTK_MAX_THREADS;
+    }
+
+  // Small buffers are not worth the threads.
+  size_t const minimumPartSize = 1048576;
+  size_t length = static_cast<size_t>(end - begin);
+  if(numberOfThreads < 2 || length < 2*minimumPartSize)
+    {
+    return vtkNumberParserParseRange(begin, end, values, count, stop);
+    }
+  if(length/minimumPartSize < static_cast<size_t>(numberOfThreads))
+    {
+    numberOfThreads = static_cast<int>(length/minimumPartSize);
+    }
+
+  // Split the buffer at whitespace.
+  size_t numberOfParts = static_cast<size_t>(numberOfThreads);
+  vtkNumberParserParts<T> parts;
+  parts.Bounds.resize(numberOfParts+1);
+  parts.Counts.resize(numberOfParts);
+  parts.Offsets.resize(numberOfParts);
+  parts.Parsed.resize(numberOfParts);
+  parts.Stops.resize(numberOfParts);
+  parts.Values = values;
+  parts.Bounds[0] = begin;
+  parts.Bounds[numberOfParts] = end;
+  for(size_t i = 1; i < numberOfParts; ++i)
+    {
+    const char* p = begin + length/numberOfParts*i;
+    if(p < parts.Bounds[i-1])
+      {
+      p = parts.Bounds[i-1];
+      }
+    while(p < end && !vtkNumberParser::IsSpace(*p))
+      {
+      ++p;
+      }
+    parts.Bounds[i] = p;
+    }
+
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(vtkNumberParserThread<T>, &parts);
+  parts.Stage = 0;
+  threader->SingleMethodExecute();
+
+  // Parse only the requested number of values, each part into its place.
+  size_t left = count;
+  for(size_t i = 0; i < numberOfParts; ++i)
+    {
+    parts.Offsets[i] = count - left;
+    if(parts.Counts[i] > left)
+      {
+      parts.Counts[i] = left;
+      }
+    left -= parts.Counts[i];
+    }
+  parts.Stage = 1;
+  threader->SingleMethodExecute();
+  threader->Delete();
+
+  // Stop at the first part that did not parse all its numbers.
+  size_t n = 0;
+  *stop = begin;
+  for(size_t i = 0; i < numberOfParts; ++i)
+    {
+    if(parts.Counts[i] == 0)
+      {
+      continue;
+      }
+    n += parts.Parsed[i];
+    *stop = parts.Stops[i];
+    if(parts.Parsed[i] < parts.Counts[i])
+      {
+      break;
+      }
+    }
+  return n;
+}
+
+//----------------------------------------------------------------------------
+#define vtkNumberParserParseValuesMacro(type) \
+  size_t vtkNumberParser::ParseValues(const char* begin, const char* end, \
+                                      type* values, size_t count,         \
+                                      const char** stop,                  \
+                                      int numberOfThreads)                \
+  {                                                                       \
+    return vtkNumberParserParseValues(begin, end, values, count, stop,    \
+                                      numberOfThreads);                   \
+  }
+vtkNumberParserParseValuesMacro(double)
+vtkNumberParserParseValuesMacro(float)
+vtkNumberParserParseValuesMacro(char)
+vtkNumberParserParseValuesMacro(signed char)
+vtkNumberParserParseValuesMacro(unsigned char)
+vtkNumberParserParseValuesMacro(short)
+vtkNumberParserParseValuesMacro(unsigned short)
+vtkNumberParserParseValuesMacro(int)
+vtkNumberParserParseValuesMacro(unsigned int)
+vtkNumberParserParseValuesMacro(long)
+vtkNumberParserParseValuesMacro(unsigned long)
+#if defined(VTK_TYPE_USE_LONG_LONG)
+vtkNumberParserParseValuesMacro(long long)
+vtkNumberParserParseValuesMacro(unsigned long long)
+#endif
+#if defined(VTK_TYPE_USE___INT64)
+vtkNumberParserParseValuesMacro(__int64)
+vtkNumberParserParseValuesMacro(unsigned __int64)
+#endif
+#undef vtkNumberParserParseValuesMacro
+
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkNumberParser.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkNumberParser - fast parsing of ascii numbers in memory.
+// .SECTION Description
+// vtkNumberParser converts ascii numbers separated by whitespace in a
+// memory buffer to binary values.  The conversion does not depend on the
+// locale and is several times faster than reading from an istream.
+// Floating point numbers with up to 15 significant digits and a decimal
+// exponent up to 22 are converted with one correctly rounded operation;
+// other numbers fall back to the standard library.  "nan", "inf" and
+// "infinity" are accepted in any case.
+//
+// ParseValues() parses large buffers on several threads.  The buffer is
+// split at whitespace, the numbers of each part are counted and the parts
+// are then converted in parallel into their place in the output.
+// .SECTION See Also
+// vtkDataReader
+
+#ifndef __vtkNumberParser_h
+#define __vtkNumberParser_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class VTKIOCORE_EXPORT vtkNumberParser : public vtkObject
+{
+public:
+  static vtkNumberParser *New();
+  vtkTypeMacro(vtkNumberParser,vtkObject);
+
+  //BTX
+  // Description:
+  // Parse the number that begins after any whitespace at 'begin' and
+  // ends before 'end'.  The number must be followed by whitespace or by
+  // 'end'.  Returns a pointer to the character after the number, or 0
+  // if there is no valid number.
+  static const char* Parse(const char* begin, const char* end,
+                           double& value);
+  static const char* Parse(const char* begin, const char* end,
+                           float& value);
+  static const char* Parse(const char* begin, const char* end,
+                           vtkTypeInt64& value);
+  static const char* Parse(const char* begin, const char* end,
+                           vtkTypeUInt64& value);
+
+  // Description:
+  // Parse up to 'count' numbers from the buffer into 'values'.  Returns
+  // the number of values parsed and sets 'stop' to the character after
+  // the last of them.  Fewer values are parsed if the buffer ends or
+  // holds something else than a number; 'stop' then tells which.
+  // Integers are converted to the type of the values without range
+  // checks.  Buffers larger than a few megabytes are parsed on
+  // 'numberOfThreads' threads, or on the default number of threads of
+  // vtkMultiThreader if it is 0.
+  static size_t ParseValues(const char* begin, const char* end,
+                            double* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            float* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            char* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            signed char* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            unsigned char* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            short* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            unsigned short* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            int* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            unsigned int* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            long* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            unsigned long* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+#if defined(VTK_TYPE_USE_LONG_LONG)
+  static size_t ParseValues(const char* begin, const char* end,
+                            long long* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            unsigned long long* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+#endif
+#if defined(VTK_TYPE_USE___INT64)
+  static size_t ParseValues(const char* begin, const char* end,
+                            __int64* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+  static size_t ParseValues(const char* begin, const char* end,
+                            unsigned __int64* values, size_t count,
+                            const char** stop, int numberOfThreads = 0);
+#endif
+
+  // Description:
+  // Return whether the character separates numbers.
+  static bool IsSpace(char c)
+    {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+  //ETX
+
+protected:
+  vtkNumberParser() {};
+  ~vtkNumberParser() {};
+
+private:
+  vtkNumberParser(const vtkNumberParser&);  // Not implemented.
+  void operator=(const vtkNumberParser&);  // Not implemented.
+};
+
+#endif
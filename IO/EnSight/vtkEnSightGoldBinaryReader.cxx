@@ -30,17 +30,44 @@
 
 #include <sys/stat.h>
 #include <ctype.h>
+#include <map>
 #include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+//----------------------------------------------------------------------------
+// The offsets of the "BEGIN TIME STEP" lines of a file of a file set.
+struct vtkEnSightGoldBinaryReaderTimeSteps
+{
+  vtkEnSightGoldBinaryReaderTimeSteps()
+    : FileSize(-1), NumberOfTimeSteps(-1) {}
+  vtkIdType FileSize;
+  int NumberOfTimeSteps;
+  std::map<int, vtkTypeInt64> Offsets;
+};
+
+// The offsets of the time steps of the files read so far, recorded as the
+// time steps are read or skipped so that stepping through a file set
+// seeks straight to each time step.  The offsets of a file are forgotten
+// when its size changes.
+class vtkEnSightGoldBinaryReaderFileOffsets
+{
+public:
+  vtkEnSightGoldBinaryReaderFileOffsets() : Current(0) {}
+  std::map<std::string, vtkEnSightGoldBinaryReaderTimeSteps> Files;
+  // The time steps of the open file.
+  vtkEnSightGoldBinaryReaderTimeSteps *Current;
+};
+
 //----------------------------------------------------------------------------
 vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 {
   this->IFile = NULL;
+  this->FileOffsets = new vtkEnSightGoldBinaryReaderFileOffsets;
   this->FileSize = 0;
   this->SizeOfInt = (int)sizeof(int);
   this->Fortran = 0;
@@ -57,6 +84,7 @@ vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
     delete this->IFile;
     this->IFile = NULL;
     }
+  delete this->FileOffsets;
 }
 
 //----------------------------------------------------------------------------
@@ -84,6 +112,16 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (vtkIdType)(fs.st_size);
 
+    // Use the time step offsets recorded for the file, unless it changed.
+    vtkEnSightGoldBinaryReaderTimeSteps &timeSteps =
+      this->FileOffsets->Files[filename];
+    if (timeSteps.FileSize != this->FileSize)
+      {
+      timeSteps = vtkEnSightGoldBinaryReaderTimeSteps();
+      timeSteps.FileSize = this->FileSize;
+      }
+    this->FileOffsets->Current = &timeSteps;
+
 #ifdef _WIN32
     this->IFile = new ifstream(filename, ios::in | ios::binary);
 #else
@@ -239,35 +277,40 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     return 0;
     }
 
-  //this will close the file, so we need to reinitialize it
-  int numberOfTimeStepsInFile=this->CountTimeSteps();
-
-  if (!this->InitializeFile(fileName))
-  {
-  return 0;
-  }
-
-
   if (this->UseFileSets)
     {
+    // The time steps of the file are counted, and their offsets recorded,
+    // the first time it is read.  Later time steps are reached by seeking.
+    int numberOfTimeStepsInFile =
+      this->FileOffsets->Current->NumberOfTimeSteps;
+    if (numberOfTimeStepsInFile < 0)
+      {
+      //this will close the file, so we need to reinitialize it
+      numberOfTimeStepsInFile = this->CountTimeSteps();
+      if (!this->InitializeFile(fileName))
+        {
+        return 0;
+        }
+      }
+
+    int fileTimeStep = 0;
     if (numberOfTimeStepsInFile>1)
       {
-      for (i = 0; i < timeStep - 1; i++)
+      fileTimeStep = timeStep - 1;
+      for (i = this->SeekToCachedTimeStep(fileTimeStep); i < fileTimeStep; i++)
         {
-        if (!this->SkipTimeStep())
+        if (!this->SkipTimeStep(i))
           {
           return 0;
           }
         }
       }
 
-    // use do-while here to initialize 'line' before 'strncmp' is appllied
-    // Thanks go to Brancois for care of this issue
-    do
+    if (!this->ReadTimeStepBegin(fileTimeStep, line))
       {
-      this->ReadLine(line);
+      vtkErrorMacro("Could not find time step " << timeStep << ".");
+      return 0;
       }
-    while ( strncmp(line, "BEGIN TIME STEP", 15) != 0 );
     }
 
   // Skip the 2 description lines.
@@ -411,7 +454,7 @@ int vtkEnSightGoldBinaryReader::CountTimeSteps()
   int count=0;
   while(1)
     {
-    int result=this->SkipTimeStep();
+    int result=this->SkipTimeStep(count);
     if (result)
       {
       count++;
@@ -421,22 +464,19 @@ int vtkEnSightGoldBinaryReader::CountTimeSteps()
       break;
       }
     }
+  this->FileOffsets->Current->NumberOfTimeSteps = count;
   return count;
 }
 
 //----------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::SkipTimeStep()
+int vtkEnSightGoldBinaryReader::SkipTimeStep(int timeStep)
 {
   char line[80], subLine[80];
   int lineRead;
 
-  line[0] = '\0';
-  while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
+  if (!this->ReadTimeStepBegin(timeStep, line))
     {
-    if (!this->ReadLine(line))
-      {
-      return 0;
-      }
+    return 0;
     }
 
   // Skip the 2 description lines.
@@ -537,6 +577,46 @@ int vtkEnSightGoldBinaryReader::SkipTimeStep()
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::SeekToCachedTimeStep(int timeStep)
+{
+  vtkEnSightGoldBinaryReaderTimeSteps *timeSteps = this->FileOffsets->Current;
+  if (!timeSteps || !this->IFile)
+    {
+    return 0;
+    }
+  std::map<int, vtkTypeInt64>::iterator it =
+    timeSteps->Offsets.upper_bound(timeStep);
+  if (it == timeSteps->Offsets.begin())
+    {
+    return 0;
+    }
+  --it;
+  this->IFile->seekg(static_cast<std::streamoff>(it->second), ios::beg);
+  return it->first;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadTimeStepBegin(int timeStep, char line[80])
+{
+  vtkTypeInt64 offset;
+  do
+    {
+    offset = static_cast<vtkTypeInt64>(this->IFile->tellg());
+    if (!this->ReadLine(line))
+      {
+      return 0;
+      }
+    }
+  while (strncmp(line, "BEGIN TIME STEP", 15) != 0);
+
+  if (this->FileOffsets->Current)
+    {
+    this->FileOffsets->Current->Offsets[timeStep] = offset;
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkEnSightGoldBinaryReader::SkipStructuredGrid(char line[256])
 {
@@ -1111,7 +1191,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   char line[80], subLine[80];
   vtkIdType i;
   int *pointIds;
-  float *xCoords, *yCoords, *zCoords;
   vtkPoints *points = vtkPoints::New();
   vtkPolyData *pd = vtkPolyData::New();
 
@@ -1158,12 +1237,9 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-        {
-        this->ReadLine(line);
-        }
+      this->ReadTimeStepBegin(i, line);
       // Skip the description line.
       this->ReadLine(line);
 
@@ -1184,10 +1260,7 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
         ios::cur);
       this->ReadLine(line); // END TIME STEP
       }
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-      {
-      this->ReadLine(line);
-      }
+    this->ReadTimeStepBegin(timeStep - 1, line);
     }
 
   // Skip the description line.
@@ -1198,10 +1271,7 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   this->ReadInt(&this->NumberOfMeasuredPoints);
 
   pointIds = new int[this->NumberOfMeasuredPoints];
-  xCoords = new float [this->NumberOfMeasuredPoints];
-  yCoords = new float [this->NumberOfMeasuredPoints];
-  zCoords = new float [this->NumberOfMeasuredPoints];
-  points->Allocate(this->NumberOfMeasuredPoints);
+  points->SetNumberOfPoints(this->NumberOfMeasuredPoints);
   pd->Allocate(this->NumberOfMeasuredPoints);
 
   // Extract the array of point indices. Note EnSight Manual v8.2 (pp. 559,
@@ -1214,26 +1284,21 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   this->ReadIntArray( pointIds, this->NumberOfMeasuredPoints );
 
   // Read point coordinates tuple by tuple while each tuple contains three
-  // components: (x-cord, y-cord, z-cord)
-  int  floatSize = sizeof( float );
-  for ( i = 0; i < this->NumberOfMeasuredPoints; i ++ )
-    {
-    this->IFile->read(  ( char * )( xCoords + i ),  floatSize  );
-    this->IFile->read(  ( char * )( yCoords + i ),  floatSize  );
-    this->IFile->read(  ( char * )( zCoords + i ),  floatSize  );
-    }
+  // components: (x-cord, y-cord, z-cord).  They are laid out as the tuples
+  // of the points, so they are read in one block.
+  float* coords =
+    static_cast<vtkFloatArray*>(points->GetData())->GetPointer(0);
+  vtkIdType numCoords = 3 * this->NumberOfMeasuredPoints;
+  this->IFile->read(reinterpret_cast<char*>(coords),
+                    numCoords * sizeof(float));
 
   if ( this->ByteOrder == FILE_LITTLE_ENDIAN )
     {
-    vtkByteSwap::Swap4LERange( xCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4LERange( yCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4LERange( zCoords, this->NumberOfMeasuredPoints );
+    vtkByteSwap::Swap4LERange( coords, numCoords );
     }
   else
     {
-    vtkByteSwap::Swap4BERange( xCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4BERange( yCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4BERange( zCoords, this->NumberOfMeasuredPoints );
+    vtkByteSwap::Swap4BERange( coords, numCoords );
     }
 
   // NOTE: EnSight always employs a 1-based indexing scheme and therefore
@@ -1242,7 +1307,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   // This bug was noticed while fixing bug #7453.
   for (i = 0; i < this->NumberOfMeasuredPoints; i++)
     {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
     pd->InsertNextCell(VTK_VERTEX, 1, &i);
     }
 
@@ -1252,9 +1316,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   points->Delete();
   pd->Delete();
   delete [] pointIds;
-  delete [] xCoords;
-  delete [] yCoords;
-  delete [] zCoords;
 
   if (this->IFile)
     {
@@ -1274,7 +1335,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *scalars;
-  float* scalarsRead;
   vtkDataSet *output;
 
   // Initialize
@@ -1308,13 +1368,9 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-        {
-        this->ReadLine(line);
-        }
+      this->ReadTimeStepBegin(i, line);
       this->ReadLine(line); // skip the description line
 
       if (measured)
@@ -1347,11 +1403,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
           }
         }
         }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-      {
-      this->ReadLine(line);
-      }
+    this->ReadTimeStepBegin(timeStep - 1, line);
     }
 
   this->ReadLine(line); // skip the description line
@@ -1369,17 +1421,12 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
       scalars = vtkFloatArray::New();
       scalars->SetNumberOfComponents(numberOfComponents);
       scalars->SetNumberOfTuples(numPts);
-      scalarsRead = new float [numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
       // Why are we setting only one component here?
       // Only one component is set because scalars are single-component arrays.
       // For complex scalars, there is a file for the real part and another
       // file for the imaginary part, but we are storing them as a 2-component
       // array.
-      for (i = 0; i < numPts; i++)
-        {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-        }
+      this->ReadFloatComponent(scalars, component, numPts);
       scalars->SetName(description);
       output->GetPointData()->AddArray(scalars);
       if (!output->GetPointData()->GetScalars())
@@ -1387,7 +1434,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
         output->GetPointData()->SetScalars(scalars);
         }
       scalars->Delete();
-      delete [] scalarsRead;
       }
     if (this->IFile)
       {
@@ -1423,13 +1469,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
           GetArray(description));
         }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
-
-      for (i = 0; i < numPts; i++)
-        {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-        }
+      this->ReadFloatComponent(scalars, component, numPts);
       if (component == 0)
         {
         scalars->SetName(description);
@@ -1444,7 +1484,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
         {
         output->GetPointData()->AddArray(scalars);
         }
-      delete [] scalarsRead;
       }
 
     this->IFile->peek();
@@ -1473,8 +1512,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *vectors;
-  float tuple[3];
-  float *comp1, *comp2, *comp3;
   float *vectorsRead;
   vtkDataSet *output;
 
@@ -1509,13 +1546,9 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-        {
-        this->ReadLine(line);
-        }
+      this->ReadTimeStepBegin(i, line);
       this->ReadLine(line); // skip the description line
 
       if (measured)
@@ -1548,11 +1581,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
           }
         }
         }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-      {
-      this->ReadLine(line);
-      }
+    this->ReadTimeStepBegin(timeStep - 1, line);
     }
 
   this->ReadLine(line); // skip the description line
@@ -1603,19 +1632,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
       this->ReadLine(line); // "coordinates" or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
-        {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        vectors->SetTuple(i, tuple);
-        }
+      this->ReadFloatComponents(vectors, numPts);
       vectors->SetName(description);
       output->GetPointData()->AddArray(vectors);
       if (!output->GetPointData()->GetVectors())
@@ -1623,9 +1640,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
         output->GetPointData()->SetVectors(vectors);
         }
       vectors->Delete();
-      delete [] comp1;
-      delete [] comp2;
-      delete [] comp3;
       }
 
     this->IFile->peek();
@@ -1655,8 +1669,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *tensors;
-  float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
-  float tuple[6];
   vtkDataSet *output;
 
   // Initialize
@@ -1690,13 +1702,9 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-        {
-        this->ReadLine(line);
-        }
+      this->ReadTimeStepBegin(i, line);
       this->ReadLine(line); // skip the description line
 
       while (this->ReadLine(line) &&
@@ -1715,11 +1723,7 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-      {
-      this->ReadLine(line);
-      }
+    this->ReadTimeStepBegin(timeStep - 1, line);
     }
 
   this->ReadLine(line); // skip the description line
@@ -1738,37 +1742,10 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
       this->ReadLine(line); // "coordinates" or "block"
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      comp4 = new float[numPts];
-      comp5 = new float[numPts];
-      comp6 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      this->ReadFloatArray(comp4, numPts);
-      this->ReadFloatArray(comp5, numPts);
-      this->ReadFloatArray(comp6, numPts);
-      for (i = 0; i < numPts; i++)
-        {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        tuple[3] = comp4[i];
-        tuple[4] = comp5[i];
-        tuple[5] = comp6[i];
-        tensors->InsertTuple(i, tuple);
-        }
+      this->ReadFloatComponents(tensors, numPts);
       tensors->SetName(description);
       output->GetPointData()->AddArray(tensors);
       tensors->Delete();
-      delete [] comp1;
-      delete [] comp2;
-      delete [] comp3;
-      delete [] comp4;
-      delete [] comp5;
-      delete [] comp6;
       }
 
     this->IFile->peek();
@@ -1799,7 +1776,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
   char line[80];
   int partId, realId, numCells, numCellsPerElement, i, idx;
   vtkFloatArray *scalars;
-  float *scalarsRead;
   int lineRead, elementType;
   vtkDataSet *output;
 
@@ -1835,13 +1811,9 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-        {
-        this->ReadLine(line);
-        }
+      this->ReadTimeStepBegin(i, line);
       this->ReadLine(line); // skip the description line
       lineRead = this->ReadLine(line); // "part"
 
@@ -1896,11 +1868,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
           }
         } // end while
       } // end for
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-      {
-      this->ReadLine(line);
-      }
+    this->ReadTimeStepBegin(timeStep - 1, line);
     }
 
   this->ReadLine(line); // skip the description line
@@ -1931,12 +1899,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
         {
-        scalarsRead = new float[numCells];
-        this->ReadFloatArray(scalarsRead, numCells);
-        for (i = 0; i < numCells; i++)
-          {
-          scalars->SetComponent(i, component, scalarsRead[i]);
-          }
+        this->ReadFloatComponent(scalars, component, numCells);
         if (this->IFile->eof())
           {
           lineRead = 0;
@@ -1945,7 +1908,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
           {
           lineRead = this->ReadLine(line);
           }
-        delete [] scalarsRead;
         }
       else
         {
@@ -1971,13 +1933,8 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
           idx = this->UnstructuredPartIds->IsId(realId);
           numCellsPerElement =
             this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          scalarsRead = new float[numCellsPerElement];
-          this->ReadFloatArray(scalarsRead, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
-            {
-            scalars->SetComponent(this->GetCellIds(idx, elementType)->GetId(i),
-              component, scalarsRead[i]);
-            }
+          this->ReadFloatComponent(scalars, component, numCellsPerElement,
+            this->GetCellIds(idx, elementType));
           this->IFile->peek();
           if (this->IFile->eof())
             {
@@ -1987,7 +1944,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
             {
             lineRead = this->ReadLine(line);
             }
-          delete [] scalarsRead;
           } // end while
         } // end else
       if (component == 0)
@@ -2036,9 +1992,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
   char line[80];
   int partId, realId, numCells, numCellsPerElement, i, idx;
   vtkFloatArray *vectors;
-  float *comp1, *comp2, *comp3;
   int lineRead, elementType;
-  float tuple[3];
   vtkDataSet *output;
 
   // Initialize
@@ -2073,13 +2027,9 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-        {
-        this->ReadLine(line);
-        }
+      this->ReadTimeStepBegin(i, line);
       this->ReadLine(line); // skip the description line
       lineRead = this->ReadLine(line); // "part"
 
@@ -2131,11 +2081,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-      {
-      this->ReadLine(line);
-      }
+    this->ReadTimeStepBegin(timeStep - 1, line);
     }
 
   this->ReadLine(line); // skip the description line
@@ -2158,19 +2104,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
         {
-        comp1 = new float[numCells];
-        comp2 = new float[numCells];
-        comp3 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        for (i = 0; i < numCells; i++)
-          {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          vectors->SetTuple(i, tuple);
-          }
+        this->ReadFloatComponents(vectors, numCells);
         this->IFile->peek();
         if (this->IFile->eof())
           {
@@ -2180,9 +2114,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
           {
           lineRead = this->ReadLine(line);
           }
-        delete [] comp1;
-        delete [] comp2;
-        delete [] comp3;
         }
       else
         {
@@ -2201,20 +2132,8 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
           idx = this->UnstructuredPartIds->IsId(realId);
           numCellsPerElement =
             this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          comp1 = new float[numCellsPerElement];
-          comp2 = new float[numCellsPerElement];
-          comp3 = new float[numCellsPerElement];
-          this->ReadFloatArray(comp1, numCellsPerElement);
-          this->ReadFloatArray(comp2, numCellsPerElement);
-          this->ReadFloatArray(comp3, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
-            {
-            tuple[0] = comp1[i];
-            tuple[1] = comp2[i];
-            tuple[2] = comp3[i];
-            vectors->SetTuple(this->GetCellIds(idx, elementType)->GetId(i),
-              tuple);
-            }
+          this->ReadFloatComponents(vectors, numCellsPerElement,
+            this->GetCellIds(idx, elementType));
           this->IFile->peek();
           if (this->IFile->eof())
             {
@@ -2224,9 +2143,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
             {
             lineRead = this->ReadLine(line);
             }
-          delete [] comp1;
-          delete [] comp2;
-          delete [] comp3;
           } // end while
         } // end else
       vectors->SetName(description);
@@ -2269,8 +2185,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
   int partId, realId, numCells, numCellsPerElement, i, idx;
   vtkFloatArray *tensors;
   int lineRead, elementType;
-  float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
-  float tuple[6];
   vtkDataSet *output;
 
   // Initialize
@@ -2305,13 +2219,9 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
 
   if (this->UseFileSets)
     {
-    for (i = 0; i < timeStep - 1; i++)
+    for (i = this->SeekToCachedTimeStep(timeStep - 1); i < timeStep - 1; i++)
       {
-      this->ReadLine(line);
-      while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-        {
-        this->ReadLine(line);
-        }
+      this->ReadTimeStepBegin(i, line);
       this->ReadLine(line); // skip the description line
       lineRead = this->ReadLine(line); // "part"
 
@@ -2363,11 +2273,7 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
           }
         }
       }
-    this->ReadLine(line);
-    while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
-      {
-      this->ReadLine(line);
-      }
+    this->ReadTimeStepBegin(timeStep - 1, line);
     }
 
   this->ReadLine(line); // skip the description line
@@ -2391,28 +2297,7 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
         {
-        comp1 = new float[numCells];
-        comp2 = new float[numCells];
-        comp3 = new float[numCells];
-        comp4 = new float[numCells];
-        comp5 = new float[numCells];
-        comp6 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        this->ReadFloatArray(comp4, numCells);
-        this->ReadFloatArray(comp5, numCells);
-        this->ReadFloatArray(comp6, numCells);
-        for (i = 0; i < numCells; i++)
-          {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          tuple[3] = comp4[i];
-          tuple[4] = comp5[i];
-          tuple[5] = comp6[i];
-          tensors->InsertTuple(i, tuple);
-          }
+        this->ReadFloatComponents(tensors, numCells);
         this->IFile->peek();
         if (this->IFile->eof())
           {
@@ -2422,12 +2307,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
           {
           lineRead = this->ReadLine(line);
           }
-        delete [] comp1;
-        delete [] comp2;
-        delete [] comp3;
-        delete [] comp4;
-        delete [] comp5;
-        delete [] comp6;
         }
       else
         {
@@ -2446,29 +2325,8 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
           idx = this->UnstructuredPartIds->IsId(realId);
           numCellsPerElement =
             this->GetCellIds(idx, elementType)->GetNumberOfIds();
-          comp1 = new float[numCellsPerElement];
-          comp2 = new float[numCellsPerElement];
-          comp3 = new float[numCellsPerElement];
-          comp4 = new float[numCellsPerElement];
-          comp5 = new float[numCellsPerElement];
-          comp6 = new float[numCellsPerElement];
-          this->ReadFloatArray(comp1, numCellsPerElement);
-          this->ReadFloatArray(comp2, numCellsPerElement);
-          this->ReadFloatArray(comp3, numCellsPerElement);
-          this->ReadFloatArray(comp4, numCellsPerElement);
-          this->ReadFloatArray(comp5, numCellsPerElement);
-          this->ReadFloatArray(comp6, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
-            {
-            tuple[0] = comp1[i];
-            tuple[1] = comp2[i];
-            tuple[2] = comp3[i];
-            tuple[3] = comp4[i];
-            tuple[4] = comp5[i];
-            tuple[5] = comp6[i];
-            tensors->InsertTuple(this->GetCellIds(idx, elementType)->GetId(i),
-              tuple);
-            }
+          this->ReadFloatComponents(tensors, numCellsPerElement,
+            this->GetCellIds(idx, elementType));
           this->IFile->peek();
           if (this->IFile->eof())
             {
@@ -2478,12 +2336,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
             {
             lineRead = this->ReadLine(line);
             }
-          delete [] comp1;
-          delete [] comp2;
-          delete [] comp3;
-          delete [] comp4;
-          delete [] comp5;
-          delete [] comp6;
           } // end while
         } // end else
       tensors->SetName(description);
@@ -2524,7 +2376,6 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
   int *nodeIdList;
   int numElements;
   int idx, cellId, cellType;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -2569,30 +2420,18 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       vtkPoints *points = vtkPoints::New();
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Allocate(numPts);
+      points->SetNumberOfPoints(numPts);
 
       if (this->NodeIdsListed)
         {
         this->IFile->seekg(sizeof(int)*numPts, ios::cur);
         }
 
-      xCoords = new float[numPts];
-      yCoords = new float[numPts];
-      zCoords = new float[numPts];
-      this->ReadFloatArray(xCoords, numPts);
-      this->ReadFloatArray(yCoords, numPts);
-      this->ReadFloatArray(zCoords, numPts);
-
-      for (i = 0; i < numPts; i++)
-        {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-        }
+      this->ReadFloatComponents(
+        static_cast<vtkFloatArray*>(points->GetData()), numPts);
 
       output->SetPoints(points);
       points->Delete();
-      delete [] xCoords;
-      delete [] yCoords;
-      delete [] zCoords;
       }
     else if (strncmp(line, "point", 5) == 0)
       {
@@ -3632,7 +3471,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   int i;
   vtkPoints *points = vtkPoints::New();
   int numPts;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -3674,19 +3512,9 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     return -1;
     }
   output->SetDimensions(dimensions);
-  points->Allocate(numPts);
-
-  xCoords = new float[numPts];
-  yCoords = new float[numPts];
-  zCoords = new float[numPts];
-  this->ReadFloatArray(xCoords, numPts);
-  this->ReadFloatArray(yCoords, numPts);
-  this->ReadFloatArray(zCoords, numPts);
-
-  for (i = 0; i < numPts; i++)
-    {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-    }
+  points->SetNumberOfPoints(numPts);
+  this->ReadFloatComponents(
+    static_cast<vtkFloatArray*>(points->GetData()), numPts);
   output->SetPoints(points);
   if (iblanked)
     {
@@ -3704,9 +3532,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     }
 
   points->Delete();
-  delete [] xCoords;
-  delete [] yCoords;
-  delete [] zCoords;
 
   this->IFile->peek();
   if (this->IFile->eof())
@@ -3747,11 +3572,9 @@ int vtkEnSightGoldBinaryReader::CreateRectilinearGridOutput(
   int lineRead;
   int iblanked = 0;
   int dimensions[3];
-  int i;
   vtkFloatArray *xCoords = vtkFloatArray::New();
   vtkFloatArray *yCoords = vtkFloatArray::New();
   vtkFloatArray *zCoords = vtkFloatArray::New();
-  float *tempCoords;
   int numPts;
 
   this->NumberOfNewOutputs++;
@@ -3797,31 +3620,12 @@ int vtkEnSightGoldBinaryReader::CreateRectilinearGridOutput(
     }
 
   output->SetDimensions(dimensions);
-  xCoords->Allocate(dimensions[0]);
-  yCoords->Allocate(dimensions[1]);
-  zCoords->Allocate(dimensions[2]);
-
-  tempCoords = new float[dimensions[0]];
-  this->ReadFloatArray(tempCoords, dimensions[0]);
-  for (i = 0; i < dimensions[0]; i++)
-    {
-    xCoords->InsertNextTuple(&tempCoords[i]);
-    }
-  delete [] tempCoords;
-  tempCoords = new float[dimensions[1]];
-  this->ReadFloatArray(tempCoords, dimensions[1]);
-  for (i = 0; i < dimensions[1]; i++)
-    {
-    yCoords->InsertNextTuple(&tempCoords[i]);
-    }
-  delete [] tempCoords;
-  tempCoords = new float[dimensions[2]];
-  this->ReadFloatArray(tempCoords, dimensions[2]);
-  for (i = 0; i < dimensions[2]; i++)
-    {
-    zCoords->InsertNextTuple(&tempCoords[i]);
-    }
-  delete [] tempCoords;
+  xCoords->SetNumberOfTuples(dimensions[0]);
+  yCoords->SetNumberOfTuples(dimensions[1]);
+  zCoords->SetNumberOfTuples(dimensions[2]);
+  this->ReadFloatComponents(xCoords, dimensions[0]);
+  this->ReadFloatComponents(yCoords, dimensions[1]);
+  this->ReadFloatComponents(zCoords, dimensions[2]);
   if (iblanked)
     {
     vtkWarningMacro("VTK does not handle blanking for rectilinear grids.");
@@ -4119,6 +3923,64 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float *result,
   return 1;
 }
 
+// Internal function to read 'numTuples' floats into component 'component'
+// of the tuples listed in 'ids', or of the first tuples if 'ids' is NULL.
+// Returns zero if there was an error.
+int vtkEnSightGoldBinaryReader::ReadFloatComponent(vtkFloatArray *array,
+  int component, int numTuples, vtkIdList *ids)
+{
+  if (numTuples <= 0)
+    {
+    return 1;
+    }
+
+  // Values of single-component arrays are read straight into the array.
+  int numComps = array->GetNumberOfComponents();
+  if (!ids && numComps == 1)
+    {
+    return this->ReadFloatArray(array->GetPointer(0), numTuples);
+    }
+
+  std::vector<float> values(numTuples);
+  if (!this->ReadFloatArray(&values[0], numTuples))
+    {
+    return 0;
+    }
+  float *tuples = array->GetPointer(0) + component;
+  if (ids)
+    {
+    const vtkIdType *tupleIds = ids->GetPointer(0);
+    for (int i = 0; i < numTuples; i++)
+      {
+      tuples[tupleIds[i]*numComps] = values[i];
+      }
+    }
+  else
+    {
+    for (int i = 0; i < numTuples; i++)
+      {
+      tuples[i*numComps] = values[i];
+      }
+    }
+  return 1;
+}
+
+// Internal function to read all the components of 'numTuples' tuples,
+// which EnSight stores one component after the other.
+// Returns zero if there was an error.
+int vtkEnSightGoldBinaryReader::ReadFloatComponents(vtkFloatArray *array,
+  int numTuples, vtkIdList *ids)
+{
+  for (int c = 0; c < array->GetNumberOfComponents(); c++)
+    {
+    if (!this->ReadFloatComponent(array, c, numTuples, ids))
+      {
+      return 0;
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
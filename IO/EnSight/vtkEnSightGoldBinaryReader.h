@@ -40,6 +40,9 @@
 #include "vtkIOEnSightModule.h" // For export macro
 #include "vtkEnSightReader.h"
 
+class vtkEnSightGoldBinaryReaderFileOffsets;
+class vtkFloatArray;
+class vtkIdList;
 class vtkMultiBlockDataSet;
 
 class VTKIOENSIGHT_EXPORT vtkEnSightGoldBinaryReader : public vtkEnSightReader
@@ -165,6 +168,21 @@ protected:
   // Returns zero if there was an error.
   int ReadFloatArray(float *result, int numFloats);
 
+  // Description:
+  // Internal function to read 'numTuples' floats into one component of
+  // 'array', at the tuples listed in 'ids' or at the first tuples if 'ids'
+  // is NULL.  The values are read in one block; those of single-component
+  // arrays are read in place.  Returns zero if there was an error.
+  int ReadFloatComponent(vtkFloatArray *array, int component, int numTuples,
+                         vtkIdList *ids = NULL);
+
+  // Description:
+  // Internal function to read all the components of 'numTuples' tuples of
+  // 'array', stored one component after the other as in EnSight files.
+  // Returns zero if there was an error.
+  int ReadFloatComponents(vtkFloatArray *array, int numTuples,
+                          vtkIdList *ids = NULL);
+
   // Description:
   // Counts the number of timesteps in the geometry file
   // This function assumes the file is already open and returns the
@@ -173,8 +191,20 @@ protected:
   int CountTimeSteps();
 
   // Description:
-  // Read to the next time step in the geometry file.
-  int SkipTimeStep();
+  // Seek to the closest time step of the open file set file whose offset
+  // is known, at or before 'timeStep' (counted from 0).  Returns the time
+  // step reached, or 0 if none is known and the file was not moved.
+  int SeekToCachedTimeStep(int timeStep);
+
+  // Description:
+  // Read up to the "BEGIN TIME STEP" line of the next time step of the
+  // open file set file, and record its offset as that of 'timeStep'.
+  // Returns zero if the end of the file was reached.
+  int ReadTimeStepBegin(int timeStep, char line[80]);
+
+  // Description:
+  // Read to the next time step in the geometry file, which is 'timeStep'.
+  int SkipTimeStep(int timeStep);
   int SkipStructuredGrid(char line[256]);
   int SkipUnstructuredGrid(char line[256]);
   int SkipRectilinearGrid(char line[256]);
@@ -188,6 +218,9 @@ protected:
   // The size of the file could be used to choose byte order.
   vtkIdType FileSize;
 
+  // The offsets of the time steps of the file set files read so far.
+  vtkEnSightGoldBinaryReaderFileOffsets *FileOffsets;
+
 private:
   int SizeOfInt;
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&);  // Not implemented.
@@ -67,6 +67,30 @@ void printLRUBack( vtkExodusIICacheRef& cit )
 
 vtkStandardNewMacro(vtkExodusIICache);
 
+// The shared caches by file name. The map is never destroyed so that caches
+// released during static destruction can still remove themselves from it.
+static std::map<std::string,vtkExodusIICache*>& vtkExodusIISharedCaches()
+{
+  static std::map<std::string,vtkExodusIICache*>* caches =
+    new std::map<std::string,vtkExodusIICache*>;
+  return *caches;
+}
+
+vtkExodusIICache* vtkExodusIICache::GetSharedCache( const char* fileName )
+{
+  std::map<std::string,vtkExodusIICache*>& caches = vtkExodusIISharedCaches();
+  std::map<std::string,vtkExodusIICache*>::iterator it = caches.find( fileName );
+  if ( it != caches.end() )
+    {
+    it->second->Register( 0 );
+    return it->second;
+    }
+  vtkExodusIICache* cache = vtkExodusIICache::New();
+  cache->SharedFileName = fileName;
+  caches[cache->SharedFileName] = cache;
+  return cache;
+}
+
 vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
@@ -76,6 +100,10 @@ vtkExodusIICache::vtkExodusIICache()
 vtkExodusIICache::~vtkExodusIICache()
 {
   this->ReduceToSize( 0. );
+  if ( ! this->SharedFileName.empty() )
+    {
+    vtkExodusIISharedCaches().erase( this->SharedFileName );
+    }
 }
 
 void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
@@ -85,6 +113,7 @@ void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "SharedFileName: " << this->SharedFileName << "\n";
 }
 
 void vtkExodusIICache::Clear()
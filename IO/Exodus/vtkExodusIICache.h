@@ -22,12 +22,17 @@
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// Several readers of the same file can share the arrays read from it
+// through the cache returned by GetSharedCache(). A cache is not
+// thread-safe; the reader makes sure only one thread uses it at a time.
 
 #include "vtkIOExodusModule.h" // For export macro
 #include "vtkObject.h"
 
 #include <map> // used for cache storage
 #include <list> // use for LRU ordering
+#include <string> // used for the shared cache file name
 
 //BTX
 class VTKIOEXODUS_EXPORT vtkExodusIICacheKey
@@ -125,12 +130,22 @@ public:
   vtkTypeMacro(vtkExodusIICache,vtkObject);
   void PrintSelf( ostream& os, vtkIndent indent );
 
+  /** Return the cache shared by all the readers of the file \a fileName,
+    * creating it if no reader holds it. The caller owns a reference to the
+    * returned cache and must Delete() it when it is done with the file.
+    */
+  static vtkExodusIICache* GetSharedCache( const char* fileName );
+
   /// Empty the cache
   void Clear();
 
   /// Set the maximum allowable cache size. This will remove cache entries if the capacity is reduced below the current size.
   void SetCacheCapacity( double sizeInMiB );
 
+  /// Get the maximum allowable cache size in MiB.
+  double GetCacheCapacity()
+    { return this->Capacity; }
+
   /** See how much cache space is left.
     * This is the difference between the capacity and the size of the cache.
     * The result is in MiB.
@@ -198,6 +213,9 @@ protected:
 
   /// The actual LRU list (indices into the cache ordered least to most recently used).
   vtkExodusIICacheLRU LRU;
+
+  /// The file whose readers share this cache, or an empty string for a private cache.
+  std::string SharedFileName;
   //ETX
 
 private:
@@ -27,10 +27,12 @@
 #include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
+#include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkMutableDirectedGraph.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -347,6 +349,7 @@ void vtkExodusIIReaderPrivate::ArrayInfoType::Reset()
 
 // ------------------------------------------------------- PRIVATE CLASS MEMBERS
 vtkStandardNewMacro(vtkExodusIIReaderPrivate);
+vtkInformationKeyRestrictedMacro(vtkExodusIIReaderPrivate, NODE_RANGE, IntegerVector, 2);
 
 //-----------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
@@ -359,6 +362,12 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
+  this->SharedCache = 0;
+
+  this->PrefetchThreader = vtkMultiThreader::New();
+  this->PrefetchThreadId = -1;
+  this->PrefetchNodes[0] = 0;
+  this->PrefetchNodes[1] = -1;
 
   this->TimeStep = 0;
   this->HasModeShapes = 0;
@@ -394,9 +403,12 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //-----------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->WaitForPrefetch();
+  this->PrefetchThreader->Delete();
   this->CloseFile();
   this->Cache->Delete();
   this->CacheSize = 0;
+  this->SetSharedCacheFile( 0 );
   this->ClearConnectivityCaches();
   this->SetFastPathIdType( 0 );
   if(this->Parser)
@@ -620,6 +632,16 @@ int vtkExodusIIReaderPrivate::AssembleOutputPointArrays(
   std::vector<ArrayInfoType>::iterator ai;
   int aidx = 0;
 
+  // Squeezed points only need the values of the nodes of this block or set,
+  // so only the span of nodes it uses is read.
+  vtkIdType first = 0;
+  vtkIdType last = this->ModelParameters.num_nodes - 1;
+  if ( this->SqueezePoints )
+    {
+    first = bsinfop->PointMap.empty() ? 0 : bsinfop->PointMap.begin()->first;
+    last = bsinfop->PointMap.empty() ? -1 : bsinfop->PointMap.rbegin()->first;
+    }
+
   for (
     ai = this->ArrayInfo[ vtkExodusIIReader::NODAL ].begin();
     ai != this->ArrayInfo[ vtkExodusIIReader::NODAL ].end();
@@ -629,7 +651,7 @@ int vtkExodusIIReaderPrivate::AssembleOutputPointArrays(
       continue; // Skip arrays we don't want.
 
     vtkExodusIICacheKey key( timeStep, vtkExodusIIReader::NODAL, 0, aidx );
-    vtkDataArray* src = this->GetCacheOrRead( key );
+    vtkDataArray* src = this->GetCacheOrReadNodes( key, first, last );
     if ( !src )
       {
       vtkDebugMacro( "Unable to read point array " << ai->Name.c_str() << " at time step " << timeStep );
@@ -1487,6 +1509,12 @@ void vtkExodusIIReaderPrivate::InsertSetSides(
 //-----------------------------------------------------------------------------
 vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key )
 {
+  if ( key.ObjectType == vtkExodusIIReader::NODAL )
+    {
+    return this->GetCacheOrReadNodes( key, 0, this->ModelParameters.num_nodes - 1 );
+    }
+
+  vtkExodusIICache* cache = this->GetCacheFor( key );
   vtkDataArray* arr;
   // Never cache points deflected for a mode shape animation... doubles don't make good keys.
   if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
@@ -1495,7 +1523,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     }
   else
     {
-    arr = this->Cache->Find( key );
+    arr = cache->Find( key );
     }
 
   if ( arr )
@@ -1504,6 +1532,155 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     return arr;
     }
 
+  arr = this->ReadArray( key );
+
+  // Even if the array is larger than the allowable cache size, it will keep the most recent insertion.
+  // So, we delete our reference knowing that the Cache will keep the object "alive" until whatever
+  // called GetCacheOrRead() references the array. But, once you get an array from GetCacheOrRead(),
+  // you better start running!
+  if ( arr )
+    {
+    cache->Insert( key, arr );
+    arr->FastDelete();
+    }
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrReadNodes(
+  vtkExodusIICacheKey key, vtkIdType first, vtkIdType last )
+{
+  vtkExodusIICache* cache = this->GetCacheFor( key );
+  vtkDataArray* arr = cache->Find( key );
+  if ( ! arr )
+    {
+    arr = this->ReadNodalArray( key, first, last );
+    if ( arr )
+      {
+      cache->Insert( key, arr );
+      arr->FastDelete();
+      }
+    return arr;
+    }
+
+  // The cached array may only hold the nodes of the blocks enabled when it
+  // was read. Read the nodes missing on either side of them.
+  int* range = arr->GetInformation()->Get( NODE_RANGE() );
+  if ( first > last || ( first >= range[0] && last <= range[1] ) )
+    {
+    return arr;
+    }
+  int status = 1;
+  if ( range[0] > range[1] )
+    {
+    status = this->ReadNodes( arr, key, first, last );
+    }
+  else
+    {
+    if ( first < range[0] )
+      {
+      status = this->ReadNodes( arr, key, first, range[0] - 1 );
+      }
+    if ( status && last > range[1] )
+      {
+      status = this->ReadNodes( arr, key, range[1] + 1, last );
+      }
+    first = first < range[0] ? first : range[0];
+    last = last > range[1] ? last : range[1];
+    }
+  if ( ! status )
+    {
+    cache->Invalidate( key );
+    return 0;
+    }
+  int nodes[2] = { static_cast<int>( first ), static_cast<int>( last ) };
+  arr->GetInformation()->Set( NODE_RANGE(), nodes, 2 );
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::ReadNodalArray(
+  vtkExodusIICacheKey key, vtkIdType first, vtkIdType last )
+{
+  ArrayInfoType* ainfop = &this->ArrayInfo[vtkExodusIIReader::NODAL][key.ArrayId];
+  int ncomps = ( this->ModelParameters.num_dim == 2 && ainfop->Components == 2 ) ? 3 : ainfop->Components;
+  vtkDataArray* arr = vtkDataArray::CreateDataArray( ainfop->StorageType );
+  arr->SetName( ainfop->Name.c_str() );
+  arr->SetNumberOfComponents( ncomps );
+  arr->SetNumberOfTuples( this->ModelParameters.num_nodes );
+  if ( ncomps != ainfop->Components )
+    {
+    arr->FillComponent( 2, 0. );
+    }
+  if ( ! this->ReadNodes( arr, key, first, last ) )
+    {
+    arr->Delete();
+    return 0;
+    }
+  int nodes[2] = { static_cast<int>( first ), static_cast<int>( last ) };
+  arr->GetInformation()->Set( NODE_RANGE(), nodes, 2 );
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+int vtkExodusIIReaderPrivate::ReadNodes( vtkDataArray* arr,
+  vtkExodusIICacheKey key, vtkIdType first, vtkIdType last )
+{
+  int exoid = this->Exoid;
+  ArrayInfoType* ainfop = &this->ArrayInfo[vtkExodusIIReader::NODAL][key.ArrayId];
+  int count = static_cast<int>( last - first + 1 );
+  if ( count <= 0 )
+    {
+    return 1;
+    }
+  if ( arr->GetNumberOfComponents() == 1 )
+    {
+    // ex_get_n_var reads a hyperslab of the variable with 1-based node numbers.
+    if ( ex_get_n_var( exoid, key.Time + 1, EX_NODAL,
+        ainfop->OriginalIndices[0], 0, static_cast<int>( first ) + 1, count,
+        arr->GetVoidPointer( first ) ) < 0 )
+      {
+      vtkErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
+      return 0;
+      }
+    return 1;
+    }
+
+  // Exodus doesn't support reading with a stride, so we have to manually interleave the arrays. Bleh.
+  std::vector<std::vector<double> > tmpVal;
+  tmpVal.resize( ainfop->Components );
+  int c;
+  for ( c = 0; c < ainfop->Components; ++c )
+    {
+    tmpVal[c].resize( count );
+    if ( ex_get_n_var( exoid, key.Time + 1, EX_NODAL,
+        ainfop->OriginalIndices[c], 0, static_cast<int>( first ) + 1, count,
+        &tmpVal[c][0] ) < 0)
+      {
+      vtkErrorMacro( "Could not read nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
+      return 0;
+      }
+    }
+  int ncomps = arr->GetNumberOfComponents();
+  int t;
+  std::vector<double> tmpTuple;
+  tmpTuple.resize( ncomps );
+  tmpTuple[ncomps - 1] = 0.; // In case we're embedding a 2-D vector in 3-D
+  for ( t = 0; t < count; ++t )
+    {
+    for ( c = 0; c < ainfop->Components; ++c )
+      {
+      tmpTuple[c] = tmpVal[c][t];
+      }
+    arr->SetTuple( first + t, &tmpTuple[0] );
+    }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::ReadArray( vtkExodusIICacheKey key )
+{
+  vtkDataArray* arr = 0;
   int exoid = this->Exoid;
 
   // If array is NULL, try reading it from file.
@@ -1530,60 +1707,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   else if ( key.ObjectType == vtkExodusIIReader::NODAL )
     {
     // read nodal array
-    ArrayInfoType* ainfop = &this->ArrayInfo[vtkExodusIIReader::NODAL][key.ArrayId];
-    int ncomps = ( this->ModelParameters.num_dim == 2 && ainfop->Components == 2 ) ? 3 : ainfop->Components;
-    arr = vtkDataArray::CreateDataArray( ainfop->StorageType );
-    arr->SetName( ainfop->Name.c_str() );
-    arr->SetNumberOfComponents( ncomps );
-    arr->SetNumberOfTuples( this->ModelParameters.num_nodes );
-    if ( ncomps != ainfop->Components )
-      {
-      arr->FillComponent( 2, 0. );
-      }
-    if ( ncomps == 1 )
-      {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-          ainfop->OriginalIndices[0], 0, arr->GetNumberOfTuples(),
-          arr->GetVoidPointer( 0 ) ) < 0 )
-        {
-        vtkErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
-        arr->Delete();
-        arr = 0;
-        }
-      }
-    else
-      {
-      // Exodus doesn't support reading with a stride, so we have to manually interleave the arrays. Bleh.
-      std::vector<std::vector<double> > tmpVal;
-      tmpVal.resize( ainfop->Components );
-      int c;
-      for ( c = 0; c < ainfop->Components; ++c )
-        {
-        vtkIdType N = this->ModelParameters.num_nodes;
-        tmpVal[c].resize( N );
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-            ainfop->OriginalIndices[c], 0, arr->GetNumberOfTuples(),
-            &tmpVal[c][0] ) < 0)
-          {
-          vtkErrorMacro( "Could not read nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
-          arr->Delete();
-          arr = 0;
-          return 0;
-          }
-        }
-      int t;
-      std::vector<double> tmpTuple;
-      tmpTuple.resize( ncomps );
-      tmpTuple[ncomps - 1] = 0.; // In case we're embedding a 2-D vector in 3-D
-      for ( t = 0; t < arr->GetNumberOfTuples(); ++t )
-        {
-        for ( c = 0; c < ainfop->Components; ++c )
-          {
-          tmpTuple[c] = tmpVal[c][t];
-          }
-        arr->SetTuple( t, &tmpTuple[0] );
-        }
-      }
+    arr = this->ReadNodalArray( key, 0, this->ModelParameters.num_nodes - 1 );
     }
   else if ( key.ObjectType == vtkExodusIIReader::GLOBAL_TEMPORAL )
     {
@@ -2651,15 +2775,6 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr = 0;
     }
 
-  // Even if the array is larger than the allowable cache size, it will keep the most recent insertion.
-  // So, we delete our reference knowing that the Cache will keep the object "alive" until whatever
-  // called GetCacheOrRead() references the array. But, once you get an array from GetCacheOrRead(),
-  // you better start running!
-  if ( arr )
-    {
-    this->Cache->Insert( key, arr );
-    arr->FastDelete();
-    }
   return arr;
 }
 
@@ -3337,6 +3452,8 @@ void vtkExodusIIReader::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "ExodusModel: " << this->ExodusModel << "\n";
   os << indent << "SILUpdateStamp: " << this->SILUpdateStamp << "\n";
   os << indent << "ProducedFastPathOutput: " << this->ProducedFastPathOutput << "\n";
+  os << indent << "ShareCache: " << this->ShareCache << "\n";
+  os << indent << "Prefetch: " << this->Prefetch << "\n";
   if ( this->Metadata )
     {
     os << indent << "Metadata:\n";
@@ -3356,6 +3473,7 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
   os << indent << "AppWordSize: " << this->AppWordSize << "\n";
   os << indent << "DiskWordSize: " << this->DiskWordSize << "\n";
   os << indent << "ExodusVersion: " << this->ExodusVersion << "\n";
+  os << indent << "SharedCacheFile: " << this->SharedCacheFile << "\n";
   os << indent << "ModelParameters:\n";
 
   vtkIndent inden2 = indent.GetNextIndent();
@@ -4305,6 +4423,7 @@ int vtkExodusIIReaderPrivate::SetUpEmptyGrid( vtkMultiBlockDataSet* output )
 
 void vtkExodusIIReaderPrivate::Reset()
 {
+  this->WaitForPrefetch();
   this->CloseFile();
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
   this->BlockInfo.clear();
@@ -4358,8 +4477,11 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  this->WaitForPrefetch();
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+  // The arrays of the shared cache stay with the other readers of the file.
+  this->SetSharedCacheFile( 0 );
   this->ClearConnectivityCaches();
 }
 
@@ -4367,12 +4489,235 @@ void vtkExodusIIReaderPrivate::SetCacheSize( double size )
 {
   if (this->CacheSize != size)
     {
+    this->WaitForPrefetch();
     this->CacheSize = size;
     this->Cache->SetCacheCapacity(this->CacheSize);
+    // The shared cache holds as much as the largest cache of its readers.
+    if ( this->SharedCache && this->SharedCache->GetCacheCapacity() < size )
+      {
+      this->SharedCache->SetCacheCapacity( size );
+      }
     this->Modified();
     }
 }
 
+void vtkExodusIIReaderPrivate::SetSharedCacheFile( const char* filename )
+{
+  std::string name;
+  if ( filename && *filename )
+    {
+    name = vtksys::SystemTools::CollapseFullPath( filename );
+    }
+  if ( name == this->SharedCacheFile )
+    {
+    return;
+    }
+  this->WaitForPrefetch();
+  if ( this->SharedCache )
+    {
+    this->SharedCache->Delete();
+    this->SharedCache = 0;
+    }
+  this->SharedCacheFile = name;
+  if ( ! name.empty() )
+    {
+    this->SharedCache = vtkExodusIICache::GetSharedCache( name.c_str() );
+    if ( this->SharedCache->GetCacheCapacity() < this->CacheSize )
+      {
+      this->SharedCache->SetCacheCapacity( this->CacheSize );
+      }
+    }
+}
+
+vtkExodusIICache* vtkExodusIIReaderPrivate::GetCacheFor( const vtkExodusIICacheKey& key )
+{
+  if ( ! this->SharedCache )
+    {
+    return this->Cache;
+    }
+  // Only result variables are shared; other arrays depend on the settings
+  // of each reader (displacements, squeezed points, generated ids, ...).
+  switch ( key.ObjectType )
+    {
+  case vtkExodusIIReader::NODAL:
+  case vtkExodusIIReader::EDGE_BLOCK:
+  case vtkExodusIIReader::FACE_BLOCK:
+  case vtkExodusIIReader::ELEM_BLOCK:
+  case vtkExodusIIReader::NODE_SET:
+  case vtkExodusIIReader::EDGE_SET:
+  case vtkExodusIIReader::FACE_SET:
+  case vtkExodusIIReader::SIDE_SET:
+  case vtkExodusIIReader::ELEM_SET:
+    return this->SharedCache;
+  default:
+    return this->Cache;
+    }
+}
+
+// The readers whose prefetch thread is running.
+static std::set<vtkExodusIIReaderPrivate*>& vtkExodusIIPrefetchingReaders()
+{
+  static std::set<vtkExodusIIReaderPrivate*> readers;
+  return readers;
+}
+
+static VTK_THREAD_RETURN_TYPE vtkExodusIIReaderPrefetchThread( void* arg )
+{
+  vtkExodusIIReaderPrivate* self = static_cast<vtkExodusIIReaderPrivate*>(
+    static_cast<vtkMultiThreader::ThreadInfo*>( arg )->UserData );
+  self->ExecutePrefetch();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+void vtkExodusIIReaderPrivate::StartPrefetch( const char* filename, int timeStep )
+{
+  this->WaitForPrefetch();
+  if ( ! filename || timeStep < 0 || timeStep >= this->GetNumberOfTimeSteps() ||
+       this->HasModeShapes )
+    {
+    return;
+    }
+
+  // Collect the enabled cell variables and the span of the nodes used by
+  // the enabled blocks and sets, as RequestData() will need them.
+  this->PrefetchKeys.clear();
+  this->PrefetchNodes[0] = 0;
+  this->PrefetchNodes[1] = this->ModelParameters.num_nodes - 1;
+  if ( this->SqueezePoints )
+    {
+    this->PrefetchNodes[0] = this->ModelParameters.num_nodes;
+    this->PrefetchNodes[1] = -1;
+    }
+  for ( int conntypidx = 0; conntypidx < num_conn_types; ++conntypidx )
+    {
+    int otypidx = conn_obj_idx_cvt[conntypidx];
+    int otyp = obj_types[otypidx];
+    int numObj = this->GetNumberOfObjectsOfType( otyp );
+    std::map<int,std::vector<ArrayInfoType> >::iterator ami = this->ArrayInfo.find( otyp );
+    for ( int obj = 0; obj < numObj; ++obj )
+      {
+      BlockSetInfoType* bsinfop = static_cast<BlockSetInfoType*>( this->GetObjectInfo( otypidx, obj ) );
+      if ( ! bsinfop->Status )
+        {
+        continue;
+        }
+      if ( this->SqueezePoints && ! bsinfop->PointMap.empty() )
+        {
+        this->PrefetchNodes[0] = std::min( this->PrefetchNodes[0], bsinfop->PointMap.begin()->first );
+        this->PrefetchNodes[1] = std::max( this->PrefetchNodes[1], bsinfop->PointMap.rbegin()->first );
+        }
+      if ( ami == this->ArrayInfo.end() )
+        {
+        continue;
+        }
+      for ( int aidx = 0; aidx < (int) ami->second.size(); ++aidx )
+        {
+        if ( ami->second[aidx].Status && ami->second[aidx].ObjectTruth[obj] )
+          {
+          this->PrefetchKeys.push_back( vtkExodusIICacheKey( timeStep, otyp, obj, aidx ) );
+          }
+        }
+      }
+    }
+  std::vector<ArrayInfoType>& nodal = this->ArrayInfo[vtkExodusIIReader::NODAL];
+  for ( int aidx = 0; aidx < (int) nodal.size(); ++aidx )
+    {
+    if ( nodal[aidx].Status )
+      {
+      this->PrefetchKeys.push_back( vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, 0, aidx ) );
+      }
+    }
+  // Displacements are applied to all the nodes.
+  int displacements = this->ApplyDisplacements ? this->GetDisplacementArrayIndex() : -1;
+  if ( displacements >= 0 )
+    {
+    this->PrefetchKeys.push_back( vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, -1, displacements ) );
+    }
+
+  // Arrays already cached are not read again.
+  std::vector<vtkExodusIICacheKey>::iterator it = this->PrefetchKeys.begin();
+  while ( it != this->PrefetchKeys.end() )
+    {
+    vtkExodusIICacheKey key( *it );
+    key.ObjectId = key.ObjectType == vtkExodusIIReader::NODAL ? 0 : key.ObjectId;
+    it = this->GetCacheFor( key )->Find( key ) ? this->PrefetchKeys.erase( it ) : it + 1;
+    }
+  if ( this->PrefetchKeys.empty() )
+    {
+    return;
+    }
+
+  this->PrefetchFile = filename;
+  if ( ! this->PrefetchThreader )
+    {
+    this->PrefetchThreader = vtkMultiThreader::New();
+    }
+  this->PrefetchThreadId =
+    this->PrefetchThreader->SpawnThread( vtkExodusIIReaderPrefetchThread, this );
+  vtkExodusIIPrefetchingReaders().insert( this );
+}
+
+void vtkExodusIIReaderPrivate::ExecutePrefetch()
+{
+  if ( ! this->OpenFile( this->PrefetchFile.c_str() ) )
+    {
+    return;
+    }
+  std::vector<vtkExodusIICacheKey>::iterator it;
+  for ( it = this->PrefetchKeys.begin(); it != this->PrefetchKeys.end(); ++it )
+    {
+    vtkExodusIICacheKey key( *it );
+    vtkDataArray* arr;
+    if ( key.ObjectType == vtkExodusIIReader::NODAL )
+      {
+      // An ObjectId of -1 marks the displacements, needed for all nodes.
+      bool allNodes = key.ObjectId < 0;
+      key.ObjectId = 0;
+      arr = allNodes ?
+        this->ReadNodalArray( key, 0, this->ModelParameters.num_nodes - 1 ) :
+        this->ReadNodalArray( key, this->PrefetchNodes[0], this->PrefetchNodes[1] );
+      }
+    else
+      {
+      arr = this->ReadArray( key );
+      }
+    if ( ! arr )
+      {
+      continue;
+      }
+    // Never evict arrays: the application may be using them meanwhile.
+    vtkExodusIICache* cache = this->GetCacheFor( key );
+    if ( ! cache->Find( key ) &&
+         arr->GetActualMemorySize() / 1024. <= cache->GetSpaceLeft() )
+      {
+      cache->Insert( key, arr );
+      }
+    arr->Delete();
+    }
+  this->CloseFile();
+}
+
+void vtkExodusIIReaderPrivate::WaitForPrefetch()
+{
+  if ( this->PrefetchThreadId < 0 )
+    {
+    return;
+    }
+  this->PrefetchThreader->TerminateThread( this->PrefetchThreadId );
+  this->PrefetchThreadId = -1;
+  vtkExodusIIPrefetchingReaders().erase( this );
+}
+
+void vtkExodusIIReaderPrivate::WaitForAllPrefetches()
+{
+  std::set<vtkExodusIIReaderPrivate*> readers = vtkExodusIIPrefetchingReaders();
+  std::set<vtkExodusIIReaderPrivate*>::iterator it;
+  for ( it = readers.begin(); it != readers.end(); ++it )
+    {
+    (*it)->WaitForPrefetch();
+    }
+}
+
 bool vtkExodusIIReaderPrivate::IsXMLMetadataValid()
 {
   // Make sure that each block id referred to in the metadata arrays exist
@@ -4643,6 +4988,7 @@ void vtkExodusIIReaderPrivate::SetObjectArrayStatus( int otyp, int i, int stat )
       // no change => do nothing
       return;
       }
+    this->WaitForPrefetch();
     it->second[i].Status = stat;
     this->Modified();
     // FIXME: Mark something so we know what's changed since the last RequestData?!
@@ -4817,6 +5163,7 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements( int d )
   this->Modified();
 
   // Require the coordinates to be recomputed:
+  this->WaitForPrefetch();
   this->Cache->Invalidate(
     vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
     vtkExodusIICacheKey( 0, 1, 0, 0 ) );
@@ -4831,12 +5178,23 @@ void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
   this->Modified();
 
   // Require the coordinates to be recomputed:
+  this->WaitForPrefetch();
   this->Cache->Invalidate(
     vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
     vtkExodusIICacheKey( 0, 1, 0, 0 ) );
 }
 
 vtkDataArray* vtkExodusIIReaderPrivate::FindDisplacementVectors( int timeStep )
+{
+  int i = this->GetDisplacementArrayIndex();
+  if ( i >= 0 )
+    {
+    return this->GetCacheOrRead( vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, 0, i ) );
+    }
+  return 0;
+}
+
+int vtkExodusIIReaderPrivate::GetDisplacementArrayIndex()
 {
   std::map<int,std::vector<ArrayInfoType> >::iterator it = this->ArrayInfo.find( vtkExodusIIReader::NODAL );
   if ( it != this->ArrayInfo.end() )
@@ -4847,11 +5205,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::FindDisplacementVectors( int timeStep )
       std::string upperName = vtksys::SystemTools::UpperCase( it->second[i].Name.substr( 0, 3 ) );
       if ( upperName == "DIS" && it->second[i].Components == this->ModelParameters.num_dim )
         {
-        return this->GetCacheOrRead( vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, 0, i ) );
+        return i;
         }
       }
     }
-  return 0;
+  return -1;
 }
 
 
@@ -4877,6 +5235,8 @@ vtkExodusIIReader::vtkExodusIIReader()
   this->DisplayType = 0;
   this->SILUpdateStamp = -1;
   this->ProducedFastPathOutput = false;
+  this->ShareCache = 0;
+  this->Prefetch = 0;
 
   this->SetNumberOfInputPorts( 0 );
 }
@@ -4901,6 +5261,8 @@ int vtkExodusIIReader::CanReadFile( const char* fname )
   int diskWordSize = 8;
   float version;
 
+  // The exodus library may not be used by several threads at once.
+  vtkExodusIIReaderPrivate::WaitForAllPrefetches();
   if ( (exoid = ex_open( fname, EX_READ, &appWordSize, &diskWordSize, &version )) < 0 )
     {
     return 0;
@@ -5021,6 +5383,8 @@ int vtkExodusIIReader::RequestInformation(
   int newMetadata = 0;
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
+  vtkExodusIIReaderPrivate::WaitForAllPrefetches();
+
   // If the metadata is older than the filename
   if ( this->GetMetadataMTime() < this->FileNameMTime )
     {
@@ -5089,11 +5453,14 @@ int vtkExodusIIReader::RequestData(
   vtkInformationVector* outputVector )
 {
   this->ProducedFastPathOutput = false;
+  // Prefetches of this and other readers may be filling the caches.
+  vtkExodusIIReaderPrivate::WaitForAllPrefetches();
   if ( ! this->FileName || ! this->Metadata->OpenFile( this->FileName ) )
     {
     vtkErrorMacro( "Unable to open file \"" << (this->FileName ? this->FileName : "(null)") << "\" to read data" );
     return 0;
     }
+  this->Metadata->SetSharedCacheFile( this->ShareCache ? this->FileName : 0 );
 
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkMultiBlockDataSet *output = vtkMultiBlockDataSet::SafeDownCast( outInfo->Get( vtkDataObject::DATA_OBJECT() ) );
@@ -5178,6 +5545,12 @@ int vtkExodusIIReader::RequestData(
   this->Metadata->RequestData( this->TimeStep, output );
   this->ProducedFastPathOutput = this->Metadata->ProducedFastPathOutput;
 
+  // Read the next time step while the application uses this one.
+  if ( this->Prefetch && ! this->GetHasModeShapes() )
+    {
+    this->Metadata->StartPrefetch( this->FileName, this->TimeStep + 1 );
+    }
+
   // Restore previous fastpath values so we don't respond to old pipeline requests
   if ( haveFastPath )
     {
@@ -6158,6 +6531,7 @@ void vtkExodusIIReader::ResetCache()
 
 void vtkExodusIIReader::UpdateTimeInformation()
 {
+  vtkExodusIIReaderPrivate::WaitForAllPrefetches();
   if ( this->Metadata->OpenFile( this->FileName ) )
     {
     this->Metadata->UpdateTimeInformation();
@@ -701,6 +701,27 @@ public:
   // Get the size of the cache in MiB.
   double GetCacheSize();
 
+  // Description:
+  // When on, the result variables read from the file are kept in a cache
+  // shared by all the readers of the same file, so that readers showing
+  // different blocks or views of one file read each time step once.  The
+  // shared cache is as large as the largest CacheSize of its readers.
+  // Default is off.
+  vtkSetMacro(ShareCache, int);
+  vtkGetMacro(ShareCache, int);
+  vtkBooleanMacro(ShareCache, int);
+
+  // Description:
+  // When on, after each update the variables enabled for the next time
+  // step are read on a background thread, so that stepping forward in
+  // time finds them in the cache.  Only the nodes used by the enabled
+  // blocks and sets are read when points are squeezed.  Prefetched arrays
+  // are kept only if they fit in the free space of the cache, so CacheSize
+  // must be large enough to hold a time step.  Default is off.
+  vtkSetMacro(Prefetch, int);
+  vtkGetMacro(Prefetch, int);
+  vtkBooleanMacro(Prefetch, int);
+
   // Description:
   // Re-reads time information from the exodus file and updates
   // TimeStepRange accordingly.
@@ -786,6 +807,9 @@ protected:
 
   int SILUpdateStamp;
   bool ProducedFastPathOutput;
+
+  int ShareCache;
+  int Prefetch;
 private:
   vtkExodusIIReader(const vtkExodusIIReader&); // Not implemented
   void operator=(const vtkExodusIIReader&); // Not implemented
@@ -9,11 +9,14 @@
 #include "vtksys/RegularExpression.hxx"
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include "vtk_exodusII.h"
 #include "vtkIOExodusModule.h" // For export macro
 class vtkExodusIIReaderParser;
+class vtkInformationIntegerVectorKey;
+class vtkMultiThreader;
 class vtkMutableDirectedGraph;
 
 /** This class holds metadata for an Exodus file.
@@ -77,6 +80,34 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /** Share the cache of result variables with the other readers of the file
+    * \a filename, or stop sharing it if \a filename is NULL.
+    */
+  void SetSharedCacheFile( const char* filename );
+
+  /** Start reading the enabled result variables of \a timeStep into the
+    * cache on a background thread. The file \a filename is opened again by
+    * the thread. The arrays that do not fit in the cache are dropped.
+    */
+  void StartPrefetch( const char* filename, int timeStep );
+
+  /// Read the arrays of the prefetch. Called on the prefetch thread.
+  void ExecutePrefetch();
+
+  /// Wait for the prefetch of this reader, if any.
+  void WaitForPrefetch();
+
+  /** Wait for the prefetches of all readers. Exodus and NetCDF calls are
+    * not thread-safe, so this must be called before any file access.
+    */
+  static void WaitForAllPrefetches();
+
+  /** The range of nodes whose values have been read in a nodal array. Nodal
+    * arrays read for squeezed points only hold the values of the nodes used
+    * by the enabled blocks and sets.
+    */
+  static vtkInformationIntegerVectorKey* NODE_RANGE();
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -600,6 +631,34 @@ protected:
     */
   vtkDataArray* GetCacheOrRead( vtkExodusIICacheKey );
 
+  /** Return a nodal array for the specified cache key holding at least the
+    * values of nodes \a first to \a last. Only the missing nodes are read
+    * when the array is already cached.
+    */
+  vtkDataArray* GetCacheOrReadNodes(
+    vtkExodusIICacheKey key, vtkIdType first, vtkIdType last );
+
+  /** Read the array of the specified cache key from the file, without
+    * looking in or adding to the cache. Returns a new array or 0.
+    */
+  vtkDataArray* ReadArray( vtkExodusIICacheKey key );
+
+  /** Read a nodal array holding the values of nodes \a first to \a last
+    * (0-based) only. Returns a new array or 0.
+    */
+  vtkDataArray* ReadNodalArray(
+    vtkExodusIICacheKey key, vtkIdType first, vtkIdType last );
+
+  /// Read the values of nodes \a first to \a last into \a arr.
+  int ReadNodes( vtkDataArray* arr, vtkExodusIICacheKey key,
+    vtkIdType first, vtkIdType last );
+
+  /// Return the shared cache for arrays read as-is from the file, or Cache.
+  vtkExodusIICache* GetCacheFor( const vtkExodusIICacheKey& key );
+
+  /// Return the index of the nodal displacement array or -1.
+  int GetDisplacementArrayIndex();
+
   /** Return the index of an object type (in a private list of all object types).
     * This returns a 0-based index if the object type was found and -1 if it
     * was not.
@@ -788,6 +847,20 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /** The cache shared with the other readers of the same file, or NULL.
+    * It holds the result variables read as-is from the file.
+    */
+  vtkExodusIICache* SharedCache;
+  std::string SharedCacheFile;
+
+  /// The thread reading the arrays of the next time step.
+  vtkMultiThreader* PrefetchThreader;
+  int PrefetchThreadId;
+  std::string PrefetchFile;
+  std::vector<vtkExodusIICacheKey> PrefetchKeys;
+  /// The nodes used by the enabled blocks and sets when points are squeezed.
+  vtkIdType PrefetchNodes[2];
+
   int ApplyDisplacements;
   float DisplacementMagnitude;
   int HasModeShapes;
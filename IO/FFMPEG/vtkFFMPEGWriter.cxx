@@ -292,8 +292,6 @@ int vtkFFMPEGWriterInternal::Start()
 //---------------------------------------------------------------------------
 int vtkFFMPEGWriterInternal::Write(vtkImageData *id)
 {
-  this->Writer->GetInputAlgorithm(0, 0)->UpdateWholeExtent();
-
   AVCodecContext *cc = this->avStream->codec;
 
   //copy the image from the input to the RGB buffer while flipping Y
@@ -459,6 +457,7 @@ vtkFFMPEGWriter::vtkFFMPEGWriter()
 //---------------------------------------------------------------------------
 vtkFFMPEGWriter::~vtkFFMPEGWriter()
 {
+  this->WaitForPendingFrames();
   delete this->Internals;
 }
 
@@ -542,7 +541,7 @@ void vtkFFMPEGWriter::Write()
     this->Initialized = 1;
     }
 
-  if (!this->Internals->Write(input))
+  if (!this->WriteFrame(input))
     {
     vtkErrorMacro("Error storing image.");
     this->Error = 1;
@@ -550,9 +549,21 @@ void vtkFFMPEGWriter::Write()
     }
 }
 
+//---------------------------------------------------------------------------
+int vtkFFMPEGWriter::EncodeFrame(vtkImageData *frame)
+{
+  return this->Internals->Write(frame);
+}
+
 //---------------------------------------------------------------------------
 void vtkFFMPEGWriter::End()
 {
+  if (!this->WaitForPendingFrames() && !this->Error)
+    {
+    vtkErrorMacro("Error storing image.");
+    this->Error = 1;
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    }
   this->Internals->End();
 
   delete this->Internals;
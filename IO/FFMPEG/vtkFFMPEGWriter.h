@@ -75,6 +75,9 @@ protected:
   vtkFFMPEGWriter();
   ~vtkFFMPEGWriter();
 
+  // Encode a frame, on the background thread in asynchronous mode.
+  virtual int EncodeFrame(vtkImageData *frame);
+
   vtkFFMPEGWriterInternal *Internals;
 
   int Initialized;
@@ -0,0 +1,235 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOpenFOAMReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that cases with one and two regions give the same data when
+// their regions and field files are read on one and several threads, and
+// that the mesh read at the first time step is reused by the following
+// time steps until one of them has a polyMesh of its own.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDirectory.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+#include <vtksys/ios/fstream>
+#include <vtksys/ios/sstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+void WriteFile(const std::string& path, const char* className,
+               const char* object, const std::string& body)
+{
+  vtksys_ios::ofstream file(path.c_str());
+  file << "FoamFile\n{\n  version 2.0;\n  format ascii;\n  class "
+       << className << ";\n  object " << object << ";\n}\n" << body;
+}
+
+// Two hexahedra stacked along z, the second one 'height' above the first.
+void WriteMesh(const std::string& dir, double height, bool pointsOnly)
+{
+  vtkDirectory::MakeDirectory(dir.c_str());
+  vtksys_ios::ostringstream points;
+  points << "12\n(\n";
+  for (int k = 0; k < 3; k++)
+    {
+    points << "(0 0 " << k * height << ")\n(1 0 " << k * height << ")\n"
+           << "(1 1 " << k * height << ")\n(0 1 " << k * height << ")\n";
+    }
+  points << ")\n";
+  WriteFile(dir + "/points", "vectorField", "points", points.str());
+  if (pointsOnly)
+    {
+    return;
+    }
+
+  // The internal face first, then the boundary faces pointing outwards.
+  vtksys_ios::ostringstream faces, owner;
+  faces << "11\n(\n4(4 5 6 7)\n4(0 3 2 1)\n4(8 9 10 11)\n";
+  owner << "11\n(\n0\n0\n1\n";
+  for (int c = 0; c < 2; c++)
+    {
+    int a = 4 * c, b = 4 * c + 4;
+    faces << "4(" << a << " " << a + 1 << " " << b + 1 << " " << b << ")\n"
+          << "4(" << a + 1 << " " << a + 2 << " " << b + 2 << " " << b + 1
+          << ")\n"
+          << "4(" << a + 2 << " " << a + 3 << " " << b + 3 << " " << b + 2
+          << ")\n"
+          << "4(" << a + 3 << " " << a << " " << b << " " << b + 3 << ")\n";
+    owner << c << "\n" << c << "\n" << c << "\n" << c << "\n";
+    }
+  faces << ")\n";
+  owner << ")\n";
+  WriteFile(dir + "/faces", "faceList", "faces", faces.str());
+  WriteFile(dir + "/owner", "labelList", "owner", owner.str());
+  WriteFile(dir + "/neighbour", "labelList", "neighbour", "1\n(\n1\n)\n");
+  WriteFile(dir + "/boundary", "polyBoundaryMesh", "boundary",
+            "1\n(\nwalls\n{\ntype wall;\nnFaces 10;\nstartFace 1;\n}\n)\n");
+}
+
+void WriteScalarField(const std::string& dir, const char* name, double value)
+{
+  vtksys_ios::ostringstream body;
+  body << "dimensions [0 0 0 0 0 0 0];\n"
+       << "internalField nonuniform List<scalar> 2(" << value << " "
+       << value + 1 << ");\n"
+       << "boundaryField\n{\nwalls\n{\ntype fixedValue;\nvalue uniform "
+       << value << ";\n}\n}\n";
+  WriteFile(dir + "/" + name, "volScalarField", name, body.str());
+}
+
+void WriteCase(const std::string& caseDir, bool solidRegion)
+{
+  vtkDirectory::MakeDirectory((caseDir + "/system").c_str());
+  WriteFile(caseDir + "/system/controlDict", "dictionary", "controlDict",
+            "application icoFoam;\nwriteControl timeStep;\n");
+  WriteMesh(caseDir + "/constant/polyMesh", 1.0, false);
+  if (solidRegion)
+    {
+    WriteMesh(caseDir + "/constant/solid/polyMesh", 1.0, false);
+    }
+  const char* times[3] = { "0", "1", "2" };
+  const char* fields[5] = { "a", "b", "c", "d", "e" };
+  for (int t = 0; t < 3; t++)
+    {
+    std::string timeDir = caseDir + "/" + times[t];
+    std::string solidDir = timeDir + "/solid";
+    vtkDirectory::MakeDirectory((solidRegion ? solidDir : timeDir).c_str());
+    for (int f = 0; f < 5; f++)
+      {
+      WriteScalarField(timeDir, fields[f], 10 * t + f);
+      if (solidRegion)
+        {
+        WriteScalarField(solidDir, fields[f], 100 * t + f);
+        }
+      }
+    }
+  // The mesh of the default region moves at the last time step.
+  WriteMesh(caseDir + "/2/polyMesh", 2.0, true);
+}
+
+// A single region is not wrapped in a block of its own.
+vtkUnstructuredGrid* GetInternalMesh(vtkOpenFOAMReader* reader,
+                                     unsigned int numberOfRegions,
+                                     unsigned int region)
+{
+  vtkMultiBlockDataSet* regionBlock = numberOfRegions == 1 ?
+    reader->GetOutput() : vtkMultiBlockDataSet::SafeDownCast(
+      reader->GetOutput()->GetBlock(region));
+  return regionBlock ?
+    vtkUnstructuredGrid::SafeDownCast(regionBlock->GetBlock(0)) : NULL;
+}
+
+void UpdateTime(vtkOpenFOAMReader* reader, double time)
+{
+  reader->UpdateInformation();
+  reader->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), time);
+  reader->Update();
+}
+
+int TestCase(const std::string& caseDir, unsigned int numberOfRegions)
+{
+  WriteCase(caseDir, numberOfRegions == 2);
+  std::string fileName = caseDir + "/system/controlDict";
+
+  vtkNew<vtkOpenFOAMReader> serialReader;
+  serialReader->SetFileName(fileName.c_str());
+  serialReader->UpdateInformation();
+  serialReader->EnableAllCellArrays();
+  vtkNew<vtkOpenFOAMReader> threadedReader;
+  threadedReader->SetFileName(fileName.c_str());
+  threadedReader->SetNumberOfThreads(4);
+  threadedReader->UpdateInformation();
+  threadedReader->EnableAllCellArrays();
+
+  vtkPoints* firstPoints = NULL;
+  for (int t = 0; t < 3; t++)
+    {
+    UpdateTime(serialReader.GetPointer(), t);
+    UpdateTime(threadedReader.GetPointer(), t);
+    for (unsigned int region = 0; region < numberOfRegions; region++)
+      {
+      vtkUnstructuredGrid* serial =
+        GetInternalMesh(serialReader.GetPointer(), numberOfRegions, region);
+      vtkUnstructuredGrid* threaded =
+        GetInternalMesh(threadedReader.GetPointer(), numberOfRegions, region);
+      TEST_ASSERT(serial && threaded && serial->GetNumberOfCells() == 2 &&
+                  threaded->GetNumberOfCells() == 2,
+                  "Expected 2 cells in region " << region << " of "
+                  << caseDir);
+      TEST_ASSERT(serial->GetCellData()->GetNumberOfArrays() == 5 &&
+                  threaded->GetCellData()->GetNumberOfArrays() == 5,
+                  "Expected 5 cell arrays in region " << region << " of "
+                  << caseDir);
+      const char* fields[5] = { "a", "b", "c", "d", "e" };
+      for (int f = 0; f < 5; f++)
+        {
+        vtkDataArray* a = serial->GetCellData()->GetArray(fields[f]);
+        vtkDataArray* b = threaded->GetCellData()->GetArray(fields[f]);
+        double expected = (region == 0 ? 10 : 100) * t + f;
+        TEST_ASSERT(a && b && a->GetTuple1(0) == expected &&
+                    b->GetTuple1(0) == expected &&
+                    a->GetTuple1(1) == expected + 1 &&
+                    b->GetTuple1(1) == expected + 1,
+                    "Wrong values of " << fields[f] << " in region "
+                    << region << " of " << caseDir << " at time " << t);
+        }
+      }
+
+    // The static mesh is read once, then moved at the last time step.
+    vtkUnstructuredGrid* mesh =
+      GetInternalMesh(serialReader.GetPointer(), numberOfRegions, 0);
+    double bounds[6];
+    mesh->GetBounds(bounds);
+    if (t == 0)
+      {
+      firstPoints = mesh->GetPoints();
+      }
+    else if (t == 1)
+      {
+      TEST_ASSERT(mesh->GetPoints() == firstPoints,
+                  "Expected the mesh of time 0 to be reused at time 1");
+      }
+    TEST_ASSERT(bounds[5] == (t < 2 ? 2.0 : 4.0),
+                "Wrong mesh height " << bounds[5] << " at time " << t);
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestOpenFOAMReader(int, char*[])
+{
+  // The field files of a single region are parsed on several threads,
+  // while two regions are read on threads of their own.
+  if (TestCase("TestOpenFOAMReaderCase", 1) != EXIT_SUCCESS ||
+      TestCase("TestOpenFOAMReaderRegionsCase", 2) != EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the points of binary and ASCII STL files merged by
+// vtkCoincidentPointMerger are the same as when merged with a
+// vtkMergePoints locator, and that the merge gives the same points on
+// one and several threads.
+
+#include "vtkCellArray.h"
+#include "vtkCoincidentPointMerger.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+
+#include <vector>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfPolys() != b->GetNumberOfPolys())
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); i++)
+    {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      return false;
+      }
+    }
+  vtkIdTypeArray* ca = a->GetPolys()->GetData();
+  vtkIdTypeArray* cb = b->GetPolys()->GetData();
+  for (vtkIdType i = 0; i < ca->GetNumberOfTuples(); i++)
+    {
+    if (ca->GetValue(i) != cb->GetValue(i))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int TestSTLReaderWriter(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  const char* fileNames[2] = { "TestSTLReaderWriterBinary.stl",
+                               "TestSTLReaderWriterASCII.stl" };
+  for (int ascii = 0; ascii < 2; ascii++)
+    {
+    vtkNew<vtkSTLWriter> writer;
+    writer->SetInputData(input);
+    writer->SetFileName(fileNames[ascii]);
+    if (ascii)
+      {
+      writer->SetFileTypeToASCII();
+      }
+    else
+      {
+      writer->SetFileTypeToBinary();
+      }
+    writer->Write();
+
+    vtkNew<vtkSTLReader> reader;
+    reader->SetFileName(fileNames[ascii]);
+    reader->Update();
+    vtkPolyData* merged = reader->GetOutput();
+    TEST_ASSERT(merged->GetNumberOfPoints() == input->GetNumberOfPoints() &&
+                merged->GetNumberOfPolys() == input->GetNumberOfPolys(),
+                "Read " << merged->GetNumberOfPoints() << " points and "
+                << merged->GetNumberOfPolys() << " triangles from "
+                << fileNames[ascii]);
+
+    vtkNew<vtkSTLReader> locatorReader;
+    vtkNew<vtkMergePoints> locator;
+    locatorReader->SetFileName(fileNames[ascii]);
+    locatorReader->SetLocator(locator.GetPointer());
+    locatorReader->Update();
+    TEST_ASSERT(SamePolyData(merged, locatorReader->GetOutput()),
+                "Expected the same output as with a locator from "
+                << fileNames[ascii]);
+
+    vtkNew<vtkSTLReader> soupReader;
+    soupReader->SetFileName(fileNames[ascii]);
+    soupReader->MergingOff();
+    soupReader->Update();
+    TEST_ASSERT(soupReader->GetOutput()->GetNumberOfPoints() ==
+                3 * input->GetNumberOfPolys(),
+                "Expected 3 points per triangle without merging");
+    }
+
+  // A large soup of points in which every third point repeats an
+  // earlier one, merged on 1 and 4 threads.
+  const vtkIdType numberOfPoints = 400000;
+  std::vector<float> soup(3 * numberOfPoints);
+  vtkMath::RandomSeed(1234);
+  for (vtkIdType i = 0; i < numberOfPoints; i++)
+    {
+    vtkIdType source = i % 3 == 2 ? 3 * static_cast<vtkIdType>(
+      vtkMath::Random(0, static_cast<double>(i / 3))) : i;
+    for (int c = 0; c < 3; c++)
+      {
+      soup[3 * i + c] = source == i ?
+        static_cast<float>(vtkMath::Random(-1, 1)) : soup[3 * source + c];
+      }
+    }
+  std::vector<vtkIdType> serialMap(numberOfPoints);
+  std::vector<vtkIdType> parallelMap(numberOfPoints);
+  vtkNew<vtkCoincidentPointMerger> merger;
+  merger->SetNumberOfThreads(1);
+  vtkIdType serialCount =
+    merger->MergePoints(&soup[0], numberOfPoints, &serialMap[0]);
+  merger->SetNumberOfThreads(4);
+  vtkIdType parallelCount =
+    merger->MergePoints(&soup[0], numberOfPoints, &parallelMap[0]);
+  TEST_ASSERT(serialCount == parallelCount && serialMap == parallelMap,
+              "Expected the same merge on 1 and 4 threads");
+  TEST_ASSERT(serialCount == numberOfPoints - numberOfPoints / 3,
+              "Expected " << numberOfPoints - numberOfPoints / 3
+              << " distinct points, got " << serialCount);
+  std::vector<vtkIdType> first(serialCount, -1);
+  vtkIdType next = 0;
+  for (vtkIdType i = 0; i < numberOfPoints; i++)
+    {
+    vtkIdType id = serialMap[i];
+    if (first[id] < 0)
+      {
+      TEST_ASSERT(id == next++, "Expected the points in order");
+      first[id] = i;
+      }
+    TEST_ASSERT(soup[3 * i] == soup[3 * first[id]] &&
+                soup[3 * i + 1] == soup[3 * first[id] + 1] &&
+                soup[3 * i + 2] == soup[3 * first[id] + 2],
+                "Point " << i << " merged with a different point");
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCoincidentPointMerger.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCoincidentPointMerger.h"
+
+#include "vtkFloatArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+vtkStandardNewMacro(vtkCoincidentPointMerger);
+
+//----------------------------------------------------------------------------
+// A point id sorted by the hash of its coordinates.  Points with the same
+// hash are sorted by id so that the first of equal points is the one
+// that comes first in the input.
+struct vtkCoincidentPointMergerKey
+{
+  vtkTypeUInt64 Hash;
+  vtkIdType Id;
+  bool operator<(const vtkCoincidentPointMergerKey& other) const
+    {
+    return this->Hash < other.Hash ||
+      (this->Hash == other.Hash && this->Id < other.Id);
+    }
+};
+
+//----------------------------------------------------------------------------
+static vtkTypeUInt64 vtkCoincidentPointMergerHash(const float* x)
+{
+  const vtkTypeUInt64 m1 =
+    (static_cast<vtkTypeUInt64>(0x9E3779B9u) << 32) | 0x7F4A7C15u;
+  const vtkTypeUInt64 m2 =
+    (static_cast<vtkTypeUInt64>(0xC2B2AE3Du) << 32) | 0x27D4EB4Fu;
+  vtkTypeUInt64 h = 0;
+  for(int i = 0; i < 3; ++i)
+    {
+    // Adding 0 turns -0 into 0, which compares equal to it.
+    float value = x[i] + 0.0f;
+    vtkTypeUInt32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    h = (h ^ bits) * m1;
+    h ^= h >> 29;
+    }
+  return h * m2;
+}
+
+//----------------------------------------------------------------------------
+static bool vtkCoincidentPointMergerEqual(const float* a, const float* b)
+{
+  return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+}
+
+//----------------------------------------------------------------------------
+// The work shared by the threads.  Each thread hashes and sorts its own
+// range of the keys.
+struct vtkCoincidentPointMergerWork
+{
+  const float* Points;
+  std::vector<vtkCoincidentPointMergerKey>* Keys;
+  std::vector<vtkIdType> Bounds;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkCoincidentPointMergerThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkCoincidentPointMergerWork* work =
+    static_cast<vtkCoincidentPointMergerWork*>(info->UserData);
+  vtkIdType begin = work->Bounds[info->ThreadID];
+  vtkIdType end = work->Bounds[info->ThreadID+1];
+  vtkCoincidentPointMergerKey* keys = &(*work->Keys)[0];
+  for(vtkIdType i = begin; i < end; ++i)
+    {
+    keys[i].Hash = vtkCoincidentPointMergerHash(work->Points + 3*i);
+    keys[i].Id = i;
+    }
+  std::sort(keys + begin, keys + end);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+vtkCoincidentPointMerger::vtkCoincidentPointMerger()
+{
+  this->NumberOfThreads = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCoincidentPointMerger::MergePoints(const float* points,
+                                                vtkIdType numberOfPoints,
+                                                vtkIdType* pointMap)
+{
+  if(numberOfPoints <= 0)
+    {
+    return 0;
+    }
+
+  int numberOfThreads = this->NumberOfThreads;
+  if(numberOfThreads <= 0)
+    {
+    numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  // Small buffers are not worth the threads.
+  const vtkIdType minimumPartSize = 65536;
+  if(numberOfPoints / minimumPartSize < numberOfThreads)
+    {
+    numberOfThreads = static_cast<int>(numberOfPoints / minimumPartSize);
+    }
+  if(numberOfThreads < 1)
+    {
+    numberOfThreads = 1;
+    }
+
+  // Hash and sort each part of the points, then merge the sorted parts.
+  std::vector<vtkCoincidentPointMergerKey> keys(numberOfPoints);
+  vtkCoincidentPointMergerWork work;
+  work.Points = points;
+  work.Keys = &keys;
+  work.Bounds.resize(numberOfThreads+1);
+  for(int i = 0; i <= numberOfThreads; ++i)
+    {
+    work.Bounds[i] = numberOfPoints / numberOfThreads * i;
+    }
+  work.Bounds[numberOfThreads] = numberOfPoints;
+  if(numberOfThreads == 1)
+    {
+    vtkMultiThreader::ThreadInfo info;
+    info.ThreadID = 0;
+    info.UserData = &work;
+    vtkCoincidentPointMergerThread(&info);
+    }
+  else
+    {
+    vtkMultiThreader* threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(vtkCoincidentPointMergerThread, &work);
+    threader->SingleMethodExecute();
+    threader->Delete();
+    }
+  for(int width = 1; width < numberOfThreads; width *= 2)
+    {
+    for(int i = 0; i + width < numberOfThreads; i += 2*width)
+      {
+      int last = std::min(i + 2*width, numberOfThreads);
+      std::inplace_merge(keys.begin() + work.Bounds[i],
+                         keys.begin() + work.Bounds[i+width],
+                         keys.begin() + work.Bounds[last]);
+      }
+    }
+
+  // Map each point to the first point with the same coordinates.  The
+  // points with the same hash are nearly always equal, so each one is
+  // compared with the distinct points of its hash seen so far.
+  std::vector<vtkIdType> distinct;
+  vtkIdType begin = 0;
+  while(begin < numberOfPoints)
+    {
+    vtkIdType end = begin + 1;
+    while(end < numberOfPoints && keys[end].Hash == keys[begin].Hash)
+      {
+      ++end;
+      }
+    distinct.clear();
+    for(vtkIdType i = begin; i < end; ++i)
+      {
+      vtkIdType id = keys[i].Id;
+      pointMap[id] = id;
+      for(size_t j = 0; j < distinct.size(); ++j)
+        {
+        if(vtkCoincidentPointMergerEqual(points + 3*id,
+                                         points + 3*distinct[j]))
+          {
+          pointMap[id] = distinct[j];
+          break;
+          }
+        }
+      if(pointMap[id] == id)
+        {
+        distinct.push_back(id);
+        }
+      }
+    begin = end;
+    }
+
+  // Number the distinct points in the order in which they come first.
+  // The first of equal points comes before the others, so its new id is
+  // known when they are reached.
+  vtkIdType numberOfMergedPoints = 0;
+  for(vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+    pointMap[i] = (pointMap[i] == i) ?
+      numberOfMergedPoints++ : pointMap[pointMap[i]];
+    }
+  return numberOfMergedPoints;
+}
+
+//----------------------------------------------------------------------------
+vtkPoints* vtkCoincidentPointMerger::MergePoints(vtkPoints* points,
+                                                 vtkIdType* pointMap)
+{
+  vtkFloatArray* data = vtkFloatArray::SafeDownCast(points->GetData());
+  if(!data || data->GetNumberOfComponents() != 3)
+    {
+    return 0;
+    }
+  vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  const float* x = data->GetPointer(0);
+  vtkIdType numberOfMergedPoints =
+    this->MergePoints(x, numberOfPoints, pointMap);
+
+  vtkPoints* mergedPoints = vtkPoints::New();
+  mergedPoints->SetDataTypeToFloat();
+  mergedPoints->SetNumberOfPoints(numberOfMergedPoints);
+  float* y = static_cast<vtkFloatArray*>(mergedPoints->GetData())
+    ->GetPointer(0);
+  vtkIdType next = 0;
+  for(vtkIdType i = 0; i < numberOfPoints && next < numberOfMergedPoints; ++i)
+    {
+    if(pointMap[i] == next)
+      {
+      memcpy(y + 3*next, x + 3*i, 3*sizeof(float));
+      ++next;
+      }
+    }
+  return mergedPoints;
+}
+
+//----------------------------------------------------------------------------
+void vtkCoincidentPointMerger::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+}
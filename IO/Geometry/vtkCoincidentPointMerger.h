@@ -0,0 +1,73 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCoincidentPointMerger.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkCoincidentPointMerger - merge points with equal coordinates on several threads.
+// .SECTION Description
+// vtkCoincidentPointMerger finds the points of a float coordinate buffer
+// that have exactly the same coordinates, as vtkMergePoints does, and
+// numbers the distinct points in the order of their first occurrence.
+// The points are sorted by a hash of their coordinates on several
+// threads instead of being inserted one at a time in a locator, which
+// makes it suited to the triangle soups of STL files where every vertex
+// is repeated.
+// .SECTION See Also
+// vtkMergePoints vtkSTLReader
+
+#ifndef __vtkCoincidentPointMerger_h
+#define __vtkCoincidentPointMerger_h
+
+#include "vtkIOGeometryModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkPoints;
+
+class VTKIOGEOMETRY_EXPORT vtkCoincidentPointMerger : public vtkObject
+{
+public:
+  static vtkCoincidentPointMerger *New();
+  vtkTypeMacro(vtkCoincidentPointMerger,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get/Set the number of threads used to merge the points.  If it is 0
+  // the default number of threads of vtkMultiThreader is used.  Default
+  // is 0.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Merge the 'numberOfPoints' points whose coordinates follow each
+  // other in 'points'.  Sets 'pointMap' to the id of each point among
+  // the distinct points and returns the number of distinct points.
+  vtkIdType MergePoints(const float* points, vtkIdType numberOfPoints,
+                        vtkIdType* pointMap);
+
+  // Description:
+  // Merge the points and return the distinct points in a new vtkPoints
+  // object, or 0 if the points are not float.  Sets 'pointMap' to the
+  // id of each input point in the returned points.
+  vtkPoints* MergePoints(vtkPoints* points, vtkIdType* pointMap);
+
+protected:
+  vtkCoincidentPointMerger();
+  ~vtkCoincidentPointMerger() {};
+
+  int NumberOfThreads;
+
+private:
+  vtkCoincidentPointMerger(const vtkCoincidentPointMerger&);  // Not implemented.
+  void operator=(const vtkCoincidentPointMerger&);  // Not implemented.
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNumberParser.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -155,6 +156,7 @@ int vtkOBJReader::RequestData(
   const int MAX_LINE = 1024;
   char rawLine[MAX_LINE];
   float xyz[3];
+  const char *pNumbersEnd;
 
   int lineNr = 0;
   while (everything_ok && fgets(rawLine, MAX_LINE, in) != NULL)
@@ -183,7 +185,7 @@ int vtkOBJReader::RequestData(
     if (strcmp(cmd, "v") == 0)
       {
       // this is a vertex definition, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
+      if (vtkNumberParser::ParseValues(pLine, pEnd, xyz, 3, &pNumbersEnd, 1) == 3)
         {
         points->InsertNextPoint(xyz);
         }
@@ -196,7 +198,7 @@ int vtkOBJReader::RequestData(
     else if (strcmp(cmd, "vt") == 0)
       {
       // this is a tcoord, expect two floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f", xyz, xyz+1) == 2)
+      if (vtkNumberParser::ParseValues(pLine, pEnd, xyz, 2, &pNumbersEnd, 1) == 2)
         {
         tcoords->InsertNextTuple(xyz);
         }
@@ -209,7 +211,7 @@ int vtkOBJReader::RequestData(
     else if (strcmp(cmd, "vn") == 0)
       {
       // this is a normal, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
+      if (vtkNumberParser::ParseValues(pLine, pEnd, xyz, 3, &pNumbersEnd, 1) == 3)
         {
         normals->InsertNextTuple(xyz);
         hasNormals = true;
@@ -64,6 +64,7 @@
 #include "vtkCharArray.h"
 #include "vtkCollection.h"
 #include "vtkConvexPointSet.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDirectory.h"
 #include "vtkDoubleArray.h"
@@ -73,6 +74,7 @@
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -317,12 +319,15 @@ private:
   void ConstructDimensions(vtkStdString *, vtkFoamDict *);
   bool ReadFieldFile(vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &,
       vtkDataArraySelection *);
+  static VTK_THREAD_RETURN_TYPE ReadFieldFilesThread(void *);
   vtkFloatArray *FillField(vtkFoamEntry *, int, vtkFoamIOobject *,
       const vtkStdString &);
   void GetVolFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &);
   void GetPointFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &);
+  void GetFieldsAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
+      vtkStringArray *, const bool, const double, const double);
   void AddArrayToFieldData(vtkDataSetAttributes *, vtkDataArray *,
       const vtkStdString &);
 
@@ -4578,6 +4583,17 @@ void vtkOpenFOAMReaderPrivate::PopulatePolyMeshDirArrays()
     {
     // create the path to the timestep
     vtkStdString polyMeshPath = this->TimeRegionPath(i) + "/polyMesh/";
+    if (!vtksys::SystemTools::FileIsDirectory(polyMeshPath.c_str()))
+      {
+      // a static mesh: the timestep shares the mesh of the previous one
+      // without having its files looked for, so that the mesh cached at
+      // the previous timestep is reused
+      this->PolyMeshPointsDir->SetValue(i, i > 0
+          ? this->PolyMeshPointsDir->GetValue(i - 1) : vtkStdString("constant"));
+      this->PolyMeshFacesDir->SetValue(i, i > 0
+          ? this->PolyMeshFacesDir->GetValue(i - 1) : vtkStdString("constant"));
+      continue;
+      }
     AppendMeshDirToArray(this->PolyMeshPointsDir, polyMeshPath + "points", i);
     AppendMeshDirToArray(this->PolyMeshFacesDir, polyMeshPath + "faces", i);
     }
@@ -6488,6 +6504,119 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// struct vtkFoamFieldFile
+// a field file parsed ahead of the creation of its arrays
+struct vtkFoamFieldFile
+{
+  vtkFoamIOobject IO;
+  vtkFoamDict Dict;
+  vtkStdString Name;
+  bool IsRead;
+
+  vtkFoamFieldFile(const vtkStdString &casePath, const vtkStdString &name) :
+    IO(casePath), Dict(), Name(name), IsRead(false)
+  {
+  }
+};
+
+//-----------------------------------------------------------------------------
+// struct vtkFoamFieldFileBatch
+// the field files parsed at once, one per thread
+struct vtkFoamFieldFileBatch
+{
+  vtkOpenFOAMReaderPrivate *Reader;
+  vtkDataArraySelection *Selection;
+  std::vector<vtkFoamFieldFile *> Files;
+};
+
+//-----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkOpenFOAMReaderPrivate::ReadFieldFilesThread(
+    void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+      static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkFoamFieldFileBatch *batch =
+      static_cast<vtkFoamFieldFileBatch *>(info->UserData);
+  const size_t fileI = static_cast<size_t>(info->ThreadID);
+  if (fileI < batch->Files.size())
+    {
+    vtkFoamFieldFile *file = batch->Files[fileI];
+    file->IsRead = batch->Reader->ReadFieldFile(&file->IO, &file->Dict,
+        file->Name, batch->Selection);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//-----------------------------------------------------------------------------
+// read the field files of the current time step into the meshes. Up to
+// NumberOfThreads files are parsed at once, each on its own thread, and
+// their arrays are then created one after another. Only the files of one
+// batch are held in memory at a time.
+void vtkOpenFOAMReaderPrivate::GetFieldsAtTimeStep(
+    vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
+    vtkStringArray *fieldFiles, const bool volFields,
+    const double progressStart, const double progressRange)
+{
+  vtkFoamFieldFileBatch batch;
+  batch.Reader = this;
+  batch.Selection = volFields ? this->Parent->CellDataArraySelection
+      : this->Parent->PointDataArraySelection;
+
+  // no more threads are started if the reader instances themselves are
+  // being updated on threads
+  const int nFiles = static_cast<int>(fieldFiles->GetNumberOfValues());
+  const int batchSize = this->Parent->UpdatingOnThreads ? 1
+      : this->Parent->NumberOfThreads;
+  for (int startI = 0; startI < nFiles; startI += batchSize)
+    {
+    const int endI = (startI + batchSize < nFiles ? startI + batchSize
+        : nFiles);
+    batch.Files.clear();
+    for (int fileI = startI; fileI < endI; fileI++)
+      {
+      batch.Files.push_back(new vtkFoamFieldFile(this->CasePath,
+          fieldFiles->GetValue(fileI)));
+      }
+
+    if (batch.Files.size() == 1)
+      {
+      vtkFoamFieldFile *file = batch.Files[0];
+      file->IsRead = this->ReadFieldFile(&file->IO, &file->Dict, file->Name,
+          batch.Selection);
+      }
+    else
+      {
+      vtkMultiThreader *threader = vtkMultiThreader::New();
+      threader->SetNumberOfThreads(static_cast<int>(batch.Files.size()));
+      threader->SetSingleMethod(ReadFieldFilesThread, &batch);
+      threader->SingleMethodExecute();
+      threader->Delete();
+      }
+
+    for (int fileI = startI; fileI < endI; fileI++)
+      {
+      vtkFoamFieldFile *file = batch.Files[fileI - startI];
+      if (file->IsRead)
+        {
+        if (volFields)
+          {
+          this->GetVolFieldAtTimeStep(internalMesh, boundaryMesh, &file->IO,
+              &file->Dict, file->Name);
+          }
+        else
+          {
+          this->GetPointFieldAtTimeStep(internalMesh, boundaryMesh,
+              &file->IO, &file->Dict, file->Name);
+          }
+        }
+      delete file;
+      this->Parent->UpdateProgress(progressStart + progressRange
+          * ((float)(fileI + 1) / ((float)nFiles + 0.0001)));
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 vtkFloatArray *vtkOpenFOAMReaderPrivate::FillField(vtkFoamEntry *entryPtr,
     int nElements, vtkFoamIOobject *ioPtr, const vtkStdString &fieldType)
@@ -6722,16 +6851,10 @@ void vtkOpenFOAMReaderPrivate::ConstructDimensions(vtkStdString *dimString,
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    vtkFoamIOobject *ioPtr, vtkFoamDict *dictPtr, const vtkStdString &varName)
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->CellDataArraySelection))
-    {
-    return;
-    }
-
+  vtkFoamIOobject &io = *ioPtr;
+  vtkFoamDict &dict = *dictPtr;
   if (io.GetClassName().substr(0, 3) != "vol")
     {
     vtkErrorMacro(<< io.GetFileName().c_str() << " is not a volField");
@@ -7075,16 +7198,11 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
 // read point field at a timestep
 void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    vtkFoamIOobject *ioPtr, vtkFoamDict *dictPtr,
+    const vtkStdString &vtkNotUsed(varName))
 {
-  vtkFoamIOobject io(this->CasePath);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->PointDataArraySelection))
-    {
-    return;
-    }
-
+  vtkFoamIOobject &io = *ioPtr;
+  vtkFoamDict &dict = *dictPtr;
   if (io.GetClassName().substr(0, 5) != "point")
     {
     vtkErrorMacro(<< io.GetFileName().c_str() << " is not a pointField");
@@ -7990,20 +8108,10 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
           }
         }
       // read field data variables into Internal/Boundary meshes
-      for (int i = 0; i < (int)this->VolFieldFiles->GetNumberOfValues(); i++)
-        {
-        this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->VolFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.5 + 0.25 * ((float)(i + 1)
-            / ((float)this->VolFieldFiles->GetNumberOfValues() + 0.0001)));
-        }
-      for (int i = 0; i < (int)this->PointFieldFiles->GetNumberOfValues(); i++)
-        {
-        this->GetPointFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->PointFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.75 + 0.125 * ((float)(i + 1)
-            / ((float)this->PointFieldFiles->GetNumberOfValues() + 0.0001)));
-        }
+      this->GetFieldsAtTimeStep(this->InternalMesh, this->BoundaryMesh,
+          this->VolFieldFiles, true, 0.5, 0.25);
+      this->GetFieldsAtTimeStep(this->InternalMesh, this->BoundaryMesh,
+          this->PointFieldFiles, false, 0.75, 0.125);
       }
     // read lagrangian mesh and fields
     lagrangianMesh = this->MakeLagrangianMesh();
@@ -8130,6 +8238,10 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
   // for caching mesh
   this->CacheMesh = 1;
 
+  // for parsing on threads
+  this->NumberOfThreads = 1;
+  this->UpdatingOnThreads = false;
+
   // for decomposing polyhedra
   this->DecomposePolyhedra = 0;
   this->DecomposePolyhedraOld = 0;
@@ -8192,6 +8304,7 @@ void vtkOpenFOAMReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Refresh: " << this->Refresh << endl;
   os << indent << "CreateCellToPoint: " << this->CreateCellToPoint << endl;
   os << indent << "CacheMesh: " << this->CacheMesh << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
   os << indent << "DecomposePolyhedra: " << this->DecomposePolyhedra << endl;
   os << indent << "PositionsIsIn13Format: " << this->PositionsIsIn13Format
       << endl;
@@ -8309,6 +8422,44 @@ int vtkOpenFOAMReader::RequestInformation(vtkInformation *vtkNotUsed(request), v
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+// the reader instances of the regions read on several threads. Each
+// thread takes the next region until none is left.
+struct vtkOpenFOAMReaderRegionJobs
+{
+  std::vector<vtkOpenFOAMReaderPrivate *> Readers;
+  std::vector<vtkMultiBlockDataSet *> Outputs;
+  std::vector<int> Status;
+  bool RecreateInternalMesh;
+  bool RecreateBoundaryMesh;
+  bool UpdateVariables;
+  size_t Next;
+  vtkSimpleCriticalSection Lock;
+};
+
+//-----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkOpenFOAMReaderRequestRegions(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+      static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkOpenFOAMReaderRegionJobs *jobs =
+      static_cast<vtkOpenFOAMReaderRegionJobs *>(info->UserData);
+  for (;;)
+    {
+    jobs->Lock.Lock();
+    const size_t readerI = jobs->Next++;
+    jobs->Lock.Unlock();
+    if (readerI >= jobs->Readers.size())
+      {
+      break;
+      }
+    jobs->Status[readerI] = jobs->Readers[readerI]->RequestData(
+        jobs->Outputs[readerI], jobs->RecreateInternalMesh,
+        jobs->RecreateBoundaryMesh, jobs->UpdateVariables);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //-----------------------------------------------------------------------------
 // RequestData
 int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInformationVector **vtkNotUsed(inputVector), vtkInformationVector *outputVector)
@@ -8376,18 +8527,55 @@ int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInfor
     {
     ret = reader->RequestData(output, recreateInternalMesh,
         recreateBoundaryMesh, updateVariables);
-    this->Parent->CurrentReaderIndex++;
+    if (!this->Parent->UpdatingOnThreads)
+      {
+      this->Parent->CurrentReaderIndex++;
+      }
     }
   else
     {
+    vtkOpenFOAMReaderRegionJobs jobs;
     this->Readers->InitTraversal();
     while ((reader
         = vtkOpenFOAMReaderPrivate::SafeDownCast(this->Readers->GetNextItemAsObject()))
         != NULL)
       {
-      vtkMultiBlockDataSet *subOutput = vtkMultiBlockDataSet::New();
-      if (reader->RequestData(subOutput, recreateInternalMesh,
-          recreateBoundaryMesh, updateVariables))
+      jobs.Readers.push_back(reader);
+      jobs.Outputs.push_back(vtkMultiBlockDataSet::New());
+      }
+    jobs.Status.resize(jobs.Readers.size(), -1);
+    jobs.RecreateInternalMesh = recreateInternalMesh;
+    jobs.RecreateBoundaryMesh = recreateBoundaryMesh;
+    jobs.UpdateVariables = updateVariables;
+    jobs.Next = 0;
+
+    // read the regions on several threads
+    int numberOfThreads = this->Parent->NumberOfThreads;
+    if (numberOfThreads > static_cast<int>(jobs.Readers.size()))
+      {
+      numberOfThreads = static_cast<int>(jobs.Readers.size());
+      }
+    if (numberOfThreads > 1 && !this->Parent->UpdatingOnThreads)
+      {
+      this->Parent->UpdatingOnThreads = true;
+      vtkMultiThreader *threader = vtkMultiThreader::New();
+      threader->SetNumberOfThreads(numberOfThreads);
+      threader->SetSingleMethod(vtkOpenFOAMReaderRequestRegions, &jobs);
+      threader->SingleMethodExecute();
+      threader->Delete();
+      this->Parent->UpdatingOnThreads = false;
+      }
+
+    for (size_t readerI = 0; readerI < jobs.Readers.size(); readerI++)
+      {
+      reader = jobs.Readers[readerI];
+      vtkMultiBlockDataSet *subOutput = jobs.Outputs[readerI];
+      if (jobs.Status[readerI] == -1)
+        {
+        jobs.Status[readerI] = reader->RequestData(subOutput,
+            recreateInternalMesh, recreateBoundaryMesh, updateVariables);
+        }
+      if (jobs.Status[readerI])
         {
         vtkStdString regionName(reader->GetRegionName());
         if (regionName == "")
@@ -8403,7 +8591,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInfor
         ret = 0;
         }
       subOutput->Delete();
-      this->Parent->CurrentReaderIndex++;
+      if (!this->Parent->UpdatingOnThreads)
+        {
+        this->Parent->CurrentReaderIndex++;
+        }
       }
     }
 
@@ -8662,6 +8853,11 @@ void vtkOpenFOAMReader::UpdateStatus()
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  // progress events cannot be invoked from several threads at once
+  if (this->Parent->UpdatingOnThreads)
+    {
+    return;
+    }
   this->vtkAlgorithm::UpdateProgress((static_cast<double>(this->Parent->CurrentReaderIndex)
       + amount) / static_cast<double>(this->Parent->NumberOfReaders));
 }
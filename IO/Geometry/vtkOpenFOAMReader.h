@@ -183,11 +183,21 @@ public:
   vtkBooleanMacro(CreateCellToPoint, int);
 
   // Description:
-  // Set/Get whether mesh is to be cached.
+  // Set/Get whether mesh is to be cached.  A cached mesh is reused by the
+  // following time steps as long as their time directories hold no
+  // polyMesh of their own.
   vtkSetMacro(CacheMesh, int);
   vtkGetMacro(CacheMesh, int);
   vtkBooleanMacro(CacheMesh, int);
 
+  // Description:
+  // Set/Get the number of threads on which the regions, the decomposed
+  // processor directories read by vtkPOpenFOAMReader and the field files
+  // of a time step are parsed at once.  Default is 1: everything is read
+  // one after another.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
   // Description:
   // Set/Get whether polyhedra are to be decomposed.
   vtkSetMacro(DecomposePolyhedra, int);
@@ -241,6 +251,12 @@ protected:
   // for caching mesh
   int CacheMesh;
 
+  // for parsing regions, processor directories and fields on threads
+  int NumberOfThreads;
+  // set while reader instances are updated on several threads, during
+  // which progress is not reported and no more threads are started
+  bool UpdatingOnThreads;
+
   // for decomposing polyhedra on-the-fly
   int DecomposePolyhedra;
 
@@ -17,18 +17,23 @@
 #include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCoincidentPointMerger.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <ctype.h>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -156,8 +161,6 @@ int vtkSTLReader::RequestData(
     double x[3];
     int nextCell=0;
 
-    mergedPts = vtkPoints::New();
-    mergedPts->Allocate(newPts->GetNumberOfPoints()/2);
     mergedPolys = vtkCellArray::New();
     mergedPolys->Allocate(newPolys->GetSize());
     if (newScalars)
@@ -166,19 +169,41 @@ int vtkSTLReader::RequestData(
       mergedScalars->Allocate(newPolys->GetSize());
       }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
+    // Without a locator the points are merged by sorting them on
+    // several threads, which gives the same points as vtkMergePoints.
+    std::vector<vtkIdType> pointMap;
+    mergedPts = 0;
     if (this->Locator == NULL)
       {
-      locator.TakeReference(this->NewDefaultLocator());
+      vtkNew<vtkCoincidentPointMerger> merger;
+      pointMap.resize(newPts->GetNumberOfPoints() + 1);
+      mergedPts = merger->MergePoints(newPts, &pointMap[0]);
+      }
+    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
+    if (!mergedPts)
+      {
+      mergedPts = vtkPoints::New();
+      mergedPts->Allocate(newPts->GetNumberOfPoints()/2);
+      if (this->Locator == NULL)
+        {
+        locator.TakeReference(this->NewDefaultLocator());
+        }
+      locator->InitPointInsertion (mergedPts, newPts->GetBounds());
       }
-    locator->InitPointInsertion (mergedPts, newPts->GetBounds());
 
     for (newPolys->InitTraversal(); newPolys->GetNextCell(npts,pts); )
       {
       for (i=0; i < 3; i++)
         {
-        newPts->GetPoint(pts[i],x);
-        locator->InsertUniquePoint(x, nodes[i]);
+        if (locator)
+          {
+          newPts->GetPoint(pts[i],x);
+          locator->InsertUniquePoint(x, nodes[i]);
+          }
+        else
+          {
+          nodes[i] = pointMap[pts[i]];
+          }
         }
 
       if ( nodes[0] != nodes[1] &&
@@ -240,13 +265,9 @@ int vtkSTLReader::RequestData(
 int vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
                                 vtkCellArray *newPolys)
 {
-  int i, numTris;
-  vtkIdType pts[3];
+  vtkIdType i, numTris;
   unsigned long   ulint;
-  unsigned short  ibuff2;
   char    header[81];
-  typedef struct  {float  n[3], v1[3], v2[3], v3[3];} facet_t;
-  facet_t facet;
 
   vtkDebugMacro(<< " Reading BINARY STL file");
 
@@ -268,63 +289,66 @@ int vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
     }
   vtkByteSwap::Swap4LE(&ulint);
 
-  // Many .stl files contain bogus count.  Hence we will ignore and read
-  //   until end of file.
+  // Many .stl files contain bogus count.  Hence we will ignore it and
+  // read the whole file.
   //
-  if ( (numTris = (int) ulint) <= 0 )
+  if ( static_cast<int>(ulint) <= 0 )
     {
     vtkDebugMacro(<< "Bad binary count: attempting to correct ("
-    << numTris << ")");
+    << static_cast<int>(ulint) << ")");
     }
 
-  // Verify the numTris with the length of the file
-  unsigned long ulFileLength = vtksys::SystemTools::FileLength(this->FileName);
-  ulFileLength -= (80 + 4); // 80 byte - header, 4 byte - tringle count
-  ulFileLength /= 50;       // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
-
-  if (numTris < static_cast<int>(ulFileLength))
-    numTris = static_cast<int>(ulFileLength);
-
-  // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris*3,10000);
-  newPolys->Allocate(numTris,20000);
+  // 50 bytes per triangle: twelve 32-bit floating point numbers and a
+  // 2 byte attribute byte count, after an 80 byte header and a 4 byte
+  // triangle count.
+  const size_t facetSize = 50;
+  unsigned long fileLength = vtksys::SystemTools::FileLength(this->FileName);
+  numTris = fileLength > 84 ?
+    static_cast<vtkIdType>((fileLength - 84) / facetSize) : 0;
+
+  // Read the facets in large blocks straight into the points, and
+  // connect each triangle to its own three points.
+  vtkFloatArray* data = vtkFloatArray::New();
+  data->SetNumberOfComponents(3);
+  data->SetNumberOfTuples(3*numTris);
+  float* x = data->GetPointer(0);
+  newPts->SetData(data);
+  data->Delete();
+
+  vtkIdTypeArray* cells = vtkIdTypeArray::New();
+  cells->SetNumberOfValues(4*numTris);
+  vtkIdType* cell = cells->GetPointer(0);
+  for (i = 0; i < numTris; i++)
+    {
+    *cell++ = 3;
+    *cell++ = 3*i;
+    *cell++ = 3*i+1;
+    *cell++ = 3*i+2;
+    }
+  newPolys->SetCells(numTris, cells);
+  cells->Delete();
 
-  for ( i=0; fread(&facet,48,1,fp) > 0; i++ )
+  const vtkIdType blockSize = 65536;
+  std::vector<char> block(blockSize*facetSize);
+  for (i = 0; i < numTris; i += blockSize)
     {
-    if (fread(&ibuff2,2,1,fp) != 1) //read extra junk
+    vtkIdType n = std::min(blockSize, numTris - i);
+    if (fread(&block[0], facetSize, n, fp) != static_cast<size_t>(n))
       {
       vtkErrorMacro ("STLReader error reading file: " << this->FileName
-                     << " Premature EOF while reading extra junk.");
+                     << " Premature EOF while reading triangles.");
       fclose(fp);
       return 0;
       }
-
-    vtkByteSwap::Swap4LE (facet.n);
-    vtkByteSwap::Swap4LE (facet.n+1);
-    vtkByteSwap::Swap4LE (facet.n+2);
-
-    vtkByteSwap::Swap4LE (facet.v1);
-    vtkByteSwap::Swap4LE (facet.v1+1);
-    vtkByteSwap::Swap4LE (facet.v1+2);
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-
-    vtkByteSwap::Swap4LE (facet.v2);
-    vtkByteSwap::Swap4LE (facet.v2+1);
-    vtkByteSwap::Swap4LE (facet.v2+2);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-
-    vtkByteSwap::Swap4LE (facet.v3);
-    vtkByteSwap::Swap4LE (facet.v3+1);
-    vtkByteSwap::Swap4LE (facet.v3+2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3,pts);
-
-    if ( (i % 5000) == 0 && i != 0 )
+    // Skip the normal and the attribute byte count of each facet.
+    for (vtkIdType j = 0; j < n; j++, x += 9)
       {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i)/numTris);
+      memcpy(x, &block[j*facetSize + 12], 9*sizeof(float));
       }
+    vtkByteSwap::Swap4LERange(x - 9*n, 9*n);
+
+    vtkDebugMacro(<< "triangle# " << i + n);
+    this->UpdateProgress(static_cast<double>(i + n)/numTris);
     }
 
   return 0;
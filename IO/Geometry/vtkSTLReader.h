@@ -21,9 +21,12 @@
 //
 // .stl files are quite inefficient since they duplicate vertex
 // definitions. By setting the Merging boolean you can control whether the
-// point data is merged after reading. Merging is performed by default,
-// however, merging requires a large amount of temporary storage since a
-// 3D hash table must be constructed.
+// point data is merged after reading. Merging is performed by default.
+// Without a Locator the points are merged by vtkCoincidentPointMerger on
+// several threads; with a Locator they are inserted in it one at a time,
+// which requires a large amount of temporary storage since a 3D hash
+// table must be constructed.  Binary files are read in large blocks
+// straight into the output arrays.
 
 // .SECTION Caveats
 // Binary files written on one system may not be readable on other systems.
@@ -73,8 +76,9 @@ public:
   vtkBooleanMacro(ScalarTags,int);
 
   // Description:
-  // Specify a spatial locator for merging points. By
-  // default an instance of vtkMergePoints is used.
+  // Specify a spatial locator for merging points. By default no locator
+  // is set and the points are merged by vtkCoincidentPointMerger, which
+  // gives the same points as vtkMergePoints.
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
 
@@ -23,6 +23,8 @@
 #include "vtkTriangle.h"
 #include <vtksys/SystemTools.hxx>
 
+#include <vector>
+
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
 #else
@@ -213,8 +215,13 @@ void vtkSTLWriter::WriteBinarySTL(vtkPoints *pts, vtkCellArray *polys)
     }
 
   //  Write out triangle polygons.  In not a triangle polygon, only first
-  //  three vertices are written.
+  //  three vertices are written.  The facets are packed in large blocks
+  //  that are written at once.
   //
+  const size_t facetSize = 50;
+  const size_t blockSize = 65536;
+  std::vector<char> block(blockSize*facetSize);
+  size_t n = 0;
   for (polys->InitTraversal(); polys->GetNextCell(npts,indx); )
     {
     pts->GetPoint(indx[0],v1);
@@ -222,60 +229,35 @@ void vtkSTLWriter::WriteBinarySTL(vtkPoints *pts, vtkCellArray *polys)
     pts->GetPoint(indx[2],v3);
 
     vtkTriangle::ComputeNormal(pts, npts, indx, dn);
-    float n[3];
-    n[0] = (float)dn[0];
-    n[1] = (float)dn[1];
-    n[2] = (float)dn[2];
-    vtkByteSwap::Swap4LE(n);
-    vtkByteSwap::Swap4LE(n+1);
-    vtkByteSwap::Swap4LE(n+2);
-    if (fwrite (n, 4, 3, fp) < 3)
-      {
-      fclose(fp);
-      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-      return;
-      }
-
-    n[0] = (float)v1[0];  n[1] = (float)v1[1];  n[2] = (float)v1[2];
-    vtkByteSwap::Swap4LE(n);
-    vtkByteSwap::Swap4LE(n+1);
-    vtkByteSwap::Swap4LE(n+2);
-    if (fwrite (n, 4, 3, fp) < 3)
-      {
-      fclose(fp);
-      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-      return;
-      }
-
-    n[0] = (float)v2[0];  n[1] = (float)v2[1];  n[2] = (float)v2[2];
-    vtkByteSwap::Swap4LE(n);
-    vtkByteSwap::Swap4LE(n+1);
-    vtkByteSwap::Swap4LE(n+2);
-    if (fwrite (n, 4, 3, fp) < 3)
-      {
-      fclose(fp);
-      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-      return;
-      }
-
-    n[0] = (float)v3[0];  n[1] = (float)v3[1];  n[2] = (float)v3[2];
-    vtkByteSwap::Swap4LE(n);
-    vtkByteSwap::Swap4LE(n+1);
-    vtkByteSwap::Swap4LE(n+2);
-    if (fwrite (n, 4, 3, fp) < 3)
+    float facet[12];
+    for (int i = 0; i < 3; i++)
       {
-      fclose(fp);
-      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-      return;
+      facet[i] = static_cast<float>(dn[i]);
+      facet[3+i] = static_cast<float>(v1[i]);
+      facet[6+i] = static_cast<float>(v2[i]);
+      facet[9+i] = static_cast<float>(v3[i]);
       }
+    vtkByteSwap::Swap4LERange(facet, 12);
+    memcpy(&block[n*facetSize], facet, sizeof(facet));
+    memcpy(&block[n*facetSize + sizeof(facet)], &ibuff2, 2);
 
-    if (fwrite (&ibuff2, 2, 1, fp) < 1)
+    if (++n == blockSize)
       {
-      fclose(fp);
-      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-      return;
+      if (fwrite (&block[0], facetSize, n, fp) < n)
+        {
+        fclose(fp);
+        this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+        return;
+        }
+      n = 0;
       }
     }
+  if (n > 0 && fwrite (&block[0], facetSize, n, fp) < n)
+    {
+    fclose(fp);
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    return;
+    }
   fclose (fp);
 }
 
@@ -0,0 +1,153 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReaderExtents.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the TIFF and PNG readers give the pixels of the image
+// that was written for the whole extent and for sub-extents, and that
+// the strips of TIFF files decoded on several threads give the same
+// pixels as on one thread.
+
+#include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPNGReader.h"
+#include "vtkPNGWriter.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTIFFReader.h"
+#include "vtkTIFFWriter.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+bool SamePixels(vtkImageData* image, vtkImageData* read)
+{
+  int extent[6];
+  read->GetExtent(extent);
+  if (read->GetNumberOfScalarComponents() !=
+      image->GetNumberOfScalarComponents())
+    {
+    return false;
+    }
+  for (int y = extent[2]; y <= extent[3]; y++)
+    {
+    for (int x = extent[0]; x <= extent[1]; x++)
+      {
+      for (int c = 0; c < image->GetNumberOfScalarComponents(); c++)
+        {
+        if (read->GetScalarComponentAsDouble(x, y, 0, c) !=
+            image->GetScalarComponentAsDouble(x, y, 0, c))
+          {
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+int ReadExtent(vtkImageReader2* reader, vtkImageData* image, int* extent)
+{
+  reader->UpdateInformation();
+  reader->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+  reader->Update();
+  int readExtent[6];
+  reader->GetOutput()->GetExtent(readExtent);
+  TEST_ASSERT(readExtent[0] == extent[0] && readExtent[1] == extent[1] &&
+              readExtent[2] == extent[2] && readExtent[3] == extent[3],
+              "Wrong extent read by " << reader->GetClassName());
+  TEST_ASSERT(SamePixels(image, reader->GetOutput()),
+              "Wrong pixels read by " << reader->GetClassName()
+              << " in the extent " << extent[0] << " " << extent[1] << " "
+              << extent[2] << " " << extent[3]);
+  return EXIT_SUCCESS;
+}
+}
+
+int TestImageReaderExtents(int, char*[])
+{
+  // An RGB image whose rows span several strips of the TIFF file.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 299, 0, 199, 0, 0);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  unsigned char* pixel =
+    static_cast<unsigned char*>(image->GetScalarPointer());
+  for (int y = 0; y < 200; y++)
+    {
+    for (int x = 0; x < 300; x++)
+      {
+      *pixel++ = static_cast<unsigned char>(x);
+      *pixel++ = static_cast<unsigned char>(y);
+      *pixel++ = static_cast<unsigned char>(x * 7 + y * 13);
+      }
+    }
+
+  // The LZW predictor of libtiff works in place on the rows written, so
+  // the TIFF writer gets a copy of the image.
+  vtkNew<vtkImageData> tiffImage;
+  tiffImage->DeepCopy(image.GetPointer());
+  vtkNew<vtkTIFFWriter> tiffWriter;
+  tiffWriter->SetInputData(tiffImage.GetPointer());
+  tiffWriter->SetCompressionToLZW();
+  tiffWriter->SetFileName("TestImageReaderExtents.tif");
+  tiffWriter->Write();
+  vtkNew<vtkPNGWriter> pngWriter;
+  pngWriter->SetInputData(image.GetPointer());
+  pngWriter->SetFileName("TestImageReaderExtents.png");
+  pngWriter->Write();
+
+  int extents[3][6] = { { 0, 299, 0, 199, 0, 0 },
+                        { 17, 140, 31, 90, 0, 0 },
+                        { 250, 299, 150, 199, 0, 0 } };
+  for (int i = 0; i < 3; i++)
+    {
+    // A new reader for each extent since a smaller extent does not
+    // execute the reader again.
+    for (int threads = 1; threads <= 4; threads += 3)
+      {
+      vtkNew<vtkTIFFReader> tiffReader;
+      tiffReader->SetFileName("TestImageReaderExtents.tif");
+      tiffReader->SetNumberOfThreads(threads);
+      // The writer stores the top row first but tags the file with the
+      // top left orientation, which the reader keeps by default.
+      tiffReader->SetOrientationType(4);
+      if (ReadExtent(tiffReader.GetPointer(), image.GetPointer(),
+                     extents[i]) != EXIT_SUCCESS)
+        {
+        return EXIT_FAILURE;
+        }
+      int* tileSize = tiffReader->GetOutputInformation(0)->Get(
+        vtkTIFFReader::TILE_SIZE());
+      TEST_ASSERT(tileSize && tileSize[0] == 300 && tileSize[1] > 0 &&
+                  tileSize[1] < 200,
+                  "Expected the size of the strips of the TIFF file");
+      }
+    vtkNew<vtkPNGReader> pngReader;
+    pngReader->SetFileName("TestImageReaderExtents.png");
+    if (ReadExtent(pngReader.GetPointer(), image.GetPointer(),
+                   extents[i]) != EXIT_SUCCESS)
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
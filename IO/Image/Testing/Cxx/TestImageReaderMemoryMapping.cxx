@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReaderMemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that vtkImageReader maps the whole slices of a raw volume,
+// reads the extents that cannot be mapped, gives the same pixels either
+// way, and that changing mapped scalars does not change the file.
+
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageReader.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/ios/fstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+const int Width = 20;
+const int Height = 15;
+const int Slices = 10;
+const char* FileName = "TestImageReaderMemoryMapping.raw";
+
+short Value(int x, int y, int z)
+{
+  return static_cast<short>(x + 31 * y + 577 * z - 1000);
+}
+
+void ReadExtent(vtkImageReader* reader, int* extent)
+{
+  reader->SetFileName(FileName);
+  reader->SetDataScalarTypeToShort();
+  reader->SetDataExtent(0, Width - 1, 0, Height - 1, 0, Slices - 1);
+  reader->SetFileDimensionality(3);
+  reader->FileLowerLeftOn();
+  reader->SetHeaderSize(6);
+  reader->UpdateInformation();
+  reader->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+  reader->Update();
+}
+
+int CheckPixels(vtkImageData* image, int* extent)
+{
+  for (int z = extent[4]; z <= extent[5]; z++)
+    {
+    for (int y = extent[2]; y <= extent[3]; y++)
+      {
+      for (int x = extent[0]; x <= extent[1]; x++)
+        {
+        TEST_ASSERT(image->GetScalarComponentAsDouble(x, y, z, 0) ==
+                    Value(x, y, z),
+                    "Wrong pixel " << x << " " << y << " " << z);
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestImageReaderMemoryMapping(int, char*[])
+{
+  // A volume in the native byte order after a header of 6 bytes.
+  vtksys_ios::ofstream file(FileName, ios::out | ios::binary);
+  file.write("header", 6);
+  for (int z = 0; z < Slices; z++)
+    {
+    for (int y = 0; y < Height; y++)
+      {
+      for (int x = 0; x < Width; x++)
+        {
+        short value = Value(x, y, z);
+        file.write(reinterpret_cast<char*>(&value), sizeof(value));
+        }
+      }
+    }
+  file.close();
+
+  // Whole slices are mapped, parts of slices are read.
+  int extents[3][6] = { { 0, Width - 1, 0, Height - 1, 0, Slices - 1 },
+                        { 0, Width - 1, 0, Height - 1, 3, 6 },
+                        { 2, 11, 4, 9, 0, Slices - 1 } };
+  for (int i = 0; i < 3; i++)
+    {
+    for (int mapping = 0; mapping < 2; mapping++)
+      {
+      vtkNew<vtkImageReader> reader;
+      reader->SetMemoryMapping(mapping);
+      ReadExtent(reader.GetPointer(), extents[i]);
+      vtkImageData* image = reader->GetOutput();
+      vtkDataArray* scalars = image->GetPointData()->GetScalars();
+      TEST_ASSERT(scalars && scalars->GetNumberOfTuples() ==
+                  (extents[i][1] - extents[i][0] + 1) *
+                  (extents[i][3] - extents[i][2] + 1) *
+                  (extents[i][5] - extents[i][4] + 1),
+                  "Wrong number of scalars in extent " << i);
+      bool mapped = scalars->HasObserver(vtkCommand::DeleteEvent) != 0;
+      TEST_ASSERT(mapped == (mapping && i < 2),
+                  "Extent " << i << (mapped ? " was" : " was not")
+                  << " mapped");
+      if (CheckPixels(image, extents[i]) != EXIT_SUCCESS)
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Changing the mapped scalars leaves the file as it was.
+  vtkNew<vtkImageReader> mappedReader;
+  mappedReader->MemoryMappingOn();
+  ReadExtent(mappedReader.GetPointer(), extents[0]);
+  mappedReader->GetOutput()->GetPointData()->GetScalars()->FillComponent(0, 7);
+  vtkNew<vtkImageReader> reader;
+  ReadExtent(reader.GetPointer(), extents[0]);
+  return CheckPixels(reader->GetOutput(), extents[0]);
+}
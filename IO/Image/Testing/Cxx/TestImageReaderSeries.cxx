@@ -0,0 +1,271 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReaderSeries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the slices of a series of PNG files and of a directory
+// of DICOM files read on several threads are those read on one thread,
+// for the whole extent and for a sub-extent.
+
+#include "vtkDICOMImageReader.h"
+#include "vtkDirectory.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPNGReader.h"
+#include "vtkPNGWriter.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
+
+#include <string>
+#include <vtksys/ios/fstream>
+#include <vtksys/ios/sstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+const int Width = 40;
+const int Height = 30;
+const int Slices = 12;
+
+// The value of a pixel of the DICOM files, whose first row is the top row
+// of the image, at the position 'position' along the slice normal.
+int DICOMValue(int x, int row, int position)
+{
+  return x + 7 * row + 300 * position;
+}
+
+// A data element of an explicit VR little endian DICOM file.
+void WriteElement(vtksys_ios::ofstream& file, int group, int element,
+                  const char* vr, std::string value)
+{
+  if (value.size() % 2)
+    {
+    value += (vr[0] == 'U' && vr[1] == 'I') ? '\0' : ' ';
+    }
+  unsigned char tag[4] = { static_cast<unsigned char>(group & 0xff),
+                           static_cast<unsigned char>(group >> 8),
+                           static_cast<unsigned char>(element & 0xff),
+                           static_cast<unsigned char>(element >> 8) };
+  file.write(reinterpret_cast<char*>(tag), 4);
+  file.write(vr, 2);
+  size_t length = value.size();
+  if (vr[0] == 'O')
+    {
+    unsigned char header[6] = { 0, 0,
+                                static_cast<unsigned char>(length & 0xff),
+                                static_cast<unsigned char>(length >> 8),
+                                static_cast<unsigned char>(length >> 16),
+                                static_cast<unsigned char>(length >> 24) };
+    file.write(reinterpret_cast<char*>(header), 6);
+    }
+  else
+    {
+    unsigned char header[2] = { static_cast<unsigned char>(length & 0xff),
+                                static_cast<unsigned char>(length >> 8) };
+    file.write(reinterpret_cast<char*>(header), 2);
+    }
+  file.write(value.data(), static_cast<std::streamsize>(length));
+}
+
+std::string UnsignedShort(int value)
+{
+  std::string bytes(2, '\0');
+  bytes[0] = static_cast<char>(value & 0xff);
+  bytes[1] = static_cast<char>(value >> 8);
+  return bytes;
+}
+
+// A slice at 'position' along the z axis, with unsigned 16 bit pixels.
+void WriteDICOMFile(const std::string& fileName, int position)
+{
+  vtksys_ios::ofstream file(fileName.c_str(), ios::out | ios::binary);
+  std::string preamble(128, '\0');
+  file.write(preamble.data(), 128);
+  file.write("DICM", 4);
+  WriteElement(file, 0x0002, 0x0010, "UI", "1.2.840.10008.1.2.1");
+  WriteElement(file, 0x0020, 0x000e, "UI", "1.2.3.4");
+  vtksys_ios::ostringstream imagePosition;
+  imagePosition << "0\\0\\" << 2 * position;
+  WriteElement(file, 0x0020, 0x0032, "DS", imagePosition.str());
+  WriteElement(file, 0x0020, 0x0037, "DS", "1\\0\\0\\0\\1\\0");
+  WriteElement(file, 0x0028, 0x0010, "US", UnsignedShort(Height));
+  WriteElement(file, 0x0028, 0x0011, "US", UnsignedShort(Width));
+  WriteElement(file, 0x0028, 0x0100, "US", UnsignedShort(16));
+  WriteElement(file, 0x0028, 0x0103, "US", UnsignedShort(0));
+  std::string pixels;
+  for (int row = 0; row < Height; row++)
+    {
+    for (int x = 0; x < Width; x++)
+      {
+      pixels += UnsignedShort(DICOMValue(x, row, position));
+      }
+    }
+  WriteElement(file, 0x7fe0, 0x0010, "OW", pixels);
+}
+
+int UpdateExtent(vtkImageReader2* reader, int* extent)
+{
+  reader->UpdateInformation();
+  reader->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+  reader->Update();
+  int readExtent[6];
+  reader->GetOutput()->GetExtent(readExtent);
+  for (int i = 0; i < 6; i++)
+    {
+    TEST_ASSERT(readExtent[i] == extent[i],
+                "Wrong extent read by " << reader->GetClassName());
+    }
+  return EXIT_SUCCESS;
+}
+
+int TestPNGSeries(int* extent)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, Width - 1, 0, Height - 1, 0, Slices - 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  for (int z = 0; z < Slices; z++)
+    {
+    for (int y = 0; y < Height; y++)
+      {
+      for (int x = 0; x < Width; x++)
+        {
+        image->SetScalarComponentFromDouble(x, y, z, 0, (x + 3 * y + 17 * z) % 256);
+        }
+      }
+    }
+  vtkNew<vtkPNGWriter> writer;
+  writer->SetInputData(image.GetPointer());
+  writer->SetFilePrefix("TestImageReaderSeries");
+  writer->SetFilePattern("%s_%d.png");
+  writer->Write();
+
+  vtkNew<vtkStringArray> fileNames;
+  for (int z = 0; z < Slices; z++)
+    {
+    vtksys_ios::ostringstream name;
+    name << "TestImageReaderSeries_" << z << ".png";
+    fileNames->InsertNextValue(name.str());
+    }
+
+  // A file pattern and a list of file names, on one and several threads.
+  for (int i = 0; i < 4; i++)
+    {
+    vtkNew<vtkPNGReader> reader;
+    if (i < 2)
+      {
+      reader->SetFilePrefix("TestImageReaderSeries");
+      reader->SetFilePattern("%s_%d.png");
+      reader->SetDataExtent(0, Width - 1, 0, Height - 1, 0, Slices - 1);
+      }
+    else
+      {
+      reader->SetFileNames(fileNames.GetPointer());
+      }
+    reader->SetNumberOfThreads(i % 2 ? 4 : 1);
+    if (UpdateExtent(reader.GetPointer(), extent) != EXIT_SUCCESS)
+      {
+      return EXIT_FAILURE;
+      }
+    vtkImageData* read = reader->GetOutput();
+    for (int z = extent[4]; z <= extent[5]; z++)
+      {
+      for (int y = extent[2]; y <= extent[3]; y++)
+        {
+        for (int x = extent[0]; x <= extent[1]; x++)
+          {
+          TEST_ASSERT(read->GetScalarComponentAsDouble(x, y, z, 0) ==
+                      image->GetScalarComponentAsDouble(x, y, z, 0),
+                      "Wrong PNG pixel " << x << " " << y << " " << z
+                      << " read on " << reader->GetNumberOfThreads()
+                      << " threads");
+          }
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+int TestDICOMSeries(int* extent)
+{
+  // The slices are written in an order other than that of their position,
+  // with a file that is not a DICOM file among them.
+  const char* dir = "TestImageReaderSeriesDICOM";
+  vtkDirectory::MakeDirectory(dir);
+  for (int i = 0; i < Slices; i++)
+    {
+    vtksys_ios::ostringstream name;
+    name << dir << "/slice" << i << ".dcm";
+    WriteDICOMFile(name.str(), (i * 5) % Slices);
+    }
+  vtksys_ios::ofstream notDICOM((std::string(dir) + "/README").c_str());
+  notDICOM << "Not a DICOM file\n";
+  notDICOM.close();
+
+  for (int threads = 1; threads <= 4; threads += 3)
+    {
+    vtkNew<vtkDICOMImageReader> reader;
+    reader->SetDirectoryName(dir);
+    reader->SetNumberOfThreads(threads);
+    if (UpdateExtent(reader.GetPointer(), extent) != EXIT_SUCCESS)
+      {
+      return EXIT_FAILURE;
+      }
+    int* wholeExtent = reader->GetOutputInformation(0)->Get(
+      vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+    TEST_ASSERT(wholeExtent[5] - wholeExtent[4] + 1 == Slices,
+                "Expected " << Slices << " DICOM files, found "
+                << wholeExtent[5] - wholeExtent[4] + 1);
+    TEST_ASSERT(reader->GetPixelSpacing()[2] == 2.0,
+                "Wrong slice spacing " << reader->GetPixelSpacing()[2]);
+    vtkImageData* read = reader->GetOutput();
+    for (int z = extent[4]; z <= extent[5]; z++)
+      {
+      // The slices are sorted by decreasing position.
+      int position = Slices - 1 - z;
+      for (int y = extent[2]; y <= extent[3]; y++)
+        {
+        for (int x = extent[0]; x <= extent[1]; x++)
+          {
+          TEST_ASSERT(read->GetScalarComponentAsDouble(x, y, z, 0) ==
+                      DICOMValue(x, Height - 1 - y, position),
+                      "Wrong DICOM pixel " << x << " " << y << " " << z
+                      << " read on " << threads << " threads");
+          }
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestImageReaderSeries(int, char*[])
+{
+  int extents[2][6] = { { 0, Width - 1, 0, Height - 1, 0, Slices - 1 },
+                        { 5, 30, 3, 21, 2, 8 } };
+  for (int i = 0; i < 2; i++)
+    {
+    if (TestPNGSeries(extents[i]) != EXIT_SUCCESS ||
+        TestDICOMSeries(extents[i]) != EXIT_SUCCESS)
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageWriterSeries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the PNG and JPEG files of a series encoded on several
+// threads are those encoded on one thread, for a number of slices that is
+// not a multiple of the number of threads, and that the PNG compression
+// level changes the size of the files but not their pixels.
+
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageMandelbrotSource.h"
+#include "vtkImageWriter.h"
+#include "vtkJPEGWriter.h"
+#include "vtkNew.h"
+#include "vtkPNGReader.h"
+#include "vtkPNGWriter.h"
+
+#include <string>
+#include <vtksys/SystemTools.hxx>
+#include <vtksys/ios/fstream>
+#include <vtksys/ios/sstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+const int Slices = 10;
+
+std::string FileName(const char* prefix, const char* extension, int slice)
+{
+  vtksys_ios::ostringstream name;
+  name << prefix << "_" << slice << "." << extension;
+  return name.str();
+}
+
+std::string ReadFile(const std::string& fileName)
+{
+  vtksys_ios::ifstream file(fileName.c_str(), ios::in | ios::binary);
+  vtksys_ios::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+int WriteSeries(vtkImageWriter* writer, vtkImageCast* cast,
+                const char* extension)
+{
+  writer->SetInputConnection(cast->GetOutputPort());
+  for (int threads = 1; threads <= 4; threads += 3)
+    {
+    writer->SetFilePrefix(threads == 1 ? "TestImageWriterSeries" :
+                          "TestImageWriterSeriesThreads");
+    std::string pattern = std::string("%s_%d.") + extension;
+    writer->SetFilePattern(pattern.c_str());
+    writer->SetNumberOfThreads(threads);
+    writer->Write();
+    TEST_ASSERT(writer->GetErrorCode() == 0,
+                "Could not write the " << extension << " files on "
+                << threads << " threads");
+    }
+  for (int z = 0; z < Slices; z++)
+    {
+    std::string serial =
+      ReadFile(FileName("TestImageWriterSeries", extension, z));
+    std::string threaded =
+      ReadFile(FileName("TestImageWriterSeriesThreads", extension, z));
+    TEST_ASSERT(!serial.empty() && serial == threaded,
+                "The " << extension << " file of slice " << z
+                << " encoded on threads differs");
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestImageWriterSeries(int, char*[])
+{
+  vtkNew<vtkImageMandelbrotSource> source;
+  source->SetWholeExtent(0, 63, 0, 47, 0, Slices - 1);
+  source->SetMaximumNumberOfIterations(60);
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputConnection(source->GetOutputPort());
+  cast->SetOutputScalarTypeToUnsignedChar();
+
+  vtkNew<vtkPNGWriter> pngWriter;
+  vtkNew<vtkJPEGWriter> jpegWriter;
+  if (WriteSeries(pngWriter.GetPointer(), cast.GetPointer(), "png") !=
+      EXIT_SUCCESS ||
+      WriteSeries(jpegWriter.GetPointer(), cast.GetPointer(), "jpg") !=
+      EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The PNG files encoded on threads hold the pixels of the slices.
+  vtkNew<vtkPNGReader> reader;
+  reader->SetFilePrefix("TestImageWriterSeriesThreads");
+  reader->SetFilePattern("%s_%d.png");
+  reader->SetDataExtent(0, 63, 0, 47, 0, Slices - 1);
+  reader->Update();
+  cast->UpdateWholeExtent();
+  vtkImageData* image = cast->GetOutput();
+  vtkImageData* read = reader->GetOutput();
+  for (int z = 0; z < Slices; z++)
+    {
+    for (int y = 0; y < 48; y++)
+      {
+      for (int x = 0; x < 64; x++)
+        {
+        TEST_ASSERT(read->GetScalarComponentAsDouble(x, y, z, 0) ==
+                    image->GetScalarComponentAsDouble(x, y, z, 0),
+                    "Wrong PNG pixel " << x << " " << y << " " << z);
+        }
+      }
+    }
+
+  // The fastest and the smallest compression of an image.
+  vtkNew<vtkImageMandelbrotSource> imageSource;
+  imageSource->SetWholeExtent(0, 255, 0, 255, 0, 0);
+  imageSource->SetMaximumNumberOfIterations(60);
+  vtkNew<vtkImageCast> imageCast;
+  imageCast->SetInputConnection(imageSource->GetOutputPort());
+  imageCast->SetOutputScalarTypeToUnsignedChar();
+  imageCast->Update();
+  image = imageCast->GetOutput();
+  const char* fileNames[2] = { "TestImageWriterSeriesFast.png",
+                               "TestImageWriterSeriesSmall.png" };
+  vtkNew<vtkPNGWriter> levelWriter;
+  levelWriter->SetInputConnection(imageCast->GetOutputPort());
+  for (int i = 0; i < 2; i++)
+    {
+    levelWriter->SetCompressionLevel(i ? 9 : 1);
+    levelWriter->SetFileName(fileNames[i]);
+    levelWriter->Write();
+    }
+  TEST_ASSERT(vtksys::SystemTools::FileLength(fileNames[1]) <
+              vtksys::SystemTools::FileLength(fileNames[0]),
+              "Expected a smaller file with the compression level 9");
+  for (int i = 0; i < 2; i++)
+    {
+    vtkNew<vtkPNGReader> levelReader;
+    levelReader->SetFileName(fileNames[i]);
+    levelReader->Update();
+    vtkImageData* levelRead = levelReader->GetOutput();
+    for (int y = 0; y < 256; y++)
+      {
+      for (int x = 0; x < 256; x++)
+        {
+        TEST_ASSERT(levelRead->GetScalarComponentAsDouble(x, y, 0, 0) ==
+                    image->GetScalarComponentAsDouble(x, y, 0, 0),
+                    "Wrong pixel " << x << " " << y << " in " << fileNames[i]);
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
@@ -563,6 +563,18 @@ void vtkBMPReader::ExecuteDataWithInformation(vtkDataObject *output,
     }
 }
 
+//----------------------------------------------------------------------------
+int vtkBMPReader::CopyReaderSettings(vtkImageReader2 *reader)
+{
+  vtkBMPReader *bmpReader = vtkBMPReader::SafeDownCast(reader);
+  if (!bmpReader || !this->Superclass::CopyReaderSettings(reader))
+    {
+    return 0;
+    }
+  bmpReader->SetAllow8BitBMP(this->Allow8BitBMP);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkBMPReader::PrintSelf(ostream& os, vtkIndent indent)
 {
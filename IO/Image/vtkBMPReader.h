@@ -102,6 +102,7 @@ protected:
   virtual void ComputeDataIncrements();
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *out, vtkInformation* outInfo);
+  virtual int CopyReaderSettings(vtkImageReader2 *reader);
 private:
   vtkBMPReader(const vtkBMPReader&);  // Not implemented.
   void operator=(const vtkBMPReader&);  // Not implemented.
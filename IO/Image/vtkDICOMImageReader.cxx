@@ -14,13 +14,16 @@
 =========================================================================*/
 #include "vtkDICOMImageReader.h"
 
+#include "vtkCriticalSection.h"
 #include "vtkDirectory.h"
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -36,6 +39,158 @@ class vtkDICOMImageReaderVector : public std::vector<std::string>
 
 };
 
+//----------------------------------------------------------------------------
+// Open a file and parse its header with the callbacks of 'helper'.
+// Returns false if the file cannot be opened or is not a DICOM file, which
+// the parser checks before reading any record, so each file is opened once.
+static bool vtkDICOMImageReaderReadHeader(DICOMParser* parser,
+                                          DICOMAppHelper* helper,
+                                          const std::string& fileName)
+{
+  parser->ClearAllDICOMTagCallbacks();
+  if (!parser->OpenFile(fileName))
+    {
+    return false;
+    }
+  helper->RegisterCallbacks(parser);
+  return parser->ReadHeader();
+}
+
+//----------------------------------------------------------------------------
+// Decode the pixels of a file into the rows of 'slice' that hold the x and
+// y range of 'extent'.  DICOM stores the upper left pixel as the first
+// pixel in an image while VTK stores the lower left pixel first, so the
+// rows are flipped.
+static bool vtkDICOMImageReaderReadSlice(DICOMParser* parser,
+                                         DICOMAppHelper* helper,
+                                         const std::string& fileName,
+                                         const int* extent, int pixelSize,
+                                         unsigned char* slice)
+{
+  parser->ClearAllDICOMTagCallbacks();
+  if (!parser->OpenFile(fileName))
+    {
+    return false;
+    }
+  helper->RegisterCallbacks(parser);
+  helper->RegisterPixelDataCallback(parser);
+  parser->ReadHeader();
+
+  void* imgData = NULL;
+  DICOMParser::VRTypes dataType;
+  unsigned long imageDataLengthInBytes = 0;
+  helper->GetImageData(imgData, dataType, imageDataLengthInBytes);
+  int width = helper->GetWidth();
+  int height = helper->GetHeight();
+  if (!imageDataLengthInBytes || extent[1] >= width || extent[3] >= height ||
+      imageDataLengthInBytes <
+      static_cast<unsigned long>(width) * height * pixelSize)
+    {
+    return false;
+    }
+
+  size_t rowLength = static_cast<size_t>(extent[1] - extent[0] + 1) * pixelSize;
+  unsigned char* iData = static_cast<unsigned char*>(imgData);
+  for (int y = extent[2]; y <= extent[3]; ++y)
+    {
+    memcpy(slice, iData + (static_cast<size_t>(height - 1 - y) * width +
+                           extent[0]) * pixelSize, rowLength);
+    slice += rowLength;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// The files of a directory whose headers are scanned on threads.  Each
+// thread scans a contiguous range of the files with a helper of its own,
+// so that merging the helpers in order gives the series of a single scan.
+struct vtkDICOMImageReaderHeaderJobs
+{
+  const std::vector<std::string>* Files;
+  std::vector<char> IsDICOM;
+  std::vector<DICOMAppHelper*> Helpers;
+  int NumberOfThreads;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkDICOMImageReaderReadHeaders(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkDICOMImageReaderHeaderJobs* jobs =
+    static_cast<vtkDICOMImageReaderHeaderJobs*>(info->UserData);
+  size_t numFiles = jobs->Files->size();
+  size_t begin = numFiles * info->ThreadID / jobs->NumberOfThreads;
+  size_t end = numFiles * (info->ThreadID + 1) / jobs->NumberOfThreads;
+
+  DICOMParser parser;
+  DICOMAppHelper* helper = jobs->Helpers[info->ThreadID];
+  for (size_t i = begin; i < end; ++i)
+    {
+    jobs->IsDICOM[i] =
+      vtkDICOMImageReaderReadHeader(&parser, helper, (*jobs->Files)[i]);
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+// The files of the slices of the update extent decoded on threads.  Each
+// thread takes the next file and decodes it with a parser and a helper of
+// its own, and the thread that takes the last file is recorded.
+struct vtkDICOMImageReaderSliceJobs
+{
+  const std::vector<std::string>* Files;
+  std::vector<DICOMAppHelper*> Helpers;
+  int LastThread;
+  const int* Extent;
+  int PixelSize;
+  size_t SliceBytes;
+  unsigned char* Output;
+  size_t Next;
+  size_t FirstFailed;
+  vtkSimpleCriticalSection Lock;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkDICOMImageReaderReadSlices(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkDICOMImageReaderSliceJobs* jobs =
+    static_cast<vtkDICOMImageReaderSliceJobs*>(info->UserData);
+  size_t numFiles = jobs->Files->size();
+
+  DICOMParser parser;
+  DICOMAppHelper* helper = jobs->Helpers[info->ThreadID];
+  for (;;)
+    {
+    jobs->Lock.Lock();
+    size_t i = jobs->Next++;
+    bool failed = jobs->FirstFailed < numFiles;
+    if (i + 1 == numFiles)
+      {
+      jobs->LastThread = info->ThreadID;
+      }
+    jobs->Lock.Unlock();
+    if (i >= numFiles || failed)
+      {
+      break;
+      }
+    if (!vtkDICOMImageReaderReadSlice(&parser, helper, (*jobs->Files)[i],
+                                      jobs->Extent, jobs->PixelSize,
+                                      jobs->Output + i * jobs->SliceBytes))
+      {
+      jobs->Lock.Lock();
+      if (i < jobs->FirstFailed)
+        {
+        jobs->FirstFailed = i;
+        }
+      jobs->Lock.Unlock();
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //----------------------------------------------------------------------------
 vtkDICOMImageReader::vtkDICOMImageReader()
 {
@@ -166,6 +321,7 @@ void vtkDICOMImageReader::ExecuteInformation()
     this->DICOMFileNames->clear();
     this->AppHelper->Clear();
 
+    std::vector<std::string> files;
     for (int i = 0; i < numFiles; i++)
       {
       if (strcmp(dir->GetFile(i), ".") == 0 ||
@@ -177,44 +333,68 @@ void vtkDICOMImageReader::ExecuteInformation()
       std::string fileString = this->DirectoryName;
       fileString += "/";
       fileString += dir->GetFile(i);
+      files.push_back(fileString);
+      }
+    dir->Delete();
 
-      int val = this->CanReadFile(fileString.c_str());
-
-      if (val == 1)
+    // The header of each file is parsed as soon as the file is known to be
+    // a DICOM file, on threads when there are several.
+    int numberOfThreads = this->NumberOfThreads;
+    if (static_cast<size_t>(numberOfThreads) > files.size())
+      {
+      numberOfThreads = static_cast<int>(files.size());
+      }
+    std::vector<char> isDICOM(files.size(), 0);
+    if (numberOfThreads <= 1)
+      {
+      for (size_t i = 0; i < files.size(); i++)
         {
-        vtkDebugMacro( << "Adding " << fileString.c_str() << " to DICOMFileNames.");
-        this->DICOMFileNames->push_back(fileString);
+        isDICOM[i] = vtkDICOMImageReaderReadHeader(this->Parser,
+                                                   this->AppHelper, files[i]);
         }
-      else
+      }
+    else
+      {
+      vtkDICOMImageReaderHeaderJobs jobs;
+      jobs.Files = &files;
+      jobs.IsDICOM.resize(files.size(), 0);
+      jobs.NumberOfThreads = numberOfThreads;
+      for (int t = 0; t < numberOfThreads; t++)
         {
-        vtkDebugMacro( << fileString.c_str() << " - DICOMParser CanReadFile returned : " << val);
+        jobs.Helpers.push_back(new DICOMAppHelper());
         }
+      vtkMultiThreader* threader = vtkMultiThreader::New();
+      threader->SetNumberOfThreads(numberOfThreads);
+      threader->SetSingleMethod(vtkDICOMImageReaderReadHeaders, &jobs);
+      threader->SingleMethodExecute();
+      threader->Delete();
 
+      for (int t = 0; t < numberOfThreads; t++)
+        {
+        size_t begin = files.size() * t / numberOfThreads;
+        size_t end = files.size() * (t + 1) / numberOfThreads;
+        if (std::find(jobs.IsDICOM.begin() + begin,
+                      jobs.IsDICOM.begin() + end, 1) !=
+            jobs.IsDICOM.begin() + end)
+          {
+          this->AppHelper->Merge(jobs.Helpers[t]);
+          }
+        delete jobs.Helpers[t];
+        }
+      isDICOM = jobs.IsDICOM;
       }
-    std::vector<std::string>::iterator iter;
 
-    for (iter = this->DICOMFileNames->begin();
-         iter != this->DICOMFileNames->end();
-         iter++)
+    for (size_t i = 0; i < files.size(); i++)
       {
-      const char* fn = iter->c_str();
-      vtkDebugMacro( << "Trying : " << fn);
-
-      bool couldOpen = this->Parser->OpenFile(fn);
-      if (!couldOpen)
+      if (isDICOM[i])
         {
-        dir->Delete();
-        return;
+        vtkDebugMacro( << "Adding " << files[i].c_str() << " to DICOMFileNames.");
+        this->DICOMFileNames->push_back(files[i]);
+        }
+      else
+        {
+        vtkDebugMacro( << files[i].c_str() << " is not a DICOM file.");
         }
-
-      //
-      this->Parser->ClearAllDICOMTagCallbacks();
-      this->AppHelper->RegisterCallbacks(this->Parser);
-
-      this->Parser->ReadHeader();
-
-      vtkDebugMacro( << "File name : " << fn );
-      vtkDebugMacro( << "Slice number : " << this->AppHelper->GetSliceNumber());
       }
 
     std::vector<std::pair<float, std::string> > sortedFiles;
@@ -241,7 +421,6 @@ void vtkDICOMImageReader::ExecuteInformation()
       {
       vtkErrorMacro( << "Couldn't get sorted files. Slices may be in wrong order!");
       }
-    dir->Delete();
     }
 
 }
@@ -263,116 +442,107 @@ void vtkDICOMImageReader::ExecuteDataWithInformation(vtkDataObject *output,
 
   this->ComputeDataIncrements();
 
+  unsigned char* buffer = static_cast<unsigned char*>(data->GetScalarPointer());
+  if (buffer == NULL)
+    {
+    vtkErrorMacro(<< "No memory allocated for image data!");
+    return;
+    }
+
+  // Only the files of the slices of the update extent are read.
+  int extent[6];
+  data->GetExtent(extent);
+  std::vector<std::string> files;
   if (this->FileName)
     {
     vtkDebugMacro( << "Single file : " << this->FileName);
-    this->Parser->ClearAllDICOMTagCallbacks();
-    this->Parser->OpenFile(this->FileName);
-    this->AppHelper->Clear();
-    this->AppHelper->RegisterCallbacks(this->Parser);
-    this->AppHelper->RegisterPixelDataCallback(this->Parser);
-
-    this->Parser->ReadHeader();
-
-    void* imgData = NULL;
-    DICOMParser::VRTypes dataType;
-    unsigned long imageDataLength;
-
-    this->AppHelper->GetImageData(imgData, dataType, imageDataLength);
-    if( !imageDataLength )
-      {
-      vtkErrorMacro( << "There was a problem retrieving data from: " << this->FileName );
-      this->SetErrorCode( vtkErrorCode::FileFormatError );
-      return;
-      }
-
-    void* buffer = data->GetScalarPointer();
-    if (buffer == NULL)
-      {
-      vtkErrorMacro(<< "No memory allocated for image data!");
-      return;
-      }
-    // DICOM stores the upper left pixel as the first pixel in an
-    // image. VTK stores the lower left pixel as the first pixel in
-    // an image.  Need to flip the data.
-    vtkIdType rowLength;
-    rowLength = this->DataIncrements[1];
-    unsigned char *b = (unsigned char *)buffer;
-    unsigned char *iData = (unsigned char *)imgData;
-    iData += (imageDataLength - rowLength); // beginning of last row
-    for (int i=0; i < this->AppHelper->GetHeight(); ++i)
-      {
-      memcpy(b, iData, rowLength);
-      b += rowLength;
-      iData -= rowLength;
-      }
+    files.push_back(this->FileName);
     }
-  else if (this->DICOMFileNames->size() > 0)
+  else
     {
     vtkDebugMacro( << "Multiple files (" << static_cast<int>(this->DICOMFileNames->size()) << ")");
-    this->Parser->ClearAllDICOMTagCallbacks();
-    this->AppHelper->Clear();
-    this->AppHelper->RegisterCallbacks(this->Parser);
-    this->AppHelper->RegisterPixelDataCallback(this->Parser);
-
-    void* buffer = data->GetScalarPointer();
-    if (buffer == NULL)
+    for (int z = extent[4]; z <= extent[5]; z++)
       {
-      vtkErrorMacro(<< "No memory allocated for image data!");
-      return;
+      if (z >= 0 && z < static_cast<int>(this->DICOMFileNames->size()))
+        {
+        files.push_back((*this->DICOMFileNames)[z]);
+        }
       }
+    }
+  int pixelSize = data->GetScalarSize() * data->GetNumberOfScalarComponents();
+  size_t sliceBytes = static_cast<size_t>(extent[1] - extent[0] + 1) *
+    (extent[3] - extent[2] + 1) * pixelSize;
 
-    std::vector<std::string>::iterator fiter;
-
-    int count = 0;
-    int numFiles = static_cast<int>(this->DICOMFileNames->size());
-
-    for (fiter = this->DICOMFileNames->begin();
-         fiter != this->DICOMFileNames->end();
-         fiter++)
+  int numberOfThreads = this->NumberOfThreads;
+  if (static_cast<size_t>(numberOfThreads) > files.size())
+    {
+    numberOfThreads = static_cast<int>(files.size());
+    }
+  if (numberOfThreads <= 1)
+    {
+    this->AppHelper->Clear();
+    int numFiles = static_cast<int>(files.size());
+    for (int count = 0; count < numFiles; count++)
       {
-      count++;
-      const char *file = fiter->c_str();
+      const char *file = files[count].c_str();
       vtkDebugMacro( << "File : " << file );
-      this->Parser->OpenFile( file );
-      this->Parser->ReadHeader();
-
-      void* imgData = NULL;
-      DICOMParser::VRTypes dataType;
-      unsigned long imageDataLengthInBytes;
-
-      this->AppHelper->GetImageData(imgData, dataType, imageDataLengthInBytes);
-      if( !imageDataLengthInBytes )
+      if (!vtkDICOMImageReaderReadSlice(this->Parser, this->AppHelper,
+                                        files[count], extent, pixelSize,
+                                        buffer + count * sliceBytes))
         {
         vtkErrorMacro( << "There was a problem retrieving data from: " << file );
         this->SetErrorCode( vtkErrorCode::FileFormatError );
         return;
         }
 
-      // DICOM stores the upper left pixel as the first pixel in an
-      // image. VTK stores the lower left pixel as the first pixel in
-      // an image.  Need to flip the data.
-      vtkIdType rowLength;
-      rowLength = this->DataIncrements[1];
-      unsigned char *b = (unsigned char *)buffer;
-      unsigned char *iData = (unsigned char *)imgData;
-      iData += (imageDataLengthInBytes - rowLength); // beginning of last row
-      for (int i=0; i < this->AppHelper->GetHeight(); ++i)
-        {
-        memcpy(b, iData, rowLength);
-        b += rowLength;
-        iData -= rowLength;
-        }
-      buffer = ((char*) buffer) + imageDataLengthInBytes;
-
-      this->UpdateProgress(float(count)/float(numFiles));
-      int len = static_cast<int> (strlen((const char*) (*fiter).c_str()));
-      char* filename = new char[len+1];
-      strcpy(filename, (const char*) (*fiter).c_str());
-      this->SetProgressText(filename);
-      delete[] filename;
+      this->UpdateProgress(float(count + 1)/float(numFiles));
+      this->SetProgressText(file);
+      }
+    return;
+    }
+
+  vtkDICOMImageReaderSliceJobs jobs;
+  jobs.Files = &files;
+  for (int t = 0; t < numberOfThreads; t++)
+    {
+    jobs.Helpers.push_back(new DICOMAppHelper());
+    }
+  jobs.LastThread = 0;
+  jobs.Extent = extent;
+  jobs.PixelSize = pixelSize;
+  jobs.SliceBytes = sliceBytes;
+  jobs.Output = buffer;
+  jobs.Next = 0;
+  jobs.FirstFailed = files.size();
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(vtkDICOMImageReaderReadSlices, &jobs);
+  threader->SingleMethodExecute();
+  threader->Delete();
+
+  // The helper of the thread that read the last file is merged last, so
+  // that the helper describes the files read and the last image as when
+  // the files are read one after another.
+  this->AppHelper->Clear();
+  for (int t = 0; t < numberOfThreads; t++)
+    {
+    if (t != jobs.LastThread)
+      {
+      this->AppHelper->Merge(jobs.Helpers[t]);
       }
     }
+  this->AppHelper->Merge(jobs.Helpers[jobs.LastThread]);
+  for (int t = 0; t < numberOfThreads; t++)
+    {
+    delete jobs.Helpers[t];
+    }
+
+  if (jobs.FirstFailed < files.size())
+    {
+    vtkErrorMacro( << "There was a problem retrieving data from: "
+                   << files[jobs.FirstFailed].c_str() );
+    this->SetErrorCode( vtkErrorCode::FileFormatError );
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -17,6 +17,11 @@
 // DICOM (stands for Digital Imaging in COmmunications and Medicine)
 // is a medical image file format widely used to exchange data, provided
 // by various modalities.
+//
+// When NumberOfThreads is greater than 1, the headers of the files of a
+// directory are scanned, and the slices of the update extent decoded,
+// on that many threads that each have a parser of their own, so that no
+// more than NumberOfThreads files are open at once.
 // .SECTION Warnings
 // This reader might eventually handle ACR-NEMA file (predecessor of the DICOM
 // format for medical images).
@@ -186,6 +191,12 @@ protected:
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *out, vtkInformation *outInfo);
 
+  //
+  // The files of a directory are read on threads by this class itself,
+  // not by separate readers.
+  //
+  virtual int CopyReaderSettings(vtkImageReader2 *) { return 0; }
+
   //
   // Constructor
   //
@@ -15,6 +15,7 @@
 #include "vtkImageReader.h"
 
 #include "vtkByteSwap.h"
+#include "vtkCallbackCommand.h"
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -24,6 +25,13 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 vtkStandardNewMacro(vtkImageReader);
 
 vtkCxxSetObjectMacro(vtkImageReader,Transform,vtkTransform);
@@ -51,6 +59,8 @@ vtkImageReader::vtkImageReader()
 
   this->ScalarArrayName = NULL;
   this->SetScalarArrayName("ImageFile");
+
+  this->MemoryMapping = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -89,6 +99,7 @@ void vtkImageReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "ScalarArrayName: "
      << (this->ScalarArrayName ? this->ScalarArrayName : "(none)") << endl;
+  os << indent << "MemoryMapping: " << this->MemoryMapping << "\n";
 }
 
 
@@ -418,6 +429,18 @@ void vtkImageReaderUpdate1(vtkImageReader *self, vtkImageData *data, T *inPtr)
 void vtkImageReader::ExecuteDataWithInformation(vtkDataObject *output,
                                                 vtkInformation *outInfo)
 {
+  vtkImageData *image = vtkImageData::SafeDownCast(output);
+  if (image && this->MemoryMapping && this->MapData(image, outInfo))
+    {
+    return;
+    }
+  // Scalars that point into a mapped file are not reused for the data read.
+  if (image && image->GetPointData()->GetScalars() &&
+      image->GetPointData()->GetScalars()->HasObserver(vtkCommand::DeleteEvent))
+    {
+    image->GetPointData()->SetScalars(NULL);
+    }
+
   vtkImageData *data = this->AllocateOutputData(output, outInfo);
 
   void *ptr = NULL;
@@ -451,10 +474,137 @@ void vtkImageReader::ExecuteDataWithInformation(vtkDataObject *output,
     }
 }
 
+//----------------------------------------------------------------------------
+// A mapping of a file, unmapped when the scalars that point into it are
+// deleted.
+struct vtkImageReaderMapping
+{
+  void *Address;
+  size_t Length;
+};
+
+//----------------------------------------------------------------------------
+static void vtkImageReaderUnmap(vtkObject *, unsigned long, void *clientData,
+                                void *)
+{
+  vtkImageReaderMapping *mapping =
+    static_cast<vtkImageReaderMapping *>(clientData);
+#ifndef _WIN32
+  munmap(mapping->Address, mapping->Length);
+#endif
+  delete mapping;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageReader::MapData(vtkImageData *data, vtkInformation *outInfo)
+{
+#ifdef _WIN32
+  (void)data;
+  (void)outInfo;
+  return 0;
+#else
+  int *extent = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+  int typeSize = vtkDataArray::GetDataTypeSize(this->DataScalarType);
+
+  // The extent must be whole slices of one file that are stored as the
+  // scalars are laid out in memory.
+  if (!extent || this->Transform || this->SwapBytes || !this->FileLowerLeft ||
+      this->DataMask != static_cast<vtkTypeUInt64>(~0UL) ||
+      this->DataScalarType == VTK_BIT || typeSize <= 0 ||
+      this->DataScalarType != vtkImageData::GetScalarType(outInfo) ||
+      this->NumberOfScalarComponents !=
+        vtkImageData::GetNumberOfScalarComponents(outInfo) ||
+      extent[0] != this->DataExtent[0] || extent[1] != this->DataExtent[1] ||
+      extent[2] != this->DataExtent[2] || extent[3] != this->DataExtent[3] ||
+      extent[4] > extent[5] ||
+      (this->FileDimensionality != 3 &&
+       (this->FileDimensionality != 2 || extent[4] != extent[5])))
+    {
+    return 0;
+    }
+
+  this->ComputeDataIncrements();
+  int slice = this->FileDimensionality == 3 ? 0 : extent[4];
+  vtkTypeInt64 offset = this->GetHeaderSize(slice);
+  if (this->FileDimensionality == 3)
+    {
+    offset += static_cast<vtkTypeInt64>(extent[4] - this->DataExtent[4]) *
+      static_cast<vtkTypeInt64>(this->DataIncrements[2]);
+    }
+  vtkIdType numberOfTuples =
+    static_cast<vtkIdType>(extent[1] - extent[0] + 1) *
+    (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1);
+  vtkTypeInt64 length = static_cast<vtkTypeInt64>(numberOfTuples) *
+    this->NumberOfScalarComponents * typeSize;
+  if (offset < 0 || offset % typeSize != 0)
+    {
+    return 0;
+    }
 
+  this->ComputeInternalFileName(slice);
+  int fd = open(this->InternalFileName, O_RDONLY);
+  if (fd < 0)
+    {
+    return 0;
+    }
+  struct stat statbuf;
+  if (fstat(fd, &statbuf) != 0 ||
+      static_cast<vtkTypeInt64>(statbuf.st_size) < offset + length)
+    {
+    close(fd);
+    return 0;
+    }
 
+  // The mapping starts at a page boundary.  It is private and writable so
+  // that changes to the scalars are copied instead of written to the file.
+  vtkTypeInt64 pageSize = sysconf(_SC_PAGESIZE);
+  vtkTypeInt64 start = offset - offset % pageSize;
+  vtkImageReaderMapping *mapping = new vtkImageReaderMapping;
+  mapping->Length = static_cast<size_t>(length + offset - start);
+  mapping->Address = mmap(NULL, mapping->Length, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE, fd, static_cast<off_t>(start));
+  close(fd);
+  if (mapping->Address == MAP_FAILED)
+    {
+    delete mapping;
+    return 0;
+    }
+  vtkDebugMacro("Mapping " << length << " bytes of " << this->InternalFileName
+                << " at " << offset);
+
+  data->SetExtent(extent);
+  vtkDataArray *scalars = vtkDataArray::CreateDataArray(this->DataScalarType);
+  scalars->SetNumberOfComponents(this->NumberOfScalarComponents);
+  scalars->SetVoidArray(static_cast<char *>(mapping->Address) + (offset - start),
+                        numberOfTuples * this->NumberOfScalarComponents, 1);
+  scalars->SetName(this->ScalarArrayName);
+  vtkCallbackCommand *unmap = vtkCallbackCommand::New();
+  unmap->SetCallback(vtkImageReaderUnmap);
+  unmap->SetClientData(mapping);
+  scalars->AddObserver(vtkCommand::DeleteEvent, unmap);
+  unmap->Delete();
+  data->GetPointData()->SetScalars(scalars);
+  scalars->Delete();
+  return 1;
+#endif
+}
 
+//----------------------------------------------------------------------------
+int vtkImageReader::CopyReaderSettings(vtkImageReader2 *reader)
+{
+  vtkImageReader *imageReader = vtkImageReader::SafeDownCast(reader);
+  if (!imageReader || this->Transform ||
+      !this->Superclass::CopyReaderSettings(reader))
+    {
+    return 0;
+    }
+  imageReader->SetDataVOI(this->DataVOI);
+  imageReader->SetDataMask(this->DataMask);
+  imageReader->SetScalarArrayName(this->ScalarArrayName);
+  return 1;
+}
 
+//----------------------------------------------------------------------------
 void vtkImageReader::ComputeTransformedSpacing (double Spacing[3])
 {
   if (!this->Transform)
@@ -17,6 +17,8 @@
 // vtkImageReader provides methods needed to read a region from a file.
 // It supports both transforms and masks on the input data, but as a result
 // is more complicated and slower than its parent class vtkImageReader2.
+// Raw files can also be memory-mapped instead of read, see
+// SetMemoryMapping().
 
 // .SECTION See Also
 // vtkBMPReader vtkPNMReader vtkTIFFReader
@@ -27,6 +29,7 @@
 #include "vtkIOImageModule.h" // For export macro
 #include "vtkImageReader2.h"
 
+class vtkImageData;
 class vtkTransform;
 
 #define VTK_FILE_BYTE_ORDER_BIG_ENDIAN 0
@@ -75,6 +78,19 @@ public:
   vtkSetStringMacro(ScalarArrayName);
   vtkGetStringMacro(ScalarArrayName);
 
+  // Description:
+  // Set/Get whether the file is memory-mapped instead of read.  When the
+  // extent read is made of whole slices of one file, stored in the native
+  // byte order and read without a transform or a data mask, the output
+  // scalars point into a private mapping of the file that is unmapped
+  // when they are deleted.  Only the pages that are used are then read
+  // from disk.  Changing the scalars does not change the file, but the
+  // file must not be changed while it is mapped.  Other extents are read
+  // as usual.  Default is off.
+  vtkSetMacro(MemoryMapping,int);
+  vtkGetMacro(MemoryMapping,int);
+  vtkBooleanMacro(MemoryMapping,int);
+
 protected:
   vtkImageReader();
   ~vtkImageReader();
@@ -94,11 +110,22 @@ protected:
 
   char *ScalarArrayName;
 
+  int MemoryMapping;
+
   virtual int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
                                  vtkInformationVector* outputVector);
 
   void ExecuteDataWithInformation(vtkDataObject *data, vtkInformation *outInfo);
+
+  // Description:
+  // Make the scalars of the output point into a mapping of the file.
+  // Returns 0 if the update extent cannot be mapped.
+  int MapData(vtkImageData *data, vtkInformation *outInfo);
+
+  // The slices of transformed data are not slices of the files, so they
+  // are not read on threads.
+  virtual int CopyReaderSettings(vtkImageReader2 *reader);
 private:
   vtkImageReader(const vtkImageReader&);  // Not implemented.
   void operator=(const vtkImageReader&);  // Not implemented.
@@ -15,16 +15,21 @@
 #include "vtkImageReader2.h"
 
 #include "vtkByteSwap.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
+#include <string.h>
+#include <string>
+#include <vector>
 #include <sys/stat.h>
 
 vtkStandardNewMacro(vtkImageReader2);
@@ -73,6 +78,7 @@ vtkImageReader2::vtkImageReader2()
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
   this->FileDimensionality = 2;
+  this->NumberOfThreads = 1;
   this->SetNumberOfInputPorts(0);
 }
 
@@ -482,6 +488,7 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
   os << ")\n";
 
   os << indent << "HeaderSize: " << this->HeaderSize << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 
   if ( this->InternalFileName )
     {
@@ -837,6 +844,230 @@ void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject *output,
 }
 
 
+//----------------------------------------------------------------------------
+// The slices shared by the threads.  Each thread takes the next slice of
+// the update extent and reads it with its own reader into the output.
+struct vtkImageReader2SliceJobs
+{
+  vtkImageReader2 *Self;
+  std::vector<vtkImageReader2*> Readers;
+  char *Output;
+  int OutputExtent[6];
+  int ScalarType;
+  int NumberOfComponents;
+  vtkIdType SliceSize;
+  int Next;
+  unsigned long ErrorCode;
+  std::string ScalarsName;
+  vtkSimpleCriticalSection Lock;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkImageReader2ReadSlices(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkImageReader2SliceJobs *jobs =
+    static_cast<vtkImageReader2SliceJobs*>(info->UserData);
+  jobs->Self->ReadSlicesInternal(jobs, info->ThreadID);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageReader2::RequestData(vtkInformation* request,
+                                 vtkInformationVector** inputVector,
+                                 vtkInformationVector* outputVector)
+{
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  int *uExt = outInfo ?
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) : NULL;
+  if (this->NumberOfThreads > 1 && this->FileDimensionality == 2 &&
+      (this->FileNames || (!this->FileName && this->FilePattern)) &&
+      uExt && uExt[5] > uExt[4])
+    {
+    this->SetErrorCode(vtkErrorCode::NoError);
+    if (this->ReadSlices(outInfo))
+      {
+      return this->GetErrorCode() ? 0 : 1;
+      }
+    }
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkImageReader2::CopyReaderSettings(vtkImageReader2 *reader)
+{
+  reader->SetFilePattern(this->FilePattern);
+  reader->SetFilePrefix(this->FilePrefix);
+  reader->SetFileNames(this->FileNames);
+  reader->SetFileName(this->FileName);
+  reader->FileNameSliceOffset = this->FileNameSliceOffset;
+  reader->FileNameSliceSpacing = this->FileNameSliceSpacing;
+  reader->DataScalarType = this->DataScalarType;
+  reader->NumberOfScalarComponents = this->NumberOfScalarComponents;
+  reader->FileDimensionality = this->FileDimensionality;
+  reader->FileLowerLeft = this->FileLowerLeft;
+  reader->SwapBytes = this->SwapBytes;
+  reader->HeaderSize = this->HeaderSize;
+  reader->ManualHeaderSize = this->ManualHeaderSize;
+  for (int idx = 0; idx < 6; ++idx)
+    {
+    reader->DataExtent[idx] = this->DataExtent[idx];
+    }
+  for (int idx = 0; idx < 3; ++idx)
+    {
+    reader->DataSpacing[idx] = this->DataSpacing[idx];
+    reader->DataOrigin[idx] = this->DataOrigin[idx];
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageReader2::ReadSlices(vtkInformation *outInfo)
+{
+  int *uExt = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+  int numberOfThreads = this->NumberOfThreads;
+  if (numberOfThreads > uExt[5] - uExt[4] + 1)
+    {
+    numberOfThreads = uExt[5] - uExt[4] + 1;
+    }
+
+  vtkImageReader2SliceJobs jobs;
+  jobs.Self = this;
+  jobs.ErrorCode = vtkErrorCode::NoError;
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    jobs.Readers.push_back(this->NewInstance());
+    if (!this->CopyReaderSettings(jobs.Readers.back()))
+      {
+      break;
+      }
+    // Each reader reads the header of the first slice as this one did.
+    jobs.Readers.back()->UpdateInformation();
+    if (jobs.Readers.back()->GetErrorCode() != vtkErrorCode::NoError)
+      {
+      jobs.ErrorCode = jobs.Readers.back()->GetErrorCode();
+      break;
+      }
+    }
+  if (static_cast<int>(jobs.Readers.size()) < numberOfThreads ||
+      jobs.ErrorCode != vtkErrorCode::NoError)
+    {
+    for (size_t i = 0; i < jobs.Readers.size(); ++i)
+      {
+      jobs.Readers[i]->Delete();
+      }
+    if (jobs.ErrorCode == vtkErrorCode::NoError)
+      {
+      return 0;
+      }
+    this->SetErrorCode(jobs.ErrorCode);
+    return 1;
+    }
+
+  vtkImageData *data = this->AllocateOutputData(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()), outInfo);
+  data->GetExtent(jobs.OutputExtent);
+  vtkDataArray *scalars = data->GetPointData()->GetScalars();
+  jobs.Output = static_cast<char*>(data->GetScalarPointer());
+  jobs.ScalarType = scalars->GetDataType();
+  jobs.NumberOfComponents = scalars->GetNumberOfComponents();
+  jobs.SliceSize =
+    static_cast<vtkIdType>(jobs.OutputExtent[1] - jobs.OutputExtent[0] + 1) *
+    (jobs.OutputExtent[3] - jobs.OutputExtent[2] + 1);
+  jobs.Next = jobs.OutputExtent[4];
+
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(vtkImageReader2ReadSlices, &jobs);
+  threader->SingleMethodExecute();
+  threader->Delete();
+
+  for (size_t i = 0; i < jobs.Readers.size(); ++i)
+    {
+    jobs.Readers[i]->Delete();
+    }
+  scalars->SetName(jobs.ScalarsName.empty() ?
+                   "ImageFile" : jobs.ScalarsName.c_str());
+  if (jobs.ErrorCode != vtkErrorCode::NoError)
+    {
+    vtkErrorMacro("Could not read the slices of the update extent.");
+    this->SetErrorCode(jobs.ErrorCode);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageReader2::ReadSlicesInternal(void *arg, int threadId)
+{
+  vtkImageReader2SliceJobs *jobs = static_cast<vtkImageReader2SliceJobs*>(arg);
+  vtkImageReader2 *reader = jobs->Readers[threadId];
+  vtkInformation *readerInfo = reader->GetOutputInformation(0);
+  vtkIdType sliceLength = jobs->SliceSize * jobs->NumberOfComponents;
+  size_t sliceBytes = static_cast<size_t>(sliceLength) *
+    vtkDataArray::GetDataTypeSize(jobs->ScalarType);
+
+  for (;;)
+    {
+    jobs->Lock.Lock();
+    int slice = jobs->Next++;
+    int failed = jobs->ErrorCode != vtkErrorCode::NoError;
+    jobs->Lock.Unlock();
+    if (slice > jobs->OutputExtent[5] || failed)
+      {
+      break;
+      }
+
+    // The slice wraps the output scalars at its offset, which the reader
+    // fills in place unless it allocates scalars of its own.
+    char *ptr = jobs->Output +
+      static_cast<size_t>(slice - jobs->OutputExtent[4]) * sliceBytes;
+    vtkDataArray *sliceScalars = vtkDataArray::CreateDataArray(jobs->ScalarType);
+    sliceScalars->SetNumberOfComponents(jobs->NumberOfComponents);
+    sliceScalars->SetVoidArray(ptr, sliceLength, 1);
+    vtkImageData *image = vtkImageData::New();
+    int sliceExt[6];
+    memcpy(sliceExt, jobs->OutputExtent, sizeof(sliceExt));
+    sliceExt[4] = sliceExt[5] = slice;
+    image->SetExtent(sliceExt);
+    image->GetPointData()->SetScalars(sliceScalars);
+    sliceScalars->Delete();
+
+    readerInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(),
+                    sliceExt, 6);
+    reader->SetErrorCode(vtkErrorCode::NoError);
+    reader->ExecuteDataWithInformation(image, readerInfo);
+
+    vtkDataArray *read = image->GetPointData()->GetScalars();
+    unsigned long errorCode = reader->GetErrorCode();
+    if (errorCode == vtkErrorCode::NoError &&
+        (!read || read->GetDataType() != jobs->ScalarType ||
+         read->GetNumberOfComponents() != jobs->NumberOfComponents ||
+         read->GetNumberOfTuples() != jobs->SliceSize))
+      {
+      errorCode = vtkErrorCode::FileFormatError;
+      }
+    else if (errorCode == vtkErrorCode::NoError &&
+             read->GetVoidPointer(0) != ptr)
+      {
+      memcpy(ptr, read->GetVoidPointer(0), sliceBytes);
+      }
+
+    jobs->Lock.Lock();
+    if (errorCode != vtkErrorCode::NoError &&
+        jobs->ErrorCode == vtkErrorCode::NoError)
+      {
+      jobs->ErrorCode = errorCode;
+      }
+    if (jobs->ScalarsName.empty() && read && read->GetName())
+      {
+      jobs->ScalarsName = read->GetName();
+      }
+    jobs->Lock.Unlock();
+    image->Delete();
+    }
+}
+
 //----------------------------------------------------------------------------
 // Set the data type of pixels in the file.
 // If you want the output scalar type to have a different value, set it
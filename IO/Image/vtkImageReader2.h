@@ -227,6 +227,21 @@ public:
     {
       return 0;
     }
+
+  // Description:
+  // Get/Set the number of threads on which the slices of a series of 2D
+  // files are read.  Each thread reads one file at a time with a reader
+  // of its own, so no more than NumberOfThreads files are open at once.
+  // Subclasses may also use the threads to decode a single file.
+  // Default is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Internal method, do not use.  Reads the next slices queued in 'jobs'
+  // with the reader of the thread 'threadId'.
+  void ReadSlicesInternal(void *jobs, int threadId);
+
 protected:
   vtkImageReader2();
   ~vtkImageReader2();
@@ -256,12 +271,32 @@ protected:
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
 
+  int NumberOfThreads;
+
   virtual int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
                                  vtkInformationVector* outputVector);
   virtual void ExecuteInformation();
   virtual void ExecuteDataWithInformation(vtkDataObject *data, vtkInformation *outInfo);
   virtual void ComputeDataIncrements();
+
+  // Reads the slices of a series on threads when NumberOfThreads is
+  // greater than 1, otherwise executes as the superclass does.
+  virtual int RequestData(vtkInformation* request,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
+
+  // Description:
+  // Copy to 'reader', a new instance of this class that reads some of
+  // the slices on a thread, the settings that change how the files are
+  // read.  Returns 0 if the slices cannot be read by separate readers.
+  // Subclasses with settings of their own extend it.
+  virtual int CopyReaderSettings(vtkImageReader2 *reader);
+
+  // Read the slices of the update extent on NumberOfThreads threads.
+  // Returns 0 if the slices cannot be read separately.
+  int ReadSlices(vtkInformation *outInfo);
+
 private:
   vtkImageReader2(const vtkImageReader2&);  // Not implemented.
   void operator=(const vtkImageReader2&);  // Not implemented.
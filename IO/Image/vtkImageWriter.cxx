@@ -14,11 +14,14 @@
 =========================================================================*/
 #include "vtkImageWriter.h"
 
+#include "vtkAlgorithmOutput.h"
 #include "vtkCommand.h"
+#include "vtkCriticalSection.h"
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -26,6 +29,9 @@
 
 #include <vtksys/SystemTools.hxx>
 
+#include <string>
+#include <vector>
+
 vtkStandardNewMacro(vtkImageWriter);
 
 //----------------------------------------------------------------------------
@@ -45,6 +51,7 @@ vtkImageWriter::vtkImageWriter()
 
   this->MinimumFileNumber = this->MaximumFileNumber = 0;
   this->FilesDeleted = 0;
+  this->NumberOfThreads = 1;
   this->SetNumberOfOutputPorts(0);
 }
 
@@ -85,6 +92,7 @@ void vtkImageWriter::PrintSelf(ostream& os, vtkIndent indent)
     (this->FilePattern ? this->FilePattern : "(none)") << "\n";
 
   os << indent << "FileDimensionality: " << this->FileDimensionality << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 }
 
 
@@ -545,3 +553,123 @@ void vtkImageWriter::DeleteFiles()
     }
   this->FilesDeleted = 1;
 }
+
+//----------------------------------------------------------------------------
+unsigned long vtkImageWriter::EncodeSlice(vtkImageData *vtkNotUsed(data),
+                                          int *vtkNotUsed(uExtent),
+                                          const char *vtkNotUsed(fileName))
+{
+  return vtkErrorCode::NoError;
+}
+
+//----------------------------------------------------------------------------
+// The slices of a batch shared by the threads.  Each thread takes the
+// next slice of the batch and encodes it into its file.
+struct vtkImageWriterSliceJobs
+{
+  vtkImageWriter *Self;
+  vtkImageData *Data;
+  int Extent[6];
+  std::vector<std::string> FileNames;
+  std::vector<unsigned long> ErrorCodes;
+  int Next;
+  vtkSimpleCriticalSection Lock;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkImageWriterWriteSlices(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkImageWriterSliceJobs *jobs =
+    static_cast<vtkImageWriterSliceJobs*>(info->UserData);
+  jobs->Self->WriteSlicesInternal(jobs, info->ThreadID);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageWriter::WriteSlices(int *wExtent)
+{
+  vtkImageWriterSliceJobs jobs;
+  jobs.Self = this;
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetSingleMethod(vtkImageWriterWriteSlices, &jobs);
+
+  for (int first = wExtent[4]; first <= wExtent[5];
+       first += this->NumberOfThreads)
+    {
+    int last = first + this->NumberOfThreads - 1;
+    if (last > wExtent[5])
+      {
+      last = wExtent[5];
+      }
+    memcpy(jobs.Extent, wExtent, 4*sizeof(int));
+    jobs.Extent[4] = first;
+    jobs.Extent[5] = last;
+    vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+      this->GetInputInformation(0, 0), jobs.Extent);
+    this->GetInputExecutive(0, 0)->Update(
+      this->GetInputConnection(0, 0)->GetIndex());
+    jobs.Data = this->GetInput();
+
+    // determine the names
+    jobs.FileNames.clear();
+    for (this->FileNumber = first; this->FileNumber <= last;
+         ++this->FileNumber)
+      {
+      if (this->FilePrefix)
+        {
+        sprintf(this->InternalFileName, this->FilePattern,
+                this->FilePrefix, this->FileNumber);
+        }
+      else
+        {
+        sprintf(this->InternalFileName, this->FilePattern, this->FileNumber);
+        }
+      jobs.FileNames.push_back(this->InternalFileName);
+      }
+    jobs.ErrorCodes.assign(jobs.FileNames.size(), vtkErrorCode::NoError);
+    jobs.Next = first;
+    this->MaximumFileNumber = last;
+
+    threader->SetNumberOfThreads(last - first + 1);
+    threader->SingleMethodExecute();
+
+    for (size_t i = 0; i < jobs.ErrorCodes.size(); ++i)
+      {
+      if (jobs.ErrorCodes[i] != vtkErrorCode::NoError)
+        {
+        this->SetErrorCode(jobs.ErrorCodes[i]);
+        }
+      }
+    if (this->ErrorCode == vtkErrorCode::OutOfDiskSpaceError)
+      {
+      this->DeleteFiles();
+      break;
+      }
+    this->UpdateProgress((last + 1 - wExtent[4])/
+                         (wExtent[5] - wExtent[4] + 1.0));
+    }
+  threader->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkImageWriter::WriteSlicesInternal(void *arg, int vtkNotUsed(threadId))
+{
+  vtkImageWriterSliceJobs *jobs = static_cast<vtkImageWriterSliceJobs*>(arg);
+  for (;;)
+    {
+    jobs->Lock.Lock();
+    int slice = jobs->Next++;
+    jobs->Lock.Unlock();
+    if (slice > jobs->Extent[5])
+      {
+      break;
+      }
+    int uExtent[6];
+    memcpy(uExtent, jobs->Extent, 4*sizeof(int));
+    uExtent[4] = uExtent[5] = slice;
+    jobs->ErrorCodes[slice - jobs->Extent[4]] = this->EncodeSlice(
+      jobs->Data, uExtent, jobs->FileNames[slice - jobs->Extent[4]].c_str());
+    }
+}
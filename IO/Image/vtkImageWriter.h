@@ -71,6 +71,20 @@ public:
 
   void DeleteFiles();
 
+  // Description:
+  // Get/Set the number of threads on which writers that encode each
+  // slice of a volume into a file of its own, such as vtkPNGWriter and
+  // vtkJPEGWriter, encode the slices.  The input is updated for
+  // NumberOfThreads slices at a time, which are then encoded at once.
+  // Default is 1.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Internal method, do not use.  Encodes the next slices queued in
+  // 'jobs' on the thread 'threadId'.
+  void WriteSlicesInternal(void *jobs, int threadId);
+
 protected:
   vtkImageWriter();
   ~vtkImageWriter();
@@ -107,6 +121,23 @@ protected:
   int MaximumFileNumber;
   int FilesDeleted;
 
+  int NumberOfThreads;
+
+  // Description:
+  // Encode the slice 'uExtent' of 'data' into the file 'fileName', or
+  // into memory if 'fileName' is NULL, and return a vtkErrorCode.  Since
+  // the slices of a volume are encoded on several threads at once, it
+  // must not change the writer when writing to a file.  The default does
+  // nothing.
+  virtual unsigned long EncodeSlice(vtkImageData *data, int *uExtent,
+                                    const char *fileName);
+
+  // Write the slices of the whole extent 'wExtent' to a file each with
+  // EncodeSlice, on NumberOfThreads threads.  The file names are built
+  // from FilePrefix and FilePattern, and the files are deleted if the
+  // disk fills up.
+  void WriteSlices(int *wExtent);
+
 private:
   vtkImageWriter(const vtkImageWriter&);  // Not implemented.
   void operator=(const vtkImageWriter&);  // Not implemented.
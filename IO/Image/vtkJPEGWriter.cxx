@@ -45,7 +45,6 @@ vtkJPEGWriter::vtkJPEGWriter()
   this->Progressive = 1;
   this->WriteToMemory = 0;
   this->Result = 0;
-  this->TempFP = 0;
 }
 
 vtkJPEGWriter::~vtkJPEGWriter()
@@ -91,6 +90,15 @@ void vtkJPEGWriter::Write()
   this->MinimumFileNumber = this->MaximumFileNumber = this->FileNumber;
   this->FilesDeleted = 0;
   this->UpdateProgress(0.0);
+  // the slices of a series are encoded on threads
+  if (this->NumberOfThreads > 1 && !this->WriteToMemory && !this->FileName &&
+      wExtent[5] > wExtent[4])
+    {
+    this->WriteSlices(wExtent);
+    delete [] this->InternalFileName;
+    this->InternalFileName = NULL;
+    return;
+    }
   // loop over the z axis and write the slices
   for (this->FileNumber = wExtent[4]; this->FileNumber <= wExtent[5];
        ++this->FileNumber)
@@ -121,7 +129,13 @@ void vtkJPEGWriter::Write()
         }
       }
     this->GetInputExecutive(0, 0)->Update();
-    this->WriteSlice(this->GetInput(), uExtent);
+    unsigned long errorCode = this->EncodeSlice(
+      this->GetInput(), uExtent,
+      this->WriteToMemory ? NULL : this->InternalFileName);
+    if (errorCode != vtkErrorCode::NoError)
+      {
+      this->SetErrorCode(errorCode);
+      }
     if (this->ErrorCode == vtkErrorCode::OutOfDiskSpaceError)
       {
       vtkErrorMacro("Ran out of disk space; deleting file(s) already written");
@@ -231,7 +245,8 @@ extern "C"
 #if defined(_MSC_VER) && !defined(VTK_DISPLAY_WIN32_WARNINGS)
 #pragma warning ( disable : 4611 )
 #endif
-void vtkJPEGWriter::WriteSlice(vtkImageData *data, int* uExtent)
+unsigned long vtkJPEGWriter::EncodeSlice(vtkImageData *data, int* uExtent,
+                                         const char *fileName)
 {
   // Call the correct templated function for the output
   unsigned int ui;
@@ -240,13 +255,13 @@ void vtkJPEGWriter::WriteSlice(vtkImageData *data, int* uExtent)
   if (data->GetScalarType() != VTK_UNSIGNED_CHAR)
     {
     vtkWarningMacro("JPEGWriter only supports unsigned char input");
-    return;
+    return vtkErrorCode::NoError;
     }
 
   if (data->GetNumberOfScalarComponents() > MAX_COMPONENTS)
     {
     vtkErrorMacro("Exceed JPEG limits for number of components (" << data->GetNumberOfScalarComponents() << " > " << MAX_COMPONENTS << ")" );
-    return;
+    return vtkErrorCode::NoError;
     }
 
   // overriding jpeg_error_mgr so we don't exit when an error happens
@@ -254,15 +269,14 @@ void vtkJPEGWriter::WriteSlice(vtkImageData *data, int* uExtent)
   // Create the jpeg compression object and error handler
   struct jpeg_compress_struct cinfo;
   struct VTK_JPEG_ERROR_MANAGER jerr;
-  this->TempFP = 0;
-  if (!this->WriteToMemory)
+  FILE *fp = 0;
+  if (fileName)
     {
-    this->TempFP = fopen(this->InternalFileName, "wb");
-    if (!this->TempFP)
+    fp = fopen(fileName, "wb");
+    if (!fp)
       {
-      vtkErrorMacro("Unable to open file " << this->InternalFileName);
-      this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
-      return;
+      vtkErrorMacro("Unable to open file " << fileName);
+      return vtkErrorCode::CannotOpenFileError;
       }
     }
 
@@ -271,19 +285,18 @@ void vtkJPEGWriter::WriteSlice(vtkImageData *data, int* uExtent)
   if (setjmp(jerr.setjmp_buffer))
     {
     jpeg_destroy_compress(&cinfo);
-    if (!this->WriteToMemory)
+    if (fp)
       {
-      fclose(this->TempFP);
+      fclose(fp);
       }
-    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-    return;
+    return vtkErrorCode::OutOfDiskSpaceError;
     }
 
   jpeg_create_compress(&cinfo);
 
   // set the destination file
   struct jpeg_destination_mgr compressionDestination;
-  if (this->WriteToMemory)
+  if (!fp)
     {
     // setup the compress structure to write to memory
     compressionDestination.init_destination = vtkJPEGWriteToMemoryInit;
@@ -294,7 +307,7 @@ void vtkJPEGWriter::WriteSlice(vtkImageData *data, int* uExtent)
     }
   else
     {
-    jpeg_stdio_dest(&cinfo, this->TempFP);
+    jpeg_stdio_dest(&cinfo, fp);
     }
 
   // set the information about image
@@ -340,13 +353,12 @@ void vtkJPEGWriter::WriteSlice(vtkImageData *data, int* uExtent)
     }
   jpeg_write_scanlines(&cinfo, row_pointers, height);
 
-  if (!this->WriteToMemory)
+  if (fp)
     {
-    if (fflush(this->TempFP) == EOF)
+    if (fflush(fp) == EOF)
       {
-      this->ErrorCode = vtkErrorCode::OutOfDiskSpaceError;
-      fclose(this->TempFP);
-      return;
+      fclose(fp);
+      return vtkErrorCode::OutOfDiskSpaceError;
       }
     }
 
@@ -357,10 +369,11 @@ void vtkJPEGWriter::WriteSlice(vtkImageData *data, int* uExtent)
   delete [] row_pointers;
   jpeg_destroy_compress(&cinfo);
 
-  if (!this->WriteToMemory)
+  if (fp)
     {
-    fclose(this->TempFP);
+    fclose(fp);
     }
+  return vtkErrorCode::NoError;
 }
 
 void vtkJPEGWriter::PrintSelf(ostream& os, vtkIndent indent)
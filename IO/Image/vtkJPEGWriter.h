@@ -68,14 +68,14 @@ protected:
   vtkJPEGWriter();
   ~vtkJPEGWriter();
 
-  void WriteSlice(vtkImageData *data, int* uExtent);
+  virtual unsigned long EncodeSlice(vtkImageData *data, int* uExtent,
+                                    const char *fileName);
 
 private:
   int Quality;
   unsigned int Progressive;
   unsigned int WriteToMemory;
   vtkUnsignedCharArray *Result;
-  FILE *TempFP;
 
 private:
   vtkJPEGWriter(const vtkJPEGWriter&);  // Not implemented.
@@ -266,28 +266,50 @@ void vtkPNGReaderUpdate2(vtkPNGReader *self, OT *outPtr,
   png_read_update_info(png_ptr, info_ptr);
 
   int rowbytes = png_get_rowbytes(png_ptr, info_ptr);
-  unsigned char *tempImage = new unsigned char [rowbytes*height];
-  png_bytep *row_pointers = new png_bytep [height];
-  for (ui = 0; ui < height; ++ui)
-    {
-    row_pointers[ui] = tempImage + rowbytes*ui;
-    }
-  png_read_image(png_ptr, row_pointers);
-
-  // copy the data into the outPtr
-  OT *outPtr2;
-  outPtr2 = outPtr;
   long outSize = pixSize*(outExt[1] - outExt[0] + 1);
-  for (i = outExt[2]; i <= outExt[3]; ++i)
+  if (interlace_type == PNG_INTERLACE_NONE)
+    {
+    // The rows are stored from the top of the image and decoded one after
+    // another, so the rows below the output extent are not decoded and
+    // the rows above it are decoded into a single row.
+    unsigned char *row = new unsigned char [rowbytes];
+    png_uint_32 firstRow = height - outExt[3] - 1;
+    png_uint_32 lastRow = height - outExt[2] - 1;
+    for (ui = 0; ui <= lastRow; ++ui)
+      {
+      png_read_row(png_ptr, row, NULL);
+      if (ui >= firstRow)
+        {
+        memcpy(outPtr + (lastRow - ui)*outInc[1], row + outExt[0]*pixSize,
+               outSize);
+        }
+      }
+    delete [] row;
+    }
+  else
     {
-    memcpy(outPtr2,row_pointers[height - i - 1] + outExt[0]*pixSize,outSize);
-    outPtr2 += outInc[1];
+    unsigned char *tempImage = new unsigned char [rowbytes*height];
+    png_bytep *row_pointers = new png_bytep [height];
+    for (ui = 0; ui < height; ++ui)
+      {
+      row_pointers[ui] = tempImage + rowbytes*ui;
+      }
+    png_read_image(png_ptr, row_pointers);
+
+    // copy the data into the outPtr
+    OT *outPtr2;
+    outPtr2 = outPtr;
+    for (i = outExt[2]; i <= outExt[3]; ++i)
+      {
+      memcpy(outPtr2,row_pointers[height - i - 1] + outExt[0]*pixSize,outSize);
+      outPtr2 += outInc[1];
+      }
+    delete [] tempImage;
+    delete [] row_pointers;
+    png_read_end(png_ptr, NULL);
     }
-  delete [] tempImage;
-  delete [] row_pointers;
 
   // close the file
-  png_read_end(png_ptr, NULL);
   png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
   fclose(fp);
 }
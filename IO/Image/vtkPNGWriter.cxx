@@ -32,7 +32,7 @@ vtkPNGWriter::vtkPNGWriter()
   this->FileDimensionality = 2;
   this->WriteToMemory = 0;
   this->Result = 0;
-  this->TempFP = 0;
+  this->CompressionLevel = 6;
 }
 
 vtkPNGWriter::~vtkPNGWriter()
@@ -78,6 +78,15 @@ void vtkPNGWriter::Write()
   this->MinimumFileNumber = this->MaximumFileNumber = this->FileNumber;
   this->FilesDeleted = 0;
   this->UpdateProgress(0.0);
+  // the slices of a series are encoded on threads
+  if (this->NumberOfThreads > 1 && !this->WriteToMemory && !this->FileName &&
+      wExtent[5] > wExtent[4])
+    {
+    this->WriteSlices(wExtent);
+    delete [] this->InternalFileName;
+    this->InternalFileName = NULL;
+    return;
+    }
   // loop over the z axis and write the slices
   for (this->FileNumber = wExtent[4]; this->FileNumber <= wExtent[5];
        ++this->FileNumber)
@@ -108,7 +117,13 @@ void vtkPNGWriter::Write()
     vtkDemandDrivenPipeline::SafeDownCast(
       this->GetInputExecutive(0, 0))->UpdateData(
         this->GetInputConnection(0, 0)->GetIndex());
-    this->WriteSlice(this->GetInput(), uExt);
+    unsigned long errorCode = this->EncodeSlice(
+      this->GetInput(), uExt,
+      this->WriteToMemory ? NULL : this->InternalFileName);
+    if (errorCode != vtkErrorCode::NoError)
+      {
+      this->SetErrorCode(errorCode);
+      }
     if (this->ErrorCode == vtkErrorCode::OutOfDiskSpaceError)
       {
       this->DeleteFiles();
@@ -185,7 +200,8 @@ extern "C"
 #if defined(_MSC_VER) && !defined(VTK_DISPLAY_WIN32_WARNINGS)
 #pragma warning ( disable : 4611 )
 #endif
-void vtkPNGWriter::WriteSlice(vtkImageData *data, int* uExtent)
+unsigned long vtkPNGWriter::EncodeSlice(vtkImageData *data, int* uExtent,
+                                        const char *fileName)
 {
   // Call the correct templated function for the output
   unsigned int ui;
@@ -195,7 +211,7 @@ void vtkPNGWriter::WriteSlice(vtkImageData *data, int* uExtent)
       data->GetScalarType() != VTK_UNSIGNED_CHAR)
     {
     vtkWarningMacro("PNGWriter only supports unsigned char and unsigned short inputs");
-    return;
+    return vtkErrorCode::NoError;
     }
 
   png_structp png_ptr = png_create_write_struct
@@ -203,7 +219,7 @@ void vtkPNGWriter::WriteSlice(vtkImageData *data, int* uExtent)
   if (!png_ptr)
     {
     vtkErrorMacro(<<"Unable to write PNG file!");
-    return;
+    return vtkErrorCode::NoError;
     }
 
   png_infop info_ptr = png_create_info_struct(png_ptr);
@@ -212,12 +228,11 @@ void vtkPNGWriter::WriteSlice(vtkImageData *data, int* uExtent)
     png_destroy_write_struct(&png_ptr,
                              (png_infopp)NULL);
     vtkErrorMacro(<<"Unable to write PNG file!");
-    return;
+    return vtkErrorCode::NoError;
     }
 
-
-  this->TempFP = 0;
-  if (this->WriteToMemory)
+  FILE *fp = 0;
+  if (!fileName)
     {
     vtkUnsignedCharArray *uc = this->GetResult();
     if (!uc || uc->GetReferenceCount() > 1)
@@ -233,21 +248,21 @@ void vtkPNGWriter::WriteSlice(vtkImageData *data, int* uExtent)
     }
   else
     {
-      this->TempFP = fopen(this->InternalFileName, "wb");
-      if (!this->TempFP)
+      fp = fopen(fileName, "wb");
+      if (!fp)
         {
-        vtkErrorMacro("Unable to open file " << this->InternalFileName);
-        this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-        return;
+        vtkErrorMacro("Unable to open file " << fileName);
+        png_destroy_write_struct(&png_ptr, &info_ptr);
+        return vtkErrorCode::OutOfDiskSpaceError;
         }
-      png_init_io(png_ptr, this->TempFP);
+      png_init_io(png_ptr, fp);
       png_set_error_fn(png_ptr, png_ptr,
                        vtkPNGWriteErrorFunction, vtkPNGWriteWarningFunction);
       if (setjmp(png_jmpbuf((png_ptr))))
         {
-        fclose(this->TempFP);
-        this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
-        return;
+        fclose(fp);
+        png_destroy_write_struct(&png_ptr, &info_ptr);
+        return vtkErrorCode::OutOfDiskSpaceError;
         }
     }
 
@@ -281,6 +296,7 @@ void vtkPNGWriter::WriteSlice(vtkImageData *data, int* uExtent)
                PNG_FILTER_TYPE_DEFAULT);
   // interlace_type - PNG_INTERLACE_NONE or
   //                 PNG_INTERLACE_ADAM7
+  png_set_compression_level(png_ptr, this->CompressionLevel);
 
   png_write_info(png_ptr, info_ptr);
   // default is big endian
@@ -308,19 +324,21 @@ void vtkPNGWriter::WriteSlice(vtkImageData *data, int* uExtent)
   delete [] row_pointers;
   png_destroy_write_struct(&png_ptr, &info_ptr);
 
-  if (this->TempFP)
+  unsigned long errorCode = vtkErrorCode::NoError;
+  if (fp)
     {
-    fflush(this->TempFP);
-    if (ferror(this->TempFP))
+    fflush(fp);
+    if (ferror(fp))
       {
-      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+      errorCode = vtkErrorCode::OutOfDiskSpaceError;
       }
     }
 
-  if (this->TempFP)
+  if (fp)
     {
-    fclose(this->TempFP);
+    fclose(fp);
     }
+  return errorCode;
 }
 
 void vtkPNGWriter::PrintSelf(ostream& os, vtkIndent indent)
@@ -329,4 +347,5 @@ void vtkPNGWriter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Result: " << this->Result << "\n";
   os << indent << "WriteToMemory: " << (this->WriteToMemory ? "On" : "Off") << "\n";
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
 }
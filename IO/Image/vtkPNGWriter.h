@@ -52,14 +52,22 @@ public:
   virtual void SetResult(vtkUnsignedCharArray*);
   vtkGetObjectMacro(Result, vtkUnsignedCharArray);
 
+  // Description:
+  // The zlib compression level, from 0 (no compression) to 9 (smallest
+  // files).  Low levels write larger files much faster, which suits
+  // frames written while rendering.  Default is 6, zlib's default.
+  vtkSetClampMacro(CompressionLevel, int, 0, 9);
+  vtkGetMacro(CompressionLevel, int);
+
 protected:
   vtkPNGWriter();
   ~vtkPNGWriter();
 
-  void WriteSlice(vtkImageData *data, int* uExtent);
+  virtual unsigned long EncodeSlice(vtkImageData *data, int* uExtent,
+                                    const char *fileName);
   unsigned int WriteToMemory;
   vtkUnsignedCharArray *Result;
-  FILE *TempFP;
+  int CompressionLevel;
 
 private:
   vtkPNGWriter(const vtkPNGWriter&);  // Not implemented.
@@ -14,15 +14,22 @@
 =========================================================================*/
 #include "vtkTIFFReader.h"
 
+#include "vtkCriticalSection.h"
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
 #include "vtkObjectFactory.h"
 
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 
 extern "C" {
@@ -31,6 +38,7 @@ extern "C" {
 
 //-------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTIFFReader);
+vtkInformationKeyRestrictedMacro(vtkTIFFReader, TILE_SIZE, IntegerVector, 2);
 
 class vtkTIFFReaderInternal
 {
@@ -59,6 +67,7 @@ public:
   unsigned int TileWidth;
   unsigned int TileHeight;
   unsigned short NumberOfTiles;
+  unsigned int RowsPerStrip;
   unsigned int SubFiles;
   unsigned int ResolutionUnit;
   float XResolution;
@@ -127,6 +136,7 @@ void vtkTIFFReaderInternal::Clean()
   this->TileColumns = 0;
   this->TileWidth = 0;
   this->TileHeight = 0;
+  this->RowsPerStrip = 0;
   this->XResolution = 1;
   this->YResolution = 1;
   this->SubFiles = 0;
@@ -185,8 +195,8 @@ int vtkTIFFReaderInternal::Initialize()
         }
       }
 
-    // If the number of pages is still zero we look if the image is tiled
-    if(this->NumberOfPages == 0 && TIFFIsTiled(this->Image))
+    // Look if the pages are tiled or stored in strips
+    if(TIFFIsTiled(this->Image))
       {
       this->NumberOfTiles = TIFFNumberOfTiles(this->Image);
 
@@ -202,6 +212,11 @@ int vtkTIFFReaderInternal::Initialize()
         TileColumns = this->Width/this->TileWidth;
         }
       }
+    else
+      {
+      TIFFGetFieldDefaulted(this->Image, TIFFTAG_ROWSPERSTRIP,
+                            &this->RowsPerStrip);
+      }
 
     // Checking if the TIFF contains subfiles
     if(this->NumberOfPages > 1)
@@ -303,6 +318,7 @@ vtkTIFFReader::vtkTIFFReader()
 //-------------------------------------------------------------------------
 vtkTIFFReader::~vtkTIFFReader()
 {
+  this->InternalImage->Clean();
   delete this->InternalImage;
 }
 
@@ -469,22 +485,6 @@ void vtkTIFFReader::ExecuteInformation()
     }
 
 
-   // if the tiff is tiled
-   if(this->GetInternalImage()->NumberOfTiles>1)
-     {
-     this->DataExtent[1]  = this->GetInternalImage()->TileWidth;
-     this->DataExtent[3]  = this->GetInternalImage()->TileHeight;
-     this->DataExtent[5]  = this->GetInternalImage()->NumberOfTiles;
-     if( !SpacingSpecifiedFlag )
-       {
-       this->DataSpacing[2] = 1.0;
-       }
-     if( !OriginSpecifiedFlag )
-       {
-       this->DataOrigin[2]  = 0.0;
-       }
-     }
-
   this->vtkImageReader2::ExecuteInformation();
 
   // Don't close the file yet, since we need the image internal
@@ -492,6 +492,46 @@ void vtkTIFFReader::ExecuteInformation()
   // how to read in the image
 }
 
+//-------------------------------------------------------------------------
+int vtkTIFFReader::RequestInformation(vtkInformation* request,
+                                      vtkInformationVector** inputVector,
+                                      vtkInformationVector* outputVector)
+{
+  if ( !this->Superclass::RequestInformation(request, inputVector,
+                                             outputVector) )
+    {
+    return 0;
+    }
+
+  // Report the tiles or strips that ReadBlocks decodes independently.
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkTIFFReaderInternal* internal = this->GetInternalImage();
+  int tileSize[2] = { 0, 0 };
+  if ( internal->Image && internal->CanRead() &&
+       internal->SamplesPerPixel != 2 )
+    {
+    if ( TIFFIsTiled(internal->Image) )
+      {
+      tileSize[0] = internal->TileWidth;
+      tileSize[1] = internal->TileHeight;
+      }
+    else
+      {
+      tileSize[0] = internal->Width;
+      tileSize[1] = std::min(internal->RowsPerStrip, internal->Height);
+      }
+    }
+  if ( tileSize[0] > 0 && tileSize[1] > 0 )
+    {
+    outInfo->Set(vtkTIFFReader::TILE_SIZE(), tileSize, 2);
+    }
+  else
+    {
+    outInfo->Remove(vtkTIFFReader::TILE_SIZE());
+    }
+  return 1;
+}
+
 
 // Set orientation type
 //
@@ -570,16 +610,8 @@ void vtkTIFFReaderUpdate(vtkTIFFReader *self, vtkTIFFReaderInternal *reader,
     return;
     }
 
-  // tiled image
-  if(reader->NumberOfTiles>0 )
-    {
-    self->ReadTiles( outPtr );
-    return;
-    }
-
-  //The input tiff dataset is neither multiple pages and nor
-  //tiled. Hence close the image and start reading each TIFF
-  //file
+  //The input tiff dataset is not multiple pages. Hence close the
+  //image and start reading each TIFF file
   reader->Clean();
 
   outPtr2 = outPtr;
@@ -619,6 +651,7 @@ void vtkTIFFReader::ExecuteDataWithInformation(vtkDataObject *output,
   // Call the correct templated function for the input
   outPtr = data->GetScalarPointer();
   // Needed deep in reading for finding the correct starting location.
+  this->OutputExtent = data->GetExtent();
   this->OutputIncrements = data->GetIncrements();
 
   switch (data->GetScalarType())
@@ -980,40 +1013,211 @@ void vtkTIFFReader::ReadTiles(void* buffer)
     return;
     }
 
-  unsigned char* volume = reinterpret_cast<unsigned char*>(buffer);
+  this->ReadBlocks(buffer);
+}
+
+//-------------------------------------------------------------------------
+// The tiles or strips of a page decoded on several threads.  Each thread
+// takes the next block until none is left.
+struct vtkTIFFReaderBlockJobs
+{
+  vtkTIFFReader* Self;
+  void* Output;
+  int ScalarSize;
+  int Tiled;
+  unsigned int BlockWidth;
+  unsigned int BlockHeight;
+  // The file column and row of the first pixel of each block.
+  std::vector<unsigned int> Columns;
+  std::vector<unsigned int> Rows;
+  size_t Next;
+  int Failed;
+  vtkSimpleCriticalSection Lock;
+};
 
-  for(unsigned int col = 0;col<this->GetInternalImage()->Width;col+=this->GetInternalImage()->TileWidth)
+//-------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkTIFFReaderReadBlocks(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkTIFFReaderBlockJobs* jobs =
+    static_cast<vtkTIFFReaderBlockJobs*>(info->UserData);
+  jobs->Self->ReadBlocksInternal(jobs, info->ThreadID);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//-------------------------------------------------------------------------
+void vtkTIFFReader::ReadBlocks(void* out)
+{
+  vtkTIFFReaderInternal* internal = this->GetInternalImage();
+  unsigned int width = internal->Width;
+  unsigned int height = internal->Height;
+
+  vtkTIFFReaderBlockJobs jobs;
+  jobs.Self = this;
+  jobs.Output = out;
+  jobs.ScalarSize = vtkDataArray::GetDataTypeSize(this->GetDataScalarType());
+  jobs.Tiled = TIFFIsTiled(internal->Image);
+  if ( jobs.Tiled )
+    {
+    jobs.BlockWidth = internal->TileWidth;
+    jobs.BlockHeight = internal->TileHeight;
+    }
+  else
+    {
+    jobs.BlockWidth = width;
+    jobs.BlockHeight = std::min(internal->RowsPerStrip, height);
+    }
+  jobs.Next = 0;
+  jobs.Failed = 0;
+  if ( jobs.BlockWidth == 0 || jobs.BlockHeight == 0 )
+    {
+    vtkErrorMacro( << "Cannot read the tile or strip size of "
+                   << this->InternalFileName );
+    return;
+    }
+
+  // Flip from lower left origin to upper left if necessary.
+  int* outExt = this->OutputExtent;
+  unsigned int firstRow = outExt[2];
+  unsigned int lastRow = outExt[3];
+  if ( internal->Orientation != ORIENTATION_TOPLEFT )
     {
-    for(unsigned int row = 0;row<this->GetInternalImage()->Height;row+=this->GetInternalImage()->TileHeight)
+    firstRow = height - outExt[3] - 1;
+    lastRow = height - outExt[2] - 1;
+    }
+  unsigned int firstColumn = outExt[0];
+  unsigned int lastColumn = outExt[1];
+  for ( unsigned int row = firstRow - firstRow % jobs.BlockHeight;
+        row <= lastRow; row += jobs.BlockHeight )
+    {
+    for ( unsigned int col = firstColumn - firstColumn % jobs.BlockWidth;
+          col <= lastColumn; col += jobs.BlockWidth )
       {
-      unsigned char *tempImage;
-      tempImage = new unsigned char[ this->GetInternalImage()->TileWidth * this->GetInternalImage()->TileHeight * this->GetInternalImage()->SamplesPerPixel];
+      jobs.Columns.push_back(col);
+      jobs.Rows.push_back(row);
+      }
+    }
 
-      if(TIFFReadTile(this->GetInternalImage()->Image,tempImage, col,row,0,0)<0)
-        {
-        vtkErrorMacro( << "Cannot read tile : "<< row << "," << col << " from file" );
-        if ( tempImage != buffer )
-          {
-          delete [] tempImage;
-          }
+  // The colors of palette images are looked up before the threads
+  // evaluate the pixels.
+  this->GetFormat();
 
-        return;
+  int numberOfThreads = this->NumberOfThreads;
+  if ( static_cast<size_t>(numberOfThreads) > jobs.Rows.size() )
+    {
+    numberOfThreads = static_cast<int>(jobs.Rows.size());
+    }
+  if ( numberOfThreads <= 1 )
+    {
+    this->ReadBlocksInternal(&jobs, 0);
+    }
+  else
+    {
+    vtkMultiThreader* threader = vtkMultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(vtkTIFFReaderReadBlocks, &jobs);
+    threader->SingleMethodExecute();
+    threader->Delete();
+    }
+  if ( jobs.Failed )
+    {
+    vtkErrorMacro( << "Problem reading the " << (jobs.Tiled ? "tiles" : "strips")
+                   << " of " << this->InternalFileName );
+    }
+}
+
+//-------------------------------------------------------------------------
+void vtkTIFFReader::ReadBlocksInternal(void* arg, int threadId)
+{
+  vtkTIFFReaderBlockJobs* jobs = static_cast<vtkTIFFReaderBlockJobs*>(arg);
+  vtkTIFFReaderInternal* internal = this->GetInternalImage();
+
+  // A TIFF handle cannot be shared between threads, so the other threads
+  // open the file again at the current page.
+  TIFF* image = internal->Image;
+  if ( threadId > 0 )
+    {
+    image = TIFFOpen(this->InternalFileName, "r");
+    if ( !image ||
+         !TIFFSetDirectory(image, TIFFCurrentDirectory(internal->Image)) )
+      {
+      if ( image )
+        {
+        TIFFClose(image);
         }
+      jobs->Lock.Lock();
+      jobs->Failed = 1;
+      jobs->Lock.Unlock();
+      return;
+      }
+    }
+
+  tsize_t blockSize = jobs->Tiled ? TIFFTileSize(image) : TIFFStripSize(image);
+  std::vector<unsigned char> buffer(blockSize);
+  size_t pixelSize = internal->SamplesPerPixel * (internal->BitsPerSample / 8);
+  int* outExt = this->OutputExtent;
+  vtkIdType* outInc = this->OutputIncrements;
+  for(;;)
+    {
+    jobs->Lock.Lock();
+    size_t i = jobs->Next++;
+    int failed = jobs->Failed;
+    jobs->Lock.Unlock();
+    if ( i >= jobs->Rows.size() || failed )
+      {
+      break;
+      }
+
+    unsigned int col = jobs->Columns[i];
+    unsigned int row = jobs->Rows[i];
+    tsize_t size = jobs->Tiled ?
+      TIFFReadEncodedTile(image, TIFFComputeTile(image, col, row, 0, 0),
+                          &buffer[0], blockSize) :
+      TIFFReadEncodedStrip(image, TIFFComputeStrip(image, row, 0),
+                           &buffer[0], blockSize);
+    if ( size < 0 )
+      {
+      jobs->Lock.Lock();
+      jobs->Failed = 1;
+      jobs->Lock.Unlock();
+      break;
+      }
 
-      unsigned int xx, yy;
-      for ( yy = 0; yy < this->GetInternalImage()->TileHeight; yy++ )
+    // Copy the pixels of the block that are in the output extent.
+    int firstColumn = std::max(static_cast<int>(col), outExt[0]);
+    int lastColumn = std::min(static_cast<int>(col + jobs->BlockWidth) - 1,
+                              outExt[1]);
+    unsigned int endRow = std::min(row + jobs->BlockHeight, internal->Height);
+    for ( unsigned int fileRow = row; fileRow < endRow; ++fileRow )
+      {
+      int outRow = fileRow;
+      if ( internal->Orientation != ORIENTATION_TOPLEFT )
         {
-        for ( xx = 0; xx <  this->GetInternalImage()->TileWidth; xx++ )
-          {
-          for(unsigned int i=0;i< this->GetInternalImage()->SamplesPerPixel;i++)
-            {
-            *volume = *(tempImage++);
-            volume++;
-            }
-          }
+        outRow = internal->Height - fileRow - 1;
+        }
+      if ( outRow < outExt[2] || outRow > outExt[3] )
+        {
+        continue;
+        }
+      unsigned char* source = &buffer[0] +
+        ((fileRow - row) * jobs->BlockWidth + (firstColumn - col)) * pixelSize;
+      unsigned char* output = static_cast<unsigned char*>(jobs->Output) +
+        ((outRow - outExt[2]) * outInc[1] + (firstColumn - outExt[0]) *
+         outInc[0]) * jobs->ScalarSize;
+      for ( int ix = firstColumn; ix <= lastColumn; ++ix )
+        {
+        this->EvaluateImageAt( output, source );
+        output += outInc[0] * jobs->ScalarSize;
+        source += pixelSize;
         }
       }
     }
+
+  if ( threadId > 0 )
+    {
+    TIFFClose(image);
+    }
 }
 
 /** To Support Zeiss images that contains only 2 samples per pixel but are actually
@@ -1174,337 +1378,15 @@ void vtkTIFFReader::ReadTwoSamplesPerPixelImage( void *out,
 
 void vtkTIFFReader::ReadGenericImage( void *out,
                                       unsigned int,
-                                      unsigned int height )
+                                      unsigned int )
 {
-  unsigned int isize = TIFFScanlineSize(this->GetInternalImage()->Image);
-  unsigned int cc;
-  int row, inc, fileRow;
-  tdata_t buf = _TIFFmalloc(isize);
-
   if ( this->GetInternalImage()->PlanarConfig != PLANARCONFIG_CONTIG )
     {
     vtkErrorMacro( << "This reader can only do PLANARCONFIG_CONTIG" );
     return;
     }
 
-  switch ( this->GetFormat() )
-    {
-    default:
-    case vtkTIFFReader::GRAYSCALE:
-    case vtkTIFFReader::PALETTE_GRAYSCALE:
-      inc = 1;
-      break;
-    case vtkTIFFReader::RGB:
-      inc = this->GetInternalImage()->SamplesPerPixel;
-      break;
-    case vtkTIFFReader::PALETTE_RGB:
-      inc = 3;
-      break;
-    }
-
-  // Inc is never used because we use the increment set previously.
-  // I do not want to get rid of the varialbe inc completely,
-  // so i added this test.  It might be better as a warning.
-  if (inc != this->OutputIncrements[0])
-    {
-    vtkDebugMacro("Computed increment " << inc
-                  << " does not match information increment "
-                  << this->OutputIncrements[0]);
-    }
-
-  if(this->GetDataScalarType() == VTK_UNSIGNED_CHAR)
-    {
-    unsigned char* image;
-    if (this->GetInternalImage()->PlanarConfig == PLANARCONFIG_CONTIG)
-      {
-      for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-        {
-        // Flip from lower left origin to upper left if necessary.
-        if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-          {
-          fileRow = row;
-          }
-        else
-          {
-          fileRow = height - row - 1;
-          }
-        if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, 0) <= 0)
-          {
-          vtkErrorMacro( << "Problem reading the row: " << fileRow );
-          break;
-          }
-        image = reinterpret_cast<unsigned char*>(out)
-          + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-
-        // Copy the pixels into the output buffer
-        cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-        for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-          {
-          inc = this->EvaluateImageAt( image,
-                                       static_cast<unsigned char *>(buf) +
-                                       cc );
-          image += this->OutputIncrements[0];
-          cc += this->GetInternalImage()->SamplesPerPixel;
-          }
-        }
-      }
-    else if(this->GetInternalImage()->PlanarConfig == PLANARCONFIG_SEPARATE)
-      {
-      unsigned long s;
-      unsigned long nsamples;
-      TIFFGetField(this->GetInternalImage()->Image, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
-      for (s = 0; s < nsamples; s++)
-        {
-        for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-          {
-          if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-            {
-            fileRow = row;
-            }
-          else
-            {
-            fileRow = height - row - 1;
-            }
-          if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, s) <= 0)
-            {
-            vtkErrorMacro( << "Problem reading the row: " << fileRow );
-            break;
-            }
-
-          inc = 3;
-          image = reinterpret_cast<unsigned char*>(out)
-            + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-          cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-          for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-            {
-            inc = this->EvaluateImageAt( image,
-                                         static_cast<unsigned char *>(buf) +
-                                         cc );
-            image += this->OutputIncrements[0];
-            cc += this->GetInternalImage()->SamplesPerPixel;
-            }
-          }
-        }
-      }
-    }
-  else if(this->GetDataScalarType() == VTK_CHAR)
-    {
-    char* image;
-     if (this->GetInternalImage()->PlanarConfig == PLANARCONFIG_CONTIG)
-      {
-      for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-        {
-        if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-          {
-          fileRow = row;
-          }
-        else
-          {
-          fileRow = height - row - 1;
-          }
-        if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, 0) <= 0)
-          {
-          vtkErrorMacro( << "Problem reading the row: " << fileRow );
-          break;
-          }
-
-        image = reinterpret_cast<char*>(out)
-          + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-        cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-        for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-          {
-          inc = this->EvaluateImageAt( image,
-                                       static_cast<char *>(buf) +
-                                       cc );
-          image += this->OutputIncrements[0];
-          cc += this->GetInternalImage()->SamplesPerPixel;
-          }
-        }
-      }
-    else if(this->GetInternalImage()->PlanarConfig == PLANARCONFIG_SEPARATE)
-      {
-      unsigned long s;
-      unsigned long nsamples;
-      TIFFGetField(this->GetInternalImage()->Image, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
-      for (s = 0; s < nsamples; s++)
-        {
-        for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-          {
-          if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-            {
-            fileRow = row;
-            }
-          else
-            {
-            fileRow = height - row - 1;
-            }
-          if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, s) <= 0)
-            {
-            vtkErrorMacro( << "Problem reading the row: " << fileRow );
-            break;
-            }
-
-          inc = 3;
-          image = reinterpret_cast<char*>(out)
-            + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-          cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-          for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-            {
-            inc = this->EvaluateImageAt( image,
-                                         static_cast<char *>(buf) +
-                                         cc );
-            image += this->OutputIncrements[0];
-            cc += this->GetInternalImage()->SamplesPerPixel;
-            }
-          }
-        }
-      }
-    }
-  else if(this->GetDataScalarType() == VTK_UNSIGNED_SHORT)
-    {
-    isize /= 2;
-    unsigned short* image;
-    if (this->GetInternalImage()->PlanarConfig == PLANARCONFIG_CONTIG)
-      {
-      for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-        {
-        if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-          {
-          fileRow = row;
-          }
-        else
-          {
-          fileRow = height - row - 1;
-          }
-        if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, 0) <= 0)
-          {
-          vtkErrorMacro( << "Problem reading the row: " << fileRow );
-          break;
-          }
-
-        image = reinterpret_cast<unsigned short*>(out)
-          + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-        cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-        for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-          {
-          inc = this->EvaluateImageAt( image,
-                                       static_cast<unsigned short *>(buf) +
-                                       cc );
-          image += this->OutputIncrements[0];
-          cc += this->GetInternalImage()->SamplesPerPixel;
-          }
-        }
-      }
-    else if(this->GetInternalImage()->PlanarConfig == PLANARCONFIG_SEPARATE)
-      {
-      unsigned long s, nsamples;
-      TIFFGetField(this->GetInternalImage()->Image, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
-      for (s = 0; s < nsamples; s++)
-        {
-        for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-          {
-          if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-            {
-            fileRow = row;
-            }
-          else
-            {
-            fileRow = height - row - 1;
-            }
-          if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, s) <= 0)
-            {
-            vtkErrorMacro( << "Problem reading the row: " << fileRow );
-            break;
-            }
-          image = reinterpret_cast<unsigned short*>(out)
-            + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-          cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-          for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-            {
-            inc = this->EvaluateImageAt( image,
-                                         static_cast<unsigned short *>(buf) +
-                                         cc );
-            image += this->OutputIncrements[0];
-            cc += this->GetInternalImage()->SamplesPerPixel;
-            }
-          }
-        }
-      }
-    }
-  // Short type
-  else if(this->GetDataScalarType() == VTK_SHORT)
-    {
-    isize /= 2;
-    short* image;
-    if (this->GetInternalImage()->PlanarConfig == PLANARCONFIG_CONTIG)
-      {
-      for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-        {
-        if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-          {
-          fileRow = row;
-          }
-        else
-          {
-          fileRow = height - row - 1;
-          }
-        if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, 0) <= 0)
-          {
-          vtkErrorMacro( << "Problem reading the row: " << fileRow );
-          break;
-          }
-
-        image = reinterpret_cast<short*>(out)
-          + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-        cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-        for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-          {
-          inc = this->EvaluateImageAt(image,
-                                      static_cast<short *>(buf) +
-                                      cc );
-          image += this->OutputIncrements[0];
-          cc += this->GetInternalImage()->SamplesPerPixel;
-          }
-        }
-      }
-    else if(this->GetInternalImage()->PlanarConfig == PLANARCONFIG_SEPARATE)
-      {
-      unsigned long s, nsamples;
-      TIFFGetField(this->GetInternalImage()->Image, TIFFTAG_SAMPLESPERPIXEL, &nsamples);
-      for (s = 0; s < nsamples; s++)
-        {
-        for ( row = this->OutputExtent[2]; row <= this->OutputExtent[3]; row ++ )
-          {
-          if (this->GetInternalImage()->Orientation == ORIENTATION_TOPLEFT)
-            {
-            fileRow = row;
-            }
-          else
-            {
-            fileRow = height - row - 1;
-            }
-          if (TIFFReadScanline(this->GetInternalImage()->Image, buf, fileRow, s) <= 0)
-            {
-            vtkErrorMacro( << "Problem reading the row: " << fileRow );
-            break;
-            }
-
-          image = reinterpret_cast<short*>(out)
-            + (row-this->OutputExtent[2])*this->OutputIncrements[1];
-          cc = this->OutputExtent[0] * this->GetInternalImage()->SamplesPerPixel;
-          for (int ix = this->OutputExtent[0]; ix <= this->OutputExtent[1]; ++ix)
-            {
-            inc = this->EvaluateImageAt( image,
-                                         static_cast<short *>(buf) +
-                                         cc );
-            image += this->OutputIncrements[0];
-            cc += this->GetInternalImage()->SamplesPerPixel;
-            }
-          }
-        }
-      }
-    }
-  _TIFFfree(buf);
+  this->ReadBlocks(out);
 }
 
 
@@ -1584,7 +1466,14 @@ void vtkTIFFReader::ReadImageInternal( void* vtkNotUsed(in), void* outPtr,
     case vtkTIFFReader::RGB:
     case vtkTIFFReader::PALETTE_RGB:
     case vtkTIFFReader::PALETTE_GRAYSCALE:
-      this->ReadGenericImage( outPtr, width, height );
+      if ( TIFFIsTiled(this->GetInternalImage()->Image) )
+        {
+        this->ReadTiles( outPtr );
+        }
+      else
+        {
+        this->ReadGenericImage( outPtr, width, height );
+        }
       break;
     default:
       return;
@@ -1706,6 +1595,21 @@ int vtkTIFFReader::CanReadFile(const char* fname)
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkTIFFReader::CopyReaderSettings(vtkImageReader2 *reader)
+{
+  vtkTIFFReader *tiffReader = vtkTIFFReader::SafeDownCast(reader);
+  if ( !tiffReader || !this->Superclass::CopyReaderSettings(reader) )
+    {
+    return 0;
+    }
+  tiffReader->OrientationType = this->OrientationType;
+  tiffReader->OrientationTypeSpecifiedFlag = this->OrientationTypeSpecifiedFlag;
+  tiffReader->OriginSpecifiedFlag = this->OriginSpecifiedFlag;
+  tiffReader->SpacingSpecifiedFlag = this->SpacingSpecifiedFlag;
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkTIFFReader::PrintSelf(ostream& os, vtkIndent indent)
 {
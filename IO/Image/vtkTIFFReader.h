@@ -17,6 +17,12 @@
 // vtkTIFFReader is a source object that reads TIFF files.
 // It should be able to read almost any TIFF file
 //
+// The pages of TIFF files are stored in tiles or strips that can be
+// decoded independently.  The reader decodes only the tiles or strips
+// that intersect the update extent, on NumberOfThreads threads that
+// each open the file again, and reports their size with the TILE_SIZE
+// key so that downstream filters can request pieces aligned on them.
+//
 // .SECTION See Also
 // vtkTIFFWriter
 
@@ -27,6 +33,7 @@
 #include "vtkImageReader2.h"
 
 //BTX
+class vtkInformationIntegerVectorKey;
 class vtkTIFFReaderInternal;
 //ETX
 
@@ -67,7 +74,7 @@ public:
   virtual void ReadVolume(void* buffer);
 
   // Description:
-  // Reads 3D data from tiled tiff
+  // Reads the tiles of a tiled tiff that intersect the output extent.
   virtual void ReadTiles(void* buffer);
 
   // Description:
@@ -101,11 +108,22 @@ public:
   vtkGetMacro( SpacingSpecifiedFlag, bool );
   vtkBooleanMacro( SpacingSpecifiedFlag, bool );
 
+  // Description:
+  // Key set in the output information to the width and height, in
+  // pixels, of the tiles or strips of the file.  It is not set when
+  // the pages are not decoded by tiles or strips.
+  static vtkInformationIntegerVectorKey* TILE_SIZE();
+
   // Description:
   // Internal method, do not use.
   void ReadImageInternal( void *, void *outPtr,
                           int *outExt, unsigned int size );
 
+  // Description:
+  // Internal method, do not use.  Decodes the next tiles or strips
+  // queued in 'jobs' on the thread 'threadId'.
+  void ReadBlocksInternal( void *jobs, int threadId );
+
 protected:
   vtkTIFFReader();
   ~vtkTIFFReader();
@@ -121,7 +139,11 @@ protected:
 
   void ReadGenericImage( void *out,
                          unsigned int vtkNotUsed(width),
-                         unsigned int height );
+                         unsigned int vtkNotUsed(height) );
+
+  // Decode the tiles or strips of the current page that intersect the
+  // output extent.
+  void ReadBlocks( void *out );
 
   // To support Zeiss images
   void ReadTwoSamplesPerPixelImage( void *out,
@@ -130,7 +152,11 @@ protected:
 
   unsigned int  GetFormat();
   virtual void ExecuteInformation();
+  virtual int RequestInformation(vtkInformation* request,
+                                 vtkInformationVector** inputVector,
+                                 vtkInformationVector* outputVector);
   virtual void ExecuteDataWithInformation(vtkDataObject *out, vtkInformation *outInfo);
+  virtual int CopyReaderSettings(vtkImageReader2 *reader);
 
 private:
   vtkTIFFReader(const vtkTIFFReader&);  // Not implemented.
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelimitedTextReaderTypedColumns.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the columns parsed with their types from the bytes of a
+// file, on one and several threads, are those that vtkStringToNumeric
+// gives for the columns of strings, including columns whose type changes
+// after the records the types are inferred from.
+
+#include "vtkAbstractArray.h"
+#include "vtkDelimitedTextReader.h"
+#include "vtkNew.h"
+#include "vtkTable.h"
+#include "vtkVariant.h"
+
+#include <vtksys/ios/fstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Enough records for several blocks of the file on two threads.
+const int Records = 60000;
+
+void WriteFile(const char* fileName)
+{
+  vtksys_ios::ofstream file(fileName, ios::out | ios::binary);
+  file << "id,value,name,late double,late string,large,blank\r\n";
+  for (int i = 0; i < Records; i++)
+    {
+    file << i << "," << i * 0.125 - 7 << ",";
+    if (i % 3)
+      {
+      file << "name " << i;
+      }
+    else
+      {
+      file << "\"name, " << i << "\"";
+      }
+    file << "," << (i == 45000 ? "2.5" : "3") << ","
+         << (i == 52000 ? "none" : "1e3") << ","
+         << (i == 30000 ? "3000000000" : "-12") << ",";
+    if (i % 7)
+      {
+      file << " " << i % 7 << " ";
+      }
+    file << "\r\n";
+    }
+}
+
+int CompareTables(vtkTable* expected, vtkTable* table, const char* what)
+{
+  TEST_ASSERT(table->GetNumberOfColumns() == expected->GetNumberOfColumns() &&
+              table->GetNumberOfRows() == expected->GetNumberOfRows(),
+              "Expected " << expected->GetNumberOfColumns() << " columns and "
+              << expected->GetNumberOfRows() << " rows " << what << ", got "
+              << table->GetNumberOfColumns() << " and "
+              << table->GetNumberOfRows());
+  for (vtkIdType j = 0; j < table->GetNumberOfColumns(); j++)
+    {
+    vtkAbstractArray* a = expected->GetColumn(j);
+    vtkAbstractArray* b = table->GetColumn(j);
+    TEST_ASSERT(strcmp(a->GetName(), b->GetName()) == 0 &&
+                strcmp(a->GetClassName(), b->GetClassName()) == 0,
+                "Expected column " << a->GetName() << " of type "
+                << a->GetClassName() << " " << what << ", got "
+                << b->GetName() << " of type " << b->GetClassName());
+    for (vtkIdType i = 0; i < table->GetNumberOfRows(); i++)
+      {
+      TEST_ASSERT(a->GetVariantValue(i) == b->GetVariantValue(i),
+                  "Expected '" << a->GetVariantValue(i).ToString()
+                  << "' in row " << i << " of " << a->GetName() << " "
+                  << what << ", got '" << b->GetVariantValue(i).ToString()
+                  << "'");
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+int CompareReaders(const char* fileName, bool headers, bool trim,
+                   bool forceDouble, bool merge, vtkIdType maxRecords)
+{
+  vtkNew<vtkDelimitedTextReader> expected;
+  vtkNew<vtkDelimitedTextReader> typed[2];
+  vtkDelimitedTextReader* readers[3] = { expected.GetPointer(),
+                                         typed[0].GetPointer(),
+                                         typed[1].GetPointer() };
+  for (int i = 0; i < 3; i++)
+    {
+    readers[i]->SetFileName(fileName);
+    readers[i]->SetHaveHeaders(headers);
+    readers[i]->DetectNumericColumnsOn();
+    readers[i]->SetTrimWhitespacePriorToNumericConversion(trim);
+    readers[i]->SetForceDouble(forceDouble);
+    readers[i]->SetMergeConsecutiveDelimiters(merge);
+    readers[i]->SetDefaultIntegerValue(-1);
+    readers[i]->SetDefaultDoubleValue(0.5);
+    readers[i]->SetMaxRecords(maxRecords);
+    readers[i]->SetParseTypedColumns(i > 0);
+    readers[i]->SetNumberOfThreads(i == 1 ? 1 : 2);
+    readers[i]->Update();
+    }
+  for (int i = 1; i < 3; i++)
+    {
+    if (CompareTables(expected->GetOutput(), readers[i]->GetOutput(),
+                      i == 1 ? "on one thread" : "on two threads") !=
+        EXIT_SUCCESS)
+      {
+      cerr << "Reading " << fileName << " with headers " << headers
+           << ", trim " << trim << ", force double " << forceDouble
+           << ", merge " << merge << ", max records " << maxRecords << endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestDelimitedTextReaderTypedColumns(int, char*[])
+{
+  const char* fileName = "TestDelimitedTextReaderTypedColumns.csv";
+  WriteFile(fileName);
+  if (CompareReaders(fileName, true, false, false, false, 0) != EXIT_SUCCESS ||
+      CompareReaders(fileName, true, true, false, false, 0) != EXIT_SUCCESS ||
+      CompareReaders(fileName, true, true, true, false, 0) != EXIT_SUCCESS ||
+      CompareReaders(fileName, true, true, false, false, 40000) !=
+      EXIT_SUCCESS)
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Escapes, strings, merged delimiters, blank lines and a last record
+  // without a record delimiter.
+  const char* smallFileName = "TestDelimitedTextReaderTypedColumnsSmall.csv";
+  vtksys_ios::ofstream file(smallFileName, ios::out | ios::binary);
+  file << "  1,,a\\tb,\"2\"\n\n\n4,,,5,6\n  \n7,x\"y,z\",3,\n 8,9,\"\",10";
+  file.close();
+  for (int merge = 0; merge < 2; merge++)
+    {
+    if (CompareReaders(smallFileName, false, false, false, merge != 0, 0) !=
+        EXIT_SUCCESS)
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Headers without records.
+  const char* emptyFileName = "TestDelimitedTextReaderTypedColumnsEmpty.csv";
+  file.open(emptyFileName, ios::out | ios::binary);
+  file << "a,b\n";
+  file.close();
+  return CompareReaders(emptyFileName, true, false, false, false, 0);
+}
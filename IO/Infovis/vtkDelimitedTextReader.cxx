@@ -21,9 +21,13 @@
 #include "vtkDelimitedTextReader.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMultiThreader.h"
+#include "vtkNumberParser.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -40,6 +44,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <set>
+#include <string.h>
 #include <vector>
 
 #include <ctype.h>
@@ -365,6 +370,462 @@ private:
   vtkUnicodeString::value_type WithinString;
 };
 
+
+////////////////////////////////////////////////////////////////////////////////
+// DelimitedTextTokenizer
+
+/// Splits the bytes of an ascii or UTF-8 buffer into records and fields the
+/// way DelimitedTextIterator splits a stream of characters, for delimiters
+/// that are all ascii characters.
+
+class DelimitedTextTokenizer
+{
+public:
+  DelimitedTextTokenizer() :
+    StringDelimiter(-1),
+    MergeConsDelims(false)
+  {
+  }
+
+  // Returns false if one of the delimiters is not an ascii character.
+  bool Initialize(
+    const vtkUnicodeString& record_delimiters,
+    const vtkUnicodeString& field_delimiters,
+    const vtkUnicodeString& string_delimiters,
+    const vtkUnicodeString& whitespace,
+    const vtkUnicodeString& escape,
+    bool merg_cons_delimiters,
+    bool use_string_delimeter)
+  {
+    this->MergeConsDelims = merg_cons_delimiters;
+    this->StringDelimiter = -1;
+    if(use_string_delimeter && !string_delimiters.empty())
+      {
+      if(string_delimiters.character_count() != 1 ||
+         string_delimiters[0] > 0x7f)
+        {
+        return false;
+        }
+      this->StringDelimiter = static_cast<int>(string_delimiters[0]);
+      }
+    return
+      SetCharacters(this->RecordDelimiters, record_delimiters) &&
+      SetCharacters(this->FieldDelimiters, field_delimiters) &&
+      SetCharacters(this->Whitespace, whitespace) &&
+      SetCharacters(this->EscapeDelimiter, escape);
+  }
+
+  bool IsRecordDelimiter(char c) const
+  {
+    return this->RecordDelimiters[static_cast<unsigned char>(c)];
+  }
+
+  // Parses the record that starts at 'p', skipping adjacent record
+  // delimiters and whitespace, and moves 'p' after it.  Returns false if
+  // there is no record before 'end'.
+  bool Next(const char*& p, const char* const end)
+  {
+    while(p != end && (this->RecordDelimiters[static_cast<unsigned char>(*p)] ||
+                       this->Whitespace[static_cast<unsigned char>(*p)]))
+      {
+      ++p;
+      }
+    if(p == end)
+      {
+      return false;
+      }
+
+    this->Fields.clear();
+    this->Text.clear();
+    this->BeginField(p);
+    int within_string = -1;
+    bool process_escape_sequence = false;
+    for(; p != end; ++p)
+      {
+      const unsigned char value = static_cast<unsigned char>(*p);
+
+      // Look for record delimiters ...
+      if(this->RecordDelimiters[value])
+        {
+        this->EndField(p);
+        ++p;
+        this->ResolveFields();
+        return true;
+        }
+
+      // Look for field delimiters unless we're in a string ...
+      if(within_string < 0 && this->FieldDelimiters[value])
+        {
+        if(!(this->CurrentFieldEmpty(p) && this->MergeConsDelims))
+          {
+          this->EndField(p);
+          this->BeginField(p + 1);
+          }
+        else if(!this->Fields.back().Copied)
+          {
+          this->Fields.back().Begin = p + 1;
+          }
+        continue;
+        }
+
+      // Check for start of escape sequence ...
+      if(!process_escape_sequence && this->EscapeDelimiter[value])
+        {
+        this->CopyField(p);
+        process_escape_sequence = true;
+        continue;
+        }
+
+      // Process escape sequence ...
+      if(process_escape_sequence)
+        {
+        switch(value)
+          {
+          case '0': break;
+          case 'a': this->Text += '\a'; break;
+          case 'b': this->Text += '\b'; break;
+          case 't': this->Text += '\t'; break;
+          case 'n': this->Text += '\n'; break;
+          case 'v': this->Text += '\v'; break;
+          case 'f': this->Text += '\f'; break;
+          case 'r': this->Text += '\r'; break;
+          default: this->Text += static_cast<char>(value); break;
+          }
+        process_escape_sequence = false;
+        continue;
+        }
+
+      // Start a string ...
+      if(within_string < 0 && value == this->StringDelimiter)
+        {
+        this->CopyField(p);
+        this->Text.resize(this->Fields.back().Offset);
+        within_string = value;
+        continue;
+        }
+
+      // End a string ...
+      if(within_string == value)
+        {
+        within_string = -1;
+        continue;
+        }
+
+      // Keep growing the current field ...
+      if(this->Fields.back().Copied)
+        {
+        this->Text += static_cast<char>(value);
+        }
+      }
+
+    // Handle files that do not end with a record delimiter ...
+    this->EndField(p);
+    this->ResolveFields();
+    const Field& last = this->Fields.back();
+    if(last.Begin == last.End ||
+       this->RecordDelimiters[static_cast<unsigned char>(last.End[-1])] ||
+       this->Whitespace[static_cast<unsigned char>(last.End[-1])])
+      {
+      this->Fields.pop_back();
+      }
+    return !this->Fields.empty();
+  }
+
+  size_t GetNumberOfFields() const
+  {
+    return this->Fields.size();
+  }
+
+  const char* GetFieldBegin(size_t i) const
+  {
+    return this->Fields[i].Begin;
+  }
+
+  const char* GetFieldEnd(size_t i) const
+  {
+    return this->Fields[i].End;
+  }
+
+private:
+  // A field is the range of the buffer between Begin and End until an
+  // escape sequence or a string delimiter changes its characters.  From
+  // then on it is copied into Text at Offset.
+  struct Field
+  {
+    const char* Begin;
+    const char* End;
+    size_t Offset;
+    size_t Length;
+    bool Copied;
+  };
+
+  static bool SetCharacters(bool* characters, const vtkUnicodeString& values)
+  {
+    std::fill(characters, characters + 256, false);
+    for(vtkUnicodeString::const_iterator i = values.begin(); i != values.end(); ++i)
+      {
+      if(*i > 0x7f)
+        {
+        return false;
+        }
+      characters[*i] = true;
+      }
+    return true;
+  }
+
+  void BeginField(const char* p)
+  {
+    Field field;
+    field.Begin = p;
+    field.End = p;
+    field.Offset = 0;
+    field.Length = 0;
+    field.Copied = false;
+    this->Fields.push_back(field);
+  }
+
+  void CopyField(const char* p)
+  {
+    Field& field = this->Fields.back();
+    if(!field.Copied)
+      {
+      field.Offset = this->Text.size();
+      this->Text.append(field.Begin, p);
+      field.Copied = true;
+      }
+  }
+
+  bool CurrentFieldEmpty(const char* p) const
+  {
+    const Field& field = this->Fields.back();
+    return field.Copied ? this->Text.size() == field.Offset : field.Begin == p;
+  }
+
+  void EndField(const char* p)
+  {
+    Field& field = this->Fields.back();
+    if(field.Copied)
+      {
+      field.Length = this->Text.size() - field.Offset;
+      }
+    else
+      {
+      field.End = p;
+      }
+  }
+
+  // Points the copied fields into Text once it no longer grows.
+  void ResolveFields()
+  {
+    for(std::vector<Field>::iterator i = this->Fields.begin(); i != this->Fields.end(); ++i)
+      {
+      if(i->Copied)
+        {
+        i->Begin = this->Text.data() + i->Offset;
+        i->End = i->Begin + i->Length;
+        }
+      }
+  }
+
+  bool RecordDelimiters[256];
+  bool FieldDelimiters[256];
+  bool Whitespace[256];
+  bool EscapeDelimiter[256];
+  int StringDelimiter;
+  bool MergeConsDelims;
+  std::vector<Field> Fields;
+  std::string Text;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Typed columns
+
+/// The types that vtkStringToNumeric gives to columns, from the narrowest.
+enum TypedColumnType
+{
+  IntegerColumn,
+  DoubleColumn,
+  StringColumn
+};
+
+struct TypedColumnValues
+{
+  std::vector<int> Integers;
+  std::vector<double> Doubles;
+  std::vector<vtkStdString> Strings;
+};
+
+/// The records of a range of the buffer parsed by one thread.
+struct TypedColumnsPart
+{
+  const char* Begin;
+  const char* End;
+  vtkIdType NumberOfRecords;
+  // The type each column needs for the records of the part, and the first
+  // record that needed it to be widened to a double or string column.
+  std::vector<TypedColumnType> Types;
+  std::vector<vtkIdType> FirstDouble;
+  std::vector<vtkIdType> FirstString;
+  std::vector<TypedColumnValues> Values;
+};
+
+struct TypedColumnsWork
+{
+  const DelimitedTextTokenizer* Tokenizer;
+  const std::vector<TypedColumnType>* Types;
+  bool TrimWhitespace;
+  int DefaultIntegerValue;
+  double DefaultDoubleValue;
+  std::vector<TypedColumnsPart> Parts;
+};
+
+// Trims the whitespace that vtkStringToNumeric trims.
+void TrimField(const char*& begin, const char*& end)
+{
+  while(begin != end && (*begin == ' ' || *begin == '\n' ||
+                         *begin == '\t' || *begin == '\r'))
+    {
+    ++begin;
+    }
+  while(begin != end && (end[-1] == ' ' || end[-1] == '\n' ||
+                         end[-1] == '\t' || end[-1] == '\r'))
+    {
+    --end;
+    }
+}
+
+// Like vtkVariant::ToInt(), leading whitespace is allowed but trailing
+// whitespace is not.
+bool ParseInteger(const char* begin, const char* end, int& value)
+{
+  vtkTypeInt64 parsed;
+  if(vtkNumberParser::Parse(begin, end, parsed) != end ||
+     parsed < VTK_INT_MIN || parsed > VTK_INT_MAX)
+    {
+    return false;
+    }
+  value = static_cast<int>(parsed);
+  return true;
+}
+
+bool ParseDouble(const char* begin, const char* end, double& value)
+{
+  return vtkNumberParser::Parse(begin, end, value) == end;
+}
+
+// Parses up to 'max_records' records of the part, or all of them if it is
+// negative.  The values are kept until the first one that does not fit the
+// type of its column.
+void ParseTypedRecords(const TypedColumnsWork& work, TypedColumnsPart& part,
+                       vtkIdType max_records, bool keep_values)
+{
+  DelimitedTextTokenizer tokenizer(*work.Tokenizer);
+  const size_t column_count = work.Types->size();
+  part.NumberOfRecords = 0;
+  part.Types = *work.Types;
+  part.FirstDouble.assign(column_count, -1);
+  part.FirstString.assign(column_count, -1);
+  part.Values.clear();
+  part.Values.resize(column_count);
+
+  const char* p = part.Begin;
+  while((max_records < 0 || part.NumberOfRecords < max_records) &&
+        tokenizer.Next(p, part.End))
+    {
+    const size_t field_count = tokenizer.GetNumberOfFields();
+    for(size_t i = 0; i != column_count; ++i)
+      {
+      const char* begin = "";
+      const char* end = begin;
+      if(i < field_count)
+        {
+        begin = tokenizer.GetFieldBegin(i);
+        end = tokenizer.GetFieldEnd(i);
+        }
+      TypedColumnValues& values = part.Values[i];
+      if(part.Types[i] == StringColumn)
+        {
+        if(keep_values)
+          {
+          values.Strings.push_back(vtkStdString(begin, end - begin));
+          }
+        continue;
+        }
+
+      if(work.TrimWhitespace)
+        {
+        TrimField(begin, end);
+        }
+      if(part.Types[i] == IntegerColumn)
+        {
+        int value = work.DefaultIntegerValue;
+        if(begin == end || ParseInteger(begin, end, value))
+          {
+          if(keep_values)
+            {
+            values.Integers.push_back(value);
+            }
+          continue;
+          }
+        part.Types[i] = DoubleColumn;
+        part.FirstDouble[i] = part.NumberOfRecords;
+        keep_values = false;
+        }
+      double value = work.DefaultDoubleValue;
+      if(begin == end || ParseDouble(begin, end, value))
+        {
+        if(keep_values)
+          {
+          values.Doubles.push_back(value);
+          }
+        continue;
+        }
+      part.Types[i] = StringColumn;
+      part.FirstString[i] = part.NumberOfRecords;
+      keep_values = false;
+      }
+    ++part.NumberOfRecords;
+    }
+}
+
+VTK_THREAD_RETURN_TYPE ParseTypedRecordsThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  TypedColumnsWork* work = static_cast<TypedColumnsWork*>(info->UserData);
+  ParseTypedRecords(*work, work->Parts[info->ThreadID], -1, true);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+// Appends the first 'count' values of a part to a column.
+void AppendTypedColumn(vtkAbstractArray* array, TypedColumnValues& values,
+                       vtkIdType count)
+{
+  if(count == 0)
+    {
+    return;
+    }
+  const vtkIdType size = array->GetNumberOfTuples();
+  if(vtkIntArray* const integers = vtkIntArray::SafeDownCast(array))
+    {
+    std::copy(values.Integers.begin(), values.Integers.begin() + count,
+              integers->WritePointer(size, count));
+    }
+  else if(vtkDoubleArray* const doubles = vtkDoubleArray::SafeDownCast(array))
+    {
+    std::copy(values.Doubles.begin(), values.Doubles.begin() + count,
+              doubles->WritePointer(size, count));
+    }
+  else if(vtkStringArray* const strings = vtkStringArray::SafeDownCast(array))
+    {
+    vtkStdString* const output = strings->WritePointer(size, count);
+    for(vtkIdType i = 0; i != count; ++i)
+      {
+      output[i].swap(values.Strings[i]);
+      }
+    }
+}
+
 } // End anonymous namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -402,6 +863,8 @@ vtkDelimitedTextReader::vtkDelimitedTextReader() :
   this->DefaultIntegerValue = 0;
   this->DefaultDoubleValue = 0.0;
   this->TrimWhitespacePriorToNumericConversion = false;
+  this->ParseTypedColumns = false;
+  this->NumberOfThreads = 0;
 }
 
 vtkDelimitedTextReader::~vtkDelimitedTextReader()
@@ -448,6 +911,9 @@ void vtkDelimitedTextReader::PrintSelf(ostream& os, vtkIndent indent)
     << this->DefaultDoubleValue << endl;
   os << indent << "TrimWhitespacePriorToNumericConversion: "
     << (this->TrimWhitespacePriorToNumericConversion ? "true" : "false") << endl;
+  os << indent << "ParseTypedColumns: "
+    << (this->ParseTypedColumns ? "true" : "false") << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
   os << indent << "GeneratePedigreeIds: "
     << this->GeneratePedigreeIds << endl;
   os << indent << "PedigreeIdArrayName: "
@@ -569,6 +1035,7 @@ int vtkDelimitedTextReader::RequestData(
 
     vtkStdString character_set;
     vtkTextCodec* transCodec = NULL;
+    bool typed_columns = false;
 
     if(this->UnicodeCharacterSet)
       {
@@ -588,33 +1055,41 @@ int vtkDelimitedTextReader::RequestData(
       this->UnicodeStringDelimiters =
         vtkUnicodeString::from_utf8(tstring);
       this->UnicodeOutputArrays = false;
-      transCodec = vtkTextCodecFactory::CodecToHandle(file_stream);
+      typed_columns = this->DetectNumericColumns && this->ParseTypedColumns &&
+        this->ReadTypedColumns(file_stream, output_table);
+      if(!typed_columns)
+        {
+        transCodec = vtkTextCodecFactory::CodecToHandle(file_stream);
+        }
       }
 
-    if (NULL == transCodec)
+    if(!typed_columns)
       {
-      // should this use the locale instead??
-      return 1;
-      }
-
-    DelimitedTextIterator iterator(
-      this->MaxRecords,
-      this->UnicodeRecordDelimiters,
-      this->UnicodeFieldDelimiters,
-      this->UnicodeStringDelimiters,
-      this->UnicodeWhitespace,
-      this->UnicodeEscapeCharacter,
-      this->HaveHeaders,
-      this->UnicodeOutputArrays,
-      this->MergeConsecutiveDelimiters,
-      this->UseStringDelimiter,
-      output_table);
-
-    vtkTextCodec::OutputIterator& outIter = iterator;
+      if (NULL == transCodec)
+        {
+        // should this use the locale instead??
+        return 1;
+        }
 
-    transCodec->ToUnicode(file_stream, outIter);
-    iterator.ReachedEndOfInput();
-    transCodec->Delete();
+      DelimitedTextIterator iterator(
+        this->MaxRecords,
+        this->UnicodeRecordDelimiters,
+        this->UnicodeFieldDelimiters,
+        this->UnicodeStringDelimiters,
+        this->UnicodeWhitespace,
+        this->UnicodeEscapeCharacter,
+        this->HaveHeaders,
+        this->UnicodeOutputArrays,
+        this->MergeConsecutiveDelimiters,
+        this->UseStringDelimiter,
+        output_table);
+
+      vtkTextCodec::OutputIterator& outIter = iterator;
+
+      transCodec->ToUnicode(file_stream, outIter);
+      iterator.ReachedEndOfInput();
+      transCodec->Delete();
+      }
 
     if(this->OutputPedigreeIds)
       {
@@ -648,7 +1123,8 @@ int vtkDelimitedTextReader::RequestData(
       }
     }
 
-    if (this->DetectNumericColumns && !this->UnicodeOutputArrays)
+    if (this->DetectNumericColumns && !this->UnicodeOutputArrays &&
+        !typed_columns)
       {
       vtkStringToNumeric* converter = vtkStringToNumeric::New();
       converter->SetForceDouble(this->ForceDouble);
@@ -680,3 +1156,277 @@ int vtkDelimitedTextReader::RequestData(
 
   return 1;
 }
+
+bool vtkDelimitedTextReader::ReadTypedColumns(
+  istream& stream,
+  vtkTable* output_table)
+{
+  DelimitedTextTokenizer tokenizer;
+  if(!tokenizer.Initialize(
+       this->UnicodeRecordDelimiters,
+       this->UnicodeFieldDelimiters,
+       this->UnicodeStringDelimiters,
+       this->UnicodeWhitespace,
+       this->UnicodeEscapeCharacter,
+       this->MergeConsecutiveDelimiters,
+       this->UseStringDelimiter))
+    {
+    return false;
+    }
+
+  // UTF-16 files are left to the text codecs ...
+  char bom[2];
+  stream.read(bom, 2);
+  const bool utf16 = stream.gcount() == 2 &&
+    ((bom[0] == '\xfe' && bom[1] == '\xff') ||
+     (bom[0] == '\xff' && bom[1] == '\xfe'));
+  stream.clear();
+  stream.seekg(0, ios::end);
+  const double total_bytes = static_cast<double>(stream.tellg());
+  if(utf16)
+    {
+    stream.seekg(0, ios::beg);
+    return false;
+    }
+
+  int numberOfThreads = this->NumberOfThreads;
+  if(numberOfThreads <= 0)
+    {
+    numberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+    }
+  // The file is read in blocks of a few megabytes per thread, and blocks
+  // or parts of blocks that are too small are not worth the threads.
+  const std::streamsize block_size = numberOfThreads * (1 << 20);
+  const std::ptrdiff_t minimum_part_size = 1 << 16;
+  // The number of records from which the column types are inferred.
+  const vtkIdType sample_records = 1000;
+
+  TypedColumnsWork work;
+  work.Tokenizer = &tokenizer;
+  work.TrimWhitespace = this->TrimWhitespacePriorToNumericConversion;
+  work.DefaultIntegerValue = this->DefaultIntegerValue;
+  work.DefaultDoubleValue = this->DefaultDoubleValue;
+
+  std::vector<vtkStdString> names;
+  std::vector<TypedColumnType> types;
+  std::vector<vtkSmartPointer<vtkAbstractArray> > columns;
+  std::vector<char> buffer;
+  vtkIdType record_count = 0;
+  bool read_again = true;
+  while(read_again)
+    {
+    // A field that does not fit the type of its column widens the type and
+    // reads the file again from the start ...
+    read_again = false;
+    columns.clear();
+    record_count = 0;
+    stream.clear();
+    stream.seekg(0, ios::beg);
+
+    size_t kept = 0;
+    double bytes_read = 0;
+    bool end_of_input = false;
+    while(!end_of_input && !(this->MaxRecords && record_count >= this->MaxRecords))
+      {
+      buffer.resize(kept + block_size);
+      stream.read(&buffer[kept], block_size);
+      const std::streamsize read = stream.gcount();
+      end_of_input = read < block_size;
+      bytes_read += read;
+      const char* const begin = &buffer[0];
+      const char* const end = begin + kept + read;
+
+      // Blocks end after the last record delimiter, the rest is kept for
+      // the next block ...
+      const char* stop = end;
+      if(!end_of_input)
+        {
+        while(stop != begin && !tokenizer.IsRecordDelimiter(stop[-1]))
+          {
+          --stop;
+          }
+        if(stop == begin)
+          {
+          kept = end - begin;
+          continue;
+          }
+        }
+      if(total_bytes > 0)
+        {
+        this->UpdateProgress(bytes_read / total_bytes);
+        }
+
+      const char* p = begin;
+      if(columns.empty())
+        {
+        // The first record names the columns ...
+        const char* next = p;
+        if(!tokenizer.Next(next, stop))
+          {
+          kept = end - stop;
+          memmove(&buffer[0], stop, kept);
+          continue;
+          }
+        if(names.empty())
+          {
+          for(size_t i = 0; i != tokenizer.GetNumberOfFields(); ++i)
+            {
+            if(this->HaveHeaders)
+              {
+              names.push_back(vtkStdString(tokenizer.GetFieldBegin(i),
+                tokenizer.GetFieldEnd(i) - tokenizer.GetFieldBegin(i)));
+              }
+            else
+              {
+              std::stringstream buffer_name;
+              buffer_name << "Field " << i;
+              names.push_back(buffer_name.str());
+              }
+            }
+          }
+        if(this->HaveHeaders)
+          {
+          p = next;
+          }
+
+        // ... and the first records give their types.
+        if(types.empty())
+          {
+          types.assign(names.size(),
+                       this->ForceDouble ? DoubleColumn : IntegerColumn);
+          work.Types = &types;
+          TypedColumnsPart sample;
+          sample.Begin = p;
+          sample.End = stop;
+          ParseTypedRecords(work, sample, sample_records, false);
+          types = sample.Types;
+          }
+
+        for(size_t i = 0; i != names.size(); ++i)
+          {
+          vtkSmartPointer<vtkAbstractArray> array;
+          switch(types[i])
+            {
+            case IntegerColumn:
+              array = vtkSmartPointer<vtkIntArray>::New();
+              break;
+            case DoubleColumn:
+              array = vtkSmartPointer<vtkDoubleArray>::New();
+              break;
+            default:
+              array = vtkSmartPointer<vtkStringArray>::New();
+              break;
+            }
+          array->SetName(names[i]);
+          columns.push_back(array);
+          }
+        }
+
+      // Each thread parses a part of the block that ends after a record
+      // delimiter ...
+      int part_count = numberOfThreads;
+      if((stop - p) / minimum_part_size < part_count)
+        {
+        part_count = static_cast<int>((stop - p) / minimum_part_size);
+        }
+      if(part_count < 1)
+        {
+        part_count = 1;
+        }
+      work.Types = &types;
+      work.Parts.resize(part_count);
+      const char* part_begin = p;
+      for(int i = 0; i != part_count; ++i)
+        {
+        const char* part_end = stop;
+        if(i + 1 != part_count)
+          {
+          part_end = std::max(part_begin, p + (stop - p) / part_count * (i + 1));
+          while(part_end != stop && !tokenizer.IsRecordDelimiter(*part_end))
+            {
+            ++part_end;
+            }
+          if(part_end != stop)
+            {
+            ++part_end;
+            }
+          }
+        work.Parts[i].Begin = part_begin;
+        work.Parts[i].End = part_end;
+        part_begin = part_end;
+        }
+      if(part_count == 1)
+        {
+        ParseTypedRecords(work, work.Parts[0], -1, true);
+        }
+      else
+        {
+        vtkMultiThreader* threader = vtkMultiThreader::New();
+        threader->SetNumberOfThreads(part_count);
+        threader->SetSingleMethod(ParseTypedRecordsThread, &work);
+        threader->SingleMethodExecute();
+        threader->Delete();
+        }
+
+      // ... then the columns are widened where needed, or the values of
+      // the parts are appended to them.
+      vtkIdType limit = VTK_LARGE_ID;
+      if(this->MaxRecords)
+        {
+        limit = this->MaxRecords - record_count;
+        }
+      vtkIdType offset = 0;
+      for(int i = 0; i != part_count; ++i)
+        {
+        const TypedColumnsPart& part = work.Parts[i];
+        for(size_t j = 0; j != types.size(); ++j)
+          {
+          if(part.FirstDouble[j] >= 0 && offset + part.FirstDouble[j] < limit &&
+             types[j] < DoubleColumn)
+            {
+            types[j] = DoubleColumn;
+            read_again = true;
+            }
+          if(part.FirstString[j] >= 0 && offset + part.FirstString[j] < limit)
+            {
+            types[j] = StringColumn;
+            read_again = true;
+            }
+          }
+        offset += part.NumberOfRecords;
+        }
+      if(read_again)
+        {
+        break;
+        }
+      for(int i = 0; i != part_count; ++i)
+        {
+        TypedColumnsPart& part = work.Parts[i];
+        const vtkIdType count = std::min(part.NumberOfRecords, limit);
+        for(size_t j = 0; j != columns.size(); ++j)
+          {
+          AppendTypedColumn(columns[j], part.Values[j], count);
+          }
+        record_count += count;
+        limit -= count;
+        }
+
+      kept = end - stop;
+      memmove(&buffer[0], stop, kept);
+      }
+    }
+
+  // Columns of a file without records are left to be doubles, as
+  // vtkStringToNumeric leaves them.
+  for(size_t i = 0; i != columns.size(); ++i)
+    {
+    if(record_count == 0 && types[i] == IntegerColumn)
+      {
+      columns[i] = vtkSmartPointer<vtkDoubleArray>::New();
+      columns[i]->SetName(names[i]);
+      }
+    columns[i]->Squeeze();
+    output_table->AddColumn(columns[i]);
+    }
+  return true;
+}
@@ -48,6 +48,14 @@
 //
 // This class emits ProgressEvent for every 100 lines it reads.
 //
+// When DetectNumericColumns and ParseTypedColumns are on and the reader
+// is in the default ascii mode, the file is read in blocks of bytes that
+// are split into records on several threads.  The types of the columns
+// are inferred from the first records, then numeric fields are parsed
+// straight into vtkIntArray or vtkDoubleArray columns without making
+// strings of them first.  A field that does not fit the type inferred for
+// its column widens that type and the file is read again.
+//
 // .SECTION Thanks
 // Thanks to Andy Wilson, Brian Wylie, Tim Shead, and Thomas Otahal
 // from Sandia National Laboratories for implementing this class.
@@ -190,6 +198,23 @@ public:
   vtkGetMacro(TrimWhitespacePriorToNumericConversion, bool);
   vtkBooleanMacro(TrimWhitespacePriorToNumericConversion, bool);
 
+  // Description:
+  // When set to true and DetectNumericColumns is also true, numeric
+  // columns of ascii and UTF-8 files are parsed directly from the bytes
+  // of the file on several threads, instead of being read as strings and
+  // converted afterwards.  The resulting table is the same.  Default is
+  // off.
+  vtkSetMacro(ParseTypedColumns, bool);
+  vtkGetMacro(ParseTypedColumns, bool);
+  vtkBooleanMacro(ParseTypedColumns, bool);
+
+  // Description:
+  // Get/Set the number of threads used when ParseTypedColumns is on.  If
+  // it is 0 the default number of threads of vtkMultiThreader is used.
+  // Default is 0.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
   // Description:
   // When DetectNumericColumns is set to true, the reader use this value to populate
   // the vtkIntArray where empty strings are found. Default is 0.
@@ -244,6 +269,12 @@ protected:
     vtkInformationVector**,
     vtkInformationVector*);
 
+  // Description:
+  // Read the columns of the table with their numeric types from the
+  // bytes of 'stream'.  Returns false, without reading anything, if the
+  // delimiters or the encoding of the file need the unicode code path.
+  bool ReadTypedColumns(istream& stream, vtkTable* output_table);
+
   char* FileName;
   char* UnicodeCharacterSet;
   vtkIdType MaxRecords;
@@ -255,6 +286,8 @@ protected:
   bool DetectNumericColumns;
   bool ForceDouble;
   bool TrimWhitespacePriorToNumericConversion;
+  bool ParseTypedColumns;
+  int NumberOfThreads;
   int DefaultIntegerValue;
   double DefaultDoubleValue;
   char* FieldDelimiterCharacters;
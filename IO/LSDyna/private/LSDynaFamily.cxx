@@ -23,6 +23,10 @@
 #include <errno.h>
 #include <ctype.h>
 #include <assert.h>
+#include <string.h>
+#ifndef WIN32
+#  include <sys/mman.h>
+#endif
 
 #include <string>
 #include <set>
@@ -164,8 +168,13 @@ LSDynaFamily::LSDynaFamily()
     this->StateSize = 0; // Time steps take up no room on disk
 
     this->AdaptationsMarkers.push_back( LSDynaFamilyAdaptLevel() );
+    this->MemoryMapping = true;
+    this->FileMap = NULL;
+    this->FileMapSize = 0;
     this->Chunk = NULL;
+    this->ChunkBuffer = NULL;
     this->ChunkWord = 0;
+    this->ChunkValid = 0;
     this->ChunkAlloc = 0;
 
     this->FileHandlesClosed = false;
@@ -176,14 +185,11 @@ LSDynaFamily::LSDynaFamily()
 //-----------------------------------------------------------------------------
 LSDynaFamily::~LSDynaFamily()
     {
-    if ( ! VTK_LSDYNA_ISBADFILE(this->FD) )
-      {
-      VTK_LSDYNA_CLOSEFILE(this->FD);
-      }
+    this->CloseFile();
 
-    if ( this->Chunk )
+    if ( this->ChunkBuffer )
       {
-      delete [] this->Chunk;
+      delete [] this->ChunkBuffer;
       }
 
     delete this->BufferInfo;
@@ -317,15 +323,12 @@ int LSDynaFamily::SkipToWord( SectionType sType, vtkIdType sId, vtkIdType wordNu
     {
     if ( this->FNum >= 0 )
       {
-      if ( ! VTK_LSDYNA_ISBADFILE(this->FD) )
-        {
-        VTK_LSDYNA_CLOSEFILE(this->FD);
-        }
+      this->CloseFile();
       }
-    this->FD = VTK_LSDYNA_OPENFILE(this->Files[mark.FileNumber].c_str());
-    if ( VTK_LSDYNA_ISBADFILE(this->FD) )
+    int err = this->OpenFile( mark.FileNumber );
+    if ( err )
       {
-      return errno;
+      return err;
       }
     this->FNum = mark.FileNumber;
     this->FAdapt = this->FileAdaptLevels[ this->FNum ];
@@ -337,6 +340,11 @@ int LSDynaFamily::SkipToWord( SectionType sType, vtkIdType sId, vtkIdType wordNu
     return errno;
     }
   this->FWord = mark.Offset;
+  if ( sType == TimeStepSection )
+    {
+    // A state is read from start to end, so have all of it read ahead.
+    this->WillNeed( offset, this->StateSize * this->WordSize );
+    }
   return 0;
   }
 
@@ -378,7 +386,7 @@ int LSDynaFamily::SkipWords( vtkIdType numWords )
   if(offset>0)
     {
     // try advancing to next file
-    VTK_LSDYNA_CLOSEFILE(this->FD);
+    this->CloseFile();
 
     // if the skip is too big for one file, advance to the correct file
     ++this->FNum;
@@ -388,13 +396,13 @@ int LSDynaFamily::SkipWords( vtkIdType numWords )
       ++this->FNum;
       }
 
-    this->FD = VTK_LSDYNA_OPENFILE(this->Files[this->FNum].c_str());
+    int err = this->OpenFile( this->FNum );
     this->FWord = 0;
-    if ( VTK_LSDYNA_ISBADFILE(this->FD) )
+    if ( err )
       { // bad file (permissions, deleted) or request (too big)
       this->FNum = -1;
       this->FAdapt = -1;
-      return errno;
+      return err;
       }
 
     //seek into the file the current offset amount
@@ -413,17 +421,31 @@ int LSDynaFamily::BufferChunk( WordType wType, vtkIdType chunkSizeInWords )
   if ( chunkSizeInWords == 0 )
     return 0;
 
+  this->FWord = VTK_LSDYNA_TELL(this->FD);
+
+  // A chunk that lies in the mapped file and needs no swapping is used
+  // where it is, so that it is decoded straight from the file.
+  vtkIdType chunkBytes = chunkSizeInWords*this->WordSize;
+  if ( this->FileMap && ( ! this->SwapEndian || wType == LSDynaFamily::Char ) &&
+       this->FWord >= 0 && this->FWord + chunkBytes <= this->FileMapSize )
+    {
+    this->Chunk = this->FileMap + this->FWord;
+    this->ChunkValid = chunkBytes;
+    this->ChunkWord = 0;
+    this->FWord = VTK_LSDYNA_SEEKTELL(this->FD,chunkBytes,SEEK_CUR);
+    return 0;
+    }
+
   if ( this->ChunkAlloc < chunkSizeInWords )
     {
-    if ( this->Chunk )
+    if ( this->ChunkBuffer )
       {
-      delete [] this->Chunk;
+      delete [] this->ChunkBuffer;
       }
     this->ChunkAlloc = chunkSizeInWords;
-    this->Chunk = new unsigned char[ this->ChunkAlloc*this->WordSize ];
+    this->ChunkBuffer = new unsigned char[ this->ChunkAlloc*this->WordSize ];
     }
-
-  this->FWord = VTK_LSDYNA_TELL(this->FD);
+  this->Chunk = this->ChunkBuffer;
 
   // Eventually, we must check the return value and see if the read
   // came up short (EOF). If it did, then we must advance to the next
@@ -435,7 +457,7 @@ int LSDynaFamily::BufferChunk( WordType wType, vtkIdType chunkSizeInWords )
   this->ChunkWord = 0;
   while ( bytesLeft )
     {
-    bytesRead = VTK_LSDYNA_READ(this->FD,(void*) buf,bytesLeft);
+    bytesRead = this->ReadBytes(buf,bytesLeft);
     this->ChunkValid += bytesRead;
     if ( bytesRead < bytesLeft )
       {
@@ -443,20 +465,20 @@ int LSDynaFamily::BufferChunk( WordType wType, vtkIdType chunkSizeInWords )
       std::cout << "bytesRead " << bytesRead << " bytesLeft" << bytesLeft << std::endl;
       if ( bytesRead <= 0 )
         { // try advancing to next file
-        VTK_LSDYNA_CLOSEFILE(this->FD);
+        this->CloseFile();
         if ( ++this->FNum == (vtkIdType) this->Files.size() )
           { // no more files to read. Oops.
           this->FNum = -1;
           this->FAdapt = -1;
           return 1;
           }
-        this->FD = VTK_LSDYNA_OPENFILE(this->Files[this->FNum].c_str());
+        int err = this->OpenFile( this->FNum );
         this->FWord = 0;
-        if ( VTK_LSDYNA_ISBADFILE(this->FD) )
+        if ( err )
           { // bad file (permissions, deleted) or request (too big)
           this->FNum = -1;
           this->FAdapt = -1;
-          return errno;
+          return err;
           }
         }
       }
@@ -515,13 +537,14 @@ int LSDynaFamily::BufferChunk( WordType wType, vtkIdType chunkSizeInWords )
 //-----------------------------------------------------------------------------
 int LSDynaFamily::ClearBuffer()
 {
-  if ( this->Chunk )
+  this->ChunkWord = 0;
+  this->ChunkValid = 0;
+  this->Chunk = NULL;
+  if ( this->ChunkBuffer )
     {
     this->ChunkAlloc = 0;
-    this->ChunkWord = 0;
-    this->ChunkValid = 0;
-    delete [] this->Chunk;
-    this->Chunk = NULL;
+    delete [] this->ChunkBuffer;
+    this->ChunkBuffer = NULL;
     }
 
   return 0;
@@ -591,11 +614,7 @@ int LSDynaFamily::AdvanceFile()
       return 1;
       }
     }
-  if ( ! VTK_LSDYNA_ISBADFILE(this->FD) )
-    {
-    VTK_LSDYNA_CLOSEFILE(this->FD);
-    //this->FD = VTK_LSDYNA_BADFILE;
-    }
+  this->CloseFile();
   this->FWord = 0;
   this->ChunkValid = 0;
   if ( this->FNum + 1 < (vtkIdType) this->Files.size() )
@@ -605,15 +624,9 @@ int LSDynaFamily::AdvanceFile()
     }
   else
     {
-    this->FD = VTK_LSDYNA_BADFILE;
     return 1;
     }
-  this->FD = VTK_LSDYNA_OPENFILE(this->Files[this->FNum].c_str());
-  if ( VTK_LSDYNA_ISBADFILE(this->FD) )
-    {
-    return errno;
-    }
-  return 0;
+  return this->OpenFile( this->FNum );
   }
 
 void LSDynaFamily::MarkSectionStart( int adaptLevel, SectionType m )
@@ -694,7 +707,7 @@ int LSDynaFamily::DetermineStorageModel()
     }
 
   // Oops, couldn't identify storage model
-  VTK_LSDYNA_CLOSEFILE(this->FD);
+  this->CloseFile();
   this->FNum = -1;
   this->FAdapt = -1;
   return 1;
@@ -741,11 +754,7 @@ int LSDynaFamily::GetWordSize() const
 //-----------------------------------------------------------------------------
 void LSDynaFamily::Reset()
 {
-  if ( ! VTK_LSDYNA_ISBADFILE(this->FD) )
-    {
-    VTK_LSDYNA_CLOSEFILE(this->FD);
-    this->FD = VTK_LSDYNA_BADFILE;
-    }
+  this->CloseFile();
 
   this->DatabaseDirectory = "";
   this->DatabaseBaseName = "";
@@ -807,8 +816,7 @@ void LSDynaFamily::CloseFileHandles()
 {
   if (!VTK_LSDYNA_ISBADFILE(this->FD) && !this->FileHandlesClosed)
     {
-    VTK_LSDYNA_CLOSEFILE(this->FD);
-    this->FD = VTK_LSDYNA_BADFILE;
+    this->CloseFile();
     this->ClearBuffer();
     this->FileHandlesClosed=true;
     }
@@ -819,8 +827,118 @@ void LSDynaFamily::OpenFileHandles()
 {
   if (VTK_LSDYNA_ISBADFILE(this->FD) && this->FileHandlesClosed)
     {
-    this->FD = VTK_LSDYNA_OPENFILE(this->Files[this->FNum].c_str());
+    this->OpenFile(this->FNum);
     VTK_LSDYNA_SEEK(this->FD,this->FWord,SEEK_SET);
     this->FileHandlesClosed=false;
     }
 }
+
+//-----------------------------------------------------------------------------
+void LSDynaFamily::SetMemoryMapping( bool mapping )
+{
+  this->MemoryMapping = mapping;
+}
+
+//-----------------------------------------------------------------------------
+int LSDynaFamily::OpenFile( vtkIdType fileNumber )
+{
+  this->FD = VTK_LSDYNA_OPENFILE(this->Files[fileNumber].c_str());
+  if ( VTK_LSDYNA_ISBADFILE(this->FD) )
+    {
+    return errno ? errno : 1;
+    }
+#ifndef WIN32
+  // The whole file is mapped once; pages are only read when a chunk
+  // touches them. If the mapping fails, the file is read with read().
+  struct stat st;
+  if ( this->MemoryMapping && fstat( this->FD, &st ) == 0 && st.st_size > 0 &&
+       static_cast<vtkTypeUInt64>(st.st_size) <=
+       static_cast<vtkTypeUInt64>(static_cast<size_t>(-1)) )
+    {
+    // Private writable pages keep the chunk writable for its users
+    // without ever touching the file.
+    void* map = mmap( NULL, static_cast<size_t>(st.st_size),
+                      PROT_READ | PROT_WRITE, MAP_PRIVATE, this->FD, 0 );
+    if ( map != MAP_FAILED )
+      {
+      this->FileMap = static_cast<unsigned char*>(map);
+      this->FileMapSize = static_cast<vtkIdType>(st.st_size);
+      madvise( map, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL );
+      }
+    }
+#endif
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+void LSDynaFamily::CloseFile()
+{
+#ifndef WIN32
+  if ( this->FileMap )
+    {
+    if ( this->Chunk >= this->FileMap &&
+         this->Chunk < this->FileMap + this->FileMapSize )
+      {
+      this->Chunk = this->ChunkBuffer;
+      this->ChunkValid = 0;
+      this->ChunkWord = 0;
+      }
+    munmap( this->FileMap, static_cast<size_t>(this->FileMapSize) );
+    this->FileMap = NULL;
+    this->FileMapSize = 0;
+    }
+#endif
+  if ( ! VTK_LSDYNA_ISBADFILE(this->FD) )
+    {
+    VTK_LSDYNA_CLOSEFILE(this->FD);
+    this->FD = VTK_LSDYNA_BADFILE;
+    }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType LSDynaFamily::ReadBytes( unsigned char* buf, vtkIdType numBytes )
+{
+  if ( this->FileMap )
+    {
+    vtkIdType pos = VTK_LSDYNA_TELL(this->FD);
+    // Past the end of the mapping (a file still being written), read().
+    if ( pos >= 0 && pos < this->FileMapSize )
+      {
+      vtkIdType n = std::min( numBytes, this->FileMapSize - pos );
+      memcpy( buf, this->FileMap + pos, n );
+      VTK_LSDYNA_SEEK(this->FD,n,SEEK_CUR);
+      return n;
+      }
+    }
+  return VTK_LSDYNA_READ(this->FD,(void*) buf,numBytes);
+}
+
+//-----------------------------------------------------------------------------
+void LSDynaFamily::WillNeed( vtkIdType offset, vtkIdType numBytes )
+{
+  if ( numBytes <= 0 || VTK_LSDYNA_ISBADFILE(this->FD) )
+    {
+    return;
+    }
+#ifndef WIN32
+  if ( this->FileMap )
+    {
+    if ( offset >= this->FileMapSize )
+      {
+      return;
+      }
+    numBytes = std::min( numBytes, this->FileMapSize - offset );
+    // madvise wants a start on a page boundary.
+    vtkIdType pageSize = static_cast<vtkIdType>( sysconf( _SC_PAGESIZE ) );
+    vtkIdType start = pageSize > 0 ? offset - offset % pageSize : offset;
+    madvise( this->FileMap + start,
+             static_cast<size_t>( numBytes + offset - start ), MADV_WILLNEED );
+    return;
+    }
+#  ifdef POSIX_FADV_WILLNEED
+  posix_fadvise( this->FD, offset, numBytes, POSIX_FADV_WILLNEED );
+#  endif
+#else
+  (void)offset;
+#endif
+}
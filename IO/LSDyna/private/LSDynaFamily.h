@@ -21,6 +21,9 @@
 // .SECTION Description
 //    A class to abstract away I/O from families of output files.
 //    This performs the actual reads and writes plus any required byte swapping.
+//    Where the platform allows it, the open file is memory-mapped and chunks
+//    that need no byte swapping point straight into the mapped file instead
+//    of being copied into a buffer.
 //    Also contains a subclass, LSDynaFamilyAdaptLevel, used to store
 //    file+offset
 //    information for each mesh adaptation's state info.
@@ -200,7 +203,25 @@ public:
 
   void OpenFileHandles();
 
+  //Description:
+  //Set whether the files are memory-mapped when they are opened. This
+  //is on by default; files that cannot be mapped are read with read().
+  void SetMemoryMapping( bool mapping );
+  bool GetMemoryMapping() const { return this->MemoryMapping; }
+
 protected:
+  /// Open file fileNumber of the family as FD and map it if possible.
+  /// Returns 0 on success or errno.
+  int OpenFile( vtkIdType fileNumber );
+  /// Unmap and close FD.
+  void CloseFile();
+  /// Read numBytes from the current position of FD into buf and return
+  /// the number of bytes read.
+  vtkIdType ReadBytes( unsigned char* buf, vtkIdType numBytes );
+  /// Tell the system that numBytes starting at byte offset of FD will be
+  /// read soon, so that it reads them ahead.
+  void WillNeed( vtkIdType offset, vtkIdType numBytes );
+
   /// The directory containing d3plot files
   std::string DatabaseDirectory;
   /// The name (title string) of the database. This is the first 10 words
@@ -244,15 +265,25 @@ protected:
   std::vector<LSDynaFamilySectionMark> TimeStepMarks;
   /// The adaptation level associated with each time step.
   std::vector<int> TimeAdaptLevels;
-  /// A buffer containing file contents of file FNum starting with word FWord.
+  /// Whether files are memory-mapped when they are opened.
+  bool MemoryMapping;
+  /// The contents of the currently open file when it is mapped, or NULL.
+  unsigned char* FileMap;
+  /// The size in bytes of FileMap.
+  vtkIdType FileMapSize;
+  /// The file contents of file FNum starting with word FWord. This is
+  /// either ChunkBuffer or a pointer into FileMap.
   unsigned char* Chunk;
+  /// The buffer that chunks are copied into when they are not mapped or
+  /// must be byte swapped.
+  unsigned char* ChunkBuffer;
   /// A pointer to the next word in Chunk that will be returned when the
   /// reader requests a word.
   vtkIdType ChunkWord;
   // How much of the the allocated space is filled with valid data (assert
   // ChunkValid <= ChunkAlloc).
   vtkIdType ChunkValid;
-  /// The allocated size (in words) of Chunk.
+  /// The allocated size (in words) of ChunkBuffer.
   vtkIdType ChunkAlloc;
 
   bool FileHandlesClosed;
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOggTheoraWriterAsynchronous.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the frames written by vtkOggTheoraWriter in
+// asynchronous mode, where the image is changed as soon as Write()
+// returns, are encoded as they are in synchronous mode.  The movies may
+// only differ by the serial number of their ogg stream.
+
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkOggTheoraWriter.h"
+
+#include <string>
+#include <vtksys/ios/fstream>
+#include <vtksys/ios/sstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+const int Width = 96;
+const int Height = 64;
+const int Frames = 30;
+
+void DrawFrame(vtkImageData* image, int frame)
+{
+  unsigned char* pixel =
+    static_cast<unsigned char*>(image->GetScalarPointer());
+  for (int y = 0; y < Height; y++)
+    {
+    for (int x = 0; x < Width; x++)
+      {
+      *pixel++ = static_cast<unsigned char>(x * 2 + frame * 5);
+      *pixel++ = static_cast<unsigned char>(y * 3 - frame * 7);
+      *pixel++ = static_cast<unsigned char>((x - y) * frame);
+      }
+    }
+}
+
+std::string ReadFile(const char* fileName)
+{
+  vtksys_ios::ifstream file(fileName, ios::in | ios::binary);
+  vtksys_ios::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+// Clear the serial number and the checksum of each ogg page.
+bool ClearSerialNumbers(std::string& movie)
+{
+  size_t page = 0;
+  while (page < movie.size())
+    {
+    if (page + 27 > movie.size() || movie.compare(page, 4, "OggS") != 0)
+      {
+      return false;
+      }
+    size_t segments = static_cast<unsigned char>(movie[page + 26]);
+    if (page + 27 + segments > movie.size())
+      {
+      return false;
+      }
+    size_t length = 27 + segments;
+    for (size_t i = 0; i < segments; i++)
+      {
+      length += static_cast<unsigned char>(movie[page + 27 + i]);
+      }
+    movie.replace(page + 14, 4, 4, '\0');
+    movie.replace(page + 22, 4, 4, '\0');
+    page += length;
+    }
+  return page == movie.size();
+}
+}
+
+int TestOggTheoraWriterAsynchronous(int, char*[])
+{
+  const char* fileNames[2] = { "TestOggTheoraWriterSynchronous.ogv",
+                               "TestOggTheoraWriterAsynchronous.ogv" };
+  for (int asynchronous = 0; asynchronous < 2; asynchronous++)
+    {
+    vtkNew<vtkImageData> image;
+    image->SetExtent(0, Width - 1, 0, Height - 1, 0, 0);
+    image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+    vtkNew<vtkOggTheoraWriter> writer;
+    writer->SetInputData(image.GetPointer());
+    writer->SetFileName(fileNames[asynchronous]);
+    writer->SetAsynchronous(asynchronous);
+    writer->SetMaximumNumberOfPendingFrames(2);
+    DrawFrame(image.GetPointer(), 0);
+    writer->Start();
+    for (int frame = 0; frame < Frames; frame++)
+      {
+      writer->Write();
+      // The next frame is drawn while this one may still be encoded.
+      DrawFrame(image.GetPointer(), frame + 1);
+      image->Modified();
+      }
+    writer->End();
+    TEST_ASSERT(writer->GetError() == 0,
+                "Could not write " << fileNames[asynchronous]);
+    }
+
+  std::string movies[2];
+  for (int i = 0; i < 2; i++)
+    {
+    movies[i] = ReadFile(fileNames[i]);
+    TEST_ASSERT(!movies[i].empty() && ClearSerialNumbers(movies[i]),
+                "Expected ogg pages in " << fileNames[i]);
+    }
+  TEST_ASSERT(movies[0] == movies[1],
+              "The frames encoded asynchronously differ");
+  return EXIT_SUCCESS;
+}
@@ -14,21 +14,226 @@
 =========================================================================*/
 #include "vtkGenericMovieWriter.h"
 
+#include "vtkConditionVariable.h"
+#include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkErrorCode.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
+#include "vtkPointData.h"
 
+#include <deque>
+#include <vector>
+
+//---------------------------------------------------------------------------
+// The frames of a writer waiting to be encoded, in order.  The background
+// thread encodes the front one and gives its copy back to FreeFrames for
+// the next frame to reuse.
+class vtkGenericMovieWriterAsynchronousQueue
+{
+public:
+  vtkGenericMovieWriterAsynchronousQueue(vtkGenericMovieWriter* writer)
+    {
+    this->Writer = writer;
+    this->Encoding = 0;
+    this->Failed = 0;
+    this->Stop = 0;
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    }
+  ~vtkGenericMovieWriterAsynchronousQueue()
+    {
+    if (this->ThreadId >= 0)
+      {
+      this->Lock.Lock();
+      this->Stop = 1;
+      this->Condition.Broadcast();
+      this->Lock.Unlock();
+      this->Threader->TerminateThread(this->ThreadId);
+      }
+    this->Threader->Delete();
+    for (size_t i = 0; i < this->Frames.size(); ++i)
+      {
+      this->Frames[i]->Delete();
+      }
+    for (size_t i = 0; i < this->FreeFrames.size(); ++i)
+      {
+      this->FreeFrames[i]->Delete();
+      }
+    }
+
+  static VTK_THREAD_RETURN_TYPE EncodeFrames(void* arg);
+
+  vtkGenericMovieWriter* Writer;
+  std::deque<vtkImageData*> Frames;
+  std::vector<vtkImageData*> FreeFrames;
+  int Encoding;
+  int Failed;
+  int Stop;
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Condition;
+  vtkMultiThreader* Threader;
+  int ThreadId;
+};
+
+//---------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE
+vtkGenericMovieWriterAsynchronousQueue::EncodeFrames(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkGenericMovieWriterAsynchronousQueue* self =
+    static_cast<vtkGenericMovieWriterAsynchronousQueue*>(info->UserData);
+  self->Lock.Lock();
+  for (;;)
+    {
+    while (!self->Stop && self->Frames.empty())
+      {
+      self->Condition.Wait(self->Lock);
+      }
+    if (self->Stop)
+      {
+      break;
+      }
+    vtkImageData* frame = self->Frames.front();
+    self->Frames.pop_front();
+    self->Encoding = 1;
+    int failed = self->Failed;
+    self->Lock.Unlock();
+    // The frames after one that failed are dropped.
+    int encoded = !failed && self->Writer->EncodeFrame(frame);
+    self->Lock.Lock();
+    if (!encoded)
+      {
+      self->Failed = 1;
+      }
+    self->Encoding = 0;
+    self->FreeFrames.push_back(frame);
+    self->Condition.Broadcast();
+    }
+  self->Lock.Unlock();
+  return VTK_THREAD_RETURN_VALUE;
+}
 
 //---------------------------------------------------------------------------
 vtkGenericMovieWriter::vtkGenericMovieWriter()
 {
   this->FileName = NULL;
   this->Error = 0;
+  this->Asynchronous = 0;
+  this->MaximumNumberOfPendingFrames = 4;
+  this->AsynchronousQueue = 0;
 }
 
 //---------------------------------------------------------------------------
 vtkGenericMovieWriter::~vtkGenericMovieWriter()
 {
   this->SetFileName(0);
+  delete this->AsynchronousQueue;
+}
+
+//---------------------------------------------------------------------------
+int vtkGenericMovieWriter::EncodeFrame(vtkImageData *vtkNotUsed(frame))
+{
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+int vtkGenericMovieWriter::WriteFrame(vtkImageData *frame)
+{
+  if (!this->Asynchronous)
+    {
+    return this->EncodeFrame(frame);
+    }
+
+  if (!this->AsynchronousQueue)
+    {
+    this->AsynchronousQueue = new vtkGenericMovieWriterAsynchronousQueue(this);
+    }
+  vtkGenericMovieWriterAsynchronousQueue* queue = this->AsynchronousQueue;
+
+  // Wait for room in the queue and take a copy from the frames encoded.
+  queue->Lock.Lock();
+  while (!queue->Failed &&
+         static_cast<int>(queue->Frames.size()) + queue->Encoding >=
+         this->MaximumNumberOfPendingFrames)
+    {
+    queue->Condition.Wait(queue->Lock);
+    }
+  if (queue->Failed)
+    {
+    queue->Lock.Unlock();
+    return 0;
+    }
+  vtkImageData* copy;
+  if (queue->FreeFrames.empty())
+    {
+    copy = vtkImageData::New();
+    }
+  else
+    {
+    copy = queue->FreeFrames.back();
+    queue->FreeFrames.pop_back();
+    }
+  queue->Lock.Unlock();
+
+  // The encoders only read the scalars, which are copied into those of
+  // the copy when they have the same size.
+  copy->CopyStructure(frame);
+  vtkDataArray* scalars = frame->GetPointData()->GetScalars();
+  vtkDataArray* copyScalars = copy->GetPointData()->GetScalars();
+  if (!scalars)
+    {
+    copy->GetPointData()->SetScalars(NULL);
+    }
+  else if (copyScalars &&
+           copyScalars->GetDataType() == scalars->GetDataType() &&
+           copyScalars->GetNumberOfComponents() ==
+           scalars->GetNumberOfComponents() &&
+           copyScalars->GetNumberOfTuples() == scalars->GetNumberOfTuples())
+    {
+    memcpy(copyScalars->GetVoidPointer(0), scalars->GetVoidPointer(0),
+           static_cast<size_t>(scalars->GetNumberOfTuples()) *
+           scalars->GetNumberOfComponents() * scalars->GetDataTypeSize());
+    }
+  else
+    {
+    copyScalars = scalars->NewInstance();
+    copyScalars->DeepCopy(scalars);
+    copy->GetPointData()->SetScalars(copyScalars);
+    copyScalars->Delete();
+    }
+
+  queue->Lock.Lock();
+  queue->Frames.push_back(copy);
+  queue->Condition.Broadcast();
+  queue->Lock.Unlock();
+  if (queue->ThreadId < 0)
+    {
+    queue->ThreadId = queue->Threader->SpawnThread(
+      &vtkGenericMovieWriterAsynchronousQueue::EncodeFrames, queue);
+    }
+  return 1;
+}
+
+//---------------------------------------------------------------------------
+int vtkGenericMovieWriter::WaitForPendingFrames()
+{
+  vtkGenericMovieWriterAsynchronousQueue* queue = this->AsynchronousQueue;
+  if (!queue)
+    {
+    return 1;
+    }
+  queue->Lock.Lock();
+  while (!queue->Frames.empty() || queue->Encoding)
+    {
+    queue->Condition.Wait(queue->Lock);
+    }
+  // The next movie starts afresh.
+  int failed = queue->Failed;
+  queue->Failed = 0;
+  queue->Lock.Unlock();
+  return !failed;
 }
 
 //----------------------------------------------------------------------------
@@ -39,6 +244,9 @@ void vtkGenericMovieWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "FileName: "
      << (this->FileName ? this->FileName : "(none)") << endl;
   os << indent << "Error: " << this->Error << endl;
+  os << indent << "Asynchronous: " << this->Asynchronous << endl;
+  os << indent << "MaximumNumberOfPendingFrames: "
+     << this->MaximumNumberOfPendingFrames << endl;
 }
 
 //----------------------------------------------------------------------------
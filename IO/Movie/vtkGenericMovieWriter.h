@@ -19,6 +19,11 @@
 // open and create the file, the Write() method will output a frame to
 // the file (i.e. the contents of the vtkImageData), End() will finalize
 // and close the file.
+//
+// In asynchronous mode, Write() returns once a copy of the frame is
+// queued, and the frames are encoded in order on a background thread,
+// so that encoding overlaps with rendering the next frames.  Writers
+// that support it encode their frames in EncodeFrame().
 // .SECTION See Also
 // vtkAVIWriter vtkMPEG2Writer
 
@@ -29,6 +34,7 @@
 #include "vtkImageAlgorithm.h"
 
 class vtkImageData;
+class vtkGenericMovieWriterAsynchronousQueue;
 
 class VTKIOMOVIE_EXPORT vtkGenericMovieWriter : public vtkImageAlgorithm
 {
@@ -52,6 +58,27 @@ public:
   // Was there an error on the last write performed?
   vtkGetMacro(Error,int);
 
+  // Description:
+  // Get/Set whether Write() returns as soon as a copy of the frame is
+  // taken, while the frame is encoded and written on a background
+  // thread.  An error encoding a frame is reported by the next Write()
+  // or by End().  Default is 0.
+  vtkSetMacro(Asynchronous, int);
+  vtkGetMacro(Asynchronous, int);
+  vtkBooleanMacro(Asynchronous, int);
+
+  // Description:
+  // Get/Set the number of frames waiting to be encoded at once in
+  // asynchronous mode.  Write() waits for the oldest one to be encoded
+  // when there are as many.  Default is 4.
+  vtkSetClampMacro(MaximumNumberOfPendingFrames, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingFrames, int);
+
+  // Description:
+  // Wait for the frames written asynchronously to be encoded.  Returns
+  // 1 if they all were, 0 if one of them failed.
+  int WaitForPendingFrames();
+
   // Description:
   // Converts vtkErrorCodes and vtkGenericMovieWriter errors to strings.
   static const char *GetStringFromErrorCode(unsigned long event);
@@ -74,7 +101,25 @@ protected:
   char *FileName;
   int Error;
 
+  // Description:
+  // Encode 'frame' with EncodeFrame(), or queue a copy of it to be
+  // encoded on the background thread in asynchronous mode.  Returns 0 if
+  // the frame, or in asynchronous mode an earlier frame, failed.
+  int WriteFrame(vtkImageData *frame);
+
+  // Description:
+  // Encode and write a frame, on the background thread in asynchronous
+  // mode.  Returns 0 on failure.  The default does nothing and fails.
+  // Subclasses wait for the pending frames before they are destroyed.
+  virtual int EncodeFrame(vtkImageData *frame);
+
+  int Asynchronous;
+  int MaximumNumberOfPendingFrames;
+
 private:
+  friend class vtkGenericMovieWriterAsynchronousQueue;
+  vtkGenericMovieWriterAsynchronousQueue *AsynchronousQueue;
+
   vtkGenericMovieWriter(const vtkGenericMovieWriter&); // Not implemented
   void operator=(const vtkGenericMovieWriter&); // Not implemented
 };
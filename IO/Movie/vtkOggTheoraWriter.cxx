@@ -275,8 +275,6 @@ int vtkOggTheoraWriterInternal::Write(vtkImageData *id)
     this->haveImageData = false;
     }
 
-  this->Writer->GetInputAlgorithm(0, 0)->UpdateWholeExtent();
-
   // convert current RGB int YCbCr color space
   this->RGB2YCbCr(id,this->thImage);
   this->haveImageData = true;
@@ -374,10 +372,10 @@ void vtkOggTheoraWriterInternal::RGB2YCbCr(vtkImageData *id,
                       Kbm1 = Kb - 1;
   // stride between rows in the YCbCr image planes, since
   // pixels in a row are contiguous, but rows need not be
-  static const int strideRGB = this->Dim[0]*3,
-                   strideY   = ycbcr[0].stride/sizeof(uchar), // th_image_plane strides are in bytes
-                   strideCb  = ycbcr[1].stride/sizeof(uchar),
-                   strideCr  = ycbcr[2].stride/sizeof(uchar);
+  const int strideRGB = this->Dim[0]*3,
+            strideY   = ycbcr[0].stride/sizeof(uchar), // th_image_plane strides are in bytes
+            strideCb  = ycbcr[1].stride/sizeof(uchar),
+            strideCr  = ycbcr[2].stride/sizeof(uchar);
   //
   // computation
   //
@@ -490,6 +488,7 @@ vtkOggTheoraWriter::vtkOggTheoraWriter()
 //---------------------------------------------------------------------------
 vtkOggTheoraWriter::~vtkOggTheoraWriter()
 {
+  this->WaitForPendingFrames();
   delete this->Internals;
 }
 
@@ -573,7 +572,7 @@ void vtkOggTheoraWriter::Write()
     this->Initialized = 1;
     }
 
-  if (!this->Internals->Write(input))
+  if (!this->WriteFrame(input))
     {
     vtkErrorMacro("Error storing image.");
     this->Error = 1;
@@ -581,9 +580,21 @@ void vtkOggTheoraWriter::Write()
     }
 }
 
+//---------------------------------------------------------------------------
+int vtkOggTheoraWriter::EncodeFrame(vtkImageData *frame)
+{
+  return this->Internals->Write(frame);
+}
+
 //---------------------------------------------------------------------------
 void vtkOggTheoraWriter::End()
 {
+  if (!this->WaitForPendingFrames() && !this->Error)
+    {
+    vtkErrorMacro("Error storing image.");
+    this->Error = 1;
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    }
   this->Internals->End();
 
   delete this->Internals;
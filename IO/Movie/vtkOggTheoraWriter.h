@@ -67,6 +67,9 @@ protected:
   vtkOggTheoraWriter();
   ~vtkOggTheoraWriter();
 
+  // Encode a frame, on the background thread in asynchronous mode.
+  virtual int EncodeFrame(vtkImageData *frame);
+
   vtkOggTheoraWriterInternal *Internals;
 
   int Initialized;
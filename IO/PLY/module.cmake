@@ -4,6 +4,7 @@ vtk_module(vtkIOPLY
   DEPENDS
     vtkCommonMisc
     vtkCommonExecutionModel
+    vtkIOCore
     vtkIOGeometry
   TEST_DEPENDS
     vtkRenderingOpenGL
@@ -49,6 +49,7 @@ WARRANTY OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.
 #include "vtkPLY.h"
 #include "vtkHeap.h"
 #include "vtkByteSwap.h"
+#include "vtkNumberParser.h"
 
 #include <stddef.h>
 #include <string.h>
@@ -2429,7 +2430,8 @@ void vtkPLY::get_ascii_item(
     case PLY_FLOAT:
     case PLY_FLOAT32:
     case PLY_DOUBLE:
-      *double_val = atof (word);
+      if (!vtkNumberParser::Parse (word, word + strlen (word), *double_val))
+        *double_val = atof (word);
       *int_val = (int) *double_val;
       *uint_val = (unsigned int) *double_val;
       break;
@@ -18,6 +18,7 @@
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -255,22 +256,30 @@ int vtkPLYReader::RequestData(
         RGBPoints->SetNumberOfTuples(numPts);
         }
 
+      // Write the values straight into the arrays.
+      float* x = static_cast<vtkFloatArray*>(pts->GetData())->GetPointer(0);
+      float* tex = TexCoordsPointsAvailable ?
+        TexCoordsPoints->GetPointer(0) : NULL;
+      float* normal = NormalPointsAvailable ? Normals->GetPointer(0) : NULL;
+      unsigned char* rgb = RGBPointsAvailable ? RGBPoints->GetPointer(0) : NULL;
       plyVertex vertex;
       for (int j=0; j < numPts; j++)
         {
         vtkPLY::ply_get_element (ply, (void *) &vertex);
-        pts->SetPoint (j, vertex.x);
-        if ( TexCoordsPointsAvailable )
+        memcpy(x + 3*j, vertex.x, 3*sizeof(float));
+        if ( tex )
           {
-          TexCoordsPoints->SetTuple2(j, vertex.tex[0], vertex.tex[1]);
+          memcpy(tex + 2*j, vertex.tex, 2*sizeof(float));
           }
-        if ( NormalPointsAvailable )
+        if ( normal )
           {
-          Normals->SetTuple3(j, vertex.normal[0], vertex.normal[1], vertex.normal[2]);
+          memcpy(normal + 3*j, vertex.normal, 3*sizeof(float));
           }
-        if ( RGBPointsAvailable )
+        if ( rgb )
           {
-          RGBPoints->SetTuple3(j, vertex.red, vertex.green, vertex.blue);
+          rgb[3*j] = vertex.red;
+          rgb[3*j+1] = vertex.green;
+          rgb[3*j+2] = vertex.blue;
           }
         }
       output->SetPoints(pts);
@@ -282,10 +291,11 @@ int vtkPLYReader::RequestData(
       // Create a polygonal array
       numPolys = numElems;
       vtkCellArray *polys = vtkCellArray::New();
-      polys->Allocate(polys->EstimateSize(numPolys,3),numPolys/2);
+      vtkIdTypeArray *connectivity = vtkIdTypeArray::New();
+      connectivity->Allocate(polys->EstimateSize(numPolys,3),numPolys/2);
+      vtkIdType size = 0;
       plyFace face;
       int verts[256];
-      vtkIdType vtkVerts[256];
 
       // Get the face properties
       vtkPLY::ply_get_property (ply, elemName, &faceProps[0]);
@@ -310,11 +320,13 @@ int vtkPLYReader::RequestData(
         //grab and element from the file
         face.verts = verts;
         vtkPLY::ply_get_element (ply, (void *) &face);
+        vtkIdType* cell = connectivity->WritePointer(size, face.nverts + 1);
+        size += face.nverts + 1;
+        cell[0] = face.nverts;
         for (int k=0; k < face.nverts; k++)
           {
-          vtkVerts[k] = face.verts[k];
+          cell[k+1] = face.verts[k];
           }
-        polys->InsertNextCell(face.nverts,vtkVerts);
         if ( intensityAvailable )
           {
           intensity->SetValue(j,face.intensity);
@@ -326,6 +338,8 @@ int vtkPLYReader::RequestData(
           RGBCells->SetValue(3*j+2,face.blue);
           }
         }
+      polys->SetCells(numPolys, connectivity);
+      connectivity->Delete();
       output->SetPolys(polys);
       polys->Delete();
       }//if face
@@ -20,6 +20,7 @@
 #include "vtkAppendCompositeDataLeaves.h"
 #include "vtkCharArray.h"
 #include "vtkCollection.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDirectory.h"
 #include "vtkDoubleArray.h"
@@ -29,12 +30,15 @@
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPOpenFOAMReader);
 vtkCxxSetObjectMacro(vtkPOpenFOAMReader, Controller, vtkMultiProcessController);
 
@@ -296,6 +300,37 @@ int vtkPOpenFOAMReader::RequestInformation(vtkInformation *request,
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+// The reader instances of the processor subdirectories updated on
+// several threads.  Each thread takes the next reader until none is left.
+struct vtkPOpenFOAMReaderJobs
+{
+  std::vector<vtkOpenFOAMReader *> Readers;
+  size_t Next;
+  vtkSimpleCriticalSection Lock;
+};
+
+//-----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkPOpenFOAMReaderUpdateReaders(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+      static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkPOpenFOAMReaderJobs *jobs =
+      static_cast<vtkPOpenFOAMReaderJobs *>(info->UserData);
+  for (;;)
+    {
+    jobs->Lock.Lock();
+    const size_t readerI = jobs->Next++;
+    jobs->Lock.Unlock();
+    if (readerI >= jobs->Readers.size())
+      {
+      break;
+      }
+    jobs->Readers[readerI]->Update();
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //-----------------------------------------------------------------------------
 int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     vtkInformationVector **inputVector, vtkInformationVector *outputVector)
@@ -337,6 +372,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     // append->AppendFieldDataOn();
 
     vtkOpenFOAMReader *reader;
+    vtkPOpenFOAMReaderJobs jobs;
     this->Superclass::CurrentReaderIndex = 0;
     this->Superclass::Readers->InitTraversal();
     while ((reader
@@ -354,11 +390,31 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
       if (reader->MakeMetaDataAtTimeStep(false))
         {
         append->AddInputConnection(reader->GetOutputPort());
+        jobs.Readers.push_back(reader);
         }
       }
 
     this->GatherMetaData();
 
+    // parse the processor subdirectories of this process on several
+    // threads.  The appender then finds the reader instances up to date.
+    int numberOfThreads = this->Superclass::NumberOfThreads;
+    if (numberOfThreads > static_cast<int>(jobs.Readers.size()))
+      {
+      numberOfThreads = static_cast<int>(jobs.Readers.size());
+      }
+    if (numberOfThreads > 1)
+      {
+      jobs.Next = 0;
+      this->Superclass::UpdatingOnThreads = true;
+      vtkMultiThreader *threader = vtkMultiThreader::New();
+      threader->SetNumberOfThreads(numberOfThreads);
+      threader->SetSingleMethod(vtkPOpenFOAMReaderUpdateReaders, &jobs);
+      threader->SingleMethodExecute();
+      threader->Delete();
+      this->Superclass::UpdatingOnThreads = false;
+      }
+
     if (append->GetNumberOfInputConnections(0) == 0)
       {
       output->Initialize();
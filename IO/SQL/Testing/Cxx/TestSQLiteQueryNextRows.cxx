@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSQLiteQueryNextRows.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that a table written with vtkTableToSQLiteWriter is read back
+// in batches of rows by vtkRowQueryToTable, vtkSQLiteToTableReader and
+// vtkSQLiteQuery::NextRows, including 64 bit integers and text that needs
+// quoting.
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkRowQueryToTable.h"
+#include "vtkSmartPointer.h"
+#include "vtkSQLiteDatabase.h"
+#include "vtkSQLiteQuery.h"
+#include "vtkSQLiteToTableReader.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTableToSQLiteWriter.h"
+#include "vtkTypeInt64Array.h"
+
+#include <vtksys/ios/sstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// More rows than in a batch of vtkRowQueryToTable.
+const vtkIdType Rows = 2500;
+
+vtkStdString Name(vtkIdType row)
+{
+  vtksys_ios::ostringstream name;
+  name << "row '" << row << "'";
+  return name.str();
+}
+
+int CheckTable(vtkTable* table, const char* reader)
+{
+  vtkIntArray* ids = vtkIntArray::SafeDownCast(table->GetColumn(0));
+  // vtkRowQueryToTable reads SQLite reals as floats.
+  vtkDataArray* values = vtkDataArray::SafeDownCast(table->GetColumn(1));
+  vtkStringArray* names = vtkStringArray::SafeDownCast(table->GetColumn(2));
+  TEST_ASSERT(ids && values && names &&
+              table->GetNumberOfRows() == Rows,
+              "Wrong columns or number of rows read by " << reader);
+  for (vtkIdType i = 0; i < Rows; i++)
+    {
+    TEST_ASSERT(ids->GetValue(i) == i && values->GetTuple1(i) == i * 0.25 &&
+                names->GetValue(i) == Name(i),
+                "Wrong row " << i << " read by " << reader);
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int TestSQLiteQueryNextRows(int, char*[])
+{
+  vtkNew<vtkTable> table;
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("id");
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("value");
+  vtkNew<vtkStringArray> names;
+  names->SetName("name");
+  vtkNew<vtkTypeInt64Array> large;
+  large->SetName("large");
+  for (vtkIdType i = 0; i < Rows; i++)
+    {
+    ids->InsertNextValue(static_cast<int>(i));
+    values->InsertNextValue(i * 0.25);
+    names->InsertNextValue(Name(i));
+    large->InsertNextValue((static_cast<vtkTypeInt64>(1) << 40) + i);
+    }
+  table->AddColumn(ids.GetPointer());
+  table->AddColumn(values.GetPointer());
+  table->AddColumn(names.GetPointer());
+  table->AddColumn(large.GetPointer());
+
+  vtkSQLiteDatabase* db = vtkSQLiteDatabase::SafeDownCast(
+    vtkSQLDatabase::CreateFromURL("sqlite://:memory:"));
+  TEST_ASSERT(db && db->Open("", vtkSQLiteDatabase::CREATE),
+              "Could not open an in-memory database");
+
+  vtkNew<vtkTableToSQLiteWriter> writer;
+  writer->SetInputData(table.GetPointer());
+  writer->SetDatabase(db);
+  writer->SetTableName("rows");
+  writer->Update();
+
+  vtkSmartPointer<vtkSQLiteQuery> query;
+  query.TakeReference(
+    vtkSQLiteQuery::SafeDownCast(db->GetQueryInstance()));
+  query->SetQuery("SELECT id, value, name FROM rows");
+  vtkNew<vtkRowQueryToTable> queryToTable;
+  queryToTable->SetQuery(query);
+  queryToTable->Update();
+  if (CheckTable(queryToTable->GetOutput(), "vtkRowQueryToTable") !=
+      EXIT_SUCCESS)
+    {
+    db->Delete();
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkSQLiteToTableReader> reader;
+  reader->SetDatabase(db);
+  reader->SetTableName("rows");
+  reader->Update();
+  if (CheckTable(reader->GetOutput(), "vtkSQLiteToTableReader") !=
+      EXIT_SUCCESS)
+    {
+    db->Delete();
+    return EXIT_FAILURE;
+    }
+
+  // 64 bit integers in batches that do not divide the number of rows.
+  vtkNew<vtkTable> fetched;
+  vtkNew<vtkTypeInt64Array> fetchedLarge;
+  fetched->AddColumn(fetchedLarge.GetPointer());
+  query->SetQuery("SELECT large FROM rows");
+  query->Execute();
+  vtkIdType rows;
+  vtkIdType batches = 0;
+  do
+    {
+    rows = query->NextRows(fetched.GetPointer(), 700);
+    batches++;
+    }
+  while (rows == 700);
+  db->Delete();
+  TEST_ASSERT(batches == 4 && fetchedLarge->GetNumberOfTuples() == Rows,
+              "Fetched " << fetchedLarge->GetNumberOfTuples() << " rows in "
+              << batches << " batches");
+  for (vtkIdType i = 0; i < Rows; i++)
+    {
+    TEST_ASSERT(fetchedLarge->GetValue(i) ==
+                (static_cast<vtkTypeInt64>(1) << 40) + i,
+                "Wrong 64 bit integer in row " << i);
+    }
+  return EXIT_SUCCESS;
+}
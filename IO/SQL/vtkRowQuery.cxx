@@ -21,6 +21,7 @@
 
 #include "vtkObjectFactory.h"
 #include "vtkStdString.h"
+#include "vtkTable.h"
 #include "vtksys/stl/algorithm"
 #include "vtkVariantArray.h"
 
@@ -99,3 +100,22 @@ bool vtkRowQuery::NextRow(vtkVariantArray* rowArray)
   return true;
 }
 
+vtkIdType vtkRowQuery::NextRows(vtkTable* table, vtkIdType maxRows)
+{
+  if (table->GetNumberOfColumns() != this->GetNumberOfFields())
+    {
+    vtkErrorMacro("NextRows(): The table has "
+                  << table->GetNumberOfColumns() << " columns for "
+                  << this->GetNumberOfFields() << " fields.");
+    return 0;
+    }
+  vtkIdType rows = 0;
+  vtkVariantArray* rowArray = vtkVariantArray::New();
+  while (rows < maxRows && this->NextRow(rowArray))
+    {
+    table->InsertNextRow(rowArray);
+    rows++;
+    }
+  rowArray->Delete();
+  return rows;
+}
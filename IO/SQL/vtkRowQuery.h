@@ -40,6 +40,10 @@
 //
 // DataValue() - Extract a single data value from the current row.
 //
+// NextRows() - Append the values of a batch of rows to the columns of a
+//              table.  Subclasses may override it to convert the values
+//              into the columns without going through vtkVariant.
+//
 // .SECTION Thanks
 // Thanks to Andrew Wilson from Sandia National Laboratories for his work
 // on the database classes.
@@ -53,6 +57,7 @@
 #include "vtkIOSQLModule.h" // For export macro
 #include "vtkObject.h"
 
+class vtkTable;
 class vtkVariant;
 class vtkVariantArray;
 
@@ -101,6 +106,14 @@ public:
   // Also, fill array with row values.
   bool NextRow(vtkVariantArray* rowArray);
 
+  // Description:
+  // Advance over at most maxRows rows and append their values to the
+  // columns of table, which has one column per field.  Returns the number
+  // of rows appended, which is less than maxRows only at the end of the
+  // results or on error.  The default implementation appends each row
+  // filled by NextRow(vtkVariantArray*).
+  virtual vtkIdType NextRows(vtkTable* table, vtkIdType maxRows);
+
   // Description:
   // Return data in current row, field c
   virtual vtkVariant DataValue(vtkIdType c) = 0;
@@ -26,8 +26,6 @@
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkTypeUInt64Array.h"
-#include "vtkVariant.h"
-#include "vtkVariantArray.h"
 
 #include <vtksys/ios/sstream>
 
@@ -140,24 +138,21 @@ int vtkRowQueryToTable::RequestData(
     arr->Delete();
     }
 
-  // Fill the table
-  int numRows = 0;
-  float progressGuess = 0;
-  vtkVariantArray* rowArray = vtkVariantArray::New();
-  while (this->Query->NextRow(rowArray))
+  // Fill the table a batch of rows at a time, so that the query can
+  // append the values of each field to its column at once.  A short
+  // batch is the last one.
+  const vtkIdType batchSize = 1000;
+  vtkIdType numRows = 0;
+  vtkIdType rows;
+  do
     {
-    output->InsertNextRow(rowArray);
+    rows = this->Query->NextRows(output, batchSize);
 
-    // Update progress every 100 rows
-    numRows++;
-    if ((numRows%100)==0)
-      {
-      // 1% for every 100 rows, and then 'spin around'
-      progressGuess = ((numRows/100)%100)*.01;
-      this->UpdateProgress(progressGuess);
-      }
+    // 1% for every 100 rows, and then 'spin around'
+    numRows += rows;
+    this->UpdateProgress(((numRows/100)%100)*.01);
     }
-  rowArray->Delete();
+  while (rows == batchSize);
 
   return 1;
 }
@@ -19,9 +19,11 @@
 -------------------------------------------------------------------------*/
 #include "vtkSQLiteQuery.h"
 
+#include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkSQLiteDatabase.h"
 #include "vtkStringArray.h"
+#include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
@@ -350,6 +352,130 @@ bool vtkSQLiteQuery::NextRow()
     }
 }
 
+// ----------------------------------------------------------------------
+// The values fetched for a column of a table before they are appended to
+// it.  Integers are kept as 64 bit values and converted to the type of
+// the column when they are appended.
+struct vtkSQLiteQueryColumn
+{
+  vtkDataArray *Data;
+  vtkStringArray *Strings;
+  bool Real;
+  vtksys_stl::vector<vtkTypeInt64> Integers;
+  vtksys_stl::vector<double> Reals;
+};
+
+// ----------------------------------------------------------------------
+template <class T, class S>
+static void vtkSQLiteQueryAppend(vtkDataArray *array, T *,
+                                 const vtksys_stl::vector<S> &values)
+{
+  if (values.empty())
+    {
+    return;
+    }
+  T *out = static_cast<T *>(array->WriteVoidPointer(
+    array->GetNumberOfTuples(), static_cast<vtkIdType>(values.size())));
+  for (size_t i = 0; i < values.size(); ++i)
+    {
+    out[i] = static_cast<T>(values[i]);
+    }
+}
+
+// ----------------------------------------------------------------------
+vtkIdType vtkSQLiteQuery::NextRows(vtkTable *table, vtkIdType maxRows)
+{
+  if (! this->IsActive())
+    {
+    vtkErrorMacro(<<"NextRows(): Query is not active!");
+    return 0;
+    }
+
+  int numberOfFields = this->GetNumberOfFields();
+  if (table->GetNumberOfColumns() != numberOfFields)
+    {
+    return this->Superclass::NextRows(table, maxRows);
+    }
+  vtksys_stl::vector<vtkSQLiteQueryColumn> columns(numberOfFields);
+  for (int c = 0; c < numberOfFields; ++c)
+    {
+    vtkAbstractArray *array = table->GetColumn(c);
+    columns[c].Data = vtkDataArray::SafeDownCast(array);
+    columns[c].Strings = vtkStringArray::SafeDownCast(array);
+    if ((!columns[c].Data && !columns[c].Strings) ||
+        array->GetNumberOfComponents() != 1 ||
+        array->GetDataType() == VTK_BIT)
+      {
+      return this->Superclass::NextRows(table, maxRows);
+      }
+    columns[c].Real = array->GetDataType() == VTK_FLOAT ||
+      array->GetDataType() == VTK_DOUBLE;
+    }
+
+  vtkIdType rows = 0;
+  while (rows < maxRows && this->NextRow())
+    {
+    for (int c = 0; c < numberOfFields; ++c)
+      {
+      vtkSQLiteQueryColumn &column = columns[c];
+      if (column.Strings)
+        {
+        int type = vtk_sqlite3_column_type(this->Statement, c);
+        if (type == VTK_SQLITE_TEXT || type == VTK_SQLITE_BLOB)
+          {
+          // BLOBs keep all of their bytes, as in DataValue().
+          const void *value = type == VTK_SQLITE_TEXT ?
+            static_cast<const void *>(
+              vtk_sqlite3_column_text(this->Statement, c)) :
+            vtk_sqlite3_column_blob(this->Statement, c);
+          int length = vtk_sqlite3_column_bytes(this->Statement, c);
+          column.Strings->InsertNextValue(value ?
+            vtkStdString(static_cast<const char *>(value), length) :
+            vtkStdString());
+          }
+        else
+          {
+          column.Strings->InsertNextValue(this->DataValue(c).ToString());
+          }
+        }
+      else if (column.Real)
+        {
+        column.Reals.push_back(vtk_sqlite3_column_double(this->Statement, c));
+        }
+      else
+        {
+        column.Integers.push_back(
+          vtk_sqlite3_column_int64(this->Statement, c));
+        }
+      }
+    ++rows;
+    }
+
+  for (int c = 0; c < numberOfFields; ++c)
+    {
+    vtkSQLiteQueryColumn &column = columns[c];
+    if (!column.Data)
+      {
+      continue;
+      }
+    switch (column.Data->GetDataType())
+      {
+      vtkTemplateMacro(
+        if (column.Real)
+          {
+          vtkSQLiteQueryAppend(column.Data, static_cast<VTK_TT *>(0),
+                               column.Reals);
+          }
+        else
+          {
+          vtkSQLiteQueryAppend(column.Data, static_cast<VTK_TT *>(0),
+                               column.Integers);
+          });
+      }
+    }
+  return rows;
+}
+
 // ----------------------------------------------------------------------
 vtkVariant vtkSQLiteQuery::DataValue(vtkIdType column)
 {
@@ -678,7 +804,7 @@ bool vtkSQLiteQuery::BindInt64Parameter(int index, vtkTypeInt64 value)
     this->Active = false;
     vtk_sqlite3_reset(this->Statement);
     }
-  int status = vtk_sqlite3_bind_int(this->Statement, index+1, static_cast<vtk_sqlite_int64>(value));
+  int status = vtk_sqlite3_bind_int64(this->Statement, index+1, static_cast<vtk_sqlite_int64>(value));
 
   if (status != VTK_SQLITE_OK)
     {
@@ -45,6 +45,7 @@
 #include "vtkSQLQuery.h"
 
 class vtkSQLiteDatabase;
+class vtkTable;
 class vtkVariant;
 class vtkVariantArray;
 struct vtk_sqlite3_stmt;
@@ -87,6 +88,14 @@ public:
   // Advance row, return false if past end.
   bool NextRow();
 
+  // Description:
+  // Append the values of at most maxRows rows to the columns of table.
+  // The values of vtkDataArray columns are gathered as integers or
+  // doubles from SQLite and appended to each column at once, and text is
+  // appended straight to vtkStringArray columns.  Tables with other
+  // columns are filled as by vtkRowQuery.
+  vtkIdType NextRows(vtkTable* table, vtkIdType maxRows);
+
   // Description:
   // Return true if there is an error on the current query.
   bool HasError();
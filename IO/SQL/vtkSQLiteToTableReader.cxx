@@ -85,12 +85,10 @@ int vtkSQLiteToTableReader::RequestData(vtkInformation *,
     }
 
   //use the results of the query to create columns of the proper name & type
-  std::vector<std::string> columnTypes;
   while(query->NextRow())
     {
     std::string columnName = query->DataValue(1).ToString();
     std::string columnType = query->DataValue(2).ToString();
-    columnTypes.push_back(columnType);
     if(columnType == "INTEGER")
       {
       vtkSmartPointer<vtkIntArray> column =
@@ -123,31 +121,15 @@ int vtkSQLiteToTableReader::RequestData(vtkInformation *,
     vtkErrorMacro(<<"Error performing 'select all' query");
     }
 
-  //use the results of the query to populate the columns
-  while(query->NextRow())
+  //use the results of the query to populate the columns, a batch of rows
+  //at a time; a short batch is the last one
+  const vtkIdType batchSize = 1000;
+  vtkIdType rows;
+  do
     {
-    for(int col = 0; col < query->GetNumberOfFields(); ++ col)
-      {
-      if(columnTypes[col] == "INTEGER")
-        {
-        vtkIntArray *column =
-          static_cast<vtkIntArray*>(output->GetColumn(col));
-        column->InsertNextValue(query->DataValue(col).ToInt());
-        }
-      else if(columnTypes[col] == "REAL")
-        {
-        vtkDoubleArray *column =
-          static_cast<vtkDoubleArray*>(output->GetColumn(col));
-        column->InsertNextValue(query->DataValue(col).ToDouble());
-        }
-      else
-        {
-        vtkStringArray *column =
-          static_cast<vtkStringArray*>(output->GetColumn(col));
-        column->InsertNextValue(query->DataValue(col).ToString());
-        }
-      }
+    rows = query->NextRows(output, batchSize);
     }
+  while(rows == batchSize);
 
   query->Delete();
   return 1;
@@ -13,11 +13,13 @@
 
 =========================================================================*/
 #include "vtkAbstractArray.h"
+#include "vtkDataArray.h"
 #include "vtkInformation.h"
 #include "vtkObjectFactory.h"
 #include "vtkSQLiteDatabase.h"
 #include "vtkSQLiteQuery.h"
 #include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 
@@ -37,6 +39,38 @@ vtkTableToSQLiteWriter::~vtkTableToSQLiteWriter()
 {
 }
 
+//----------------------------------------------------------------------------
+// Bind the value of a row of a column to a parameter of the insert query,
+// as an integer or a double for numbers and as text otherwise.
+static bool vtkTableToSQLiteWriterBind(vtkSQLiteQuery *query, int column,
+                                       vtkTable *table, vtkIdType row)
+{
+  vtkAbstractArray *array = table->GetColumn(column);
+  vtkDataArray *data = vtkDataArray::SafeDownCast(array);
+  vtkStringArray *strings = vtkStringArray::SafeDownCast(array);
+  if(data && data->GetNumberOfComponents() == 1 &&
+     data->GetDataType() != VTK_BIT)
+    {
+    if(data->GetDataType() == VTK_FLOAT || data->GetDataType() == VTK_DOUBLE)
+      {
+      return query->BindParameter(column, data->GetTuple1(row));
+      }
+    switch(data->GetDataType())
+      {
+      vtkTemplateMacro(
+        return query->BindParameter(column, static_cast<vtkTypeInt64>(
+          static_cast<VTK_TT*>(data->GetVoidPointer(0))[row])));
+      }
+    }
+  if(strings && strings->GetNumberOfComponents() == 1)
+    {
+    const vtkStdString &value = strings->GetValue(row);
+    return query->BindParameter(column, value.c_str(), value.size());
+    }
+  vtkStdString value = table->GetValue(row, column).ToString();
+  return query->BindParameter(column, value.c_str(), value.size());
+}
+
 //----------------------------------------------------------------------------
 void vtkTableToSQLiteWriter::WriteData()
 {
@@ -117,27 +151,32 @@ void vtkTableToSQLiteWriter::WriteData()
     vtkErrorMacro(<<"Error performing 'create table' query");
     }
 
-  //iterate over the rows of the vtkTable to complete the insert query
-  int numRows = this->GetInput()->GetNumberOfRows();
-  for(int i = 0; i < numRows; i++)
+  //insert the rows with a statement that is prepared once, binding the
+  //values of each row, in a single transaction
+  for(int j = 0; j < numColumns; j++)
+    {
+    insertPreamble += (j < numColumns - 1) ? "?, " : "?);";
+    }
+  vtkTable *input = this->GetInput();
+  vtkIdType numRows = input->GetNumberOfRows();
+  query->BeginTransaction();
+  if(!query->SetQuery(insertPreamble.c_str()))
+    {
+    vtkErrorMacro(<<"Error preparing 'insert' query");
+    numRows = 0;
+    }
+  for(vtkIdType i = 0; i < numRows; i++)
     {
-    std::string insertQuery = insertPreamble;
     for (int j = 0; j < numColumns; j++)
       {
-      insertQuery += "'" + this->GetInput()->GetValue(i, j).ToString() + "'";
-      if(j < numColumns - 1)
-        {
-        insertQuery += ", ";
-        }
+      vtkTableToSQLiteWriterBind(query, j, input, i);
       }
-    insertQuery += ");";
-    //perform the insert query for this row
-    query->SetQuery(insertQuery.c_str());
     if(!query->Execute())
       {
       vtkErrorMacro(<<"Error performing 'insert' query");
       }
     }
+  query->CommitTransaction();
 
   //cleanup and return
   query->Delete();
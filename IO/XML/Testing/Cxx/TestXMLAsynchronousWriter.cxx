@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLAsynchronousWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the asynchronous writes save the input as it was when
+// Write() was called, report their completion and their errors, and
+// respect the limits of the queue.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLPPolyDataReader.h"
+#include "vtkXMLPPolyDataWriter.h"
+
+#include <string>
+#include <vector>
+#include <vtksys/ios/sstream>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+void RecordFileName(vtkObject*, unsigned long, void* clientData,
+                    void* callData)
+{
+  std::vector<std::string>* files =
+    static_cast<std::vector<std::string>*>(clientData);
+  files->push_back(static_cast<const char*>(callData));
+}
+
+std::string StepFileName(int step)
+{
+  vtksys_ios::ostringstream name;
+  name << "TestXMLAsynchronousWriter_" << step << ".vti";
+  return name.str();
+}
+}
+
+int TestXMLAsynchronousWriter(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  source->Update();
+  vtkNew<vtkImageData> image;
+  image->DeepCopy(source->GetOutput());
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+
+  std::vector<std::string> files;
+  vtkNew<vtkCallbackCommand> observer;
+  observer->SetCallback(RecordFileName);
+  observer->SetClientData(&files);
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image.GetPointer());
+  writer->AsynchronousOn();
+  writer->SetMaximumNumberOfPendingWrites(2);
+  writer->AddObserver(vtkCommand::EndEvent, observer.GetPointer());
+
+  // Change the values in place after each write, as a simulation does.
+  const int numberOfSteps = 5;
+  std::vector<vtkSmartPointer<vtkDataArray> > expected;
+  for (int step = 0; step < numberOfSteps; step++)
+    {
+    expected.push_back(vtkSmartPointer<vtkDataArray>::Take(
+                         scalars->NewInstance()));
+    expected.back()->DeepCopy(scalars);
+    if (step == 3)
+      {
+      // A budget smaller than one copy writes one file at a time.
+      writer->SetMaximumPendingWriteMemory(1);
+      }
+    writer->SetFileName(StepFileName(step).c_str());
+    TEST_ASSERT(writer->Write(), "Cannot queue step " << step);
+    TEST_ASSERT(writer->CheckPendingWrites() <= (step < 3 ? 2 : 1),
+                "Too many pending writes");
+    for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); i++)
+      {
+      scalars->SetTuple1(i, scalars->GetTuple1(i) + 1);
+      }
+    image->Modified();
+    }
+  TEST_ASSERT(writer->WaitForPendingWrites(), "Expected the writes to succeed");
+  TEST_ASSERT(writer->CheckPendingWrites() == 0, "Expected no pending write");
+  TEST_ASSERT(static_cast<int>(files.size()) == numberOfSteps,
+              "Expected " << numberOfSteps << " completion events, got "
+              << files.size());
+
+  for (int step = 0; step < numberOfSteps; step++)
+    {
+    TEST_ASSERT(files[step] == StepFileName(step),
+                "Expected the writes to complete in order");
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName(files[step].c_str());
+    reader->Update();
+    vtkDataArray* read = reader->GetOutput()->GetPointData()->GetScalars();
+    TEST_ASSERT(read && read->GetNumberOfTuples() ==
+                expected[step]->GetNumberOfTuples(),
+                "Cannot read step " << step);
+    for (vtkIdType i = 0; i < read->GetNumberOfTuples(); i++)
+      {
+      TEST_ASSERT(read->GetTuple1(i) == expected[step]->GetTuple1(i),
+                  "Wrong value " << i << " in step " << step);
+      }
+    }
+
+  // A failed write is reported when it completes.
+  vtkObject::GlobalWarningDisplayOff();
+  writer->SetFileName("TestXMLAsynchronousWriterMissingDir/missing.vti");
+  TEST_ASSERT(writer->Write(), "Cannot queue the write");
+  TEST_ASSERT(!writer->WaitForPendingWrites(),
+              "Expected the write in a missing directory to fail");
+  vtkObject::GlobalWarningDisplayOn();
+
+  // A partitioned polydata written one piece at a time in the
+  // background, as each process of a simulation does.
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkXMLPPolyDataWriter> pWriter;
+  pWriter->SetInputConnection(sphere->GetOutputPort());
+  pWriter->SetFileName("TestXMLAsynchronousWriter.pvtp");
+  pWriter->SetNumberOfPieces(2);
+  pWriter->AsynchronousOn();
+  for (int piece = 0; piece < 2; piece++)
+    {
+    pWriter->SetStartPiece(piece);
+    pWriter->SetEndPiece(piece);
+    pWriter->SetWriteSummaryFile(piece == 0);
+    TEST_ASSERT(pWriter->Write(), "Cannot queue piece " << piece);
+    }
+  TEST_ASSERT(pWriter->WaitForPendingWrites(), "Cannot write the polydata");
+  vtkNew<vtkSphereSource> wholeSphere;
+  wholeSphere->Update();
+  vtkNew<vtkXMLPPolyDataReader> pReader;
+  pReader->SetFileName("TestXMLAsynchronousWriter.pvtp");
+  pReader->Update();
+  TEST_ASSERT(pReader->GetOutput()->GetNumberOfCells() ==
+              wholeSphere->GetOutput()->GetNumberOfCells(),
+              "Expected " << wholeSphere->GetOutput()->GetNumberOfCells()
+              << " cells, read " << pReader->GetOutput()->GetNumberOfCells());
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLBlockIndex.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that a multiblock written with a block index is read with
+// the blocks outside of the bounds or value range filters left empty and
+// their files not opened.
+
+#include "vtkDoubleArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Return a bit for each block read.
+int ReadBlocks(vtkXMLMultiBlockDataReader* reader)
+{
+  reader->Update();
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput());
+  int blocks = 0;
+  for (unsigned int i = 0; output && i < output->GetNumberOfBlocks(); i++)
+    {
+    vtkPolyData* block = vtkPolyData::SafeDownCast(output->GetBlock(i));
+    if (block && block->GetNumberOfCells() > 0)
+      {
+      blocks |= 1 << i;
+      }
+    }
+  return blocks;
+}
+}
+
+int TestXMLBlockIndex(int, char*[])
+{
+  // Six spheres along x, each with a constant array holding its index.
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  vtkNew<vtkSphereSource> sphere;
+  for (unsigned int i = 0; i < 6; i++)
+    {
+    sphere->SetCenter(3 * i, 0, 0);
+    sphere->Update();
+    vtkNew<vtkPolyData> block;
+    block->DeepCopy(sphere->GetOutput());
+    vtkNew<vtkDoubleArray> index;
+    index->SetName("Index");
+    for (vtkIdType j = 0; j < block->GetNumberOfPoints(); j++)
+      {
+      index->InsertNextValue(i);
+      }
+    block->GetPointData()->AddArray(index.GetPointer());
+    blocks->SetBlock(i, block.GetPointer());
+    }
+  vtkNew<vtkXMLMultiBlockDataWriter> writer;
+  writer->SetInputData(blocks.GetPointer());
+  writer->SetFileName("TestXMLBlockIndex.vtm");
+  writer->WriteBlockIndexOn();
+  TEST_ASSERT(writer->Write(), "Cannot write the multiblock");
+
+  vtkNew<vtkXMLMultiBlockDataReader> reader;
+  reader->SetFileName("TestXMLBlockIndex.vtm");
+  TEST_ASSERT(ReadBlocks(reader.GetPointer()) == 0x3f,
+              "Expected all the blocks without a filter");
+
+  // The spheres centered at x = 3 and 6 cross the region.
+  reader->SetBoundsFilter(3, 8, -1, 1, -1, 1);
+  TEST_ASSERT(ReadBlocks(reader.GetPointer()) == 0x06,
+              "Expected blocks 1 and 2 in the bounds");
+
+  // The spheres with an index of 4 and 5.
+  reader->SetBoundsFilter(1, -1, 1, -1, 1, -1);
+  reader->SetValueRangeFilterArrayName("Index");
+  reader->SetValueRangeFilter(3.5, 10);
+  TEST_ASSERT(ReadBlocks(reader.GetPointer()) == 0x30,
+              "Expected blocks 4 and 5 in the value range");
+
+  // The files of the blocks left out are not opened.
+  vtksys::SystemTools::RemoveFile("TestXMLBlockIndex/TestXMLBlockIndex_0.vtp");
+  vtkNew<vtkXMLMultiBlockDataReader> filteredReader;
+  filteredReader->SetFileName("TestXMLBlockIndex.vtm");
+  filteredReader->SetValueRangeFilterArrayName("Index");
+  filteredReader->SetValueRangeFilter(0.5, 10);
+  TEST_ASSERT(ReadBlocks(filteredReader.GetPointer()) == 0x3e,
+              "Expected blocks 1 to 5 in the value range");
+
+  return EXIT_SUCCESS;
+}
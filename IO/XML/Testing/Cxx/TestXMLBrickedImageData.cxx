@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLBrickedImageData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that an image written in bricks records the extent and the
+// range of each brick, and that a sub-extent and a value range are read
+// back correctly from the bricks.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+int TestXMLBrickedImageData(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 63, 0, 63, 0, 40);
+  source->Update();
+  vtkNew<vtkImageData> image;
+  image->ShallowCopy(source->GetOutput());
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image.GetPointer());
+  writer->SetFileName("TestXMLBrickedImageData.vti");
+  writer->SetBrickDimensions(16, 16, 16);
+  TEST_ASSERT(writer->Write(), "Cannot write the image");
+  TEST_ASSERT(writer->GetNumberOfPieces() == 48,
+              "Expected 48 bricks, got " << writer->GetNumberOfPieces());
+
+  // The bricks cover the image and record the range of their values.
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName("TestXMLBrickedImageData.vti");
+  reader->UpdateInformation();
+  TEST_ASSERT(reader->GetNumberOfPieces() == 48,
+              "Expected 48 pieces in the file, got "
+              << reader->GetNumberOfPieces());
+  for (int piece = 0; piece < reader->GetNumberOfPieces(); piece++)
+    {
+    int extent[6];
+    double range[2];
+    TEST_ASSERT(reader->GetPieceExtent(piece, extent),
+                "No extent for piece " << piece);
+    TEST_ASSERT(reader->GetPieceArrayRange(piece, "RTData", range),
+                "No range for piece " << piece);
+    double expected[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    for (int k = extent[4]; k <= extent[5]; k++)
+      {
+      for (int j = extent[2]; j <= extent[3]; j++)
+        {
+        for (int i = extent[0]; i <= extent[1]; i++)
+          {
+          int ijk[3] = { i, j, k };
+          double value = scalars->GetTuple1(image->ComputePointId(ijk));
+          expected[0] = value < expected[0] ? value : expected[0];
+          expected[1] = value > expected[1] ? value : expected[1];
+          }
+        }
+      }
+    // The range is written with the precision of the float values.
+    TEST_ASSERT(static_cast<float>(range[0]) ==
+                static_cast<float>(expected[0]) &&
+                static_cast<float>(range[1]) ==
+                static_cast<float>(expected[1]),
+                "Wrong range for piece " << piece << ": " << range[0] << " "
+                << range[1] << " instead of " << expected[0] << " "
+                << expected[1]);
+    }
+  double range[2];
+  TEST_ASSERT(!reader->GetPieceArrayRange(0, "Missing", range),
+              "Expected no range for a missing array");
+
+  // A sub-extent crossing several bricks.
+  int voi[6] = { 5, 40, 12, 20, 30, 40 };
+  reader->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), voi, 6);
+  reader->Update();
+  vtkImageData* output = reader->GetOutput();
+  vtkDataArray* read = output->GetPointData()->GetArray("RTData");
+  TEST_ASSERT(read && read->GetNumberOfTuples() == 36 * 9 * 11,
+              "Wrong number of values in the sub-extent");
+  for (int k = voi[4]; k <= voi[5]; k++)
+    {
+    for (int j = voi[2]; j <= voi[3]; j++)
+      {
+      for (int i = voi[0]; i <= voi[1]; i++)
+        {
+        int ijk[3] = { i, j, k };
+        TEST_ASSERT(read->GetTuple1(output->ComputePointId(ijk)) ==
+                    scalars->GetTuple1(image->ComputePointId(ijk)),
+                    "Wrong value at " << i << " " << j << " " << k);
+        }
+      }
+    }
+
+  // The bricks holding the highest values contain all of them.
+  double threshold = 0.9 * scalars->GetRange()[1];
+  int extent[6];
+  TEST_ASSERT(reader->ComputeExtentForValueRange("RTData", threshold,
+                                                 VTK_DOUBLE_MAX, extent),
+              "Expected some bricks above " << threshold);
+  TEST_ASSERT((extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) *
+              (extent[5] - extent[4] + 1) < image->GetNumberOfPoints(),
+              "Expected fewer bricks than the whole image");
+  int* dims = image->GetDimensions();
+  for (vtkIdType id = 0; id < image->GetNumberOfPoints(); id++)
+    {
+    if (scalars->GetTuple1(id) >= threshold)
+      {
+      int ijk[3] = { static_cast<int>(id % dims[0]),
+                     static_cast<int>((id / dims[0]) % dims[1]),
+                     static_cast<int>(id / (dims[0] * dims[1])) };
+      TEST_ASSERT(ijk[0] >= extent[0] && ijk[0] <= extent[1] &&
+                  ijk[1] >= extent[2] && ijk[1] <= extent[3] &&
+                  ijk[2] >= extent[4] && ijk[2] <= extent[5],
+                  "Point " << id << " is outside of the bricks");
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
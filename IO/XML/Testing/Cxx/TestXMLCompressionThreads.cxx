@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressionThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the blocks of compressed data written and read on
+// several threads give the same file and the same data as on one thread,
+// with each compressor of vtkXMLWriter.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+std::string ReadFile(const char* fileName)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+int WriteImage(vtkImageData* image, const char* fileName,
+               int numberOfThreads, int encode, int compressorType)
+{
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetCompressorType(compressorType);
+  writer->SetInputData(image);
+  writer->SetFileName(fileName);
+  writer->SetBlockSize(1024);
+  writer->SetEncodeAppendedData(encode);
+  writer->SetNumberOfThreads(numberOfThreads);
+  return writer->Write();
+}
+
+// Compare the scalars of the image to those of the reference in the
+// extent of the image.
+bool CompareScalars(vtkImageData* image, vtkImageData* reference)
+{
+  int extent[6];
+  image->GetExtent(extent);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkDataArray* referenceScalars = reference->GetPointData()->GetScalars();
+  if (!scalars)
+    {
+    return false;
+    }
+  for (int k = extent[4]; k <= extent[5]; k++)
+    {
+    for (int j = extent[2]; j <= extent[3]; j++)
+      {
+      for (int i = extent[0]; i <= extent[1]; i++)
+        {
+        int ijk[3] = {i, j, k};
+        if (scalars->GetComponent(image->ComputePointId(ijk), 0) !=
+            referenceScalars->GetComponent(reference->ComputePointId(ijk), 0))
+          {
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLCompressionThreads(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  source->Update();
+  vtkImageData* image = source->GetOutput();
+
+  int compressorTypes[] = {vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4};
+  for (int c = 0; c < 2; c++)
+    {
+    // The file does not depend on the number of threads.
+    for (int encode = 0; encode < 2; encode++)
+      {
+      TEST_ASSERT(WriteImage(image, "TestXMLCompressionThreads1.vti", 1,
+                             encode, compressorTypes[c]),
+                  "Cannot write with one thread");
+      TEST_ASSERT(WriteImage(image, "TestXMLCompressionThreads4.vti", 4,
+                             encode, compressorTypes[c]),
+                  "Cannot write with 4 threads");
+      std::string serial = ReadFile("TestXMLCompressionThreads1.vti");
+      std::string threaded = ReadFile("TestXMLCompressionThreads4.vti");
+      TEST_ASSERT(!serial.empty() && serial == threaded,
+                  "Files written with 1 and 4 threads differ");
+      }
+
+    // Reading on several threads gives the original data, in whole or
+    // in part.
+    vtkMultiThreader::SetGlobalDefaultNumberOfThreads(4);
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName("TestXMLCompressionThreads4.vti");
+    reader->Update();
+    TEST_ASSERT(reader->GetOutput()->GetNumberOfPoints() ==
+                image->GetNumberOfPoints() &&
+                CompareScalars(reader->GetOutput(), image),
+                "Wrong data read with 4 threads");
+
+    // A new reader reads only a part of the extent.
+    int extent[6] = {3, 28, 5, 20, 2, 30};
+    vtkNew<vtkXMLImageDataReader> partReader;
+    partReader->SetFileName("TestXMLCompressionThreads4.vti");
+    partReader->UpdateInformation();
+    vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+      partReader->GetOutputInformation(0), extent);
+    partReader->Update();
+    TEST_ASSERT(partReader->GetOutput()->GetNumberOfPoints() == 26*16*29 &&
+                CompareScalars(partReader->GetOutput(), image),
+                "Wrong data read in a part of the extent with 4 threads");
+    vtkMultiThreader::SetGlobalDefaultNumberOfThreads(0);
+    }
+
+  return EXIT_SUCCESS;
+}
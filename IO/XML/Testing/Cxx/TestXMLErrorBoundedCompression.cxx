@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLErrorBoundedCompression.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that the arrays written with vtkErrorBoundedDataCompressor
+// are read back within their tolerance, that the arrays without a
+// tolerance are read back exactly and that the file is smaller than with
+// lossless compression.
+
+#include "vtkDoubleArray.h"
+#include "vtkErrorBoundedDataCompressor.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <math.h>
+#include <string>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+std::string ReadFile(const char* fileName)
+{
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+// Return the largest difference between the arrays, or -1 if their
+// sizes or non finite values differ.
+double MaximumError(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+    {
+    return -1;
+    }
+  double maxError = 0;
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); c++)
+      {
+      double va = a->GetComponent(i, c);
+      double vb = b->GetComponent(i, c);
+      if (vtkMath::IsNan(va) || vtkMath::IsNan(vb) ||
+          vtkMath::IsInf(va) || vtkMath::IsInf(vb))
+        {
+        if (!(vtkMath::IsNan(va) && vtkMath::IsNan(vb)) && va != vb)
+          {
+          return -1;
+          }
+        continue;
+        }
+      maxError = std::max(maxError, fabs(va - vb));
+      }
+    }
+  return maxError;
+}
+}
+
+int TestXMLErrorBoundedCompression(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  source->Update();
+  vtkNew<vtkImageData> image;
+  image->ShallowCopy(source->GetOutput());
+  vtkPointData* pd = image->GetPointData();
+  vtkIdType numberOfPoints = image->GetNumberOfPoints();
+
+  // A float array with non finite values, a smooth double vector field,
+  // an integer array and a float array without tolerance.
+  vtkNew<vtkFloatArray> rtData;
+  rtData->DeepCopy(pd->GetScalars());
+  rtData->SetName("RTData");
+  rtData->SetValue(10, static_cast<float>(vtkMath::Inf()));
+  rtData->SetValue(20, static_cast<float>(vtkMath::Nan()));
+  rtData->SetValue(30, 1e30f);
+  pd->SetScalars(rtData.GetPointer());
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  vtkNew<vtkFloatArray> exact;
+  exact->SetName("Exact");
+  for (vtkIdType i = 0; i < numberOfPoints; i++)
+    {
+    double x[3];
+    image->GetPoint(i, x);
+    vectors->InsertNextTuple3(sin(0.1 * x[0]), cos(0.1 * x[1]), 1e-3 * x[2]);
+    ids->InsertNextValue(static_cast<int>(i * 7));
+    exact->InsertNextValue(static_cast<float>(sqrt(static_cast<double>(i))));
+    }
+  pd->AddArray(vectors.GetPointer());
+  pd->AddArray(ids.GetPointer());
+  pd->AddArray(exact.GetPointer());
+
+  vtkNew<vtkErrorBoundedDataCompressor> compressor;
+  compressor->SetArrayTolerance("RTData", 0.01);
+  compressor->SetArrayTolerance("Vectors", 1e-6);
+
+  for (int encode = 0; encode < 2; encode++)
+    {
+    vtkNew<vtkXMLImageDataWriter> writer;
+    writer->SetInputData(image.GetPointer());
+    writer->SetFileName("TestXMLErrorBoundedCompression.vti");
+    writer->SetEncodeAppendedData(encode);
+    writer->SetCompressor(compressor.GetPointer());
+    TEST_ASSERT(writer->Write(), "Cannot write the image");
+    std::string lossy = ReadFile("TestXMLErrorBoundedCompression.vti");
+    TEST_ASSERT(lossy.find("Tolerance=\"0.01\"") != std::string::npos,
+                "Expected the tolerance to be recorded in the file");
+
+    writer->SetCompressorTypeToZLib();
+    writer->SetFileName("TestXMLErrorBoundedCompressionZLib.vti");
+    TEST_ASSERT(writer->Write(), "Cannot write the image with zlib");
+    std::string lossless = ReadFile("TestXMLErrorBoundedCompressionZLib.vti");
+    cout << "Lossy file: " << lossy.size() << " bytes, lossless file: "
+         << lossless.size() << " bytes" << endl;
+    TEST_ASSERT(lossy.size() < lossless.size(),
+                "Expected the lossy file to be smaller");
+
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->SetFileName("TestXMLErrorBoundedCompression.vti");
+    reader->Update();
+    vtkPointData* outPD = reader->GetOutput()->GetPointData();
+    double error = MaximumError(rtData.GetPointer(), outPD->GetArray("RTData"));
+    TEST_ASSERT(error >= 0 && error <= 0.01,
+                "RTData error " << error << " exceeds the tolerance");
+    error = MaximumError(vectors.GetPointer(), outPD->GetArray("Vectors"));
+    TEST_ASSERT(error >= 0 && error <= 1e-6,
+                "Vectors error " << error << " exceeds the tolerance");
+    TEST_ASSERT(MaximumError(ids.GetPointer(), outPD->GetArray("Ids")) == 0,
+                "Expected the integer array to be exact");
+    TEST_ASSERT(MaximumError(exact.GetPointer(), outPD->GetArray("Exact")) == 0,
+                "Expected the array without tolerance to be exact");
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLParallelPieceReading.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that partitioned and multiblock XML files read on several
+// threads give the same data as when read on one thread.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+#include "vtkXMLPImageDataReader.h"
+#include "vtkXMLPImageDataWriter.h"
+#include "vtkXMLPPolyDataReader.h"
+#include "vtkXMLPPolyDataWriter.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+      a->GetNumberOfTuples() == 0)
+    {
+    return false;
+    }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); i++)
+    {
+    for (int c = 0; c < a->GetNumberOfComponents(); c++)
+      {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  return a && b && a->GetNumberOfCells() == b->GetNumberOfCells() &&
+    SameArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData()) &&
+    SameArrays(a->GetPointData()->GetNormals(),
+               b->GetPointData()->GetNormals());
+}
+}
+
+int TestXMLParallelPieceReading(int, char*[])
+{
+  // An image written in 4 pieces.
+  vtkNew<vtkRTAnalyticSource> image;
+  image->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  vtkNew<vtkXMLPImageDataWriter> imageWriter;
+  imageWriter->SetInputConnection(image->GetOutputPort());
+  imageWriter->SetFileName("TestXMLParallelPieceReading.pvti");
+  imageWriter->SetNumberOfPieces(4);
+  imageWriter->SetStartPiece(0);
+  imageWriter->SetEndPiece(3);
+  TEST_ASSERT(imageWriter->Write(), "Cannot write the image");
+
+  vtkNew<vtkXMLPImageDataReader> imageReader;
+  imageReader->SetFileName("TestXMLParallelPieceReading.pvti");
+  imageReader->Update();
+  vtkNew<vtkImageData> serialImage;
+  serialImage->ShallowCopy(imageReader->GetOutput());
+
+  vtkNew<vtkXMLPImageDataReader> parallelImageReader;
+  parallelImageReader->SetFileName("TestXMLParallelPieceReading.pvti");
+  parallelImageReader->SetNumberOfThreads(4);
+  parallelImageReader->Update();
+  TEST_ASSERT(SameArrays(serialImage->GetPointData()->GetArray("RTData"),
+                         parallelImageReader->GetOutput()->GetPointData()
+                         ->GetArray("RTData")),
+              "Expected the same image on 1 and 4 threads");
+
+  // A sub-extent spanning all pieces, read with a new reader since a
+  // smaller extent does not execute the first one again.
+  vtkNew<vtkXMLPImageDataReader> extentReader;
+  extentReader->SetFileName("TestXMLParallelPieceReading.pvti");
+  extentReader->SetNumberOfThreads(4);
+  extentReader->UpdateInformation();
+  extentReader->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), 5, 25, 3, 28, 7, 20);
+  extentReader->Update();
+  image->UpdateInformation();
+  image->GetOutputInformation(0)->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), 5, 25, 3, 28, 7, 20);
+  image->Update();
+  TEST_ASSERT(SameArrays(image->GetOutput()->GetPointData()->GetScalars(),
+                         extentReader->GetOutput()->GetPointData()
+                         ->GetArray("RTData")),
+              "Expected the same sub-extent on 4 threads");
+
+  // A polydata written in 4 pieces.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkXMLPPolyDataWriter> polyWriter;
+  polyWriter->SetInputConnection(sphere->GetOutputPort());
+  polyWriter->SetFileName("TestXMLParallelPieceReading.pvtp");
+  polyWriter->SetNumberOfPieces(4);
+  polyWriter->SetStartPiece(0);
+  polyWriter->SetEndPiece(3);
+  TEST_ASSERT(polyWriter->Write(), "Cannot write the polydata");
+
+  vtkNew<vtkXMLPPolyDataReader> polyReader;
+  polyReader->SetFileName("TestXMLParallelPieceReading.pvtp");
+  polyReader->Update();
+  vtkNew<vtkXMLPPolyDataReader> parallelPolyReader;
+  parallelPolyReader->SetFileName("TestXMLParallelPieceReading.pvtp");
+  parallelPolyReader->SetNumberOfThreads(4);
+  parallelPolyReader->Update();
+  TEST_ASSERT(SamePolyData(polyReader->GetOutput(),
+                           parallelPolyReader->GetOutput()),
+              "Expected the same polydata on 1 and 4 threads");
+
+  // A multiblock of 5 spheres.
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  for (unsigned int i = 0; i < 5; i++)
+    {
+    sphere->SetCenter(i, 0, 0);
+    sphere->Update();
+    vtkNew<vtkPolyData> block;
+    block->DeepCopy(sphere->GetOutput());
+    blocks->SetBlock(i, block.GetPointer());
+    }
+  vtkNew<vtkXMLMultiBlockDataWriter> blockWriter;
+  blockWriter->SetInputData(blocks.GetPointer());
+  blockWriter->SetFileName("TestXMLParallelPieceReading.vtm");
+  TEST_ASSERT(blockWriter->Write(), "Cannot write the multiblock");
+
+  vtkNew<vtkXMLMultiBlockDataReader> blockReader;
+  blockReader->SetFileName("TestXMLParallelPieceReading.vtm");
+  blockReader->SetNumberOfThreads(4);
+  blockReader->Update();
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(blockReader->GetOutput());
+  TEST_ASSERT(output && output->GetNumberOfBlocks() == 5,
+              "Expected 5 blocks");
+  for (unsigned int i = 0; i < 5; i++)
+    {
+    TEST_ASSERT(SamePolyData(vtkPolyData::SafeDownCast(blocks->GetBlock(i)),
+                             vtkPolyData::SafeDownCast(output->GetBlock(i))),
+                "Expected the same block " << i << " on 4 threads");
+    }
+
+  return EXIT_SUCCESS;
+}
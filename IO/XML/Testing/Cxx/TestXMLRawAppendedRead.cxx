@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLRawAppendedRead.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// This tests that uncompressed raw appended data read directly from the
+// file are the same as the data written, in whole or in part, and that
+// data in the other byte order are still read from the stream.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+    { \
+    cerr << "Error: " << msg << endl; \
+    return EXIT_FAILURE; \
+    }
+
+namespace
+{
+// Compare the scalars of the image to those of the reference in the
+// extent of the image.
+bool CompareScalars(vtkImageData* image, vtkImageData* reference)
+{
+  int extent[6];
+  image->GetExtent(extent);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkDataArray* referenceScalars = reference->GetPointData()->GetScalars();
+  if (!scalars)
+    {
+    return false;
+    }
+  for (int k = extent[4]; k <= extent[5]; k++)
+    {
+    for (int j = extent[2]; j <= extent[3]; j++)
+      {
+      for (int i = extent[0]; i <= extent[1]; i++)
+        {
+        int ijk[3] = {i, j, k};
+        if (scalars->GetComponent(image->ComputePointId(ijk), 0) !=
+            referenceScalars->GetComponent(reference->ComputePointId(ijk), 0))
+          {
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+int TestXMLRawAppendedRead(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 31, 0, 31, 0, 31);
+  source->Update();
+  vtkImageData* image = source->GetOutput();
+
+  vtkNew<vtkXMLImageDataWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName("TestXMLRawAppendedRead.vti");
+  writer->SetCompressor(0);
+  writer->SetEncodeAppendedData(0);
+  TEST_ASSERT(writer->Write(), "Cannot write the image");
+
+  // Read from the file.
+  vtkNew<vtkXMLImageDataReader> reader;
+  reader->SetFileName("TestXMLRawAppendedRead.vti");
+  reader->Update();
+  TEST_ASSERT(reader->GetOutput()->GetNumberOfPoints() ==
+              image->GetNumberOfPoints() &&
+              CompareScalars(reader->GetOutput(), image),
+              "Wrong data read from the file");
+
+  // A new reader reads only a part of the extent.
+  int extent[6] = {3, 28, 5, 20, 2, 30};
+  vtkNew<vtkXMLImageDataReader> partReader;
+  partReader->SetFileName("TestXMLRawAppendedRead.vti");
+  partReader->UpdateInformation();
+  vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+    partReader->GetOutputInformation(0), extent);
+  partReader->Update();
+  TEST_ASSERT(partReader->GetOutput()->GetNumberOfPoints() == 26*16*29 &&
+              CompareScalars(partReader->GetOutput(), image),
+              "Wrong data read from the file in a part of the extent");
+
+  // Data in the other byte order are read from the stream.
+#ifdef VTK_WORDS_BIGENDIAN
+  writer->SetByteOrderToLittleEndian();
+#else
+  writer->SetByteOrderToBigEndian();
+#endif
+  writer->SetFileName("TestXMLRawAppendedReadSwapped.vti");
+  TEST_ASSERT(writer->Write(), "Cannot write the swapped image");
+  vtkNew<vtkXMLImageDataReader> swappedReader;
+  swappedReader->SetFileName("TestXMLRawAppendedReadSwapped.vti");
+  swappedReader->Update();
+  TEST_ASSERT(CompareScalars(swappedReader->GetOutput(), image),
+              "Wrong data read in the other byte order");
+
+  return EXIT_SUCCESS;
+}
@@ -16,6 +16,7 @@
 
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
 #include "vtkHierarchicalBoxDataSet.h"
@@ -25,6 +26,7 @@
 #include "vtkInformationVector.h"
 #include "vtkInstantiator.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
@@ -47,6 +49,16 @@ struct vtkXMLCompositeDataReaderEntry
   const char* name;
 };
 
+// A dataset read on another thread.
+struct vtkXMLCompositeDataReaderJob
+{
+  vtkXMLDataElement* Element;
+  std::string FileName;
+  std::string ReaderType;
+  vtkXMLReader* Reader;
+  vtkDataSet* Output;
+};
+
 struct vtkXMLCompositeDataReaderInternals
 {
   vtkSmartPointer<vtkXMLDataElement> Root;
@@ -59,20 +71,100 @@ struct vtkXMLCompositeDataReaderInternals
     {
     this->MinDataset = 0;
     this->MaxDataset = 0;
+    this->Prefetching = false;
     }
   std::set<int> UpdateIndices;
   bool HasUpdateRestriction;
+
+  // When Prefetching is set, ReadDataset only records the datasets to
+  // read in Jobs.  The datasets read in parallel wait in Prefetched
+  // for ReadDataset to return them.
+  bool Prefetching;
+  std::vector<vtkXMLCompositeDataReaderJob> Jobs;
+  typedef std::map<vtkXMLDataElement*, vtkDataSet*> PrefetchedType;
+  PrefetchedType Prefetched;
+  size_t NextJob;
+  int* Abort;
+  vtkSimpleCriticalSection Lock;
 };
 
+//----------------------------------------------------------------------------
+static vtkXMLReader* vtkXMLCompositeDataReaderNewReader(const char* type)
+{
+  vtkXMLReader* reader = 0;
+  if (strcmp(type, "vtkXMLImageDataReader") == 0)
+    {
+    reader = vtkXMLImageDataReader::New();
+    }
+  else if (strcmp(type,"vtkXMLUnstructuredGridReader") == 0)
+    {
+    reader = vtkXMLUnstructuredGridReader::New();
+    }
+  else if (strcmp(type,"vtkXMLPolyDataReader") == 0)
+    {
+    reader = vtkXMLPolyDataReader::New();
+    }
+  else if (strcmp(type,"vtkXMLRectilinearGridReader") == 0)
+    {
+    reader = vtkXMLRectilinearGridReader::New();
+    }
+  else if (strcmp(type,"vtkXMLStructuredGridReader") == 0)
+    {
+    reader = vtkXMLStructuredGridReader::New();
+    }
+  if (!reader)
+    {
+    // If all fails, Use the instantiator to create the reader.
+    reader = vtkXMLReader::SafeDownCast(vtkInstantiator::CreateInstance(type));
+    }
+  return reader;
+}
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkXMLCompositeDataReaderReadJobs(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkXMLCompositeDataReaderInternals* internal =
+    static_cast<vtkXMLCompositeDataReaderInternals*>(info->UserData);
+  for (;;)
+    {
+    internal->Lock.Lock();
+    size_t i = internal->NextJob++;
+    internal->Lock.Unlock();
+    if (i >= internal->Jobs.size() || *internal->Abort)
+      {
+      break;
+      }
+    vtkXMLCompositeDataReaderJob& job = internal->Jobs[i];
+    job.Reader->SetFileName(job.FileName.c_str());
+    job.Reader->Update();
+    vtkDataSet* output = job.Reader->GetOutputAsDataSet();
+    if (output)
+      {
+      job.Output = output->NewInstance();
+      job.Output->ShallowCopy(output);
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //----------------------------------------------------------------------------
 vtkXMLCompositeDataReader::vtkXMLCompositeDataReader()
 {
   this->Internal = new vtkXMLCompositeDataReaderInternals;
+  this->NumberOfThreads = 1;
+  this->BoundsFilter[0] = this->BoundsFilter[2] = this->BoundsFilter[4] = 1;
+  this->BoundsFilter[1] = this->BoundsFilter[3] = this->BoundsFilter[5] = -1;
+  this->ValueRangeFilterArrayName = 0;
+  this->ValueRangeFilter[0] = VTK_DOUBLE_MIN;
+  this->ValueRangeFilter[1] = VTK_DOUBLE_MAX;
 }
 
 //----------------------------------------------------------------------------
 vtkXMLCompositeDataReader::~vtkXMLCompositeDataReader()
 {
+  this->SetValueRangeFilterArrayName(0);
   delete this->Internal;
 }
 
@@ -80,6 +172,16 @@ vtkXMLCompositeDataReader::~vtkXMLCompositeDataReader()
 void vtkXMLCompositeDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "BoundsFilter: " << this->BoundsFilter[0] << " "
+     << this->BoundsFilter[1] << " " << this->BoundsFilter[2] << " "
+     << this->BoundsFilter[3] << " " << this->BoundsFilter[4] << " "
+     << this->BoundsFilter[5] << "\n";
+  os << indent << "ValueRangeFilterArrayName: "
+     << (this->ValueRangeFilterArrayName ?
+         this->ValueRangeFilterArrayName : "(none)") << "\n";
+  os << indent << "ValueRangeFilter: " << this->ValueRangeFilter[0] << " "
+     << this->ValueRangeFilter[1] << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -152,32 +254,7 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
     return iter->second.GetPointer();
     }
 
-  vtkXMLReader* reader = 0;
-  if (strcmp(type, "vtkXMLImageDataReader") == 0)
-    {
-    reader = vtkXMLImageDataReader::New();
-    }
-  else if (strcmp(type,"vtkXMLUnstructuredGridReader") == 0)
-    {
-    reader = vtkXMLUnstructuredGridReader::New();
-    }
-  else if (strcmp(type,"vtkXMLPolyDataReader") == 0)
-    {
-    reader = vtkXMLPolyDataReader::New();
-    }
-  else if (strcmp(type,"vtkXMLRectilinearGridReader") == 0)
-    {
-    reader = vtkXMLRectilinearGridReader::New();
-    }
-  else if (strcmp(type,"vtkXMLStructuredGridReader") == 0)
-    {
-    reader = vtkXMLStructuredGridReader::New();
-    }
-  if (!reader)
-    {
-    // If all fails, Use the instantiator to create the reader.
-    reader = vtkXMLReader::SafeDownCast(vtkInstantiator::CreateInstance(type));
-    }
+  vtkXMLReader* reader = vtkXMLCompositeDataReaderNewReader(type);
   if (reader)
     {
     this->Internal->Readers[type] = reader;
@@ -290,8 +367,76 @@ void vtkXMLCompositeDataReader::ReadXMLData()
 
   // All process create the  entire tree structure however, only each one only
   // reads the datasets assigned to it.
+  if (this->NumberOfThreads > 1)
+    {
+    this->ReadDatasetsInParallel(composite, filePath.c_str());
+    }
   unsigned int dataSetIndex=0;
   this->ReadComposite(this->GetPrimaryElement(), composite, filePath.c_str(), dataSetIndex);
+
+  // Release the datasets that were not used.
+  for (vtkXMLCompositeDataReaderInternals::PrefetchedType::iterator iter =
+         this->Internal->Prefetched.begin();
+       iter != this->Internal->Prefetched.end(); ++iter)
+    {
+    iter->second->Delete();
+    }
+  this->Internal->Prefetched.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLCompositeDataReader::ReadDatasetsInParallel(
+  vtkCompositeDataSet* composite, const char* filePath)
+{
+  // Walk the tree into a scratch dataset to find the files to read.
+  vtkXMLCompositeDataReaderInternals* internal = this->Internal;
+  internal->Jobs.clear();
+  internal->Prefetching = true;
+  vtkCompositeDataSet* scratch = composite->NewInstance();
+  unsigned int dataSetIndex=0;
+  this->ReadComposite(this->GetPrimaryElement(), scratch, filePath,
+                      dataSetIndex);
+  scratch->Delete();
+  internal->Prefetching = false;
+  if (internal->Jobs.size() < 2)
+    {
+    internal->Jobs.clear();
+    return;
+    }
+
+  // Each dataset gets its own reader, created and destroyed on this
+  // thread.
+  size_t i;
+  for (i=0; i < internal->Jobs.size(); ++i)
+    {
+    vtkXMLCompositeDataReaderJob& job = internal->Jobs[i];
+    job.Reader = vtkXMLCompositeDataReaderNewReader(job.ReaderType.c_str());
+    job.Output = 0;
+    }
+
+  internal->NextJob = 0;
+  internal->Abort = &this->AbortExecute;
+  int numberOfThreads = this->NumberOfThreads;
+  if (static_cast<size_t>(numberOfThreads) > internal->Jobs.size())
+    {
+    numberOfThreads = static_cast<int>(internal->Jobs.size());
+    }
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(vtkXMLCompositeDataReaderReadJobs, internal);
+  threader->SingleMethodExecute();
+  threader->Delete();
+
+  for (i=0; i < internal->Jobs.size(); ++i)
+    {
+    vtkXMLCompositeDataReaderJob& job = internal->Jobs[i];
+    job.Reader->Delete();
+    if (job.Output)
+      {
+      internal->Prefetched[job.Element] = job.Output;
+      }
+    }
+  internal->Jobs.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -312,6 +457,47 @@ int vtkXMLCompositeDataReader::ShouldReadDataSet(unsigned int dataSetIndex)
   return shouldRead;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLCompositeDataReader::PassesBlockIndexFilters(
+  vtkXMLDataElement* xmlElem)
+{
+  double bounds[6];
+  if (this->BoundsFilter[0] <= this->BoundsFilter[1] &&
+      this->BoundsFilter[2] <= this->BoundsFilter[3] &&
+      this->BoundsFilter[4] <= this->BoundsFilter[5] &&
+      xmlElem->GetVectorAttribute("Bounds", 6, bounds) == 6)
+    {
+    for (int i = 0; i < 3; ++i)
+      {
+      if (bounds[2*i+1] < this->BoundsFilter[2*i] ||
+          bounds[2*i] > this->BoundsFilter[2*i+1])
+        {
+        return 0;
+        }
+      }
+    }
+
+  if (this->ValueRangeFilterArrayName)
+    {
+    for (int i = 0; i < xmlElem->GetNumberOfNestedElements(); ++i)
+      {
+      vtkXMLDataElement* arrayXML = xmlElem->GetNestedElement(i);
+      const char* name = arrayXML->GetAttribute("Name");
+      double range[2];
+      if (strcmp(arrayXML->GetName(), "Array") == 0 && name &&
+          strcmp(name, this->ValueRangeFilterArrayName) == 0 &&
+          arrayXML->GetScalarAttribute("RangeMin", range[0]) &&
+          arrayXML->GetScalarAttribute("RangeMax", range[1]) &&
+          (range[1] < this->ValueRangeFilter[0] ||
+           range[0] > this->ValueRangeFilter[1]))
+        {
+        return 0;
+        }
+      }
+    }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 vtkDataSet* vtkXMLCompositeDataReader::ReadDataset(vtkXMLDataElement* xmlElem,
   const char* filePath)
@@ -324,6 +510,12 @@ vtkDataSet* vtkXMLCompositeDataReader::ReadDataset(vtkXMLDataElement* xmlElem,
     return NULL;
     }
 
+  // Skip the datasets that the index in the meta-file rules out.
+  if (!this->PassesBlockIndexFilters(xmlElem))
+    {
+    return NULL;
+    }
+
   if(!(file[0] == '/' || file[1] == ':'))
     {
     fileName = filePath;
@@ -353,6 +545,31 @@ vtkDataSet* vtkXMLCompositeDataReader::ReadDataset(vtkXMLDataElement* xmlElem,
       rname = readerEntry->name;
       }
     }
+  // Record the dataset to read it in parallel, or return it if it was
+  // read already.
+  if (this->Internal->Prefetching)
+    {
+    if (rname)
+      {
+      vtkXMLCompositeDataReaderJob job;
+      job.Element = xmlElem;
+      job.FileName = fileName;
+      job.ReaderType = rname;
+      job.Reader = 0;
+      job.Output = 0;
+      this->Internal->Jobs.push_back(job);
+      }
+    return 0;
+    }
+  vtkXMLCompositeDataReaderInternals::PrefetchedType::iterator prefetched =
+    this->Internal->Prefetched.find(xmlElem);
+  if (prefetched != this->Internal->Prefetched.end())
+    {
+    vtkDataSet* output = prefetched->second;
+    this->Internal->Prefetched.erase(prefetched);
+    return output;
+    }
+
   vtkXMLReader* reader = this->GetReaderOfType(rname);
   if (!reader)
     {
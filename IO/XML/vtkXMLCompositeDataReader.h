@@ -47,6 +47,34 @@ public:
   vtkCompositeDataSet* GetOutput();
   vtkCompositeDataSet* GetOutput(int);
 
+  // Description:
+  // Get/Set the number of dataset files read at once, each on its own
+  // thread.  Default is 1: the datasets are read one after another.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Get/Set the bounds of the region of interest.  Datasets whose bounds
+  // recorded in the file do not intersect it are not read and are left
+  // empty in the output.  Default is (1,-1,1,-1,1,-1): empty bounds do
+  // not filter.  The bounds are recorded by a writer with
+  // WriteBlockIndex on (see vtkXMLCompositeDataWriter); datasets without
+  // them are always read.
+  vtkSetVector6Macro(BoundsFilter, double);
+  vtkGetVector6Macro(BoundsFilter, double);
+
+  // Description:
+  // Get/Set the name of the point or cell data array and the range of
+  // values of interest.  Datasets in which the range of this array
+  // recorded in the file does not intersect the range of interest are
+  // not read and are left empty in the output.  Default is no name: the
+  // values do not filter.  As in the XML files, the range of an array
+  // with several components is the range of its magnitude.
+  vtkSetStringMacro(ValueRangeFilterArrayName);
+  vtkGetStringMacro(ValueRangeFilterArrayName);
+  vtkSetVector2Macro(ValueRangeFilter, double);
+  vtkGetVector2Macro(ValueRangeFilter, double);
+
 protected:
   vtkXMLCompositeDataReader();
   ~vtkXMLCompositeDataReader();
@@ -98,6 +126,20 @@ protected:
   // process should read the dataset.
   int ShouldReadDataSet(unsigned int datasetIndex);
 
+  // Read the datasets of this process on NumberOfThreads threads
+  // before ReadComposite() puts them in the output.
+  void ReadDatasetsInParallel(vtkCompositeDataSet* composite,
+                              const char* filePath);
+
+  // Returns 0 if the index recorded in the element of a dataset shows
+  // that the dataset is outside of the bounds or value range filters.
+  int PassesBlockIndexFilters(vtkXMLDataElement* xmlElem);
+
+  int NumberOfThreads;
+  double BoundsFilter[6];
+  char* ValueRangeFilterArrayName;
+  double ValueRangeFilter[2];
+
   // Description:
   // Test if the reader can read a file with the given version number.
   virtual int CanReadFileVersion(int major, int vtkNotUsed(minor))
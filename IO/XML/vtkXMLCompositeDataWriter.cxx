@@ -17,6 +17,8 @@
 #include "vtkCallbackCommand.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
 #include "vtkErrorCode.h"
 #include "vtkExecutive.h"
 #include "vtkGarbageCollector.h"
@@ -25,6 +27,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
@@ -69,6 +72,7 @@ vtkXMLCompositeDataWriter::vtkXMLCompositeDataWriter()
   this->Internal = new vtkXMLCompositeDataWriterInternals;
   this->GhostLevel = 0;
   this->WriteMetaFile = 1;
+  this->WriteBlockIndex = 0;
 
   // Setup a callback for the internal writers to report progress.
   this->ProgressObserver = vtkCallbackCommand::New();
@@ -103,6 +107,21 @@ void vtkXMLCompositeDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "GhostLevel: " << this->GhostLevel << endl;
   os << indent << "WriteMetaFile: " << this->WriteMetaFile<< endl;
+  os << indent << "WriteBlockIndex: " << this->WriteBlockIndex << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLCompositeDataWriter::CopyWriterSettings(vtkXMLWriter* writer)
+{
+  this->Superclass::CopyWriterSettings(writer);
+  vtkXMLCompositeDataWriter* w =
+    vtkXMLCompositeDataWriter::SafeDownCast(writer);
+  if(w)
+    {
+    w->SetGhostLevel(this->GhostLevel);
+    w->SetWriteMetaFile(this->WriteMetaFile);
+    w->SetWriteBlockIndex(this->WriteBlockIndex);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -257,6 +276,10 @@ int vtkXMLCompositeDataWriter::WriteNonCompositeData(
     {
     // Create the entry for the collection file.
     datasetXML->SetAttribute("file", fileName);
+    if (this->WriteBlockIndex)
+      {
+      this->WriteBlockIndexEntry(curDS, datasetXML);
+      }
     }
 
   // FIXME
@@ -282,6 +305,66 @@ int vtkXMLCompositeDataWriter::WriteNonCompositeData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Set an attribute with enough digits for the values to be read back
+// exactly.
+template <class T>
+static void vtkXMLCompositeDataWriterSetAttribute(vtkXMLDataElement* element,
+                                                  const char* name,
+                                                  int length, const T* values)
+{
+  vtksys_ios::ostringstream str;
+  str.imbue(std::locale::classic());
+  str.precision(17);
+  for (int i = 0; i < length; ++i)
+    {
+    str << (i ? " " : "") << values[i];
+    }
+  element->SetAttribute(name, str.str().c_str());
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLCompositeDataWriter::WriteBlockIndexEntry(
+  vtkDataSet* dataSet, vtkXMLDataElement* element)
+{
+  vtkIdType numberOfPoints = dataSet->GetNumberOfPoints();
+  vtkIdType numberOfCells = dataSet->GetNumberOfCells();
+  vtkXMLCompositeDataWriterSetAttribute(element, "NumberOfPoints", 1,
+                                        &numberOfPoints);
+  vtkXMLCompositeDataWriterSetAttribute(element, "NumberOfCells", 1,
+                                        &numberOfCells);
+  if (numberOfPoints > 0)
+    {
+    vtkXMLCompositeDataWriterSetAttribute(element, "Bounds", 6,
+                                          dataSet->GetBounds());
+    }
+
+  // The ranges are those written in the dataset files: the magnitude
+  // range for arrays with several components.
+  vtkFieldData* fields[2] = { dataSet->GetPointData(), dataSet->GetCellData() };
+  const char* associations[2] = { "point", "cell" };
+  for (int f = 0; f < 2; ++f)
+    {
+    for (int i = 0; i < fields[f]->GetNumberOfArrays(); ++i)
+      {
+      vtkDataArray* array = fields[f]->GetArray(i);
+      if (!array || !array->GetName() || array->GetNumberOfTuples() == 0)
+        {
+        continue;
+        }
+      vtkSmartPointer<vtkXMLDataElement> arrayXML =
+        vtkSmartPointer<vtkXMLDataElement>::New();
+      arrayXML->SetName("Array");
+      arrayXML->SetAttribute("Name", array->GetName());
+      arrayXML->SetAttribute("Association", associations[f]);
+      double* range = array->GetRange(-1);
+      vtkXMLCompositeDataWriterSetAttribute(arrayXML, "RangeMin", 1, range);
+      vtkXMLCompositeDataWriterSetAttribute(arrayXML, "RangeMax", 1, range + 1);
+      element->AddNestedElement(arrayXML);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLCompositeDataWriter::WriteData()
 {
@@ -29,6 +29,7 @@
 
 class vtkCallbackCommand;
 class vtkCompositeDataSet;
+class vtkDataSet;
 class vtkXMLDataElement;
 class vtkXMLCompositeDataWriterInternals;
 
@@ -55,6 +56,17 @@ public:
   vtkGetMacro(WriteMetaFile, int);
   virtual void SetWriteMetaFile(int flag);
 
+  // Description:
+  // Get/Set whether the meta-file records an index of the datasets.
+  // Each DataSet element then holds the Bounds, NumberOfPoints and
+  // NumberOfCells of its dataset and an Array element with the range
+  // of each point and cell data array.  vtkXMLCompositeDataReader uses
+  // this index to skip the datasets outside of its bounds or value
+  // range filter without opening their files.  Default is off.
+  vtkSetMacro(WriteBlockIndex, int);
+  vtkGetMacro(WriteBlockIndex, int);
+  vtkBooleanMacro(WriteBlockIndex, int);
+
   // Description:
   // See the vtkAlgorithm for a desciption of what these do
   int ProcessRequest(vtkInformation*,
@@ -65,6 +77,9 @@ protected:
   vtkXMLCompositeDataWriter();
   ~vtkXMLCompositeDataWriter();
 
+  // Copy the settings of this writer to a writer of the same type.
+  virtual void CopyWriterSettings(vtkXMLWriter* writer);
+
   // Description:
   // Methods to define the file's major and minor version numbers.
   // Major version incremented since v0.1 composite data readers cannot read
@@ -137,6 +152,13 @@ protected:
   // if the file structured does not change but the data does.
   int WriteMetaFile;
 
+  // Whether to record the bounds, sizes and array ranges of the
+  // datasets in the meta-file.
+  int WriteBlockIndex;
+
+  // Add the index entries of a dataset to its meta-file element.
+  void WriteBlockIndexEntry(vtkDataSet* dataSet, vtkXMLDataElement* element);
+
   // Callback registered with the ProgressObserver.
   static void ProgressCallbackFunction(vtkObject*, unsigned long, void*,
                                        void*);
@@ -211,6 +211,38 @@ int vtkXMLDataReader::SetUpdateExtentInfo(vtkXMLDataElement *eDSA,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataReader::GetPieceArrayRange(int piece, const char* name,
+                                         double range[2])
+{
+  if(!name || piece < 0 || piece >= this->NumberOfPieces)
+    {
+    return 0;
+    }
+
+  vtkXMLDataElement* elements[2] =
+    { this->PointDataElements[piece], this->CellDataElements[piece] };
+  for(int e = 0; e < 2; ++e)
+    {
+    if(!elements[e])
+      {
+      continue;
+      }
+    for(int i = 0; i < elements[e]->GetNumberOfNestedElements(); ++i)
+      {
+      vtkXMLDataElement* eNested = elements[e]->GetNestedElement(i);
+      const char* arrayName = eNested->GetAttribute("Name");
+      if(arrayName && strcmp(arrayName, name) == 0 &&
+         eNested->GetScalarAttribute("RangeMin", range[0]) &&
+         eNested->GetScalarAttribute("RangeMax", range[1]))
+        {
+        return 1;
+        }
+      }
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLDataReader::CopyOutputInformation(vtkInformation *outInfo,
                                              int port)
@@ -41,6 +41,18 @@ public:
   // Get the number of cells in the output.
   virtual vtkIdType GetNumberOfCells()=0;
 
+  // Description:
+  // Get the number of pieces stored in the file.  Valid after
+  // UpdateInformation.
+  vtkGetMacro(NumberOfPieces, int);
+
+  // Description:
+  // Get the range recorded by the writer for the point or cell data
+  // array with the given name in the given piece, without reading the
+  // data.  Returns 0 if the array or its range is not in the file.
+  // Valid after UpdateInformation.
+  int GetPieceArrayRange(int piece, const char* name, double range[2]);
+
   // For the specified port, copy the information this reader sets up in
   // SetupOutputInformation to outInfo
   virtual void CopyOutputInformation(vtkInformation *outInfo, int port);
@@ -16,9 +16,11 @@
 
 #include "vtkCallbackCommand.h"
 #include "vtkCellData.h"
+#include "vtkCriticalSection.h"
 #include "vtkDataArray.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkPointData.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataReader.h"
@@ -28,6 +30,8 @@
 
 #include <vtksys/ios/sstream>
 
+#include <vector>
+
 
 //----------------------------------------------------------------------------
 vtkXMLPDataReader::vtkXMLPDataReader()
@@ -35,6 +39,7 @@ vtkXMLPDataReader::vtkXMLPDataReader()
   this->GhostLevel = 0;
 
   this->NumberOfPieces = 0;
+  this->NumberOfThreads = 1;
 
   this->PieceElements = 0;
   this->PieceReaders = 0;
@@ -68,6 +73,7 @@ void vtkXMLPDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -433,6 +439,127 @@ int vtkXMLPDataReader::CanReadPiece(int index)
   return (this->PieceReaders[index]? 1:0);
 }
 
+//----------------------------------------------------------------------------
+// The piece readers updated on several threads.  Each thread takes the
+// next reader until none is left.
+struct vtkXMLPDataReaderPieceJobs
+{
+  std::vector<vtkXMLDataReader*> Readers;
+  std::vector<int> CanRead;
+  int ReadData;
+  int* Abort;
+  size_t Next;
+  vtkSimpleCriticalSection Lock;
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkXMLPDataReaderUpdatePieces(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkXMLPDataReaderPieceJobs* jobs =
+    static_cast<vtkXMLPDataReaderPieceJobs*>(info->UserData);
+  for(;;)
+    {
+    jobs->Lock.Lock();
+    size_t i = jobs->Next++;
+    jobs->Lock.Unlock();
+    if(i >= jobs->Readers.size() || *jobs->Abort)
+      {
+      break;
+      }
+    vtkXMLDataReader* reader = jobs->Readers[i];
+    if(jobs->ReadData)
+      {
+      reader->Update();
+      }
+    else if(jobs->CanRead[i] || reader->CanReadFile(reader->GetFileName()))
+      {
+      jobs->CanRead[i] = 1;
+      reader->UpdateInformation();
+      }
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataReader::UpdatePieceReaders(const int* pieces,
+                                           int numberOfPieces, int readData)
+{
+  if(this->NumberOfThreads < 2)
+    {
+    return;
+    }
+
+  // Collect the readers to update.  Their progress is not reported
+  // while they run on other threads.
+  vtkXMLPDataReaderPieceJobs jobs;
+  std::vector<int> jobPieces;
+  int i;
+  for(i=0;i < numberOfPieces;++i)
+    {
+    int piece = pieces[i];
+    vtkXMLDataReader* reader = this->PieceReaders[piece];
+    if(!reader || (readData && !this->CanReadPieceFlag[piece]))
+      {
+      continue;
+      }
+    if(readData)
+      {
+      reader->SetAbortExecute(0);
+      reader->GetPointDataArraySelection()->CopySelections(
+        this->PointDataArraySelection);
+      reader->GetCellDataArraySelection()->CopySelections(
+        this->CellDataArraySelection);
+      }
+    reader->RemoveObserver(this->PieceProgressObserver);
+    jobs.Readers.push_back(reader);
+    jobs.CanRead.push_back(this->CanReadPieceFlag[piece]);
+    jobPieces.push_back(piece);
+    }
+  if(jobs.Readers.empty())
+    {
+    return;
+    }
+  jobs.ReadData = readData;
+  jobs.Abort = &this->AbortExecute;
+  jobs.Next = 0;
+
+  int numberOfThreads = this->NumberOfThreads;
+  if(static_cast<size_t>(numberOfThreads) > jobs.Readers.size())
+    {
+    numberOfThreads = static_cast<int>(jobs.Readers.size());
+    }
+  vtkMultiThreader* threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(vtkXMLPDataReaderUpdatePieces, &jobs);
+  threader->SingleMethodExecute();
+  threader->Delete();
+
+  // Record which pieces can be read, as CanReadPiece does.
+  for(size_t j=0;j < jobs.Readers.size();++j)
+    {
+    int piece = jobPieces[j];
+    vtkXMLDataReader* reader = jobs.Readers[j];
+    if(jobs.CanRead[j])
+      {
+      this->CanReadPieceFlag[piece] = 1;
+      reader->AddObserver(vtkCommand::ProgressEvent,
+                          this->PieceProgressObserver);
+      }
+    else if(!readData && !this->AbortExecute)
+      {
+      this->PieceReaders[piece] = 0;
+      reader->Delete();
+      }
+    else
+      {
+      reader->AddObserver(vtkCommand::ProgressEvent,
+                          this->PieceProgressObserver);
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 char* vtkXMLPDataReader::CreatePieceFileName(const char* fileName)
 {
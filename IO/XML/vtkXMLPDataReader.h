@@ -41,6 +41,14 @@ public:
   // Get the number of pieces from the summary file being read.
   vtkGetMacro(NumberOfPieces, int);
 
+  // Description:
+  // Get/Set the number of piece files opened and read at once, each on
+  // its own thread.  Reading several files at once hides the latency of
+  // parallel file systems.  Default is 1: the pieces are read one after
+  // another.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
   // For the specified port, copy the information this reader sets up in
   // SetupOutputInformation to outInfo
   virtual void CopyOutputInformation(vtkInformation *outInfo, int port);
@@ -74,6 +82,13 @@ protected:
   virtual int ReadPieceData();
   int CanReadPiece(int index);
 
+  // Test and update the information (readData = 0) or the data
+  // (readData = 1) of the readers of the given pieces on NumberOfThreads
+  // threads.  The update extent of each reader must be set before the
+  // data are read.  Does nothing when reading on one thread.
+  void UpdatePieceReaders(const int* pieces, int numberOfPieces,
+                          int readData);
+
   char* CreatePieceFileName(const char* fileName);
   void SplitFileName();
 
@@ -91,6 +106,9 @@ protected:
   // The piece currently being read.
   int Piece;
 
+  // The number of piece files read at once.
+  int NumberOfThreads;
+
   // The path to the input file without the file name.
   char* PathName;
 
@@ -63,6 +63,46 @@ void vtkXMLPDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "WriteSummaryFile: " << this->WriteSummaryFile << "\n";
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLPDataWriter::WriteAsynchronously()
+{
+  // The copy of the input holds one piece.  Several pieces are written
+  // on this thread.
+  if(this->StartPiece != this->EndPiece)
+    {
+    this->Modified();
+    this->Update();
+    return 1;
+    }
+
+  // Request the piece to copy from the producer of the input.
+  int port;
+  vtkAlgorithm* producer = this->GetInputAlgorithm(0, 0, port);
+  if(producer)
+    {
+    producer->UpdateInformation();
+    producer->SetUpdateExtent(port, this->StartPiece, this->NumberOfPieces,
+                              this->GhostLevel);
+    }
+  return this->Superclass::WriteAsynchronously();
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLPDataWriter::CopyWriterSettings(vtkXMLWriter* writer)
+{
+  this->Superclass::CopyWriterSettings(writer);
+  vtkXMLPDataWriter* w = vtkXMLPDataWriter::SafeDownCast(writer);
+  if(w)
+    {
+    w->SetNumberOfPieces(this->NumberOfPieces);
+    w->SetStartPiece(this->StartPiece);
+    w->SetEndPiece(this->EndPiece);
+    w->SetGhostLevel(this->GhostLevel);
+    w->WriteSummaryFile = this->WriteSummaryFile;
+    w->WriteSummaryFileInitialized = this->WriteSummaryFileInitialized;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLPDataWriter::SetWriteSummaryFile(int flag)
 {
@@ -62,6 +62,12 @@ protected:
   vtkXMLPDataWriter();
   ~vtkXMLPDataWriter();
 
+  // Copy the settings of this writer to a writer of the same type.
+  virtual void CopyWriterSettings(vtkXMLWriter* writer);
+
+  // Copy the piece written by this writer to write it asynchronously.
+  virtual int WriteAsynchronously();
+
   // Override writing method from superclass.
   virtual int WriteInternal();
 
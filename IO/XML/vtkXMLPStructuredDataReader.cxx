@@ -26,6 +26,9 @@
 
 #include <vtksys/ios/sstream>
 
+#include <algorithm>
+#include <vector>
+
 
 //----------------------------------------------------------------------------
 vtkXMLPStructuredDataReader::vtkXMLPStructuredDataReader()
@@ -133,6 +136,47 @@ void vtkXMLPStructuredDataReader::ReadXMLData()
     fractions[i] = fractions[i] / fractions[n];
     }
 
+  // Read the pieces at once when reading on several threads.  Each
+  // piece reads the bounding box of its sub-extents, which are then
+  // copied to the output below.
+  if(this->NumberOfThreads > 1)
+    {
+    std::vector<int> pieces;
+    std::vector<int> bounds(6*this->NumberOfPieces);
+    for(i=0;i < n;++i)
+      {
+      int piece = this->ExtentSplitter->GetSubExtentSource(i);
+      int subExtent[6];
+      this->ExtentSplitter->GetSubExtent(i, subExtent);
+      int* bound = &bounds[6*piece];
+      if(std::find(pieces.begin(), pieces.end(), piece) == pieces.end())
+        {
+        pieces.push_back(piece);
+        std::copy(subExtent, subExtent+6, bound);
+        }
+      for(int j=0;j < 6;j += 2)
+        {
+        bound[j] = std::min(bound[j], subExtent[j]);
+        bound[j+1] = std::max(bound[j+1], subExtent[j+1]);
+        }
+      }
+    if(!pieces.empty())
+      {
+      int numberOfPieces = static_cast<int>(pieces.size());
+      this->UpdatePieceReaders(&pieces[0], numberOfPieces, 0);
+      for(i=0;i < numberOfPieces;++i)
+        {
+        if(this->PieceReaders[pieces[i]])
+          {
+          vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+            this->PieceReaders[pieces[i]]->GetOutputInformation(0),
+            &bounds[6*pieces[i]]);
+          }
+        }
+      this->UpdatePieceReaders(&pieces[0], numberOfPieces, 1);
+      }
+    }
+
   // Read the data needed from each sub-extent.
   for(i=0;(i < n && !this->AbortExecute && !this->DataError);++i)
     {
@@ -20,6 +20,7 @@
 #include "vtkInformation.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vector>
 
 //----------------------------------------------------------------------------
 vtkXMLPUnstructuredDataReader::vtkXMLPUnstructuredDataReader()
@@ -204,6 +205,15 @@ void vtkXMLPUnstructuredDataReader::SetupUpdateExtent(int piece,
 
   // Update the information of the pieces we need.
   int i;
+  std::vector<int> pieces;
+  for(i=this->StartPiece; i < this->EndPiece; ++i)
+    {
+    pieces.push_back(i);
+    }
+  if(!pieces.empty())
+    {
+    this->UpdatePieceReaders(&pieces[0], static_cast<int>(pieces.size()), 0);
+    }
   for(i=this->StartPiece; i < this->EndPiece; ++i)
     {
     if(this->CanReadPiece(i))
@@ -306,6 +316,24 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
     fractions[index+1] = fractions[index+1] / fractions[this->EndPiece-this->StartPiece];
     }
 
+  // Read the pieces at once when reading on several threads.  The
+  // pieces are then copied to the output below.
+  std::vector<int> pieces;
+  for(i=this->StartPiece; this->NumberOfThreads > 1 && i < this->EndPiece; ++i)
+    {
+    if(this->PieceReaders[i])
+      {
+      vtkStreamingDemandDrivenPipeline::SetUpdateExtent(
+        this->PieceReaders[i]->GetOutputInformation(0),
+        0, 1, this->UpdateGhostLevel);
+      pieces.push_back(i);
+      }
+    }
+  if(!pieces.empty())
+    {
+    this->UpdatePieceReaders(&pieces[0], static_cast<int>(pieces.size()), 1);
+    }
+
   // Read the data needed from each piece.
   for(i=this->StartPiece; (i < this->EndPiece && !this->AbortExecute &&
                            !this->DataError); ++i)
@@ -19,7 +19,9 @@
 #include "vtkDataCompressor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkErrorBoundedDataCompressor.h"
 #include "vtkInstantiator.h"
+#include "vtkLZ4DataCompressor.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
@@ -296,12 +298,20 @@ void vtkXMLReader::SetupCompressor(const char* type)
   vtkObject* object = vtkInstantiator::CreateInstance(type);
   vtkDataCompressor* compressor = vtkDataCompressor::SafeDownCast(object);
 
-  // In static builds, the vtkZLibDataCompressor may not have been
-  // registered with the vtkInstantiator.  Check for it here.
+  // In static builds, the compressors of vtkIOCore may not have been
+  // registered with the vtkInstantiator.  Check for them here.
   if(!compressor && (strcmp(type, "vtkZLibDataCompressor") == 0))
     {
     compressor = vtkZLibDataCompressor::New();
     }
+  if(!compressor && (strcmp(type, "vtkLZ4DataCompressor") == 0))
+    {
+    compressor = vtkLZ4DataCompressor::New();
+    }
+  if(!compressor && (strcmp(type, "vtkErrorBoundedDataCompressor") == 0))
+    {
+    compressor = vtkErrorBoundedDataCompressor::New();
+    }
 
   if(!compressor)
     {
@@ -505,6 +515,12 @@ int vtkXMLReader::RequestData(vtkInformation *vtkNotUsed(request),
   (*this->Stream).imbue(std::locale::classic());
   this->XMLParser->SetStream(this->Stream);
 
+  // Give it the name of the file too so that raw appended data can be
+  // read from the file directly into the arrays.
+  this->XMLParser->SetFileName(
+    (this->FileStream && this->Stream == this->FileStream)?
+    this->FileName : 0);
+
   // We are just starting to read.  Do not call UpdateProgressDiscrete
   // because we want a 0 progress callback the first time.
   this->UpdateProgress(0);
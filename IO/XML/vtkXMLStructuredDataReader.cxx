@@ -211,6 +211,49 @@ int vtkXMLStructuredDataReader::ReadPiece(vtkXMLDataElement* ePiece)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLStructuredDataReader::GetPieceExtent(int piece, int extent[6])
+{
+  if(piece < 0 || piece >= this->NumberOfPieces)
+    {
+    return 0;
+    }
+  memcpy(extent, this->PieceExtents + piece*6, 6*sizeof(int));
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLStructuredDataReader::ComputeExtentForValueRange(const char* name,
+                                                           double min,
+                                                           double max,
+                                                           int extent[6])
+{
+  int found = 0;
+  for(int piece = 0; piece < this->NumberOfPieces; ++piece)
+    {
+    double range[2];
+    if(this->GetPieceArrayRange(piece, name, range) &&
+       (range[1] < min || range[0] > max))
+      {
+      continue;
+      }
+    int* pieceExtent = this->PieceExtents + piece*6;
+    for(int i = 0; i < 3; ++i)
+      {
+      if(!found || pieceExtent[2*i] < extent[2*i])
+        {
+        extent[2*i] = pieceExtent[2*i];
+        }
+      if(!found || pieceExtent[2*i+1] > extent[2*i+1])
+        {
+        extent[2*i+1] = pieceExtent[2*i+1];
+        }
+      }
+    found = 1;
+    }
+  return found;
+}
+
 //----------------------------------------------------------------------------
 void vtkXMLStructuredDataReader::ReadXMLData()
 {
@@ -51,6 +51,23 @@ public:
   vtkGetMacro(WholeSlices, int);
   vtkBooleanMacro(WholeSlices, int);
 
+  // Description:
+  // Get the extent of the given piece of the file.  Files written in
+  // bricks (see vtkXMLStructuredDataWriter::SetBrickDimensions) store
+  // each brick as a piece and only the pieces that intersect the update
+  // extent are read.  Returns 0 if the piece does not exist.  Valid
+  // after UpdateInformation.
+  int GetPieceExtent(int piece, int extent[6]);
+
+  // Description:
+  // Compute the smallest extent containing the pieces in which the
+  // range of the named array intersects [min,max].  Pieces without a
+  // recorded range are included.  Setting this extent as the update
+  // extent reads only these pieces.  Returns 0 if no piece matches.
+  // Valid after UpdateInformation.
+  int ComputeExtentForValueRange(const char* name, double min, double max,
+                                 int extent[6]);
+
   // Description:
   // For the specified port, copy the information this reader sets up in
   // SetupOutputInformation to outInfo
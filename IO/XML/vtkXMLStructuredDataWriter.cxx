@@ -26,6 +26,7 @@
 #include "vtkInformationVector.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTableExtentTranslator.h"
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef  vtkXMLOffsetsManager_DoNotInclude
@@ -38,6 +39,9 @@ vtkXMLStructuredDataWriter::vtkXMLStructuredDataWriter()
 {
   this->ExtentTranslator = vtkExtentTranslator::New();
   this->NumberOfPieces = 1;
+  this->BrickDimensions[0] = 0;
+  this->BrickDimensions[1] = 0;
+  this->BrickDimensions[2] = 0;
   this->WriteExtent[0] = 0; this->WriteExtent[1] = -1;
   this->WriteExtent[2] = 0; this->WriteExtent[3] = -1;
   this->WriteExtent[4] = 0; this->WriteExtent[5] = -1;
@@ -85,6 +89,22 @@ void vtkXMLStructuredDataWriter::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "ExtentTranslator: (none)\n";
     }
   os << indent << "NumberOfPieces" << this->NumberOfPieces << "\n";
+  os << indent << "BrickDimensions: " << this->BrickDimensions[0] << " "
+     << this->BrickDimensions[1] << " " << this->BrickDimensions[2] << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLStructuredDataWriter::CopyWriterSettings(vtkXMLWriter* writer)
+{
+  this->Superclass::CopyWriterSettings(writer);
+  vtkXMLStructuredDataWriter* w =
+    vtkXMLStructuredDataWriter::SafeDownCast(writer);
+  if(w)
+    {
+    w->SetNumberOfPieces(this->NumberOfPieces);
+    w->SetWriteExtent(this->WriteExtent);
+    w->SetBrickDimensions(this->BrickDimensions);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -443,6 +463,12 @@ void vtkXMLStructuredDataWriter::SetupExtentTranslator()
     this->SetInternalWriteExtent(this->WriteExtent);
     }
 
+  if(this->BrickDimensions[0] > 0 || this->BrickDimensions[1] > 0 ||
+     this->BrickDimensions[2] > 0)
+    {
+    this->SetupBrickExtentTranslator();
+    }
+
   // Our WriteExtent becomes the WholeExtent of the file.
   this->ExtentTranslator->SetWholeExtent(this->InternalWriteExtent);
   this->ExtentTranslator->SetNumberOfPieces(this->NumberOfPieces);
@@ -457,6 +483,66 @@ void vtkXMLStructuredDataWriter::SetupExtentTranslator()
     << this->NumberOfPieces << " pieces.");
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLStructuredDataWriter::SetupBrickExtentTranslator()
+{
+  // Split each axis of the write extent at every BrickDimensions cells.
+  // Neighboring bricks share their boundary points.
+  int* ext = this->InternalWriteExtent;
+  int numberOfBricks[3];
+  int i;
+  for(i=0; i < 3; ++i)
+    {
+    int cells = ext[2*i+1] - ext[2*i];
+    int size = this->BrickDimensions[i];
+    if(size > 0 && cells > size)
+      {
+      numberOfBricks[i] = (cells + size - 1) / size;
+      }
+    else
+      {
+      numberOfBricks[i] = 1;
+      }
+    }
+
+  vtkTableExtentTranslator* table = vtkTableExtentTranslator::New();
+  int count = numberOfBricks[0]*numberOfBricks[1]*numberOfBricks[2];
+  table->SetNumberOfPiecesInTable(count);
+  int piece = 0;
+  int brick[3];
+  for(brick[2]=0; brick[2] < numberOfBricks[2]; ++brick[2])
+    {
+    for(brick[1]=0; brick[1] < numberOfBricks[1]; ++brick[1])
+      {
+      for(brick[0]=0; brick[0] < numberOfBricks[0]; ++brick[0])
+        {
+        int extent[6];
+        for(i=0; i < 3; ++i)
+          {
+          if(numberOfBricks[i] == 1)
+            {
+            extent[2*i] = ext[2*i];
+            extent[2*i+1] = ext[2*i+1];
+            }
+          else
+            {
+            extent[2*i] = ext[2*i] + brick[i]*this->BrickDimensions[i];
+            extent[2*i+1] = extent[2*i] + this->BrickDimensions[i];
+            if(extent[2*i+1] > ext[2*i+1])
+              {
+              extent[2*i+1] = ext[2*i+1];
+              }
+            }
+          }
+        table->SetExtentForPiece(piece++, extent);
+        }
+      }
+    }
+  this->SetExtentTranslator(table);
+  table->Delete();
+  this->NumberOfPieces = count;
+}
+
 //----------------------------------------------------------------------------
 template <class iterT>
 inline void vtkXMLStructuredDataWriterCopyTuples(
@@ -52,10 +52,26 @@ public:
   virtual void SetExtentTranslator(vtkExtentTranslator*);
   vtkGetObjectMacro(ExtentTranslator, vtkExtentTranslator);
 
+  // Description:
+  // Get/Set the number of cells along each axis of the bricks in which
+  // the data are stored.  When any of them is larger than 0 the write
+  // extent is split into a grid of bricks of this size, each stored as
+  // a piece of the file with the range of its arrays.  A reader then
+  // decompresses only the bricks that intersect its update extent.  An
+  // axis with 0 is not split.  The extent translator is replaced by a
+  // vtkTableExtentTranslator listing the bricks and NumberOfPieces is
+  // set to their number when the data are written.  The default is
+  // (0,0,0) which stores the data in NumberOfPieces pieces.
+  vtkSetVector3Macro(BrickDimensions, int);
+  vtkGetVector3Macro(BrickDimensions, int);
+
 protected:
   vtkXMLStructuredDataWriter();
   ~vtkXMLStructuredDataWriter();
 
+  // Copy the settings of this writer to a writer of the same type.
+  virtual void CopyWriterSettings(vtkXMLWriter* writer);
+
   // Writing drivers defined by subclasses.
   virtual void WritePrimaryElementAttributes(ostream &os, vtkIndent indent);
   virtual void WriteAppendedPiece(int index, vtkIndent indent);
@@ -71,6 +87,7 @@ protected:
   virtual void DeletePositionArrays();
 
   void SetupExtentTranslator();
+  void SetupBrickExtentTranslator();
   vtkAbstractArray* CreateExactExtent(vtkAbstractArray* array, int* inExtent,
                                   int* outExtent, int isPoint);
   virtual int WriteInlineMode(vtkIndent indent);
@@ -98,6 +115,9 @@ protected:
   // Number of pieces used for streaming.
   int NumberOfPieces;
 
+  // Number of cells along each axis of a brick, 0 for the whole axis.
+  int BrickDimensions[3];
+
   // Translate piece number to extent.
   vtkExtentTranslator* ExtentTranslator;
 
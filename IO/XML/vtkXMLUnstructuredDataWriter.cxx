@@ -81,6 +81,20 @@ void vtkXMLUnstructuredDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "GhostLevel: " << this->GhostLevel << "\n";
 }
 
+//----------------------------------------------------------------------------
+void vtkXMLUnstructuredDataWriter::CopyWriterSettings(vtkXMLWriter* writer)
+{
+  this->Superclass::CopyWriterSettings(writer);
+  vtkXMLUnstructuredDataWriter* w =
+    vtkXMLUnstructuredDataWriter::SafeDownCast(writer);
+  if(w)
+    {
+    w->SetNumberOfPieces(this->NumberOfPieces);
+    w->SetWritePiece(this->WritePiece);
+    w->SetGhostLevel(this->GhostLevel);
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkPointSet* vtkXMLUnstructuredDataWriter::GetInputAsPointSet()
 {
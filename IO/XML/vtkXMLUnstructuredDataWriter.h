@@ -61,6 +61,9 @@ protected:
   vtkXMLUnstructuredDataWriter();
   ~vtkXMLUnstructuredDataWriter();
 
+  // Copy the settings of this writer to a writer of the same type.
+  virtual void CopyWriterSettings(vtkXMLWriter* writer);
+
   vtkPointSet* GetInputAsPointSet();
   virtual const char* GetDataSetName()=0;
   virtual void SetInputUpdateExtent(int piece, int numPieces,
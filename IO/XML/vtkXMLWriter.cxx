@@ -19,11 +19,16 @@
 #include "vtkByteSwap.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
+#include "vtkConditionVariable.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkErrorBoundedDataCompressor.h"
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -45,7 +50,9 @@
 #include <vtksys/ios/sstream>
 
 #include <assert.h>
+#include <deque>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h> /* unlink */
@@ -219,6 +226,85 @@ int vtkXMLWriterWriteBinaryDataBlocks(vtkXMLWriter* writer,
 //*****************************************************************************
 
 vtkCxxSetObjectMacro(vtkXMLWriter, Compressor, vtkDataCompressor);
+//----------------------------------------------------------------------------
+// A file written on the background thread by a copy of the writer.
+struct vtkXMLWriterPendingWrite
+{
+  vtkXMLWriter* Writer;
+  unsigned long MemorySize;
+  int Done;
+};
+
+//----------------------------------------------------------------------------
+// The asynchronous writes of a writer, in order.  The background thread
+// writes Writes[NumberOfWritesStarted] when there is one, and marks it
+// Done.  The main thread removes the writes done from the front.
+class vtkXMLWriterAsynchronousQueue
+{
+public:
+  vtkXMLWriterAsynchronousQueue()
+    {
+    this->NumberOfWritesStarted = 0;
+    this->MemorySize = 0;
+    this->Stop = 0;
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    }
+  ~vtkXMLWriterAsynchronousQueue()
+    {
+    if(this->ThreadId >= 0)
+      {
+      this->Lock.Lock();
+      this->Stop = 1;
+      this->Condition.Broadcast();
+      this->Lock.Unlock();
+      this->Threader->TerminateThread(this->ThreadId);
+      }
+    this->Threader->Delete();
+    }
+
+  static VTK_THREAD_RETURN_TYPE WriteFiles(void* arg);
+
+  std::deque<vtkXMLWriterPendingWrite> Writes;
+  size_t NumberOfWritesStarted;
+  unsigned long MemorySize;
+  int Stop;
+  vtkSimpleMutexLock Lock;
+  vtkSimpleConditionVariable Condition;
+  vtkMultiThreader* Threader;
+  int ThreadId;
+};
+
+//----------------------------------------------------------------------------
+VTK_THREAD_RETURN_TYPE vtkXMLWriterAsynchronousQueue::WriteFiles(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkXMLWriterAsynchronousQueue* self =
+    static_cast<vtkXMLWriterAsynchronousQueue*>(info->UserData);
+  self->Lock.Lock();
+  for(;;)
+    {
+    while(!self->Stop && self->NumberOfWritesStarted == self->Writes.size())
+      {
+      self->Condition.Wait(self->Lock);
+      }
+    if(self->Stop)
+      {
+      break;
+      }
+    vtkXMLWriterPendingWrite& write =
+      self->Writes[self->NumberOfWritesStarted++];
+    self->Lock.Unlock();
+    write.Writer->Write();
+    self->Lock.Lock();
+    write.Done = 1;
+    self->Condition.Broadcast();
+    }
+  self->Lock.Unlock();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //----------------------------------------------------------------------------
 vtkXMLWriter::vtkXMLWriter()
 {
@@ -247,6 +333,11 @@ vtkXMLWriter::vtkXMLWriter()
   this->BlockSize = 32768; //2^15
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = 0;
+  this->NumberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  this->CompressionBuffer = 0;
+  this->CompressionBufferBlockSizes = 0;
+  this->CompressionBufferCapacity = 0;
+  this->NumberOfBufferedBlocks = 0;
   this->Int32IdTypeBuffer = 0;
   this->ByteSwapBuffer = 0;
 
@@ -270,11 +361,22 @@ vtkXMLWriter::vtkXMLWriter()
   this->UserContinueExecuting = -1; //invalid state
   this->NumberOfTimeValues = NULL;
   this->FieldDataOM = new OffsetsManagerGroup;
+
+  this->Asynchronous = 0;
+  this->AsynchronousShallowCopy = 0;
+  this->MaximumNumberOfPendingWrites = 2;
+  this->MaximumPendingWriteMemory = 0;
+  this->AsynchronousQueue = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkXMLWriter::~vtkXMLWriter()
 {
+  if(this->AsynchronousQueue)
+    {
+    this->WaitForPendingWrites();
+    delete this->AsynchronousQueue;
+    }
   this->SetFileName(0);
   this->DataStream->Delete();
   this->SetCompressor(0);
@@ -282,6 +384,8 @@ vtkXMLWriter::~vtkXMLWriter()
 
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete[] this->CompressionBuffer;
+  delete[] this->CompressionBufferBlockSizes;
 }
 
 //----------------------------------------------------------------------------
@@ -309,6 +413,22 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     this->Modified();
     return;
     }
+
+  if (compressorType == LZ4)
+    {
+    if (this->Compressor && this->Compressor->IsTypeOf("vtkLZ4DataCompressor"))
+      {
+      return;
+      }
+    if (this->Compressor)
+      {
+      this->Compressor->Delete();
+      }
+
+    this->Compressor = vtkLZ4DataCompressor::New();
+    this->Modified();
+    return;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -355,6 +475,14 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "Asynchronous: " << this->Asynchronous << "\n";
+  os << indent << "AsynchronousShallowCopy: "
+     << this->AsynchronousShallowCopy << "\n";
+  os << indent << "MaximumNumberOfPendingWrites: "
+     << this->MaximumNumberOfPendingWrites << "\n";
+  os << indent << "MaximumPendingWriteMemory: "
+     << this->MaximumPendingWriteMemory << "\n";
   if(this->Stream)
     {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -594,6 +722,11 @@ int vtkXMLWriter::Write()
     return 0;
     }
 
+  if(this->Asynchronous)
+    {
+    return this->WriteAsynchronously();
+    }
+
   // always write even if the data hasn't changed
   this->Modified();
 
@@ -601,6 +734,149 @@ int vtkXMLWriter::Write()
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLWriter::WriteAsynchronously()
+{
+  // Take a copy of the input for a copy of this writer.
+  int producerPort;
+  vtkAlgorithm* producer = this->GetInputAlgorithm(0, 0, producerPort);
+  producer->Update(producerPort);
+  vtkDataObject* input = this->GetInputDataObject(0, 0);
+  if(!input)
+    {
+    vtkErrorMacro("No input provided!");
+    return 0;
+    }
+  unsigned long memorySize = input->GetActualMemorySize();
+
+  // Wait for room in the queue before taking the copy.
+  this->CompletePendingWrites(this->MaximumNumberOfPendingWrites, memorySize);
+
+  vtkDataObject* copy = input->NewInstance();
+  if(this->AsynchronousShallowCopy)
+    {
+    copy->ShallowCopy(input);
+    }
+  else
+    {
+    copy->DeepCopy(input);
+    }
+  vtkXMLWriter* writer = this->NewInstance();
+  this->CopyWriterSettings(writer);
+  writer->SetInputData(copy);
+  copy->Delete();
+
+  vtkXMLWriterPendingWrite write;
+  write.Writer = writer;
+  write.MemorySize = memorySize;
+  write.Done = 0;
+  if(!this->AsynchronousQueue)
+    {
+    this->AsynchronousQueue = new vtkXMLWriterAsynchronousQueue;
+    }
+  vtkXMLWriterAsynchronousQueue* queue = this->AsynchronousQueue;
+  queue->Lock.Lock();
+  queue->Writes.push_back(write);
+  queue->MemorySize += memorySize;
+  queue->Condition.Broadcast();
+  queue->Lock.Unlock();
+  if(queue->ThreadId < 0)
+    {
+    queue->ThreadId = queue->Threader->SpawnThread(
+      &vtkXMLWriterAsynchronousQueue::WriteFiles, queue);
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::CompletePendingWrites(int maxPending,
+                                        unsigned long memorySize)
+{
+  vtkXMLWriterAsynchronousQueue* queue = this->AsynchronousQueue;
+  if(!queue)
+    {
+    return 0;
+    }
+  unsigned long maxMemory = this->MaximumPendingWriteMemory;
+  int failed = 0;
+  for(;;)
+    {
+    // Take the writes done from the front of the queue.
+    std::vector<vtkXMLWriter*> done;
+    queue->Lock.Lock();
+    while(!queue->Writes.empty() && queue->Writes.front().Done)
+      {
+      done.push_back(queue->Writes.front().Writer);
+      queue->MemorySize -= queue->Writes.front().MemorySize;
+      queue->Writes.pop_front();
+      --queue->NumberOfWritesStarted;
+      }
+    size_t pending = queue->Writes.size();
+    bool wait = pending > 0 && maxPending >= 0 && done.empty() &&
+      (pending >= static_cast<size_t>(maxPending) ||
+       (maxMemory > 0 && queue->MemorySize + memorySize > maxMemory));
+    if(wait)
+      {
+      queue->Condition.Wait(queue->Lock);
+      }
+    queue->Lock.Unlock();
+
+    // Report them on this thread.
+    for(size_t i=0; i < done.size(); ++i)
+      {
+      vtkXMLWriter* writer = done[i];
+      if(writer->GetErrorCode() != vtkErrorCode::NoError)
+        {
+        this->SetErrorCode(writer->GetErrorCode());
+        vtkErrorMacro("Error writing " << writer->GetFileName());
+        ++failed;
+        }
+      this->InvokeEvent(vtkCommand::EndEvent, writer->GetFileName());
+      writer->Delete();
+      }
+    if(!wait && done.empty())
+      {
+      break;
+      }
+    }
+  return failed;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::CheckPendingWrites()
+{
+  this->CompletePendingWrites(-1, 0);
+  if(!this->AsynchronousQueue)
+    {
+    return 0;
+    }
+  this->AsynchronousQueue->Lock.Lock();
+  int pending = static_cast<int>(this->AsynchronousQueue->Writes.size());
+  this->AsynchronousQueue->Lock.Unlock();
+  return pending;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::WaitForPendingWrites()
+{
+  return this->CompletePendingWrites(0, 0) == 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLWriter::CopyWriterSettings(vtkXMLWriter* writer)
+{
+  writer->SetDebug(this->GetDebug());
+  writer->SetFileName(this->GetFileName());
+  writer->SetByteOrder(this->GetByteOrder());
+  writer->SetHeaderType(this->GetHeaderType());
+  writer->SetIdType(this->GetIdType());
+  writer->SetCompressor(this->GetCompressor());
+  writer->SetBlockSize(this->GetBlockSize());
+  writer->SetNumberOfThreads(this->GetNumberOfThreads());
+  writer->SetDataMode(this->GetDataMode());
+  writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLWriter::OpenFile()
 {
@@ -993,6 +1269,17 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       {
       return 0;
       }
+    // An error-bounded compressor needs to know the values it
+    // compresses.
+    vtkErrorBoundedDataCompressor* errorBoundedCompressor =
+      vtkErrorBoundedDataCompressor::SafeDownCast(this->Compressor);
+    if(errorBoundedCompressor)
+      {
+      errorBoundedCompressor->SetCurrentArray(
+        wordType, a->GetNumberOfComponents(),
+        this->GetCompressionTolerance(a));
+      }
+
     // Start writing the data.
     int result = this->DataStream->StartWriting();
 
@@ -1002,6 +1289,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
+    // Compress and write the blocks still waiting in the buffer.
+    if(result && !this->WriteBufferedCompressionBlocks())
+      {
+      result = 0;
+      }
+
     // Finish writing the data.
     if(result && !this->DataStream->EndWriting())
       {
@@ -1014,12 +1307,22 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
       }
 
-    // Destroy the compression header if it was used.
+    // Destroy the compression header and buffer if they were used.
     if(this->CompressionHeader)
       {
       delete this->CompressionHeader;
       this->CompressionHeader = 0;
       }
+    delete [] this->CompressionBuffer;
+    this->CompressionBuffer = 0;
+    delete [] this->CompressionBufferBlockSizes;
+    this->CompressionBufferBlockSizes = 0;
+    this->NumberOfBufferedBlocks = 0;
+
+    if(errorBoundedCompressor)
+      {
+      errorBoundedCompressor->SetCurrentArray(VTK_VOID, 1, 0.0);
+      }
 
     return result;
     }
@@ -1070,6 +1373,31 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+double vtkXMLWriter::GetCompressionTolerance(vtkAbstractArray* a)
+{
+  vtkErrorBoundedDataCompressor* compressor =
+    vtkErrorBoundedDataCompressor::SafeDownCast(this->Compressor);
+  int wordType = a->GetDataType();
+  if(!compressor || this->DataMode == vtkXMLWriter::Ascii ||
+     (wordType != VTK_FLOAT && wordType != VTK_DOUBLE))
+    {
+    return 0.0;
+    }
+
+  // The values can be compressed with loss only in the byte order of
+  // this machine.
+#ifdef VTK_WORDS_BIGENDIAN
+  if(this->ByteOrder != vtkXMLWriter::BigEndian)
+#else
+  if(this->ByteOrder != vtkXMLWriter::LittleEndian)
+#endif
+    {
+    return 0.0;
+    }
+  return compressor->GetArrayTolerance(a->GetName());
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteBinaryDataInternal(vtkAbstractArray* a)
 {
@@ -1306,32 +1634,96 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
 
+  // Allocate the buffer of the blocks compressed together.  A few blocks
+  // per thread balance the work when the blocks compress unevenly.
+  this->CompressionBufferCapacity = 4*this->NumberOfThreads;
+  if(this->CompressionBufferCapacity > numBlocks)
+    {
+    this->CompressionBufferCapacity = numBlocks;
+    }
+  delete [] this->CompressionBuffer;
+  delete [] this->CompressionBufferBlockSizes;
+  this->CompressionBuffer =
+    new unsigned char[this->CompressionBufferCapacity*this->BlockSize];
+  this->CompressionBufferBlockSizes =
+    new size_t[this->CompressionBufferCapacity];
+  this->NumberOfBufferedBlocks = 0;
+
   return result;
 }
 
 //----------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Copy the data to the buffer.  The blocks are compressed together
+  // when it is full.
+  if(this->NumberOfBufferedBlocks == this->CompressionBufferCapacity ||
+     size > this->BlockSize)
+    {
+    vtkErrorMacro("Compression block does not fit in the buffer.");
+    return 0;
+    }
+  memcpy(this->CompressionBuffer +
+         this->NumberOfBufferedBlocks*this->BlockSize, data, size);
+  this->CompressionBufferBlockSizes[this->NumberOfBufferedBlocks++] = size;
+  if(this->NumberOfBufferedBlocks == this->CompressionBufferCapacity)
+    {
+    return this->WriteBufferedCompressionBlocks();
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkXMLWriter::WriteBufferedCompressionBlocks()
+{
+  size_t count = this->NumberOfBufferedBlocks;
+  if(count == 0)
+    {
+    return 1;
+    }
+  this->NumberOfBufferedBlocks = 0;
+
+  // Compress the blocks concurrently.
+  std::vector<unsigned char const*> blocks(count);
+  for(size_t i=0; i < count; ++i)
+    {
+    blocks[i] = this->CompressionBuffer + i*this->BlockSize;
+    }
+  std::vector<vtkUnsignedCharArray*> outputArrays(count);
+  if(!this->Compressor->CompressBlocks(count, &blocks[0],
+                                       this->CompressionBufferBlockSizes,
+                                       &outputArrays[0],
+                                       this->NumberOfThreads))
+    {
+    vtkErrorMacro("Error compressing data.");
+    return 0;
+    }
+
+  // Write the compressed data in order.
+  int result = 1;
+  for(size_t i=0; i < count; ++i)
+    {
+    // Find the compressed size.
+    size_t outputSize = outputArrays[i]->GetNumberOfTuples();
+    unsigned char* outputPointer = outputArrays[i]->GetPointer(0);
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+    // Write the compressed data.
+    if(result && !this->DataStream->Write(outputPointer, outputSize))
+      {
+      result = 0;
+      }
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
+
+    outputArrays[i]->Delete();
+    }
   this->Stream->flush();
   if (this->Stream->fail())
     {
     this->SetErrorCode(vtkErrorCode::GetLastSystemError());
     }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3+this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
-
   return result;
 }
 
@@ -1873,6 +2265,13 @@ void vtkXMLWriter::WriteArrayHeader(vtkAbstractArray* a,  vtkIndent indent,
     }
 
   this->WriteDataModeAttribute("format");
+
+  // Record the error allowed by lossy compression.
+  double tolerance = this->GetCompressionTolerance(a);
+  if(tolerance > 0.0)
+    {
+    this->WriteScalarAttribute("Tolerance", tolerance);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -40,6 +40,7 @@ class vtkPointData;
 class vtkPoints;
 class vtkFieldData;
 class vtkXMLDataHeader;
+class vtkXMLWriterAsynchronousQueue;
 //BTX
 class vtkStdString;
 class OffsetsManager;      // one per piece/per time
@@ -114,6 +115,10 @@ public:
   // Description:
   // Get/Set the compressor used to compress binary and appended data
   // before writing to the file.  Default is a vtkZLibDataCompressor.
+  // vtkLZ4DataCompressor writes and reads faster with a lower ratio.
+  // vtkErrorBoundedDataCompressor compresses float and double arrays
+  // with a bounded error; the tolerance of each array is recorded in its
+  // Tolerance attribute.
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
@@ -121,7 +126,8 @@ public:
   enum CompressorType
     {
     NONE,
-    ZLIB
+    ZLIB,
+    LZ4
     };
 //ETX
 
@@ -136,6 +142,10 @@ public:
     {
     this->SetCompressorType(ZLIB);
     }
+  void SetCompressorTypeToLZ4()
+    {
+    this->SetCompressorType(LZ4);
+    }
 
   // Description:
   // Get/Set the block size used in compression.  When reading, this
@@ -145,6 +155,13 @@ public:
   virtual void SetBlockSize(size_t blockSize);
   vtkGetMacro(BlockSize, size_t);
 
+  // Description:
+  // Get/Set the number of threads used to compress the blocks of an
+  // array.  The file written does not depend on the number of threads.
+  // Default is the global default number of threads of vtkMultiThreader.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
   // Description:
   // Get/Set the data mode used for the file's data.  The options are
   // vtkXMLWriter::Ascii, vtkXMLWriter::Binary, and
@@ -179,9 +196,54 @@ public:
   virtual const char* GetDefaultFileExtension()=0;
 
   // Description:
-  // Invoke the writer.  Returns 1 for success, 0 for failure.
+  // Invoke the writer.  Returns 1 for success, 0 for failure.  In
+  // asynchronous mode, returns once the input is copied; the errors of
+  // the write are reported later.
   int Write();
 
+  // Description:
+  // Get/Set whether Write() returns as soon as a copy of the input is
+  // taken, while the file is serialized, compressed and written on a
+  // background thread.  The writes are done in order.  EndEvent is
+  // invoked with the name of the file as call data when a write
+  // completes; see CheckPendingWrites().  The compressor must not be
+  // used by another writer meanwhile.  Default is 0.
+  vtkSetMacro(Asynchronous, int);
+  vtkGetMacro(Asynchronous, int);
+  vtkBooleanMacro(Asynchronous, int);
+
+  // Description:
+  // Get/Set whether an asynchronous write takes a shallow copy of the
+  // input instead of a deep copy.  The arrays of the input must then be
+  // left unchanged until the write completes.  Default is 0.
+  vtkSetMacro(AsynchronousShallowCopy, int);
+  vtkGetMacro(AsynchronousShallowCopy, int);
+  vtkBooleanMacro(AsynchronousShallowCopy, int);
+
+  // Description:
+  // Get/Set the number of asynchronous writes pending at once.  Write()
+  // waits for the oldest one to complete when there are as many.
+  // Default is 2: a file is written while the next one is prepared.
+  vtkSetClampMacro(MaximumNumberOfPendingWrites, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingWrites, int);
+
+  // Description:
+  // Get/Set the memory in kibibytes that the copies of the pending
+  // writes may hold.  Write() waits for earlier writes to complete
+  // rather than exceed it.  Default is 0: no limit.
+  vtkSetMacro(MaximumPendingWriteMemory, unsigned long);
+  vtkGetMacro(MaximumPendingWriteMemory, unsigned long);
+
+  // Description:
+  // Invoke EndEvent for the asynchronous writes that completed and
+  // return the number of writes still pending.
+  int CheckPendingWrites();
+
+  // Description:
+  // Wait for all the asynchronous writes to complete.  Returns 1 if
+  // they all succeeded, 0 otherwise.
+  int WaitForPendingWrites();
+
   // See the vtkAlgorithm for a description of what these do
   virtual int ProcessRequest(vtkInformation* request,
                              vtkInformationVector** inputVector,
@@ -275,6 +337,14 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  int NumberOfThreads;
+
+  // Blocks waiting to be compressed together by
+  // WriteBufferedCompressionBlocks().
+  unsigned char* CompressionBuffer;
+  size_t* CompressionBufferBlockSizes;
+  size_t CompressionBufferCapacity;
+  size_t NumberOfBufferedBlocks;
 
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
@@ -287,6 +357,13 @@ protected:
   // Method to drive most of actual writing.
   virtual int WriteInternal();
 
+  // Copy the settings of this writer to a writer of the same type.
+  // Used to write asynchronously.
+  virtual void CopyWriterSettings(vtkXMLWriter* writer);
+
+  // Queue a write of a copy of the input on the background thread.
+  virtual int WriteAsynchronously();
+
   // Method defined by subclasses to write data.  Return 1 for
   // success, 0 for failure.
   virtual int WriteData() {return 1;};
@@ -361,6 +438,7 @@ protected:
     int timestep=0);
   int WriteAsciiData(vtkAbstractArray* a, vtkIndent indent);
   int WriteBinaryData(vtkAbstractArray* a);
+  double GetCompressionTolerance(vtkAbstractArray* a);
   int WriteBinaryDataInternal(vtkAbstractArray* a);
   void WriteArrayAppendedData(vtkAbstractArray* a, vtkTypeInt64 pos,
                               vtkTypeInt64 &lastoffset);
@@ -410,6 +488,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int WriteBufferedCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -448,9 +527,24 @@ protected:
   friend class vtkXMLWriterHelper;
   //ETX
 
+  // Asynchronous write settings.
+  int Asynchronous;
+  int AsynchronousShallowCopy;
+  int MaximumNumberOfPendingWrites;
+  unsigned long MaximumPendingWriteMemory;
+
+  // Invoke the events of the completed asynchronous writes, after
+  // waiting until fewer than maxPending writes are pending and a write
+  // of the given memory size fits in MaximumPendingWriteMemory.  A
+  // maxPending of 0 waits for all writes, a negative one does not wait.
+  // Returns the number of writes that failed.
+  int CompletePendingWrites(int maxPending, unsigned long memorySize);
+
 private:
   vtkXMLWriter(const vtkXMLWriter&);  // Not implemented.
   void operator=(const vtkXMLWriter&);  // Not implemented.
+
+  vtkXMLWriterAsynchronousQueue* AsynchronousQueue;
 };
 
 #endif
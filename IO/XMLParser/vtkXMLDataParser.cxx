@@ -19,6 +19,7 @@
 #include "vtkCommand.h"
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
@@ -28,8 +29,16 @@
 #include <vtksys/auto_ptr.hxx>
 #include <vtksys/ios/sstream>
 
+#include <vector>
+
 #include "vtkXMLUtilities.h"
 
+#if !defined(_WIN32) || defined(__CYGWIN__)
+# include <errno.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
 
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
@@ -46,10 +55,12 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->DataStream = 0;
   this->InlineDataStream = vtkBase64InputStream::New();
   this->AppendedDataStream = vtkBase64InputStream::New();
+  this->AppendedDataIsRaw = 0;
 
   this->BlockCompressedSizes = 0;
   this->BlockStartOffsets = 0;
   this->Compressor = 0;
+  this->NumberOfThreads = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
 
   this->AsciiDataBuffer = 0;
   this->AsciiDataBufferLength = 0;
@@ -108,6 +119,7 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -168,6 +180,7 @@ void vtkXMLDataParser::StartElement(const char* name, const char** atts)
       {
       this->AppendedDataStream->Delete();
       this->AppendedDataStream = vtkInputStream::New();
+      this->AppendedDataIsRaw = 1;
       }
     }
 }
@@ -587,6 +600,48 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(vtkTypeUInt64 firstBlock, size_t numBlocks,
+                                 unsigned char* buffer)
+{
+  // The compressed blocks are contiguous in the stream.  Read them at
+  // once.
+  size_t compressedSize = 0;
+  for(size_t i=0; i < numBlocks; ++i)
+    {
+    compressedSize += this->BlockCompressedSizes[firstBlock+i];
+    }
+  if(!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+    {
+    return 0;
+    }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if(compressedSize > 0 &&
+     this->DataStream->Read(&readBuffer[0], compressedSize) < compressedSize)
+    {
+    return 0;
+    }
+
+  // Uncompress the blocks concurrently.
+  std::vector<unsigned char const*> compressedData(numBlocks);
+  std::vector<size_t> uncompressedSizes(numBlocks);
+  std::vector<unsigned char*> uncompressedData(numBlocks);
+  unsigned char const* compressedPointer = compressedSize? &readBuffer[0] : 0;
+  for(size_t i=0; i < numBlocks; ++i)
+    {
+    compressedData[i] = compressedPointer;
+    compressedPointer += this->BlockCompressedSizes[firstBlock+i];
+    uncompressedSizes[i] = this->FindBlockSize(firstBlock+i);
+    uncompressedData[i] = buffer;
+    buffer += uncompressedSizes[i];
+    }
+  return this->Compressor->UncompressBlocks(numBlocks, &compressedData[0],
+                                            this->BlockCompressedSizes+firstBlock,
+                                            &uncompressedData[0],
+                                            &uncompressedSizes[0],
+                                            this->NumberOfThreads);
+}
+
 //----------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(unsigned char* data,
                                               vtkTypeUInt64 startWord,
@@ -755,18 +810,32 @@ size_t vtkXMLDataParser::ReadCompressedData(unsigned char* data,
     // Report progress.
     this->UpdateProgress(float(outputPointer-data)/length);
 
-    unsigned int currentBlock = firstBlock+1;
-    for(;currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks a few per thread at a time so that they
+    // are uncompressed concurrently.
+    vtkTypeUInt64 currentBlock = firstBlock+1;
+    size_t blocksPerRead = 4*this->NumberOfThreads;
+    while(currentBlock != lastBlock && !this->Abort)
       {
-      // Read this block.
-      if(!this->ReadBlock(currentBlock, outputPointer)) { return 0; }
+      size_t numBlocks = blocksPerRead;
+      if(numBlocks > lastBlock-currentBlock)
+        {
+        numBlocks = static_cast<size_t>(lastBlock-currentBlock);
+        }
 
-      // Byte swap this block.  Note that blockSize will always be an
+      // Read these blocks.
+      if(!this->ReadBlocks(currentBlock, numBlocks, outputPointer))
+        {
+        return 0;
+        }
+
+      // Byte swap these blocks.  Note that blockSize will always be an
       // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      this->PerformByteSwap(outputPointer, numBlocks*blockSize / wordSize,
+                            wordSize);
 
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += numBlocks*blockSize;
+      currentBlock += numBlocks;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer-data)/length);
@@ -907,10 +976,134 @@ size_t vtkXMLDataParser::ReadAppendedData(vtkTypeInt64 offset,
                                           int wordType)
 {
   this->DataStream = this->AppendedDataStream;
+
+  // Read uncompressed raw data straight from the file when possible.
+  size_t wordSize = this->GetWordTypeSize(wordType);
+  size_t actualWords;
+  if(this->AppendedDataIsRaw && !this->Compressor && this->FileName &&
+     !this->Abort &&
+     this->ReadRawAppendedData(this->AppendedDataPosition+offset,
+                               reinterpret_cast<unsigned char*>(buffer),
+                               startWord, numWords, wordSize, actualWords))
+    {
+    return this->Abort? 0:actualWords;
+    }
+
   this->SeekG(this->AppendedDataPosition+offset);
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//----------------------------------------------------------------------------
+#if !defined(_WIN32) || defined(__CYGWIN__)
+static bool vtkXMLDataParserReadAt(int fd, vtkTypeInt64 position,
+                                   unsigned char* data, size_t length)
+{
+  // Read until all the bytes are in or the file ends.
+  while(length > 0)
+    {
+    ssize_t n = pread(fd, data, length, static_cast<off_t>(position));
+    if(n < 0 && errno == EINTR)
+      {
+      continue;
+      }
+    if(n <= 0)
+      {
+      return false;
+      }
+    data += n;
+    position += n;
+    length -= static_cast<size_t>(n);
+    }
+  return true;
+}
+#endif
+
+//----------------------------------------------------------------------------
+int vtkXMLDataParser::ReadRawAppendedData(vtkTypeInt64 position,
+                                          unsigned char* data,
+                                          vtkTypeUInt64 startWord,
+                                          size_t numWords,
+                                          size_t wordSize,
+                                          size_t& actualWords)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  (void)position; (void)data; (void)startWord; (void)numWords;
+  (void)wordSize; (void)actualWords;
+  return 0;
+#else
+  // Data in the other byte order are swapped word by word, which the
+  // stream path does just as well.
+#ifdef VTK_WORDS_BIGENDIAN
+  int nativeOrder = vtkXMLDataParser::BigEndian;
+#else
+  int nativeOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if(this->ByteOrder != nativeOrder && wordSize > 1)
+    {
+    return 0;
+    }
+
+  // Use the stream if the file cannot be opened.  Each read opens the
+  // file so that readers of several pieces may share it on several
+  // threads.
+  int fd = open(this->FileName, O_RDONLY);
+  if(fd < 0)
+    {
+    return 0;
+    }
+  actualWords = 0;
+
+  // First read the length of the data.
+  vtksys::auto_ptr<vtkXMLDataHeader>
+    uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  if(!vtkXMLDataParserReadAt(fd, position, uh->Data(), headerSize))
+    {
+    vtkErrorMacro("Error reading uncompressed binary data header.");
+    close(fd);
+    return 1;
+    }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+
+  // Clip the requested words to the data as ReadUncompressedData does.
+  vtkTypeUInt64 size = (uh->Get(0)/wordSize)*wordSize;
+  vtkTypeUInt64 offset = startWord*wordSize;
+  if(offset > size)
+    {
+    close(fd);
+    return 1;
+    }
+  vtkTypeUInt64 end = offset+numWords*wordSize;
+  if(end > size)
+    {
+    end = size;
+    }
+  size_t length = static_cast<size_t>(end-offset);
+
+  // Read the data into the buffer in 64MB blocks and report progress.
+  size_t const blockSize = 67108864;
+  vtkTypeInt64 filePosition =
+    position + static_cast<vtkTypeInt64>(headerSize + offset);
+  size_t done = 0;
+  this->UpdateProgress(0);
+  while(done < length && !this->Abort)
+    {
+    size_t n = (blockSize < length-done)? blockSize:length-done;
+    if(!vtkXMLDataParserReadAt(fd, filePosition+done, data+done, n))
+      {
+      close(fd);
+      return 1;
+      }
+    done += n;
+    this->UpdateProgress(float(done)/length);
+    }
+  this->UpdateProgress(1);
+  close(fd);
+  actualWords = length/wordSize;
+  return 1;
+#endif
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
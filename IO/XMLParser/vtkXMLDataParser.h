@@ -63,7 +63,10 @@ public:
 
   // Description:
   // Read from an appended data section starting at the given appended
-  // data offset.  Returns the number of words read.
+  // data offset.  Returns the number of words read.  Uncompressed raw
+  // appended data in the byte order of this machine are read from the
+  // file named by FileName, if set, directly into the buffer with
+  // positioned reads that do not move the stream.
   size_t ReadAppendedData(vtkTypeInt64 offset, void* buffer,
                           vtkTypeUInt64 startWord,
                           size_t numWords, int wordType);
@@ -92,6 +95,13 @@ public:
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
 
+  // Description:
+  // Get/Set the number of threads used to decompress the blocks of
+  // compressed data.  Default is the global default number of threads
+  // of vtkMultiThreader.
+  vtkSetClampMacro(NumberOfThreads, int, 1, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
   // Description:
   // Get the size of a word of the given type.
   size_t GetWordTypeSize(int wordType);
@@ -158,6 +168,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, size_t numBlocks,
+                 unsigned char* buffer);
   size_t ReadUncompressedData(unsigned char* data,
                               vtkTypeUInt64 startWord,
                               size_t numWords,
@@ -166,6 +178,9 @@ protected:
                             vtkTypeUInt64 startWord,
                             size_t numWords,
                             size_t wordSize);
+  int ReadRawAppendedData(vtkTypeInt64 position, unsigned char* data,
+                          vtkTypeUInt64 startWord, size_t numWords,
+                          size_t wordSize, size_t& actualWords);
 
   // Go to the start of the inline data
   void SeekInlineDataPosition(vtkXMLDataElement *element);
@@ -208,6 +223,9 @@ protected:
   // The stream to use for appended data.
   vtkInputStream* AppendedDataStream;
 
+  // Whether the appended data are raw rather than base64 encoded.
+  int AppendedDataIsRaw;
+
   // Decompression data.
   vtkDataCompressor* Compressor;
   size_t NumberOfBlocks;
@@ -215,6 +233,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  int NumberOfThreads;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
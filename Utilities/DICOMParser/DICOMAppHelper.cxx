@@ -1348,6 +1348,55 @@ void DICOMAppHelper::Clear()
   this->Implementation->SeriesUIDMap.clear();
 }
 
+void DICOMAppHelper::Merge(DICOMAppHelper* other)
+{
+  dicom_stl::map<dicom_stl::string, dicom_stl::vector<dicom_stl::string>, ltstdstr>::iterator miter;
+  for (miter = other->Implementation->SeriesUIDMap.begin();
+       miter != other->Implementation->SeriesUIDMap.end();
+       ++miter)
+    {
+    dicom_stl::vector<dicom_stl::string>& files =
+      this->Implementation->SeriesUIDMap[(*miter).first];
+    files.insert(files.end(), (*miter).second.begin(), (*miter).second.end());
+    }
+
+  dicom_stl::map<dicom_stl::string, DICOMOrderingElements, ltstdstr>::iterator oiter;
+  for (oiter = other->Implementation->SliceOrderingMap.begin();
+       oiter != other->Implementation->SliceOrderingMap.end();
+       ++oiter)
+    {
+    this->Implementation->SliceOrderingMap[(*oiter).first] = (*oiter).second;
+    }
+
+  this->BitsAllocated = other->BitsAllocated;
+  this->ByteSwapData = other->ByteSwapData;
+  this->PixelSpacing[0] = other->PixelSpacing[0];
+  this->PixelSpacing[1] = other->PixelSpacing[1];
+  this->PixelSpacing[2] = other->PixelSpacing[2];
+  this->Width = other->Width;
+  this->Height = other->Height;
+  this->SliceNumber = other->SliceNumber;
+  this->Dimensions[0] = other->Dimensions[0];
+  this->Dimensions[1] = other->Dimensions[1];
+  for (int i = 0; i < 3; i++)
+    {
+    this->ImagePositionPatient[i] = other->ImagePositionPatient[i];
+    }
+  for (int i = 0; i < 6; i++)
+    {
+    this->ImageOrientationPatient[i] = other->ImageOrientationPatient[i];
+    }
+  this->PixelRepresentation = other->PixelRepresentation;
+  *this->PhotometricInterpretation = *other->PhotometricInterpretation;
+  *this->TransferSyntaxUID = *other->TransferSyntaxUID;
+  this->RescaleOffset = other->RescaleOffset;
+  this->RescaleSlope = other->RescaleSlope;
+  *this->PatientName = *other->PatientName;
+  *this->StudyUID = *other->StudyUID;
+  *this->StudyID = *other->StudyID;
+  this->GantryAngle = other->GantryAngle;
+}
+
 void DICOMAppHelper::PatientNameCallback(DICOMParser *,
                                          doublebyte,
                                          doublebyte,
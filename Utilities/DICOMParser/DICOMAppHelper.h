@@ -382,6 +382,12 @@ public:
    * ordering filenames based on image locations. */
   void Clear();
 
+  /** Add the files processed by another helper to the internal
+   * databases, after the files processed by this one, and take the
+   * information of the last image it processed. This allows several
+   * parsers to scan the files of a series on separate threads. */
+  void Merge(DICOMAppHelper* other);
+
   /** Get the series UIDs for the files processed since the last
    * clearing of the cache. */
   void GetSeriesUIDs(dicom_stl::vector<dicom_stl::string> &v);